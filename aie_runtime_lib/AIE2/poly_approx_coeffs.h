@@ -0,0 +1,122 @@
+//===- poly_approx_coeffs.h - Polynomial approximation data -----*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+// Coefficients and constants of the approximations in poly_approx_ops.h. They
+// do not depend on aie_api, so that host code can check them against libm.
+//===----------------------------------------------------------------------===//
+
+#ifndef POLY_APPROX_COEFFS_H
+#define POLY_APPROX_COEFFS_H
+
+namespace poly_approx {
+
+// Newton iterations of the reciprocal and reciprocal square root at `order`.
+constexpr unsigned getNewtonSteps(unsigned order) { return (order + 1) / 2; }
+
+// Coefficients of exp(r) on [-ln2, ln2], lowest degree first, from
+// interpolation at Chebyshev nodes.
+template <unsigned Order> struct ExpCoeffs;
+template <> struct ExpCoeffs<2> {
+  static constexpr float c[] = {1.0f, 1.061148f, 0.515195662f};
+};
+template <> struct ExpCoeffs<3> {
+  static constexpr float c[] = {0.998778334f, 0.99975678f, 0.520301477f,
+                                0.170710747f};
+};
+template <> struct ExpCoeffs<4> {
+  static constexpr float c[] = {1.0f, 0.999390214f, 0.499898731f,
+                                0.171728996f, 0.0425079788f};
+};
+template <> struct ExpCoeffs<5> {
+  static constexpr float c[] = {1.00000488f,  1.00000069f,   0.499817412f,
+                                0.166640654f, 0.0426773242f, 0.00847740354f};
+};
+
+// Odd coefficients of tanh(x) on [-0.5, 0.5]: x * (c[0] + c[1] x^2 + ...).
+template <unsigned Order> struct TanhCoeffs;
+template <> struct TanhCoeffs<2> {
+  static constexpr float c[] = {0.999055143f, -0.30271552f};
+};
+template <> struct TanhCoeffs<3> {
+  static constexpr float c[] = {0.999977239f, -0.331685329f, 0.115185198f};
+};
+template <> struct TanhCoeffs<4> {
+  static constexpr float c[] = {0.999999451f, -0.333262842f, 0.131899394f,
+                                -0.0443927384f};
+};
+template <> struct TanhCoeffs<5> {
+  static constexpr float c[] = {0.999999987f, -0.333330679f, 0.133247505f,
+                                -0.0529842388f, 0.0171313444f};
+};
+
+// erf(x) = 1 - t * P(t) * exp(-x^2), t = 1 / (1 + p * x), for x >= 0, with
+// an absolute error of at most maxError on [0, 4]. Orders 2 and 4 are
+// Abramowitz and Stegun 7.1.25 and 7.1.26; orders 3 and 5 are minimax fits of
+// the same form.
+template <unsigned Order> struct ErfCoeffs;
+template <> struct ErfCoeffs<2> {
+  static constexpr float p = 0.47047f;
+  static constexpr float c[] = {0.3480242f, -0.0958798f, 0.7478556f};
+  static constexpr double maxError = 2.5e-5;
+};
+template <> struct ErfCoeffs<3> {
+  static constexpr float p = 0.6f;
+  static constexpr float c[] = {0.370281339f, 0.140431702f, 0.727851093f,
+                                -0.238564447f};
+  static constexpr double maxError = 2.5e-6;
+};
+template <> struct ErfCoeffs<4> {
+  static constexpr float p = 0.3275911f;
+  static constexpr float c[] = {0.254829592f, -0.284496736f, 1.421413741f,
+                                -1.453152027f, 1.061405429f};
+  static constexpr double maxError = 1.5e-7;
+};
+template <> struct ErfCoeffs<5> {
+  static constexpr float p = 0.55f;
+  static constexpr float c[] = {0.301635593f, 0.390493542f, -0.0405049399f,
+                                0.758510768f, -0.517260492f, 0.107125528f};
+  static constexpr double maxError = 3e-8;
+};
+
+// Maclaurin series of erf(x) for |x| < 0.5, where 1 - t * P(t) * exp(-x^2)
+// cancels: x * (c[0] + c[1] x^2 + ...).
+template <unsigned Order> struct ErfSmallCoeffs;
+template <> struct ErfSmallCoeffs<2> {
+  static constexpr float c[] = {1.12837917f, -0.376126389f};
+};
+template <> struct ErfSmallCoeffs<3> {
+  static constexpr float c[] = {1.12837917f, -0.376126389f, 0.112837917f};
+};
+template <> struct ErfSmallCoeffs<4> {
+  static constexpr float c[] = {1.12837917f, -0.376126389f, 0.112837917f,
+                                -0.0268661707f};
+};
+template <> struct ErfSmallCoeffs<5> {
+  static constexpr float c[] = {1.12837917f, -0.376126389f, 0.112837917f,
+                                -0.0268661707f, 0.00522397762f};
+};
+
+// Initial guesses of 1/x and 1/sqrt(x) as bit patterns: the fp32 seeds
+// 0x7ef311c3 and 0x5f3759df, and their upper halves for bfloat16.
+constexpr unsigned invSeedF32 = 0x7ef311c3;
+constexpr short invSeedBf16 = 0x7ef3;
+constexpr short rsqrtSeedBf16 = 0x5f37;
+
+// exp range reduction: log2(e), and ln2 split into a part that is exact in
+// bfloat16 and the remainder. Inputs are clamped to [expMin, expMax] so that
+// 2^n stays in the range of normal floats.
+constexpr float log2e = 1.44269504f;
+constexpr float ln2Hi = 0.69140625f;
+constexpr float ln2Lo = 1.74093056e-3f;
+constexpr float expMin = -87.0f;
+constexpr float expMax = 88.0f;
+
+} // namespace poly_approx
+
+#endif // POLY_APPROX_COEFFS_H
@@ -0,0 +1,272 @@
+//===- poly_approx_ops.h - Polynomial approximations ------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+// Vectorized approximations of exp, tanh, sigmoid, erf, rsqrt and 1/x for
+// bfloat16 that only use range reduction, polynomials and Newton iterations.
+// Unlike lut_based_ops.h they need no lookup tables in data memory.
+//
+// Every function takes an `Order` template parameter trading cycles for
+// accuracy. For exp it is the degree of the polynomial on [-ln2, ln2]; the
+// relative error of the polynomial is 2.4e-2, 2.1e-3, 1.5e-4 and 8.8e-6 for
+// orders 2 to 5. The other functions use exp of the same order, and
+// (Order + 1) / 2 Newton iterations wherever they need a reciprocal or a
+// reciprocal square root. The results are within eight bfloat16 ulps of libm
+// at order 2, and within two from order 3 on.
+//===----------------------------------------------------------------------===//
+
+#ifndef POLY_APPROX_OPS_H
+#define POLY_APPROX_OPS_H
+
+#include "aie_api/aie.hpp"
+#include "poly_approx_coeffs.h"
+
+namespace poly_approx {
+
+// Evaluate the polynomial with coefficients `c` at `x` by Horner's rule,
+// accumulating in fp32.
+template <unsigned Lanes, unsigned N>
+inline __attribute__((always_inline)) aie::accum<accfloat, Lanes>
+horner(const float (&c)[N], aie::vector<bfloat16, Lanes> x) {
+  aie::accum<accfloat, Lanes> acc;
+  acc.from_vector(aie::broadcast<float, Lanes>(c[N - 1]));
+  for (int i = N - 2; i >= 0; i--) {
+    aie::accum<accfloat, Lanes> coeff;
+    coeff.from_vector(aie::broadcast<float, Lanes>(c[i]));
+    acc = aie::mac(coeff, acc.template to_vector<bfloat16>(), x);
+  }
+  return acc;
+}
+
+// 1/d, seeded from the exponent of d and refined with Newton iterations
+// y = y * (2 - d * y).
+template <unsigned Steps, unsigned Lanes>
+inline __attribute__((always_inline)) aie::vector<bfloat16, Lanes>
+inv(aie::vector<bfloat16, Lanes> d) {
+  const aie::vector<int16, Lanes> magic =
+      aie::broadcast<int16, Lanes>(invSeedBf16);
+  aie::vector<bfloat16, Lanes> y =
+      aie::sub(magic, d.template cast_to<int16>()).template cast_to<bfloat16>();
+  const aie::vector<bfloat16, Lanes> two =
+      aie::broadcast<bfloat16, Lanes>(2.0f);
+  for (unsigned i = 0; i < Steps; i++) {
+    aie::accum<accfloat, Lanes> e;
+    e.from_vector(two);
+    e = aie::msc(e, d, y);
+    y = aie::mul(e.template to_vector<bfloat16>(), y)
+            .template to_vector<bfloat16>();
+  }
+  return y;
+}
+
+// 1/sqrt(x), seeded as in getRsqrtBf16 and refined with Newton iterations
+// y = y * (1.5 - 0.5 * x * y * y).
+template <unsigned Steps, unsigned Lanes>
+inline __attribute__((always_inline)) aie::vector<bfloat16, Lanes>
+rsqrt(aie::vector<bfloat16, Lanes> x) {
+  const aie::vector<int16, Lanes> magic =
+      aie::broadcast<int16, Lanes>(rsqrtSeedBf16);
+  aie::vector<bfloat16, Lanes> y =
+      aie::sub(magic, aie::downshift(x.template cast_to<int16>(), 1))
+          .template cast_to<bfloat16>();
+  aie::vector<bfloat16, Lanes> halfX =
+      aie::mul(x, bfloat16(0.5f)).template to_vector<bfloat16>();
+  const aie::vector<bfloat16, Lanes> threeHalfs =
+      aie::broadcast<bfloat16, Lanes>(1.5f);
+  for (unsigned i = 0; i < Steps; i++) {
+    aie::vector<bfloat16, Lanes> y2 =
+        aie::mul_square(y).template to_vector<bfloat16>();
+    aie::accum<accfloat, Lanes> t;
+    t.from_vector(threeHalfs);
+    t = aie::msc(t, halfX, y2);
+    y = aie::mul(t.template to_vector<bfloat16>(), y)
+            .template to_vector<bfloat16>();
+  }
+  return y;
+}
+
+// exp(x) = 2^n * exp(r), with n = round(x / ln2) and r = x - n * ln2. ln2 is
+// split in two so that n * ln2 is exact enough for large n, and 2^n is
+// applied by adding n to the exponent of the fp32 result.
+template <unsigned Order>
+inline __attribute__((always_inline)) aie::vector<bfloat16, 16>
+exp(aie::vector<bfloat16, 16> x) {
+  static_assert(Order >= 2 && Order <= 5, "unsupported exp order");
+  x = aie::max(aie::min(x, bfloat16(expMax)), bfloat16(expMin));
+  aie::accum<accfloat, 16> t = aie::mul(x, bfloat16(log2e));
+  aie::vector<int32, 16> n = bfloat16_to_int(t.to_vector<bfloat16>(), 0);
+  aie::accum<accfloat, 16> nAcc;
+  nAcc.from_vector(aie::to_float(n, 0));
+  aie::vector<bfloat16, 16> nBf16 = nAcc.to_vector<bfloat16>();
+  aie::accum<accfloat, 16> r;
+  r.from_vector(x);
+  r = aie::msc(r, nBf16, bfloat16(ln2Hi));
+  r = aie::msc(r, nBf16, bfloat16(ln2Lo));
+  aie::accum<accfloat, 16> p =
+      horner(ExpCoeffs<Order>::c, r.to_vector<bfloat16>());
+  aie::vector<int32, 16> bits =
+      aie::add(p.to_vector<float>().cast_to<int32>(), aie::upshift(n, 23));
+  aie::accum<accfloat, 16> res;
+  res.from_vector(bits.cast_to<float>());
+  return res.to_vector<bfloat16>();
+}
+
+template <unsigned Order>
+inline __attribute__((always_inline)) aie::vector<bfloat16, 32>
+exp(aie::vector<bfloat16, 32> x) {
+  return aie::concat(exp<Order>(x.extract<16>(0)),
+                     exp<Order>(x.extract<16>(1)));
+}
+
+// For |x| < 0.5, an odd polynomial. Otherwise tanh(|x|) = 1 - 2 / (exp(2|x|)
+// + 1), which has no cancellation there; |x| is clamped to 9, where tanh
+// rounds to 1.
+template <unsigned Order, unsigned Lanes>
+inline __attribute__((always_inline)) aie::vector<bfloat16, Lanes>
+tanh(aie::vector<bfloat16, Lanes> x) {
+  aie::vector<bfloat16, Lanes> ax = aie::min(aie::abs(x), bfloat16(9.0f));
+  aie::vector<bfloat16, Lanes> e =
+      exp<Order>(aie::mul(ax, bfloat16(2.0f)).template to_vector<bfloat16>());
+  aie::vector<bfloat16, Lanes> q =
+      inv<getNewtonSteps(Order)>(aie::add(e, bfloat16(1.0f)));
+  aie::accum<accfloat, Lanes> large;
+  large.from_vector(aie::broadcast<bfloat16, Lanes>(1.0f));
+  large = aie::msc(large, q, bfloat16(2.0f));
+  aie::vector<bfloat16, Lanes> largeVec =
+      large.template to_vector<bfloat16>();
+  largeVec = aie::select(largeVec, aie::neg(largeVec), aie::lt(x, bfloat16(0)));
+
+  aie::vector<bfloat16, Lanes> x2 =
+      aie::mul_square(x).template to_vector<bfloat16>();
+  aie::vector<bfloat16, Lanes> small =
+      aie::mul(horner(TanhCoeffs<Order>::c, x2).template to_vector<bfloat16>(),
+               x)
+          .template to_vector<bfloat16>();
+  return aie::select(largeVec, small, aie::lt(ax, bfloat16(0.5f)));
+}
+
+// sigmoid(x) = 1 / (1 + exp(-x)), with x clamped to [-20, 20].
+template <unsigned Order, unsigned Lanes>
+inline __attribute__((always_inline)) aie::vector<bfloat16, Lanes>
+sigmoid(aie::vector<bfloat16, Lanes> x) {
+  x = aie::max(aie::min(x, bfloat16(20.0f)), bfloat16(-20.0f));
+  aie::vector<bfloat16, Lanes> e = exp<Order>(aie::neg(x));
+  return inv<getNewtonSteps(Order)>(aie::add(e, bfloat16(1.0f)));
+}
+
+// For |x| < 0.5, an odd polynomial. Otherwise the rational approximation of
+// ErfCoeffs on |x| clamped to 4, where erf rounds to 1, with the sign of x.
+template <unsigned Order, unsigned Lanes>
+inline __attribute__((always_inline)) aie::vector<bfloat16, Lanes>
+erf(aie::vector<bfloat16, Lanes> x) {
+  using Coeffs = ErfCoeffs<Order>;
+  aie::vector<bfloat16, Lanes> ax = aie::min(aie::abs(x), bfloat16(4.0f));
+  aie::accum<accfloat, Lanes> d;
+  d.from_vector(aie::broadcast<bfloat16, Lanes>(1.0f));
+  d = aie::mac(d, ax, bfloat16(Coeffs::p));
+  aie::vector<bfloat16, Lanes> t =
+      inv<getNewtonSteps(Order)>(d.template to_vector<bfloat16>());
+  aie::vector<bfloat16, Lanes> tp =
+      aie::mul(horner(Coeffs::c, t).template to_vector<bfloat16>(), t)
+          .template to_vector<bfloat16>();
+  aie::vector<bfloat16, Lanes> e = exp<Order>(
+      aie::neg(aie::mul_square(ax).template to_vector<bfloat16>()));
+  aie::accum<accfloat, Lanes> y;
+  y.from_vector(aie::broadcast<bfloat16, Lanes>(1.0f));
+  y = aie::msc(y, tp, e);
+  aie::vector<bfloat16, Lanes> yVec = y.template to_vector<bfloat16>();
+  yVec = aie::select(yVec, aie::neg(yVec), aie::lt(x, bfloat16(0)));
+
+  aie::vector<bfloat16, Lanes> x2 =
+      aie::mul_square(x).template to_vector<bfloat16>();
+  aie::vector<bfloat16, Lanes> small =
+      aie::mul(
+          horner(ErfSmallCoeffs<Order>::c, x2).template to_vector<bfloat16>(),
+          x)
+          .template to_vector<bfloat16>();
+  return aie::select(yVec, small, aie::lt(ax, bfloat16(0.5f)));
+}
+
+} // namespace poly_approx
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v16bfloat16
+getExpBf16Poly(v16bfloat16 in) {
+  return (v16bfloat16)poly_approx::exp<Order>(aie::vector<bfloat16, 16>(in));
+}
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v32bfloat16
+getExpBf16Poly(v32bfloat16 in) {
+  return (v32bfloat16)poly_approx::exp<Order>(aie::vector<bfloat16, 32>(in));
+}
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v16bfloat16
+getTanhBf16Poly(v16bfloat16 in) {
+  return (v16bfloat16)poly_approx::tanh<Order>(aie::vector<bfloat16, 16>(in));
+}
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v32bfloat16
+getTanhBf16Poly(v32bfloat16 in) {
+  return (v32bfloat16)poly_approx::tanh<Order>(aie::vector<bfloat16, 32>(in));
+}
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v16bfloat16
+getSigmoidBf16Poly(v16bfloat16 in) {
+  return (v16bfloat16)poly_approx::sigmoid<Order>(
+      aie::vector<bfloat16, 16>(in));
+}
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v32bfloat16
+getSigmoidBf16Poly(v32bfloat16 in) {
+  return (v32bfloat16)poly_approx::sigmoid<Order>(
+      aie::vector<bfloat16, 32>(in));
+}
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v16bfloat16
+getErfBf16Poly(v16bfloat16 in) {
+  return (v16bfloat16)poly_approx::erf<Order>(aie::vector<bfloat16, 16>(in));
+}
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v32bfloat16
+getErfBf16Poly(v32bfloat16 in) {
+  return (v32bfloat16)poly_approx::erf<Order>(aie::vector<bfloat16, 32>(in));
+}
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v16bfloat16
+getRsqrtBf16Poly(v16bfloat16 in) {
+  return (v16bfloat16)poly_approx::rsqrt<poly_approx::getNewtonSteps(Order)>(
+      aie::vector<bfloat16, 16>(in));
+}
+
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) v32bfloat16
+getRsqrtBf16Poly(v32bfloat16 in) {
+  return (v32bfloat16)poly_approx::rsqrt<poly_approx::getNewtonSteps(Order)>(
+      aie::vector<bfloat16, 32>(in));
+}
+
+// Scalar 1/x, as computed by getInvBf16 without the mantissa lookup table.
+template <unsigned Order = 4>
+inline __attribute__((always_inline)) bfloat16 getInvBf16Poly(float x) {
+  unsigned int *B_x = (unsigned int *)&x;
+  unsigned int B_y = poly_approx::invSeedF32 - *B_x;
+  float y = *(float *)&B_y;
+  for (unsigned i = 0; i < poly_approx::getNewtonSteps(Order); i++)
+    y = y * (2.0f - x * y);
+  return (bfloat16)y;
+}
+
+#endif // POLY_APPROX_OPS_H
@@ -0,0 +1,31 @@
+//===- TilingDSE.h ----------------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef AIE_C_TILINGDSE_H
+#define AIE_C_TILINGDSE_H
+
+#include "mlir-c/Support.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Explore the tilings of the loop nest described by the JSON `problem` (see
+/// aie/Dialect/AIE/Transforms/AIETilingDSE.h). On success, calls `callback`
+/// with the JSON array of the Pareto-optimal tilings; otherwise, calls it with
+/// the reason the problem is invalid and returns failure.
+MLIR_CAPI_EXPORTED MlirLogicalResult aieExploreTilings(
+    MlirStringRef problem, MlirStringCallback callback, void *userData);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AIE_C_TILINGDSE_H
@@ -0,0 +1,103 @@
+//===- AIEDeviceIndex.h -----------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef MLIR_AIE_DEVICE_INDEX_H
+#define MLIR_AIE_DEVICE_INDEX_H
+
+#include "aie/Dialect/AIE/IR/AIEDialect.h"
+
+#include "mlir/Pass/AnalysisManager.h"
+
+namespace xilinx::AIE {
+
+// An index of the operations of a device by tile coordinates and by symbol.
+// It is built in a single walk of the device and meant to be obtained through
+// the AnalysisManager:
+//
+//   auto &index = getAnalysis<AIEDeviceIndex>();
+//
+// so that consecutive passes share it instead of each scanning the device.
+// Passes that do not create or erase tiles, tile elements or symbols preserve
+// it; changing attributes such as lock ids, BD ids and buffer addresses is
+// fine, as the lookups by id read them from the operations.
+class AIEDeviceIndex {
+public:
+  explicit AIEDeviceIndex(mlir::Operation *op);
+
+  DeviceOp getDevice() const { return device; }
+  const AIETargetModel &getTargetModel() const { return *targetModel; }
+
+  // The operations of the tile at `id`, or null if there is none.
+  TileOp getTile(TileID id) const;
+  TileOp getTile(int col, int row) const { return getTile({col, row}); }
+  SwitchboxOp getSwitchbox(TileID id) const;
+  ShimMuxOp getShimMux(TileID id) const;
+  CoreOp getCore(TileID id) const;
+  // The MemOp, MemTileDMAOp or ShimDMAOp of the tile at `id`.
+  mlir::Operation *getDMA(TileID id) const;
+
+  // The buffers, locks, BDs and DMA starts of the tile at `id`, in the order
+  // they appear in the device.
+  llvm::ArrayRef<BufferOp> getBuffers(TileID id) const;
+  llvm::ArrayRef<LockOp> getLocks(TileID id) const;
+  llvm::ArrayRef<DMABDOp> getBDs(TileID id) const;
+  llvm::ArrayRef<DMAStartOp> getDMAStarts(TileID id) const;
+
+  // The lock, BD and DMA start of the tile at `id` with the given id or
+  // channel, or null if there is none. A tile has a bounded number of each.
+  LockOp getLock(TileID id, int lockID) const;
+  DMABDOp getBD(TileID id, int bdID) const;
+  DMAStartOp getDMAStart(TileID id, DMAChannelDir dir, int channel) const;
+
+  // The operation of the device defining the symbol `name`.
+  mlir::Operation *lookupSymbol(llvm::StringRef name) const;
+  template <typename OpTy>
+  OpTy lookupSymbol(llvm::StringRef name) const {
+    return llvm::dyn_cast_or_null<OpTy>(lookupSymbol(name));
+  }
+
+  // The first shim DMA allocation of the symbol `name`, or null.
+  ShimDMAAllocationOp getShimDMAAllocation(llvm::StringRef name) const;
+
+  // Return the tile or switchbox at the given coordinates, creating it with
+  // `builder` if the device has none yet. The index is kept up to date.
+  TileOp getOrCreateTile(mlir::OpBuilder &builder, int col, int row);
+  SwitchboxOp getOrCreateSwitchbox(mlir::OpBuilder &builder, TileOp tile);
+
+  bool isInvalidated(const mlir::AnalysisManager::PreservedAnalyses &pa) {
+    return !pa.isPreserved<AIEDeviceIndex>();
+  }
+
+private:
+  struct TileInfo {
+    TileOp tile;
+    SwitchboxOp switchbox;
+    ShimMuxOp shimMux;
+    CoreOp core;
+    mlir::Operation *dma = nullptr;
+    llvm::SmallVector<BufferOp, 4> buffers;
+    llvm::SmallVector<LockOp, 4> locks;
+    llvm::SmallVector<DMABDOp, 4> bds;
+    llvm::SmallVector<DMAStartOp, 4> dmaStarts;
+  };
+
+  const TileInfo *lookup(TileID id) const;
+  void addDMA(mlir::Operation *dma, TileID id);
+
+  DeviceOp device;
+  const AIETargetModel *targetModel;
+  llvm::DenseMap<TileID, TileInfo> tiles;
+  llvm::DenseMap<mlir::StringAttr, mlir::Operation *> symbols;
+  llvm::DenseMap<mlir::StringAttr, ShimDMAAllocationOp> shimDMAAllocations;
+};
+
+} // namespace xilinx::AIE
+
+#endif // MLIR_AIE_DEVICE_INDEX_H
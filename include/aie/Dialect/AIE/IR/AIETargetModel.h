@@ -165,6 +165,12 @@ public:
   /// Return the size (in bytes) of the local data memory of a core.
   virtual uint32_t getLocalMemorySize() const = 0;
 
+  /// Return the number of banks the data memory of the given tile is split
+  /// into. Buffers are allocated over the banks by AIEAssignBuffers.
+  uint32_t getNumBanks(int col, int row) const {
+    return isMemTile(col, row) ? 1 : 4;
+  }
+
   /// Return the number of lock objects
   virtual uint32_t getNumLocks(int col, int row) const = 0;
 
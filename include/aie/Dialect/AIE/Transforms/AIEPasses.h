@@ -44,6 +44,9 @@ createAIEObjectFifoRegisterProcessPass();
 std::unique_ptr<mlir::OperationPass<DeviceOp>> createAIELowerCascadeFlowsPass();
 std::unique_ptr<mlir::OperationPass<DeviceOp>>
 createAIEAssignBufferDescriptorIDsPass();
+std::unique_ptr<mlir::OperationPass<DeviceOp>> createAIEEstimateCyclesPass();
+std::unique_ptr<mlir::OperationPass<DeviceOp>> createAIEPlaceTilesPass();
+std::unique_ptr<mlir::OperationPass<DeviceOp>> createAIEAnalyzeLocksPass();
 
 /// Generate the code for registering passes.
 #define GEN_PASS_REGISTRATION
@@ -200,6 +200,9 @@ public:
   virtual std::optional<std::map<PathEndPoint, SwitchSettings>>
   findPaths(int maxIterations) = 0;
   virtual Switchbox *getSwitchbox(TileID coords) = 0;
+  // The channels between switchboxes, with the congestion left by the last
+  // findPaths, or none if the router does not track it.
+  virtual std::vector<const Channel *> getChannels() const { return {}; }
 };
 
 class Pathfinder : public Router {
@@ -221,6 +224,13 @@ public:
     return *sb;
   }
 
+  std::vector<const Channel *> getChannels() const override {
+    std::vector<const Channel *> channels;
+    for (const ChannelEdge &edge : edges)
+      channels.push_back(&edge);
+    return channels;
+  }
+
 private:
   SwitchboxGraph graph;
   std::vector<FlowNode> flows;
@@ -0,0 +1,131 @@
+//===- AIETilingDSE.h -------------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+//
+// Design-space exploration of the tilings of a perfect loop nest onto the
+// L3 (external memory) -> L2 (mem tiles) -> L1 (core memories) hierarchy.
+//
+// Each loop is split into an L1 tile computed by one core, a spatial factor
+// spreading it over several cores, and an L2 tile staged in the mem tiles;
+// all of them divide the loop bound. Every tiling and loop order that fits
+// the memories, cores and DMA dimensions of the target is evaluated with an
+// analytic model and the Pareto-optimal ones, trading compute cycles for
+// communication cycles, are returned.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef AIE_TILING_DSE_H
+#define AIE_TILING_DSE_H
+
+#include "aie/Dialect/AIE/IR/AIETargetModel.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/JSON.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace xilinx::AIE {
+
+struct TilingLoop {
+  std::string name;
+  int64_t bound = 1;
+};
+
+// A tensor accessed by the loop nest, indexed by the induction variables of
+// `loops` (indices into TilingProblem::loops), outermost dimension first.
+// Loops that do not index an output are reductions and are not spread over
+// cores, as that would need the partial results to be combined.
+struct TilingTensor {
+  std::string name;
+  llvm::SmallVector<unsigned, 4> loops;
+  unsigned elementBytes = 4;
+  bool output = false;
+};
+
+// The resources of the target available to the loop nest.
+struct TilingLimits {
+  // Bytes of data memory of a core, and of a mem tile (0 if there are none,
+  // in which case the L2 tiles are streamed straight to the cores).
+  uint64_t l1Bytes = 0;
+  uint64_t l2Bytes = 0;
+  // Number of columns with a path to external memory, and cores per column.
+  unsigned numColumns = 1;
+  unsigned coresPerColumn = 1;
+  // Dimensions of the address generation of a DMA BD.
+  unsigned dmaDims = 1;
+  // Bytes per cycle moved from L3 to L2 and from L2 to L1, per column.
+  double l3BytesPerCycle = 1;
+  double l2BytesPerCycle = 1;
+  // Multiply-accumulates per cycle of a core.
+  double macsPerCycle = 1;
+  // Number of buffers of each tile, e.g. 2 to overlap transfers and compute.
+  unsigned bufferCount = 2;
+};
+
+struct TilingProblem {
+  // The loops of the nest; the order is free, it is explored as well.
+  llvm::SmallVector<TilingLoop, 4> loops;
+  llvm::SmallVector<TilingTensor, 4> tensors;
+  TilingLimits limits;
+};
+
+struct TilingSolution {
+  // Per loop: the L1 tile, the number of cores it is spread over and the L2
+  // tile. l1Tile * spatial divides l2Tile, which divides the loop bound.
+  llvm::SmallVector<int64_t, 4> l1Tile;
+  llvm::SmallVector<int64_t, 4> spatial;
+  llvm::SmallVector<int64_t, 4> l2Tile;
+  // The temporal loop order, outermost first, used at both levels.
+  llvm::SmallVector<unsigned, 4> order;
+
+  unsigned cores = 1;
+  unsigned columns = 1;
+  // Bytes of L1 per core and of L2 per column, including the extra buffers.
+  uint64_t l1Bytes = 0;
+  uint64_t l2Bytes = 0;
+  // Bytes moved from L3 to L2 and from L2 to L1 by the whole nest.
+  uint64_t l3Traffic = 0;
+  uint64_t l2Traffic = 0;
+  double computeCycles = 0;
+  double communicationCycles = 0;
+
+  // Transfers overlap with compute, so the slower of the two dominates.
+  double cycles() const {
+    return std::max(computeCycles, communicationCycles);
+  }
+};
+
+// The limits of the devices of `targetModel`, for loop nests computing one
+// multiply-accumulate per innermost iteration.
+TilingLimits getTilingLimits(const AIETargetModel &targetModel);
+
+// Return the Pareto-optimal tilings of `problem` in (compute cycles,
+// communication cycles), sorted by cycles(). A problem whose loops do not
+// fit the target even with unit tiles has no solutions.
+std::vector<TilingSolution> exploreTilings(const TilingProblem &problem);
+
+// The JSON form of a problem is
+//
+//   {"device": "npu",
+//    "loops": [{"name": "i", "bound": 64}, ...],
+//    "tensors": [{"name": "A", "loops": ["i", "k"], "element_bytes": 2},
+//                {"name": "C", "loops": ["i", "j"], "output": true}, ...],
+//    "limits": {"l1_bytes": 65536, ...}}
+//
+// where "device" selects the limits of a target model, and the entries of
+// "limits" (named as the fields of TilingLimits in snake case) override them.
+bool fromJSON(const llvm::json::Value &value, TilingProblem &problem,
+              llvm::json::Path path);
+llvm::json::Value toJSON(const TilingSolution &solution);
+
+} // namespace xilinx::AIE
+
+#endif // AIE_TILING_DSE_H
@@ -63,6 +63,18 @@ struct LowerVectorToAIEVecOptions
                      "will determine the aievec operations used to convert "
                      "from vector dialect."),
       llvm::cl::init("cpp")};
+  PassOptions::Option<std::string> mathApprox{
+      *this, "math-approx",
+      llvm::cl::desc("Select the lowering of transcendental math ops: "
+                     "\"lut\" calls the lookup table based routines, "
+                     "\"poly\" calls polynomial approximations that use no "
+                     "data memory."),
+      llvm::cl::init("lut")};
+  PassOptions::Option<unsigned> mathApproxOrder{
+      *this, "math-approx-order",
+      llvm::cl::desc("Order (2-5) of the polynomial approximations, trading "
+                     "cycles for accuracy. 0 selects the library default."),
+      llvm::cl::init(0)};
 };
 
 /// Options for the "optimize-aievec" pipeline.
@@ -115,12 +127,26 @@ struct ConvertVectorToAIEVecOptions
                      "will determine the aievec operations used to convert "
                      "from vector dialect."),
       llvm::cl::init("cpp")};
+  PassOptions::Option<std::string> mathApprox{
+      *this, "math-approx",
+      llvm::cl::desc("Select the lowering of transcendental math ops: "
+                     "\"lut\" calls the lookup table based routines, "
+                     "\"poly\" calls polynomial approximations that use no "
+                     "data memory."),
+      llvm::cl::init("lut")};
+  PassOptions::Option<unsigned> mathApproxOrder{
+      *this, "math-approx-order",
+      llvm::cl::desc("Order (2-5) of the polynomial approximations, trading "
+                     "cycles for accuracy. 0 selects the library default."),
+      llvm::cl::init(0)};
 
   mlir::LogicalResult parseFromString(mlir::StringRef options) {
     auto res = PassPipelineOptions::parseFromString(options);
     if (!failed(res)) {
       lowerOptions.aieTarget = aieTarget;
       lowerOptions.targetBackend = targetBackend;
+      lowerOptions.mathApprox = mathApprox;
+      lowerOptions.mathApproxOrder = mathApproxOrder;
       canonicalizeOptions.aieTarget = aieTarget;
       canonicalizeOptions.targetBackend = targetBackend;
       optimizeOptions.aieTarget = aieTarget;
@@ -0,0 +1,72 @@
+//===- CostModel.h - AIE Vector Code Cost Estimation ------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+// Static cost estimation of AIEVec operation sequences
+//===----------------------------------------------------------------------===//
+
+#ifndef AIE_DIALECT_AIEVEC_TRANSFORMS_COSTMODEL_H
+#define AIE_DIALECT_AIEVEC_TRANSFORMS_COSTMODEL_H
+
+#include "mlir/IR/Operation.h"
+
+namespace xilinx::aievec {
+
+// Target parameters used by the cost model.
+struct VectCostParams {
+  bool aieml;
+  // Number of load units, and the number of bits each can load per cycle.
+  unsigned loadPorts;
+  unsigned loadPortBits;
+  // Size of the vector and accumulator register files, in bits.
+  unsigned vectorRegisterBits;
+  unsigned accRegisterBits;
+  // Width of one vector register, in bits. Spills are counted in registers
+  // of this width.
+  unsigned registerBits;
+
+  static VectCostParams get(bool aieml);
+};
+
+// Estimated cost of the AIEVec operations of a piece of IR. The estimate is
+// deliberately coarse: operations are counted per VLIW slot they issue in,
+// and the peak number of live vector and accumulator bits gives the register
+// pressure. It is meant to rank alternative vectorizations of the same loop
+// nest, not to predict cycle counts.
+struct VectCost {
+  // Operations issued in the vector unit (mul/mac/conv, add/sub, min/max,
+  // compare, bitwise).
+  unsigned vectorOps = 0;
+  // Load port cycles spent on vector loads (upd).
+  unsigned loads = 0;
+  // Lane movement operations (select, shift, ext, concat, shuffle,
+  // broadcast, pack).
+  unsigned shuffles = 0;
+  // Moves between vector and accumulator registers (srs, ups).
+  unsigned moves = 0;
+  // Peak number of live bits in vector and accumulator registers.
+  unsigned peakVectorBits = 0;
+  unsigned peakAccBits = 0;
+  // Registers that do not fit in the register files.
+  unsigned spills = 0;
+
+  // Operations in different slots issue in the same instruction bundle, so
+  // the busiest slot bounds the schedule. Each spilled register costs a
+  // store and a reload.
+  unsigned getCycles() const;
+
+  VectCost &operator+=(const VectCost &other);
+  void print(llvm::raw_ostream &os) const;
+};
+
+// Estimate the cost of the AIEVec operations nested in `root`.
+VectCost estimateVectCost(mlir::Operation *root, const VectCostParams &params);
+
+} // namespace xilinx::aievec
+
+#endif // AIE_DIALECT_AIEVEC_TRANSFORMS_COSTMODEL_H
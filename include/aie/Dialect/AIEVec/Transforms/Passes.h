@@ -33,6 +33,10 @@ namespace arith {
 class ArithDialect;
 } // end namespace arith
 
+namespace LLVM {
+class LLVMDialect;
+} // end namespace LLVM
+
 namespace memref {
 class MemRefDialect;
 } // end namespace memref
@@ -65,6 +69,9 @@ namespace aievec {
 #include "aie/Dialect/AIEVec/Transforms/Passes.h.inc"
 
 std::unique_ptr<mlir::Pass> createAIEVectorizePass();
+std::unique_ptr<mlir::Pass> createAIEBlockMatMulPass();
+std::unique_ptr<mlir::Pass> createAIEVectorTailPass();
+std::unique_ptr<mlir::Pass> createAIELoopHintsPass();
 
 /// Generate the code for registering passes.
 #define GEN_PASS_REGISTRATION
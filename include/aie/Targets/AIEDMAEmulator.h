@@ -0,0 +1,163 @@
+//===- AIEDMAEmulator.h -----------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+//
+// Host-side emulation of AIE2 DMA buffer descriptor address generation.
+//
+// The emulator executes buffer descriptors (as encoded by the NPU instruction
+// stream or as configured through the CDO BD setup) against host memory and
+// reports the exact sequence of 32-bit words that the DMA reads or writes,
+// together with burst statistics for the resulting access pattern. It has no
+// dependency on MLIR so it can be used directly from host tests.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef AIE_TARGETS_AIEDMAEMULATOR_H
+#define AIE_TARGETS_AIEDMAEMULATOR_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xilinx {
+namespace AIE {
+
+// One dimension of a BD address generator. Both fields are in units of 32-bit
+// words and hold the actual (not the "minus one" register encoded) values. A
+// size of zero means the dimension never wraps.
+struct DMADimension {
+  uint32_t size = 0;
+  uint32_t stride = 1;
+};
+
+struct DMABufferDescriptor {
+  // Identifies the host buffer (the runtime sequence argument for shim BDs).
+  uint32_t ddrId = 0;
+  // Start of the transfer, in bytes, relative to the host buffer.
+  uint64_t bufferOffset = 0;
+  // Length of the transfer in 32-bit words.
+  uint32_t bufferLength = 0;
+  // Address generator dimensions, innermost first. Empty means linear.
+  std::vector<DMADimension> dims;
+  // Iteration (fourth) dimension: the base address is advanced by
+  // `iterationStride` words each time the BD is executed, wrapping after
+  // `iterationSize` executions.
+  uint32_t iterationSize = 1;
+  uint32_t iterationStride = 0;
+  uint32_t iterationCurrent = 0;
+  std::optional<uint32_t> nextBd;
+  bool valid = true;
+
+  // Build a descriptor from the `sizes`/`strides` of an `aie.dma_bd` (as
+  // passed to XAie_DmaSetMultiDimAddr, innermost first, in 32-bit words).
+  static DMABufferDescriptor
+  fromDims(uint64_t bufferOffset, uint32_t bufferLength,
+           const std::vector<std::pair<uint32_t, uint32_t>> &sizesAndStrides);
+};
+
+// A single DMA access: which host buffer and which byte address within it.
+struct DMAAccess {
+  uint32_t ddrId;
+  uint64_t address;
+};
+
+// Access-pattern statistics. A run is a maximal sequence of accesses to
+// consecutive 32-bit words of the same buffer.
+struct DMABurstStats {
+  uint64_t words = 0;
+  uint64_t runs = 0;
+  uint64_t minRunLength = 0;
+  uint64_t maxRunLength = 0;
+  // Runs whose first word sits on a 128-bit boundary vs. runs that are only
+  // 32-bit aligned.
+  uint64_t runs128BitAligned = 0;
+  uint64_t runs32BitAligned = 0;
+  // Number of 128-bit beats transferred: each run is a burst of its own and
+  // is charged for every beat it overlaps, so a beat shared by two runs is
+  // counted twice.
+  uint64_t beats128Bit = 0;
+
+  double averageRunLength() const {
+    return runs ? static_cast<double>(words) / runs : 0.0;
+  }
+  // Fraction of the bytes moved on a 128-bit interface that are useful.
+  double efficiency128Bit() const {
+    return beats128Bit ? static_cast<double>(words * 4) / (beats128Bit * 16)
+                       : 0.0;
+  }
+};
+
+// A task pushed onto a DMA channel queue: the chain starting at `startBd`
+// executed `repeatCount + 1` times.
+struct DMATask {
+  uint32_t column = 0;
+  uint32_t channel = 0;
+  bool isMM2S = true;
+  uint32_t startBd = 0;
+  uint32_t repeatCount = 0;
+  bool issueToken = false;
+};
+
+class DMAEmulator {
+public:
+  // Install the descriptor for `bdId`, replacing any previous one.
+  void setBufferDescriptor(uint32_t bdId, const DMABufferDescriptor &bd);
+  const DMABufferDescriptor *getBufferDescriptor(uint32_t bdId) const;
+
+  // Execute `task` and return every access in issue order. Iteration state of
+  // the executed BDs is updated, as it is in hardware. Returns std::nullopt
+  // and sets `error` if the chain references an invalid or undefined BD.
+  std::optional<std::vector<DMAAccess>> run(const DMATask &task,
+                                            std::string *error = nullptr);
+
+  // Gather the words read by an MM2S transfer from the host buffers indexed
+  // by ddr id. Accesses outside a buffer read as zero.
+  static std::vector<uint32_t>
+  read(const std::vector<DMAAccess> &accesses,
+       const std::vector<std::vector<uint32_t>> &buffers);
+  // Scatter `stream` to the host buffers as an S2MM transfer would. Returns
+  // false if an access falls outside its buffer.
+  static bool write(const std::vector<DMAAccess> &accesses,
+                    const std::vector<uint32_t> &stream,
+                    std::vector<std::vector<uint32_t>> &buffers);
+
+  static DMABurstStats computeStats(const std::vector<DMAAccess> &accesses);
+
+  // Address sequence of a single execution of `bd`, ignoring chaining.
+  static std::vector<DMAAccess> generate(const DMABufferDescriptor &bd);
+
+private:
+  std::map<uint32_t, DMABufferDescriptor> bds;
+};
+
+// Decode the ten words of an NPU `writebd_shimtile` instruction (opcode 6,
+// see appendWriteBdShimTile) into its BD id and descriptor.
+std::pair<uint32_t, DMABufferDescriptor>
+decodeNPUShimBD(const uint32_t *words);
+
+// The accesses performed by one task pushed onto a shim DMA queue. `error` is
+// non-empty if the task could not be executed.
+struct NPUDMATrace {
+  DMATask task;
+  std::vector<DMAAccess> accesses;
+  std::string error;
+};
+// Replay an NPU instruction stream as produced by AIETranslateToNPU (prolog
+// included): BD writes are installed per column and every shim DMA queue push
+// is executed in program order.
+std::vector<NPUDMATrace>
+emulateNPUInstructions(const std::vector<uint32_t> &instructions);
+
+} // namespace AIE
+} // namespace xilinx
+
+#endif // AIE_TARGETS_AIEDMAEMULATOR_H
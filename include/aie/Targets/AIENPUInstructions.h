@@ -0,0 +1,66 @@
+//===- AIENPUInstructions.h -------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+//
+// Layout of the NPU instruction stream produced by AIETranslateToNPU, shared by
+// the host-side tools that decode or rewrite it.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef AIE_TARGETS_AIENPUINSTRUCTIONS_H
+#define AIE_TARGETS_AIENPUINSTRUCTIONS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace xilinx {
+namespace AIE {
+namespace npu {
+
+// Size of the prolog emitted at the start of every instruction stream.
+constexpr size_t PROLOG_WORDS = 17;
+
+// Opcodes live in bits [31:24] of the first word of an instruction; every
+// opcode below keeps its column in bits [23:16] of that word.
+constexpr uint32_t OPCODE_WRITE32 = 2;
+constexpr uint32_t OPCODE_SYNC = 3;
+constexpr uint32_t OPCODE_WRITEBD_SHIMTILE = 6;
+
+inline uint32_t getOpCode(uint32_t word) { return (word >> 24) & 0xff; }
+inline uint32_t getColumn(uint32_t word) { return (word >> 16) & 0xff; }
+inline uint32_t setColumn(uint32_t word, uint32_t column) {
+  return (word & ~(0xffu << 16)) | ((column & 0xff) << 16);
+}
+
+// Number of words of the instruction with the given opcode, or 0 if the
+// opcode is unknown.
+inline size_t getInstructionSize(uint32_t opCode) {
+  switch (opCode) {
+  case OPCODE_WRITE32:
+    return 3;
+  case OPCODE_SYNC:
+    return 2;
+  case OPCODE_WRITEBD_SHIMTILE:
+    return 10;
+  default:
+    return 0;
+  }
+}
+
+// Shim DMA task queue registers, see PushToNpuPattern in AIEDmaToNpu.cpp.
+constexpr uint32_t SHIM_S2MM_0_TASK_QUEUE = 0x1D204;
+constexpr uint32_t SHIM_S2MM_1_TASK_QUEUE = 0x1D20C;
+constexpr uint32_t SHIM_MM2S_0_TASK_QUEUE = 0x1D214;
+constexpr uint32_t SHIM_MM2S_1_TASK_QUEUE = 0x1D21C;
+
+} // namespace npu
+} // namespace AIE
+} // namespace xilinx
+
+#endif // AIE_TARGETS_AIENPUINSTRUCTIONS_H
@@ -0,0 +1,173 @@
+//===- AIEPartitionScheduler.h ----------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+//
+// Runtime scheduling of several compiled designs on one device.
+//
+// The CDO and NPU targets assume that a design owns the whole partition it was
+// compiled for. The scheduler below packs several designs into disjoint column
+// ranges of a single device, relocates their NPU instruction streams to the
+// columns they were assigned and dispatches them concurrently, one queue per
+// design. The CDO of a design is relocated by generating it with the assigned
+// start column as its partition start column (see AIETranslateToCDODirect).
+// It has no dependency on MLIR so it can be used directly from host runtimes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef AIE_TARGETS_AIEPARTITIONSCHEDULER_H
+#define AIE_TARGETS_AIEPARTITIONSCHEDULER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace xilinx {
+namespace AIE {
+
+// A compiled design as seen by the runtime.
+struct PartitionDesign {
+  std::string name;
+  // Number of contiguous columns the design occupies.
+  uint32_t numColumns = 1;
+  // Leftmost column the design was compiled for. Instructions are relocated
+  // by the difference between this and the column the design is placed at.
+  uint32_t baseColumn = 0;
+  // NPU instruction stream as produced by AIETranslateToNPU.
+  std::vector<uint32_t> npuInstructions;
+};
+
+// Assign a start column to each design of the given widths so that no two
+// designs share a column, using first-fit decreasing over the columns
+// [firstColumn, numDeviceColumns). Returns std::nullopt if the designs do not
+// fit on the device.
+std::optional<std::vector<uint32_t>>
+packPartitions(const std::vector<uint32_t> &widths, uint32_t numDeviceColumns,
+               uint32_t firstColumn = 0);
+
+// Add `columnOffset` to the column of every instruction in an NPU instruction
+// stream (prolog included). Returns false and sets `error` if the stream is
+// malformed or a relocated column does not fit the instruction encoding.
+bool relocateNPUInstructions(std::vector<uint32_t> &instructions,
+                             int32_t columnOffset,
+                             std::string *error = nullptr);
+
+// The device the scheduler dispatches to. `configure` is called once per
+// design before any of its instructions are executed; `execute` may then be
+// called concurrently for different slots.
+class PartitionBackend {
+public:
+  virtual ~PartitionBackend() = default;
+  virtual bool configure(uint32_t slot, const PartitionDesign &design,
+                         uint32_t startColumn, std::string *error) = 0;
+  virtual bool execute(uint32_t slot, const std::vector<uint32_t> &instructions,
+                       std::string *error) = 0;
+  virtual void release(uint32_t slot) = 0;
+};
+
+// Backend that models only column ownership: it checks that configured
+// partitions are disjoint and that every executed instruction stays within
+// the columns of the slot that issued it.
+class EmulatedPartitionBackend : public PartitionBackend {
+public:
+  explicit EmulatedPartitionBackend(uint32_t numColumns)
+      : owners(numColumns) {}
+
+  bool configure(uint32_t slot, const PartitionDesign &design,
+                 uint32_t startColumn, std::string *error) override;
+  bool execute(uint32_t slot, const std::vector<uint32_t> &instructions,
+               std::string *error) override;
+  void release(uint32_t slot) override;
+
+  // Owning slot of each column.
+  std::optional<uint32_t> getOwner(uint32_t column) const;
+  // Number of instructions executed on behalf of `slot`.
+  uint64_t getNumExecuted(uint32_t slot) const;
+
+private:
+  struct Partition {
+    uint32_t startColumn;
+    uint32_t numColumns;
+    uint64_t numExecuted = 0;
+  };
+
+  mutable std::mutex mutex;
+  std::vector<std::optional<uint32_t>> owners;
+  std::map<uint32_t, Partition> partitions;
+};
+
+class PartitionScheduler {
+public:
+  PartitionScheduler(PartitionBackend &backend, uint32_t numDeviceColumns,
+                     uint32_t firstColumn = 0)
+      : backend(backend), numDeviceColumns(numDeviceColumns),
+        firstColumn(firstColumn) {}
+  PartitionScheduler(const PartitionScheduler &) = delete;
+  PartitionScheduler &operator=(const PartitionScheduler &) = delete;
+  ~PartitionScheduler();
+
+  // Place `designs` on the device, relocate their instruction streams and
+  // configure the backend. Design i is identified by slot i afterwards.
+  // Replaces any previously loaded designs.
+  bool load(std::vector<PartitionDesign> designs,
+            std::string *error = nullptr);
+
+  uint32_t getNumDesigns() const { return slots.size(); }
+  uint32_t getStartColumn(uint32_t slot) const {
+    return slots[slot]->startColumn;
+  }
+  // The relocated instruction stream of `slot`.
+  const std::vector<uint32_t> &getInstructions(uint32_t slot) const {
+    return slots[slot]->design.npuInstructions;
+  }
+
+  // Queue one run of design `slot`. Runs of the same design execute in
+  // submission order; runs of different designs execute concurrently. The
+  // future holds false (and `error`, if provided, is set) if the backend
+  // rejected the run. `error` must outlive the future.
+  std::future<bool> submit(uint32_t slot, std::string *error = nullptr);
+  // Block until every submitted run has completed.
+  void wait();
+
+private:
+  struct Run {
+    std::promise<bool> result;
+    std::string *error;
+  };
+  struct Slot {
+    PartitionDesign design;
+    uint32_t startColumn = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Run> queue;
+    bool busy = false;
+    bool stop = false;
+    std::thread worker;
+  };
+
+  void work(uint32_t slot);
+  void unload();
+
+  PartitionBackend &backend;
+  uint32_t numDeviceColumns;
+  uint32_t firstColumn;
+  std::vector<std::unique_ptr<Slot>> slots;
+};
+
+} // namespace AIE
+} // namespace xilinx
+
+#endif // AIE_TARGETS_AIEPARTITIONSCHEDULER_H
@@ -23,6 +23,9 @@ mlir::LogicalResult AIETranslateToHSA(mlir::ModuleOp module,
                                       llvm::raw_ostream &output);
 mlir::LogicalResult AIEFlowsToJSON(mlir::ModuleOp module,
                                    llvm::raw_ostream &output);
+mlir::LogicalResult AIETranslateToResourceReport(mlir::ModuleOp module,
+                                                llvm::raw_ostream &output,
+                                                bool html = false);
 mlir::LogicalResult ADFGenerateCPPGraph(mlir::ModuleOp module,
                                         llvm::raw_ostream &output);
 mlir::LogicalResult AIETranslateSCSimConfig(mlir::ModuleOp module,
@@ -32,8 +35,14 @@ mlir::LogicalResult AIETranslateShimSolution(mlir::ModuleOp module,
 mlir::LogicalResult AIETranslateGraphXPE(mlir::ModuleOp module,
                                          llvm::raw_ostream &);
 mlir::LogicalResult AIETranslateToNPU(mlir::ModuleOp module,
-                                      llvm::raw_ostream &output);
+                                      llvm::raw_ostream &output,
+                                      int columnOffset = 0);
 std::vector<uint32_t> AIETranslateToNPU(mlir::ModuleOp);
+mlir::LogicalResult AIETranslateNPUToDMATrace(mlir::ModuleOp module,
+                                              llvm::raw_ostream &output);
+mlir::LogicalResult AIETranslateNPUToPartitionSchedule(mlir::ModuleOp module,
+                                                      llvm::raw_ostream &output,
+                                                      int numRuns);
 mlir::LogicalResult AIETranslateToLdScript(mlir::ModuleOp module,
                                            llvm::raw_ostream &output,
                                            int tileCol, int tileRow);
@@ -0,0 +1,44 @@
+//===- TilingDSE.cpp --------------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+#include "aie-c/TilingDSE.h"
+#include "aie/Dialect/AIE/Transforms/AIETilingDSE.h"
+
+#include "mlir/CAPI/Support.h"
+#include "mlir/CAPI/Utils.h"
+
+#include "llvm/Support/JSON.h"
+
+using namespace llvm;
+using namespace xilinx::AIE;
+
+MlirLogicalResult aieExploreTilings(MlirStringRef problem,
+                                    MlirStringCallback callback,
+                                    void *userData) {
+  mlir::detail::CallbackOstream os(callback, userData);
+  Expected<json::Value> value = json::parse(unwrap(problem));
+  if (!value) {
+    os << toString(value.takeError());
+    return mlirLogicalResultFailure();
+  }
+
+  TilingProblem tilingProblem;
+  json::Path::Root root("problem");
+  if (!fromJSON(*value, tilingProblem, root)) {
+    os << toString(root.getError());
+    return mlirLogicalResultFailure();
+  }
+
+  json::Array solutions;
+  for (const TilingSolution &solution : exploreTilings(tilingProblem))
+    solutions.push_back(toJSON(solution));
+  os << json::Value(std::move(solutions));
+  return mlirLogicalResultSuccess();
+}
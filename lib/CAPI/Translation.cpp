@@ -120,6 +120,29 @@ MlirStringRef aieTranslateToBCF(MlirOperation moduleOp, int col, int row) {
   return mlirStringRefCreate(cStr, bcf.size());
 }
 
+MlirStringRef aieTranslateToLdScript(MlirOperation moduleOp, int col,
+                                     int row) {
+  std::string ldScript;
+  llvm::raw_string_ostream os(ldScript);
+  ModuleOp mod = llvm::cast<ModuleOp>(unwrap(moduleOp));
+  if (failed(AIETranslateToLdScript(mod, os, col, row)))
+    return mlirStringRefCreate(nullptr, 0);
+  char *cStr = static_cast<char *>(malloc(ldScript.size()));
+  ldScript.copy(cStr, ldScript.size());
+  return mlirStringRefCreate(cStr, ldScript.size());
+}
+
+MlirStringRef aieTranslateToTargetArch(MlirOperation moduleOp) {
+  std::string arch;
+  llvm::raw_string_ostream os(arch);
+  ModuleOp mod = llvm::cast<ModuleOp>(unwrap(moduleOp));
+  if (failed(AIETranslateToTargetArch(mod, os)))
+    return mlirStringRefCreate(nullptr, 0);
+  char *cStr = static_cast<char *>(malloc(arch.size()));
+  arch.copy(cStr, arch.size());
+  return mlirStringRefCreate(cStr, arch.size());
+}
+
 MlirStringRef aieLLVMLink(MlirStringRef *modules, int nModules) {
   std::string ll;
   llvm::raw_string_ostream os(ll);
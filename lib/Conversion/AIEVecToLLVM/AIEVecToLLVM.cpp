@@ -1216,8 +1216,38 @@ public:
   LogicalResult
   matchAndRewrite(aievec::UnpackOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
-    op.emitWarning() << "aie.unpack conversion is not implemented\n";
-    return failure();
+    Location loc = op.getLoc();
+    auto srcType = cast<VectorType>(op.getSource().getType());
+    auto resultType = cast<VectorType>(op.getResult().getType());
+    unsigned srcBitWidth = srcType.getElementTypeBitWidth();
+    unsigned resultBitWidth = resultType.getElementTypeBitWidth();
+    int srcLanes = getVectorLaneSize(srcType);
+
+    // Both intrinsics unpack 256 bits of packed values into 512 bits.
+    int32_t sign = srcType.getElementType().isUnsignedInteger() ? 0 : 1;
+    auto signCst = rewriter.create<LLVM::ConstantOp>(
+        loc, rewriter.getI32Type(), rewriter.getI32IntegerAttr(sign));
+    SmallVector<Value> operands({adaptor.getSource(), signCst});
+    SmallVector<Type> signature(
+        {VectorType::get({32}, rewriter.getI8Type()), rewriter.getI32Type()});
+    Value result;
+    if (srcBitWidth == 4 && resultBitWidth == 8 && srcLanes == 64) {
+      result = rewriter.create<xllvm::UnpackI8I4IntrOp>(
+          loc, VectorType::get({64}, rewriter.getI8Type()),
+          forceCastOperandsToSignature(rewriter, loc, operands, signature));
+    } else if (srcBitWidth == 8 && resultBitWidth == 16 && srcLanes == 32) {
+      result = rewriter.create<xllvm::UnpackI16I8IntrOp>(
+          loc, VectorType::get({32}, rewriter.getI16Type()),
+          forceCastOperandsToSignature(rewriter, loc, operands, signature));
+    } else {
+      op.emitWarning() << "aie.unpack conversion is not implemented for "
+                       << srcType << " to " << resultType << "\n";
+      return failure();
+    }
+
+    rewriter.replaceOp(
+        op, forceCastValueToType(rewriter, loc, result, resultType));
+    return success();
   }
 };
 
@@ -1546,6 +1576,639 @@ class MatMulOpConversion
   }
 };
 
+// Emit a call to the intrinsic `IntrOpTy` after forcing `operands` into the
+// intrinsic's `signature`.
+template <typename IntrOpTy>
+static Value createIntrinsic(OpBuilder &builder, Location loc, Type resultType,
+                             ValueRange operands, TypeRange signature) {
+  return builder
+      .create<IntrOpTy>(loc, resultType,
+                        forceCastOperandsToSignature(builder, loc, operands,
+                                                     signature))
+      .getResult();
+}
+
+// Returns the 512-bit vector type with elements of `bitWidth` bits that the
+// AIE2 lane-wise intrinsics operate on.
+static VectorType get512bIntVectorType(OpBuilder &builder, unsigned bitWidth) {
+  return VectorType::get({512 / bitWidth}, builder.getIntegerType(bitWidth));
+}
+
+// aievec.max and aievec.min map onto the vmax.lt/vmin.ge intrinsics, which
+// return the selected lanes together with the comparison mask.
+template <typename SrcOpTy, typename I8IntrOpTy, typename I16IntrOpTy,
+          typename I32IntrOpTy, typename BF16IntrOpTy>
+class MaxMinOpConversion : public mlir::ConvertOpToLLVMPattern<SrcOpTy> {
+public:
+  using mlir::ConvertOpToLLVMPattern<SrcOpTy>::ConvertOpToLLVMPattern;
+  using OpAdaptor = typename SrcOpTy::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(SrcOpTy op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+
+    VectorType resultType = cast<VectorType>(op.getResult().getType());
+    Type resultScaTy = resultType.getElementType();
+    unsigned resultBitWidth = resultScaTy.getIntOrFloatBitWidth();
+    int resultLanes = getVectorLaneSize(resultType);
+    int resultVectorSize = resultBitWidth * resultLanes;
+
+    if (resultVectorSize != 512) {
+      op.emitWarning() << op->getName()
+                       << " conversion with result vector size "
+                       << resultVectorSize << " is not implemented.\n";
+      return failure();
+    }
+
+    Type i32ty = rewriter.getI32Type();
+    SmallVector<Value> operands({adaptor.getLhs(), adaptor.getRhs()});
+    Value maxMinOp = nullptr;
+    if (resultScaTy.isa<IntegerType>()) {
+      // Integer types, compared as signed
+      auto signCst = rewriter.create<LLVM::ConstantOp>(
+          loc, i32ty, rewriter.getI32IntegerAttr(1));
+      operands.push_back(signCst);
+      VectorType vecTy = get512bIntVectorType(rewriter, resultBitWidth);
+      SmallVector<Type> intrFuncSig({vecTy, vecTy, i32ty});
+      if (resultBitWidth == 8) {
+        auto structTy = LLVM::LLVMStructType::getLiteral(
+            rewriter.getContext(), {vecTy, VectorType::get({2}, i32ty)});
+        maxMinOp = createIntrinsic<I8IntrOpTy>(rewriter, loc, structTy,
+                                               operands, intrFuncSig);
+      } else if (resultBitWidth == 16) {
+        auto structTy = LLVM::LLVMStructType::getLiteral(rewriter.getContext(),
+                                                         {vecTy, i32ty});
+        maxMinOp = createIntrinsic<I16IntrOpTy>(rewriter, loc, structTy,
+                                                operands, intrFuncSig);
+      } else if (resultBitWidth == 32) {
+        auto structTy = LLVM::LLVMStructType::getLiteral(rewriter.getContext(),
+                                                         {vecTy, i32ty});
+        maxMinOp = createIntrinsic<I32IntrOpTy>(rewriter, loc, structTy,
+                                                operands, intrFuncSig);
+      }
+    } else if (resultBitWidth == 16) {
+      // Float types
+      VectorType vecTy = VectorType::get({32}, rewriter.getBF16Type());
+      auto structTy = LLVM::LLVMStructType::getLiteral(rewriter.getContext(),
+                                                       {vecTy, i32ty});
+      maxMinOp = createIntrinsic<BF16IntrOpTy>(rewriter, loc, structTy,
+                                               operands, {vecTy, vecTy});
+    }
+
+    if (!maxMinOp) {
+      op.emitWarning() << op->getName() << " conversion with element type "
+                       << resultScaTy << " is not implemented.\n";
+      return failure();
+    }
+
+    rewriter.replaceOpWithNewOp<LLVM::ExtractValueOp>(op, maxMinOp,
+                                                      ArrayRef<int64_t>{0});
+    return success();
+  }
+};
+
+using MaxOpConversion =
+    MaxMinOpConversion<aievec::MaxOp, xllvm::VectorMaxLt8IntrOp,
+                       xllvm::VectorMaxLt16IntrOp, xllvm::VectorMaxLt32IntrOp,
+                       xllvm::VectorMaxLtBf16IntrOp>;
+using MinOpConversion =
+    MaxMinOpConversion<aievec::MinOp, xllvm::VectorMinGe8IntrOp,
+                       xllvm::VectorMinGe16IntrOp, xllvm::VectorMinGe32IntrOp,
+                       xllvm::VectorMinGeBf16IntrOp>;
+
+class CmpOpConversion : public mlir::ConvertOpToLLVMPattern<aievec::CmpOp> {
+public:
+  using ConvertOpToLLVMPattern<aievec::CmpOp>::ConvertOpToLLVMPattern;
+
+  // Emit the lane-wise `lhs < rhs` (or `lhs >= rhs` if `ge` is set) on 512-bit
+  // vectors of `scaTy`. The mask has one bit per lane: i64 for 8-bit lanes,
+  // i32 otherwise.
+  static Value createCompare(OpBuilder &builder, Location loc, bool ge,
+                             Value lhs, Value rhs, Type scaTy, bool isSigned) {
+    Type i32ty = builder.getI32Type();
+    unsigned bitWidth = scaTy.getIntOrFloatBitWidth();
+    if (!scaTy.isa<IntegerType>()) {
+      VectorType vecTy = VectorType::get({32}, builder.getBF16Type());
+      if (ge)
+        return createIntrinsic<xllvm::VectorGeBf16IntrOp>(
+            builder, loc, i32ty, {lhs, rhs}, {vecTy, vecTy});
+      return createIntrinsic<xllvm::VectorLtBf16IntrOp>(
+          builder, loc, i32ty, {lhs, rhs}, {vecTy, vecTy});
+    }
+
+    auto signCst = builder.create<LLVM::ConstantOp>(
+        loc, i32ty, builder.getI32IntegerAttr(isSigned));
+    SmallVector<Value> operands({lhs, rhs, signCst});
+    VectorType vecTy = get512bIntVectorType(builder, bitWidth);
+    SmallVector<Type> intrFuncSig({vecTy, vecTy, i32ty});
+    if (bitWidth == 8) {
+      VectorType maskTy = VectorType::get({2}, i32ty);
+      Value mask =
+          ge ? createIntrinsic<xllvm::VectorGe8IntrOp>(builder, loc, maskTy,
+                                                       operands, intrFuncSig)
+             : createIntrinsic<xllvm::VectorLt8IntrOp>(builder, loc, maskTy,
+                                                       operands, intrFuncSig);
+      return bitcastValueToType(builder, loc, mask, builder.getI64Type());
+    }
+    if (bitWidth == 16)
+      return ge ? createIntrinsic<xllvm::VectorGe16IntrOp>(
+                      builder, loc, i32ty, operands, intrFuncSig)
+                : createIntrinsic<xllvm::VectorLt16IntrOp>(
+                      builder, loc, i32ty, operands, intrFuncSig);
+    return ge ? createIntrinsic<xllvm::VectorGe32IntrOp>(builder, loc, i32ty,
+                                                         operands, intrFuncSig)
+              : createIntrinsic<xllvm::VectorLt32IntrOp>(builder, loc, i32ty,
+                                                         operands, intrFuncSig);
+  }
+
+  LogicalResult
+  matchAndRewrite(aievec::CmpOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+
+    VectorType lhsType = cast<VectorType>(op.getLhs().getType());
+    Type lhsScaTy = lhsType.getElementType();
+    unsigned lhsBitWidth = lhsScaTy.getIntOrFloatBitWidth();
+    int lhsLanes = getVectorLaneSize(lhsType);
+    int lhsVectorSize = lhsBitWidth * lhsLanes;
+
+    if (lhsVectorSize != 512 ||
+        (!lhsScaTy.isa<IntegerType>() && lhsBitWidth != 16)) {
+      op.emitWarning() << "aievec.cmp conversion of " << lhsType
+                       << " is not implemented.\n";
+      return failure();
+    }
+
+    Type maskTy = lhsBitWidth == 8 ? rewriter.getI64Type()
+                                   : (Type)rewriter.getI32Type();
+    Type resultTy = getTypeConverter()->convertType(op.getResult().getType());
+    if (resultTy != maskTy) {
+      op.emitWarning() << "aievec.cmp conversion of " << lhsType << " to "
+                       << op.getResult().getType()
+                       << " is not implemented.\n";
+      return failure();
+    }
+
+    // The intrinsics only implement `<` and `>=`; the other predicates swap
+    // the operands or combine two comparisons.
+    Value lhs = adaptor.getLhs();
+    Value rhs = adaptor.getRhs();
+    StringRef pred = op.getPred();
+    bool isSigned = !pred.starts_with("u");
+    auto compare = [&](bool ge, Value a, Value b) {
+      return createCompare(rewriter, loc, ge, a, b, lhsScaTy, isSigned);
+    };
+    Value mask;
+    if (pred == "slt" || pred == "ult") {
+      mask = compare(/*ge=*/false, lhs, rhs);
+    } else if (pred == "sge" || pred == "uge") {
+      mask = compare(/*ge=*/true, lhs, rhs);
+    } else if (pred == "sgt" || pred == "ugt") {
+      mask = compare(/*ge=*/false, rhs, lhs);
+    } else if (pred == "sle" || pred == "ule") {
+      mask = compare(/*ge=*/true, rhs, lhs);
+    } else if (pred == "eq" || pred == "ne") {
+      mask = rewriter.create<LLVM::AndOp>(loc, compare(/*ge=*/true, lhs, rhs),
+                                          compare(/*ge=*/true, rhs, lhs));
+      if (pred == "ne") {
+        int64_t laneMask =
+            lhsLanes >= 32 ? -1 : (int64_t(1) << lhsLanes) - 1;
+        auto laneMaskCst = rewriter.create<LLVM::ConstantOp>(
+            loc, maskTy, rewriter.getIntegerAttr(maskTy, laneMask));
+        mask = rewriter.create<LLVM::XOrOp>(loc, mask, laneMaskCst);
+      }
+    } else {
+      op.emitWarning() << "aievec.cmp conversion with predicate '" << pred
+                       << "' is not implemented.\n";
+      return failure();
+    }
+
+    rewriter.replaceOp(op, mask);
+    return success();
+  }
+};
+
+class SelOpConversion : public mlir::ConvertOpToLLVMPattern<aievec::SelOp> {
+public:
+  using ConvertOpToLLVMPattern<aievec::SelOp>::ConvertOpToLLVMPattern;
+
+  LogicalResult
+  matchAndRewrite(aievec::SelOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+
+    VectorType resultType = cast<VectorType>(op.getResult().getType());
+    Type resultScaTy = resultType.getElementType();
+    unsigned resultBitWidth = resultScaTy.getIntOrFloatBitWidth();
+    int resultLanes = getVectorLaneSize(resultType);
+    int resultVectorSize = resultBitWidth * resultLanes;
+
+    if (resultVectorSize != 512) {
+      op.emitWarning() << "aievec.sel conversion with result vector size "
+                       << resultVectorSize << " is not implemented.\n";
+      return failure();
+    }
+
+    // Lanes are selected by bit pattern only, so bf16 vectors go through the
+    // 16-bit intrinsic.
+    Type i32ty = rewriter.getI32Type();
+    VectorType vecTy = get512bIntVectorType(rewriter, resultBitWidth);
+    SmallVector<Value> operands(
+        {adaptor.getLhs(), adaptor.getRhs(), adaptor.getSel()});
+    Value selOp = nullptr;
+    if (resultBitWidth == 8) {
+      selOp = createIntrinsic<xllvm::VectorSel8IntrOp>(
+          rewriter, loc, vecTy, operands,
+          {vecTy, vecTy, VectorType::get({2}, i32ty)});
+    } else if (resultBitWidth == 16) {
+      selOp = createIntrinsic<xllvm::VectorSel16IntrOp>(
+          rewriter, loc, vecTy, operands, {vecTy, vecTy, i32ty});
+    } else if (resultBitWidth == 32) {
+      selOp = createIntrinsic<xllvm::VectorSel32IntrOp>(
+          rewriter, loc, vecTy, operands, {vecTy, vecTy, i32ty});
+    } else {
+      op.emitWarning() << "aievec.sel conversion with element type "
+                       << resultScaTy << " is not implemented.\n";
+      return failure();
+    }
+
+    // cast the result back to the op type
+    rewriter.replaceOp(op, forceCastValueToType(rewriter, loc, selOp,
+                                                op.getResult().getType()));
+    return success();
+  }
+};
+
+// AIE2 has no bf16 vector arithmetic: bf16 lanes are upshifted to accfloat,
+// combined by `computeAcc` and rounded back to bf16. A vector<32xbf16> is
+// processed one 256-bit half at a time. Returns nullptr for other shapes.
+static Value
+computeBF16InAccFloat(OpBuilder &builder, Location loc, VectorType resultType,
+                      ValueRange operands,
+                      function_ref<Value(ArrayRef<Value>)> computeAcc) {
+  int lanes = getVectorLaneSize(resultType);
+  if (!resultType.getElementType().isBF16() || (lanes != 16 && lanes != 32))
+    return nullptr;
+
+  VectorType v16bf16Ty = VectorType::get({16}, builder.getBF16Type());
+  VectorType v8i64Ty = VectorType::get({8}, builder.getI64Type());
+  VectorType v8i32Ty = VectorType::get({8}, builder.getI32Type());
+  VectorType v16i32Ty = VectorType::get({16}, builder.getI32Type());
+  SmallVector<Value> halves;
+  for (int half = 0; half < lanes / 16; ++half) {
+    SmallVector<Value> accs;
+    for (Value operand : operands) {
+      if (lanes == 32) {
+        auto indexCst = builder.create<LLVM::ConstantOp>(
+            loc, builder.getI32Type(), builder.getI32IntegerAttr(half));
+        operand = createIntrinsic<xllvm::ExtI256I512IntrOp>(
+            builder, loc, v8i32Ty, {operand, indexCst},
+            {v16i32Ty, builder.getI32Type()});
+      }
+      accs.push_back(createIntrinsic<xllvm::Vector16BF16ToV16AccFloatIntrOp>(
+          builder, loc, v8i64Ty, {operand}, {v16bf16Ty}));
+    }
+    halves.push_back(
+        createIntrinsic<xllvm::Vector16AccFloatToV16BF16IntrOp>(
+            builder, loc, v16bf16Ty, {computeAcc(accs)}, {v8i64Ty}));
+  }
+  if (lanes == 16)
+    return halves.front();
+
+  Value concatOp = createIntrinsic<xllvm::ConcatI512I256IntrOp>(
+      builder, loc, v16i32Ty, halves, {v8i32Ty, v8i32Ty});
+  return bitcastValueToType(builder, loc, concatOp, resultType);
+}
+
+class NegOpConversion : public mlir::ConvertOpToLLVMPattern<aievec::NegOp> {
+public:
+  using ConvertOpToLLVMPattern<aievec::NegOp>::ConvertOpToLLVMPattern;
+
+  LogicalResult
+  matchAndRewrite(aievec::NegOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+
+    // Integer and fp32 negation have a native instruction, which the backend
+    // selects from the LLVM operation. bf16 is negated in accfloat as
+    // 0 - x.
+    VectorType resultType = cast<VectorType>(op.getResult().getType());
+    if (resultType.getElementType().isa<IntegerType>()) {
+      auto zeroCst = rewriter.create<LLVM::ConstantOp>(
+          loc, resultType, rewriter.getZeroAttr(resultType));
+      rewriter.replaceOpWithNewOp<LLVM::SubOp>(op, zeroCst,
+                                               adaptor.getSource());
+      return success();
+    }
+
+    if (!resultType.getElementType().isBF16()) {
+      rewriter.replaceOpWithNewOp<LLVM::FNegOp>(op, adaptor.getSource());
+      return success();
+    }
+
+    Value negOp = computeBF16InAccFloat(
+        rewriter, loc, resultType, {adaptor.getSource()},
+        [&](ArrayRef<Value> accs) -> Value {
+          VectorType v8i64Ty = VectorType::get({8}, rewriter.getI64Type());
+          auto zeroCst = rewriter.create<LLVM::ConstantOp>(
+              loc, v8i64Ty, rewriter.getZeroAttr(v8i64Ty));
+          auto confCst = rewriter.create<LLVM::ConstantOp>(
+              loc, rewriter.getI32Type(), rewriter.getI32IntegerAttr(0));
+          return rewriter.create<xllvm::SubAccFloatIntrOp>(
+              loc, v8i64Ty, zeroCst, accs[0], confCst);
+        });
+    if (!negOp) {
+      op.emitWarning() << "aievec.neg conversion with type " << resultType
+                       << " is not supported.\n";
+      return failure();
+    }
+    rewriter.replaceOp(op, negOp);
+    return success();
+  }
+};
+
+// The bitwise ops ignore lane boundaries, so every element type is handled as
+// a vector<16xi32>.
+template <typename SrcOpTy, typename DstOpTy>
+class BitwiseBinaryOpConversion : public mlir::ConvertOpToLLVMPattern<SrcOpTy> {
+public:
+  using mlir::ConvertOpToLLVMPattern<SrcOpTy>::ConvertOpToLLVMPattern;
+  using OpAdaptor = typename SrcOpTy::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(SrcOpTy op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+    VectorType v16xi32ty = VectorType::get({16}, rewriter.getI32Type());
+    auto operands = forceCastOperandsToSignature(
+        rewriter, loc, {adaptor.getLhs(), adaptor.getRhs()},
+        {v16xi32ty, v16xi32ty});
+    auto bitwiseOp = rewriter.create<DstOpTy>(loc, operands[0], operands[1]);
+
+    // cast the result back to the op type
+    rewriter.replaceOp(op, forceCastValueToType(rewriter, loc, bitwiseOp,
+                                                op.getResult().getType()));
+    return success();
+  }
+};
+
+using BandOpConversion = BitwiseBinaryOpConversion<aievec::BandOp, LLVM::AndOp>;
+using BorOpConversion = BitwiseBinaryOpConversion<aievec::BorOp, LLVM::OrOp>;
+using BxorOpConversion = BitwiseBinaryOpConversion<aievec::BxorOp, LLVM::XOrOp>;
+
+class BnegOpConversion : public mlir::ConvertOpToLLVMPattern<aievec::BnegOp> {
+public:
+  using ConvertOpToLLVMPattern<aievec::BnegOp>::ConvertOpToLLVMPattern;
+
+  LogicalResult
+  matchAndRewrite(aievec::BnegOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+    VectorType v16xi32ty = VectorType::get({16}, rewriter.getI32Type());
+    auto allOnesCst = rewriter.create<LLVM::ConstantOp>(
+        loc, v16xi32ty,
+        rewriter.getI32VectorAttr(SmallVector<int32_t>(16, -1)));
+    Value src =
+        forceCastValueToType(rewriter, loc, adaptor.getSource(), v16xi32ty);
+    auto bnegOp = rewriter.create<LLVM::XOrOp>(loc, src, allOnesCst);
+
+    // cast the result back to the op type
+    rewriter.replaceOp(op, forceCastValueToType(rewriter, loc, bnegOp,
+                                                op.getResult().getType()));
+    return success();
+  }
+};
+
+class ExtElemOpConversion
+    : public mlir::ConvertOpToLLVMPattern<aievec::ExtElemOp> {
+public:
+  using ConvertOpToLLVMPattern<aievec::ExtElemOp>::ConvertOpToLLVMPattern;
+
+  LogicalResult
+  matchAndRewrite(aievec::ExtElemOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+
+    VectorType srcType = cast<VectorType>(op.getSource().getType());
+    Type srcScaTy = srcType.getElementType();
+    unsigned srcBitWidth = srcScaTy.getIntOrFloatBitWidth();
+    int srcLanes = getVectorLaneSize(srcType);
+    int srcVectorSize = srcBitWidth * srcLanes;
+
+    if (srcVectorSize != 256 && srcVectorSize != 512) {
+      op.emitWarning() << "aievec.ext_elem conversion with source vector size "
+                       << srcVectorSize << " is not implemented.\n";
+      return failure();
+    }
+
+    // The intrinsics sign-extend the element into an i32; 256-bit sources are
+    // widened first, which leaves the lower lanes in place.
+    Type i32ty = rewriter.getI32Type();
+    auto signCst = rewriter.create<LLVM::ConstantOp>(
+        loc, i32ty, rewriter.getI32IntegerAttr(1));
+    VectorType vecTy = get512bIntVectorType(rewriter, srcBitWidth);
+    SmallVector<Value> operands(
+        {adaptor.getSource(), adaptor.getIndex(), signCst});
+    SmallVector<Type> intrFuncSig({vecTy, i32ty, i32ty});
+    Value extElemOp = nullptr;
+    if (srcBitWidth == 8) {
+      extElemOp = createIntrinsic<xllvm::VectorExtractElem8I512IntrOp>(
+          rewriter, loc, i32ty, operands, intrFuncSig);
+    } else if (srcBitWidth == 16) {
+      extElemOp = createIntrinsic<xllvm::VectorExtractElem16I512IntrOp>(
+          rewriter, loc, i32ty, operands, intrFuncSig);
+    } else if (srcBitWidth == 32) {
+      extElemOp = createIntrinsic<xllvm::VectorExtractElem32I512IntrOp>(
+          rewriter, loc, i32ty, operands, intrFuncSig);
+    } else {
+      op.emitWarning() << "aievec.ext_elem conversion with element type "
+                       << srcScaTy << " is not implemented.\n";
+      return failure();
+    }
+
+    Type resultTy = op.getResult().getType();
+    if (srcBitWidth < 32)
+      extElemOp = rewriter.create<LLVM::TruncOp>(
+          loc, rewriter.getIntegerType(srcBitWidth), extElemOp);
+    if (resultTy.isa<FloatType>())
+      extElemOp = bitcastValueToType(rewriter, loc, extElemOp, resultTy);
+    rewriter.replaceOp(op, extElemOp);
+    return success();
+  }
+};
+
+// Integer add_elem/sub_elem lower to LLVM vector arithmetic, which the
+// backend selects natively. fp32 accumulators use the accfloat intrinsics,
+// and bf16 vectors go through accfloat and back.
+template <typename SrcOpTy, typename IntOpTy, typename FloatOpTy,
+          typename AccFloatIntrOpTy>
+class AddSubElemOpConversion : public mlir::ConvertOpToLLVMPattern<SrcOpTy> {
+public:
+  using mlir::ConvertOpToLLVMPattern<SrcOpTy>::ConvertOpToLLVMPattern;
+  using OpAdaptor = typename SrcOpTy::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(SrcOpTy op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+
+    VectorType resultType = cast<VectorType>(op.getResult().getType());
+    Type resultScaTy = resultType.getElementType();
+    if (resultScaTy.isa<IntegerType>()) {
+      rewriter.replaceOpWithNewOp<IntOpTy>(op, adaptor.getLhs(),
+                                           adaptor.getRhs());
+      return success();
+    }
+
+    VectorType v8xi64ty = VectorType::get({8}, rewriter.getI64Type());
+    if (resultScaTy.isBF16()) {
+      Value resOp = computeBF16InAccFloat(
+          rewriter, loc, resultType, {adaptor.getLhs(), adaptor.getRhs()},
+          [&](ArrayRef<Value> accs) -> Value {
+            auto confCst = rewriter.create<LLVM::ConstantOp>(
+                loc, rewriter.getI32Type(), rewriter.getI32IntegerAttr(0));
+            return rewriter.create<AccFloatIntrOpTy>(loc, v8xi64ty, accs[0],
+                                                     accs[1], confCst);
+          });
+      if (!resOp) {
+        op.emitWarning() << op->getName() << " conversion with type "
+                         << resultType << " is not supported.\n";
+        return failure();
+      }
+      rewriter.replaceOp(op, resOp);
+      return success();
+    }
+
+    if (!resultScaTy.isF32() || getVectorLaneSize(resultType) != 16) {
+      rewriter.replaceOpWithNewOp<FloatOpTy>(op, adaptor.getLhs(),
+                                             adaptor.getRhs());
+      return success();
+    }
+
+    auto confCst = rewriter.create<LLVM::ConstantOp>(
+        loc, rewriter.getI32Type(), rewriter.getI32IntegerAttr(0));
+    Value accOp = createIntrinsic<AccFloatIntrOpTy>(
+        rewriter, loc, v8xi64ty,
+        {adaptor.getLhs(), adaptor.getRhs(), confCst},
+        {v8xi64ty, v8xi64ty, rewriter.getI32Type()});
+
+    // cast the result back to the op type
+    rewriter.replaceOp(op, forceCastValueToType(rewriter, loc, accOp,
+                                                op.getResult().getType()));
+    return success();
+  }
+};
+
+using AddElemOpConversion =
+    AddSubElemOpConversion<aievec::AddElemOp, LLVM::AddOp, LLVM::FAddOp,
+                           xllvm::AddAccFloatIntrOp>;
+using SubElemOpConversion =
+    AddSubElemOpConversion<aievec::SubElemOp, LLVM::SubOp, LLVM::FSubOp,
+                           xllvm::SubAccFloatIntrOp>;
+
+// Control word of the AIE2 convolution variants of the mul/mac intrinsics:
+// 32x8 for i8 inputs into 32-bit accumulators and 16x4 for i16 inputs into
+// 64-bit accumulators. Returns -1 for unsupported types.
+static int getConvControl(Type lhsScaTy, int M, int N, bool sub) {
+  unsigned lhsBitWidth = lhsScaTy.getIntOrFloatBitWidth();
+  if (!lhsScaTy.isa<IntegerType>())
+    return -1;
+  if (lhsBitWidth == 8 && M == 32 && N == 8)
+    return MulElemOpConversion::aiev2_mul_mac_compute_control(
+        /*sgn_x=*/1, /*sgn_y=*/1, /*amode=*/0, /*bmode=*/1,
+        /*variant=*/2, /*zero_acc=*/0, /*shift16=*/0,
+        /*sub_mul=*/sub, /*sub_acc1=*/0, /*sub_acc2=*/0,
+        /*sub_mask=*/0);
+  if (lhsBitWidth == 16 && M == 16 && N == 4)
+    return MulElemOpConversion::aiev2_mul_mac_compute_control(
+        /*sgn_x=*/1, /*sgn_y=*/1, /*amode=*/1, /*bmode=*/3,
+        /*variant=*/3, /*zero_acc=*/0, /*shift16=*/0,
+        /*sub_mul=*/sub, /*sub_acc1=*/0, /*sub_acc2=*/0,
+        /*sub_mask=*/0);
+  return -1;
+}
+
+class MulConvOpConversion
+    : public mlir::ConvertOpToLLVMPattern<aievec::MulConvOp> {
+public:
+  using ConvertOpToLLVMPattern<aievec::MulConvOp>::ConvertOpToLLVMPattern;
+
+  LogicalResult
+  matchAndRewrite(aievec::MulConvOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+
+    Type lhsScaTy = cast<VectorType>(op.getLhs().getType()).getElementType();
+    int conf = getConvControl(lhsScaTy, op.getM(), op.getN(), /*sub=*/false);
+    if (conf < 0) {
+      op.emitWarning() << "aievec.mul_conv conversion is not supported.\n";
+      return failure();
+    }
+
+    // create constant for config
+    Type i32ty = rewriter.getI32Type();
+    auto confCst = rewriter.create<LLVM::ConstantOp>(
+        loc, i32ty, rewriter.getI32IntegerAttr(conf));
+    SmallVector<Value> operands({adaptor.getLhs(), adaptor.getRhs(), confCst});
+    SmallVector<Type> intrFuncSig({VectorType::get({64}, rewriter.getI8Type()),
+                                   VectorType::get({16}, i32ty), i32ty});
+    VectorType v16xi64ty = VectorType::get({16}, rewriter.getI64Type());
+    Value mulConvOp =
+        lhsScaTy.getIntOrFloatBitWidth() == 8
+            ? createIntrinsic<xllvm::MulConfAcc32IntrOp>(
+                  rewriter, loc, v16xi64ty, operands, intrFuncSig)
+            : createIntrinsic<xllvm::MulConfAcc64IntrOp>(
+                  rewriter, loc, v16xi64ty, operands, intrFuncSig);
+
+    // cast the result back to the op type
+    rewriter.replaceOp(op, forceCastValueToType(rewriter, loc, mulConvOp,
+                                                op.getResult().getType()));
+    return success();
+  }
+};
+
+class FMAConvOpConversion
+    : public mlir::ConvertOpToLLVMPattern<aievec::FMAConvOp> {
+public:
+  using ConvertOpToLLVMPattern<aievec::FMAConvOp>::ConvertOpToLLVMPattern;
+
+  LogicalResult
+  matchAndRewrite(aievec::FMAConvOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+
+    Type lhsScaTy = cast<VectorType>(op.getLhs().getType()).getElementType();
+    int conf = getConvControl(lhsScaTy, op.getM(), op.getN(), op.getFmsub());
+    if (conf < 0) {
+      op.emitWarning() << "aievec.fma_conv conversion is not supported.\n";
+      return failure();
+    }
+
+    // create constant for config
+    Type i32ty = rewriter.getI32Type();
+    auto confCst = rewriter.create<LLVM::ConstantOp>(
+        loc, i32ty, rewriter.getI32IntegerAttr(conf));
+    SmallVector<Value> operands(
+        {adaptor.getLhs(), adaptor.getRhs(), adaptor.getAcc(), confCst});
+    VectorType v16xi64ty = VectorType::get({16}, rewriter.getI64Type());
+    SmallVector<Type> intrFuncSig({VectorType::get({64}, rewriter.getI8Type()),
+                                   VectorType::get({16}, i32ty), v16xi64ty,
+                                   i32ty});
+    Value fmaConvOp =
+        lhsScaTy.getIntOrFloatBitWidth() == 8
+            ? createIntrinsic<xllvm::MacConfAcc32IntrOp>(
+                  rewriter, loc, v16xi64ty, operands, intrFuncSig)
+            : createIntrinsic<xllvm::MacConfAcc64IntrOp>(
+                  rewriter, loc, v16xi64ty, operands, intrFuncSig);
+
+    // cast the result back to the op type
+    rewriter.replaceOp(op, forceCastValueToType(rewriter, loc, fmaConvOp,
+                                                op.getResult().getType()));
+    return success();
+  }
+};
+
 // This pattern folds aievec.cast op. For AIE-ML, the accumulators are in 32/64
 // bits, and the vectors are in 4/8/16/32 bits. Hence, we don't have to
 // explicitly express the casting between accumulators and vectors at the LLVM
@@ -1583,6 +2246,20 @@ void populateAIEVecToLLVMConversionPatterns(
                FMAElemOpConversion,
                MatMulOpConversion,
                ShiftOpConversion,
+               MaxOpConversion,
+               MinOpConversion,
+               CmpOpConversion,
+               SelOpConversion,
+               NegOpConversion,
+               BandOpConversion,
+               BorOpConversion,
+               BxorOpConversion,
+               BnegOpConversion,
+               ExtElemOpConversion,
+               AddElemOpConversion,
+               SubElemOpConversion,
+               MulConvOpConversion,
+               FMAConvOpConversion,
                FoldAIECastOps>(converter);
   patterns.add<MulElemOpConversion>(converter, aie2Fp32EmulationOption);
   // clang-format on
@@ -0,0 +1,173 @@
+//===- AIEDeviceIndex.cpp ---------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+#include "aie/Dialect/AIE/IR/AIEDeviceIndex.h"
+
+#include "mlir/IR/SymbolTable.h"
+
+#include "llvm/ADT/TypeSwitch.h"
+
+using namespace mlir;
+using namespace xilinx;
+using namespace xilinx::AIE;
+
+AIEDeviceIndex::AIEDeviceIndex(Operation *op)
+    : device(cast<DeviceOp>(op)), targetModel(&device.getTargetModel()) {
+  for (Operation &child : device.getBody()->getOperations())
+    if (auto name =
+            child.getAttrOfType<StringAttr>(SymbolTable::getSymbolAttrName()))
+      symbols.try_emplace(name, &child);
+
+  device.walk<WalkOrder::PreOrder>([&](Operation *child) {
+    return TypeSwitch<Operation *, WalkResult>(child)
+        .Case([&](TileOp tile) {
+          tiles[tile.getTileID()].tile = tile;
+          return WalkResult::advance();
+        })
+        .Case([&](SwitchboxOp switchbox) {
+          tiles[switchbox.getTileID()].switchbox = switchbox;
+          return WalkResult::skip();
+        })
+        .Case([&](ShimMuxOp shimMux) {
+          tiles[shimMux.getTileID()].shimMux = shimMux;
+          return WalkResult::skip();
+        })
+        .Case([&](CoreOp core) {
+          tiles[core.getTileID()].core = core;
+          return WalkResult::advance();
+        })
+        .Case<MemOp, MemTileDMAOp, ShimDMAOp>([&](auto dma) {
+          addDMA(dma, dma.getTileID());
+          return WalkResult::skip();
+        })
+        .Case([&](BufferOp buffer) {
+          tiles[buffer.getTileID()].buffers.push_back(buffer);
+          return WalkResult::advance();
+        })
+        .Case([&](LockOp lock) {
+          tiles[lock.getTileID()].locks.push_back(lock);
+          return WalkResult::advance();
+        })
+        .Case([&](ShimDMAAllocationOp alloc) {
+          shimDMAAllocations.try_emplace(alloc.getSymNameAttr().getAttr(),
+                                         alloc);
+          return WalkResult::advance();
+        })
+        .Default([](Operation *) { return WalkResult::advance(); });
+  });
+}
+
+void AIEDeviceIndex::addDMA(Operation *dma, TileID id) {
+  TileInfo &info = tiles[id];
+  info.dma = dma;
+  dma->walk([&](Operation *op) {
+    if (auto bd = dyn_cast<DMABDOp>(op))
+      info.bds.push_back(bd);
+    else if (auto start = dyn_cast<DMAStartOp>(op))
+      info.dmaStarts.push_back(start);
+  });
+}
+
+const AIEDeviceIndex::TileInfo *AIEDeviceIndex::lookup(TileID id) const {
+  auto it = tiles.find(id);
+  return it == tiles.end() ? nullptr : &it->second;
+}
+
+TileOp AIEDeviceIndex::getTile(TileID id) const {
+  const TileInfo *info = lookup(id);
+  return info ? info->tile : TileOp();
+}
+
+SwitchboxOp AIEDeviceIndex::getSwitchbox(TileID id) const {
+  const TileInfo *info = lookup(id);
+  return info ? info->switchbox : SwitchboxOp();
+}
+
+ShimMuxOp AIEDeviceIndex::getShimMux(TileID id) const {
+  const TileInfo *info = lookup(id);
+  return info ? info->shimMux : ShimMuxOp();
+}
+
+CoreOp AIEDeviceIndex::getCore(TileID id) const {
+  const TileInfo *info = lookup(id);
+  return info ? info->core : CoreOp();
+}
+
+Operation *AIEDeviceIndex::getDMA(TileID id) const {
+  const TileInfo *info = lookup(id);
+  return info ? info->dma : nullptr;
+}
+
+ArrayRef<BufferOp> AIEDeviceIndex::getBuffers(TileID id) const {
+  const TileInfo *info = lookup(id);
+  return info ? ArrayRef<BufferOp>(info->buffers) : ArrayRef<BufferOp>();
+}
+
+ArrayRef<LockOp> AIEDeviceIndex::getLocks(TileID id) const {
+  const TileInfo *info = lookup(id);
+  return info ? ArrayRef<LockOp>(info->locks) : ArrayRef<LockOp>();
+}
+
+ArrayRef<DMABDOp> AIEDeviceIndex::getBDs(TileID id) const {
+  const TileInfo *info = lookup(id);
+  return info ? ArrayRef<DMABDOp>(info->bds) : ArrayRef<DMABDOp>();
+}
+
+ArrayRef<DMAStartOp> AIEDeviceIndex::getDMAStarts(TileID id) const {
+  const TileInfo *info = lookup(id);
+  return info ? ArrayRef<DMAStartOp>(info->dmaStarts) : ArrayRef<DMAStartOp>();
+}
+
+LockOp AIEDeviceIndex::getLock(TileID id, int lockID) const {
+  for (LockOp lock : getLocks(id))
+    if (lock.getLockID() == lockID)
+      return lock;
+  return {};
+}
+
+DMABDOp AIEDeviceIndex::getBD(TileID id, int bdID) const {
+  for (DMABDOp bd : getBDs(id))
+    if (bd.getBdId() == bdID)
+      return bd;
+  return {};
+}
+
+DMAStartOp AIEDeviceIndex::getDMAStart(TileID id, DMAChannelDir dir,
+                                       int channel) const {
+  for (DMAStartOp start : getDMAStarts(id))
+    if (start.getChannelDir() == dir && start.getChannelIndex() == channel)
+      return start;
+  return {};
+}
+
+Operation *AIEDeviceIndex::lookupSymbol(StringRef name) const {
+  return symbols.lookup(StringAttr::get(device.getContext(), name));
+}
+
+ShimDMAAllocationOp
+AIEDeviceIndex::getShimDMAAllocation(StringRef name) const {
+  return shimDMAAllocations.lookup(StringAttr::get(device.getContext(), name));
+}
+
+TileOp AIEDeviceIndex::getOrCreateTile(OpBuilder &builder, int col, int row) {
+  TileInfo &info = tiles[{col, row}];
+  if (!info.tile)
+    info.tile = builder.create<TileOp>(builder.getUnknownLoc(), col, row);
+  return info.tile;
+}
+
+SwitchboxOp AIEDeviceIndex::getOrCreateSwitchbox(OpBuilder &builder,
+                                                 TileOp tile) {
+  TileInfo &info = tiles[tile.getTileID()];
+  if (!info.switchbox)
+    info.switchbox =
+        builder.create<SwitchboxOp>(builder.getUnknownLoc(), tile);
+  return info.switchbox;
+}
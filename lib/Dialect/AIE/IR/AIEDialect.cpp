@@ -106,6 +106,20 @@ static VE2302TargetModel VE2302model;
 static VE2802TargetModel VE2802model;
 static NPUTargetModel NPUmodel;
 
+const AIETargetModel &getTargetModel(AIEDevice device) {
+  switch (device) {
+  case AIEDevice::xcvc1902:
+    return VC1902model;
+  case AIEDevice::xcve2302:
+    return VE2302model;
+  case AIEDevice::xcve2802:
+    return VE2802model;
+  case AIEDevice::npu:
+    return NPUmodel;
+  }
+  return VC1902model;
+}
+
 const AIETargetModel &getTargetModel(Operation *op) {
   if (auto t = dyn_cast<AIETarget>(op))
     return t.getTargetModel();
@@ -976,17 +990,7 @@ LogicalResult GetCascadeOp::verify() {
 //===----------------------------------------------------------------------===//
 
 const AIETargetModel &DeviceOp::getTargetModel() {
-  switch (getDevice()) {
-  case AIEDevice::xcvc1902:
-    return VC1902model;
-  case AIEDevice::xcve2302:
-    return VE2302model;
-  case AIEDevice::xcve2802:
-    return VE2802model;
-  case AIEDevice::npu:
-    return NPUmodel;
-  }
-  return VC1902model;
+  return xilinx::AIE::getTargetModel(getDevice());
 }
 
 LogicalResult DeviceOp::verify() { return success(); }
@@ -1424,6 +1428,9 @@ LogicalResult MemTileDMAOp::verify() {
           .failed())
     return failure();
 
+  // Blocks already found to only access local buffers and locks, so that the
+  // BDs shared by channels 4 and 5 are only checked once.
+  llvm::SmallPtrSet<Block *, 16> checked;
   for (auto &bodyOp : getBody().getOps()) {
     if (auto allocOp = dyn_cast<memref::AllocOp>(bodyOp)) {
       if (!allocOp->getAttr("id"))
@@ -1448,21 +1455,24 @@ LogicalResult MemTileDMAOp::verify() {
         llvm::SmallSet<Block *, 16> reachable;
         SmallVector<Block *, 16> worklist;
         Block *firstBD = startOp.getSuccessor(0);
-        reachable.insert(firstBD);
-        worklist.push_back(firstBD);
+        if (!checked.contains(firstBD)) {
+          reachable.insert(firstBD);
+          worklist.push_back(firstBD);
+        }
         while (!worklist.empty()) {
           Block *block = worklist.pop_back_val();
           if (block->empty())
             continue;
           auto successors = block->getTerminator()->getSuccessors();
           for (auto *i : successors) {
-            if (!reachable.contains(i)) {
+            if (!checked.contains(i) && !reachable.contains(i)) {
               reachable.insert(i);
               worklist.push_back(i);
             }
           }
         }
         for (Block *b : reachable) {
+          checked.insert(b);
           for (DMABDOp bd : b->getOps<DMABDOp>()) {
             if (auto bufferOp = bd.getBufferOp();
                 bufferOp.getTileOp().colIndex() != colIndex() ||
@@ -1677,7 +1687,7 @@ LogicalResult SwitchboxOp::verify() {
         return connectOp.emitOpError()
                << "; connecting " << to_string(source) << " to "
                << to_string(dest) << " on "
-               << to_string(this->getTileOp().getTileID())
+               << to_string(tile.getTileID())
                << " targets same dst as another connect op; existing "
                   "destinations: "
                << llvm::join(llvm::map_range(
@@ -1691,7 +1701,9 @@ LogicalResult SwitchboxOp::verify() {
 
       if (checkBound("source", connectOp.getSourceBundle(),
                      connectOp.sourceIndex(),
-                     getNumSourceConnections(connectOp.getSourceBundle()))
+                     targetModel.getNumSourceSwitchboxConnections(
+                         tile.getCol(), tile.getRow(),
+                         connectOp.getSourceBundle()))
               .failed())
         return failure();
 
@@ -1699,7 +1711,9 @@ LogicalResult SwitchboxOp::verify() {
         return connectOp.emitOpError("dest index cannot be less than zero");
 
       if (checkBound("dest", connectOp.getDestBundle(), connectOp.destIndex(),
-                     getNumDestConnections(connectOp.getDestBundle()))
+                     targetModel.getNumDestSwitchboxConnections(
+                         tile.getCol(), tile.getRow(),
+                         connectOp.getDestBundle()))
               .failed())
         return failure();
 
@@ -1730,7 +1744,9 @@ LogicalResult SwitchboxOp::verify() {
         return connectOp.emitOpError("dest index cannot be less than zero");
 
       if (checkBound("dest", connectOp.getDestBundle(), connectOp.destIndex(),
-                     getNumDestConnections(connectOp.getDestBundle()))
+                     targetModel.getNumDestSwitchboxConnections(
+                         tile.getCol(), tile.getRow(),
+                         connectOp.getDestBundle()))
               .failed())
         return failure();
 
@@ -1831,55 +1847,32 @@ LogicalResult LockOp::verify() {
   return success();
 }
 
-struct UsesOneLockInDMABlock {
-  static LogicalResult verifyTrait(Operation *op) {
-    auto *block = op->getBlock();
-    int lockID = -1;
-    for (auto op : block->getOps<UseLockOp>()) {
-      if (auto lock = dyn_cast<LockOp>(op.getLock().getDefiningOp());
-          lock.getLockID().has_value()) {
-        if (lockID != -1 && lockID != lock.getLockIDValue())
-          return failure();
-        lockID = lock.getLockIDValue();
-      }
-    }
-    return success();
-  }
-};
-
-struct AcquireReleaseOneStateInDMABlock {
-  static LogicalResult verifyTrait(Operation *op) {
-    auto *block = op->getBlock();
-    int acqValue = -1, relValue = -1;
-    for (auto op : block->getOps<UseLockOp>()) {
-      if (op.acquire() || op.acquireGE()) {
-        if (acqValue != -1 && acqValue != op.getLockValue()) {
-          return failure();
-        }
-        acqValue = op.getLockValue();
-      } else if (op.release()) {
-        if (relValue != -1 && relValue != op.getLockValue()) {
-          return failure();
-        }
-        relValue = op.getLockValue();
-      }
+// Check the UseLockOps of a DMA block against each other: on AIE1 they must
+// all use the same lock, and all acquires and all releases must be of a single
+// state. The block is scanned once, from its first UseLockOp, and the error is
+// reported there; the other UseLockOps of the block need not scan it again.
+static LogicalResult verifyDMABlockLocks(UseLockOp first, bool singleLock) {
+  int lockID = -1, acqValue = -1, relValue = -1;
+  bool multipleLocks = false, multipleStates = false;
+  for (auto useLock : first->getBlock()->getOps<UseLockOp>()) {
+    if (auto lock = dyn_cast<LockOp>(useLock.getLock().getDefiningOp());
+        singleLock && lock.getLockID().has_value()) {
+      if (lockID != -1 && lockID != lock.getLockIDValue())
+        multipleLocks = true;
+      lockID = lock.getLockIDValue();
     }
-    return success();
+    int &value = useLock.release() ? relValue : acqValue;
+    if (value != -1 && value != useLock.getLockValue())
+      multipleStates = true;
+    value = useLock.getLockValue();
   }
-};
-
-struct AccessesLocalLocks {
-  static LogicalResult verifyTrait(Operation *op) {
-    if (auto memOp = op->getParentOfType<MemOp>()) {
-      auto useLock = dyn_cast<UseLockOp>(op);
-      if (auto lock = useLock.getLockOp();
-          lock.getTileOp().colIndex() != memOp.colIndex() ||
-          lock.getTileOp().rowIndex() != memOp.rowIndex())
-        return failure();
-    }
-    return success();
-  }
-};
+  if (multipleLocks)
+    return first.emitOpError("used in a DMA block that have multiple locks.");
+  if (multipleStates)
+    return first.emitOpError(
+        "acquires/releases the lock in a DMA block from/to multiple states.");
+  return success();
+}
 
 LogicalResult UseLockOp::verify() {
   // AIE.useLock cannot be used at the top level
@@ -1897,17 +1890,14 @@ LogicalResult UseLockOp::verify() {
     if (!(*this)->getBlock())
       return (*this)->emitOpError("is not in a block.");
 
-    if (targetModel.getTargetArch() == AIEArch::AIE1 &&
-        UsesOneLockInDMABlock::verifyTrait(*this).failed())
-      return (*this)->emitOpError(
-          "used in a DMA block that have multiple locks.");
-
-    if (AcquireReleaseOneStateInDMABlock::verifyTrait(*this).failed())
-      return (*this)->emitOpError(
-          "acquires/releases the lock in a DMA block from/to multiple states.");
+    if (*(*this)->getBlock()->getOps<UseLockOp>().begin() == *this &&
+        failed(verifyDMABlockLocks(
+            *this, targetModel.getTargetArch() == AIEArch::AIE1)))
+      return failure();
 
-    if (HasSomeParent<MemOp>::verifyTrait(*this).succeeded() &&
-        AccessesLocalLocks::verifyTrait(*this).failed())
+    if (auto memOp = (*this)->getParentOfType<MemOp>();
+        memOp && (getLockOp().getTileOp().colIndex() != memOp.colIndex() ||
+                  getLockOp().getTileOp().rowIndex() != memOp.rowIndex()))
       return (*this)->emitOpError("can only access a lock in the same tile");
     return success();
 
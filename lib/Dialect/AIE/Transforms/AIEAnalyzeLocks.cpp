@@ -0,0 +1,749 @@
+//===- AIEAnalyzeLocks.cpp --------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// This pass simulates the lock protocol of a device to find deadlocks and the
+// throughput bottleneck. Each core and each DMA channel is a sequential
+// process: a program of lock acquires and releases, timed work and stream
+// transfers, with counted loops. The locks are the places of a timed Petri
+// net and the circuit flows between DMA channels are bounded streams. The
+// processes are run by a discrete-event simulation until they all end or
+// block, or until a horizon. A core left blocked is a deadlock; otherwise the
+// busiest process bounds the rate at which the locks it acquires cycle.
+
+#include "aie/Dialect/AIE/IR/AIEDialect.h"
+#include "aie/Dialect/AIE/Transforms/AIEPasses.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Interfaces/LoopLikeInterface.h"
+#include "mlir/Pass/Pass.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#define DEBUG_TYPE "aie-analyze-locks"
+
+using namespace mlir;
+using namespace xilinx;
+using namespace xilinx::AIE;
+
+namespace {
+
+// Cycles taken by a lock acquire or release, and bytes moved per cycle by a
+// DMA channel over a 32-bit stream.
+constexpr uint64_t lockCycles = 1;
+constexpr uint64_t streamBytesPerCycle = 4;
+
+enum class StepKind { Acquire, Release, Work, Send, Receive, Loop, End };
+
+struct Step {
+  StepKind kind;
+  // The op reported when the process blocks on this step.
+  Operation *op = nullptr;
+  // Acquire/Release: the lock and the value. An AIE2 Acquire waits for the
+  // exact value, an AcquireGreaterEqual for at least the value.
+  unsigned lock = 0;
+  int64_t value = 0;
+  bool equal = false;
+  // Send/Receive: the bytes transferred and the streams to all receivers, or
+  // from the sender.
+  uint64_t bytes = 0;
+  SmallVector<unsigned, 1> streams;
+  // Cycles the process is busy once the step starts.
+  uint64_t cycles = 0;
+  // Loop: the first step of the body, the trip count (none: forever) and the
+  // index of the counter of the loop.
+  unsigned target = 0;
+  std::optional<uint64_t> tripCount;
+  unsigned counter = 0;
+};
+
+struct Process {
+  std::string name;
+  Operation *op;
+  bool isCore;
+  SmallVector<Step> steps;
+  unsigned numCounters = 0;
+  // Work is merged into the previous step only from this step on, so that
+  // the body of a loop starts with a step of its own.
+  unsigned mergeFrom = 0;
+  // DMA channels: the streams of the flows from or to the channel.
+  SmallVector<unsigned, 1> streams;
+
+  // State of the simulation.
+  unsigned pc = 0;
+  SmallVector<uint64_t> counters;
+  uint64_t readyAt = 0;
+  bool ended = false;
+  std::optional<uint64_t> blockedSince;
+  uint64_t busyCycles = 0;
+  // Cycles spent blocked on each lock and each stream.
+  DenseMap<unsigned, uint64_t> lockWaits;
+  DenseMap<unsigned, uint64_t> streamWaits;
+};
+
+struct LockState {
+  LockOp op;
+  std::string name;
+  int64_t value;
+  // AIE1 locks are also held by the last acquirer until released.
+  bool held = false;
+  uint64_t acquires = 0;
+  uint64_t firstAcquire = 0;
+  uint64_t lastAcquire = 0;
+};
+
+// A circuit flow from the MM2S channel `sender` to the S2MM channel
+// `receiver`. It buffers up to the largest transfer of either end, so that
+// the sender may run one transfer ahead of the receiver.
+struct Stream {
+  unsigned sender;
+  unsigned receiver;
+  uint64_t capacity = 0;
+  uint64_t bytes = 0;
+};
+
+// The number of iterations of a loop with constant bounds.
+std::optional<uint64_t> getTripCount(LoopLikeOpInterface loop) {
+  auto lb = loop.getSingleLowerBound();
+  auto ub = loop.getSingleUpperBound();
+  auto step = loop.getSingleStep();
+  if (!lb || !ub || !step)
+    return std::nullopt;
+  auto lbValue = getConstantIntValue(*lb);
+  auto ubValue = getConstantIntValue(*ub);
+  auto stepValue = getConstantIntValue(*step);
+  if (!lbValue || !ubValue || !stepValue || *stepValue <= 0)
+    return std::nullopt;
+  if (*ubValue <= *lbValue)
+    return 0;
+  return llvm::divideCeil(*ubValue - *lbValue, *stepValue);
+}
+
+func::FuncOp getDefinedCallee(func::CallOp call) {
+  auto callee = SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(
+      call, call.getCalleeAttr());
+  if (!callee || callee.isExternal())
+    return {};
+  return callee;
+}
+
+unsigned percent(uint64_t part, uint64_t whole) {
+  return whole ? (part * 100 + whole / 2) / whole : 0;
+}
+
+class LockSimulator {
+public:
+  explicit LockSimulator(DeviceOp device)
+      : isAIE1(device.getTargetModel().getTargetArch() == AIEArch::AIE1) {}
+
+  // Fail if a lock operation is under a condition that is not constant,
+  // as the program of its process is then not known.
+  LogicalResult build(DeviceOp device);
+  void run(uint64_t maxCycles);
+  // Report the blocked processes and return true if a core is blocked. At
+  // the horizon, only report the cores that have been blocked for most of
+  // the simulation, and return false.
+  bool reportDeadlock(DeviceOp device);
+  void reportThroughput(DeviceOp device);
+
+private:
+  unsigned getLock(LockOp lock);
+  void appendLock(Process &process, UseLockOp useLock);
+  void appendWork(Process &process, uint64_t cycles);
+  void appendOp(Process &process, Operation &op);
+  void appendRegion(Process &process, Region &region);
+  void appendTransfer(Process &process, DMABDOp bd, bool send);
+  void appendBlock(Process &process, Block &block, bool send);
+  bool containsLocks(Operation *op);
+  uint64_t estimateOp(Operation *op);
+
+  bool canStart(const Step &step) const;
+  bool advance(Process &process, uint64_t now);
+  void describeWait(Diagnostic &note, const Process &process) const;
+
+  bool isAIE1;
+  std::vector<Process> processes;
+  SmallVector<LockState> locks;
+  SmallVector<Stream> streams;
+  DenseMap<Operation *, unsigned> lockIndex;
+  // Whether a function contains lock operations, directly or in callees.
+  DenseMap<Operation *, bool> lockingFuncs;
+  // The first conditional with lock operations whose branch is not known.
+  Operation *unknownBranch = nullptr;
+  uint64_t endTime = 0;
+  bool horizonReached = false;
+};
+
+unsigned LockSimulator::getLock(LockOp lock) {
+  auto [it, inserted] = lockIndex.try_emplace(lock, locks.size());
+  if (!inserted)
+    return it->second;
+  LockState state;
+  state.op = lock;
+  if (lock.hasName()) {
+    state.name = lock.name().str();
+  } else {
+    llvm::raw_string_ostream os(state.name);
+    os << "(" << lock.colIndex() << ", " << lock.rowIndex();
+    if (std::optional<int32_t> id = lock.getLockID())
+      os << ", " << *id;
+    os << ")";
+  }
+  state.value = lock.getInit().value_or(0);
+  locks.push_back(std::move(state));
+  return it->second;
+}
+
+void LockSimulator::appendLock(Process &process, UseLockOp useLock) {
+  Step step;
+  step.kind = useLock.release() ? StepKind::Release : StepKind::Acquire;
+  step.op = useLock;
+  step.lock = getLock(useLock.getLockOp());
+  step.value = useLock.getLockValue();
+  step.equal = useLock.acquire();
+  step.cycles = lockCycles;
+  process.steps.push_back(step);
+}
+
+void LockSimulator::appendWork(Process &process, uint64_t cycles) {
+  if (cycles == 0)
+    return;
+  if (process.steps.size() > process.mergeFrom &&
+      process.steps.back().kind == StepKind::Work) {
+    process.steps.back().cycles =
+        llvm::SaturatingAdd(process.steps.back().cycles, cycles);
+    return;
+  }
+  Step step;
+  step.kind = StepKind::Work;
+  step.cycles = cycles;
+  process.steps.push_back(step);
+}
+
+bool LockSimulator::containsLocks(Operation *op) {
+  return op
+      ->walk([&](Operation *nested) {
+        if (isa<UseLockOp>(nested))
+          return WalkResult::interrupt();
+        auto call = dyn_cast<func::CallOp>(nested);
+        func::FuncOp callee = call ? getDefinedCallee(call) : nullptr;
+        if (!callee)
+          return WalkResult::advance();
+        auto [it, inserted] = lockingFuncs.try_emplace(callee, false);
+        // Recursive calls are not followed.
+        if (inserted) {
+          bool locking = containsLocks(callee);
+          lockingFuncs[callee] = locking;
+          return locking ? WalkResult::interrupt() : WalkResult::advance();
+        }
+        return it->second ? WalkResult::interrupt() : WalkResult::advance();
+      })
+      .wasInterrupted();
+}
+
+// The cycles of an op without lock operations: the `aie.estimated_cycles`
+// of the op or of its callee, as set by aie-estimate-cycles, and otherwise
+// one cycle per op.
+uint64_t LockSimulator::estimateOp(Operation *op) {
+  if (auto cycles = op->getAttrOfType<IntegerAttr>("aie.estimated_cycles"))
+    return cycles.getInt();
+  if (auto call = dyn_cast<func::CallOp>(op)) {
+    auto callee = SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(
+        call, call.getCalleeAttr());
+    if (callee)
+      if (auto cycles =
+              callee->getAttrOfType<IntegerAttr>("aie.estimated_cycles"))
+        return cycles.getInt();
+    return 1;
+  }
+  if (op->hasTrait<OpTrait::ConstantLike>() ||
+      op->hasTrait<OpTrait::IsTerminator>())
+    return 0;
+  if (op->getNumRegions() == 0)
+    return 1;
+  uint64_t cycles = 0;
+  for (Region &region : op->getRegions())
+    for (Operation &nested : region.getOps())
+      cycles = llvm::SaturatingAdd(cycles, estimateOp(&nested));
+  if (auto loop = dyn_cast<LoopLikeOpInterface>(op))
+    cycles = llvm::SaturatingMultiply(cycles,
+                                      getTripCount(loop).value_or(uint64_t(1)));
+  return cycles;
+}
+
+void LockSimulator::appendOp(Process &process, Operation &op) {
+  if (auto useLock = dyn_cast<UseLockOp>(op))
+    return appendLock(process, useLock);
+  if (!containsLocks(&op))
+    return appendWork(process, estimateOp(&op));
+
+  if (auto loop = dyn_cast<LoopLikeOpInterface>(op);
+      loop && op.getNumRegions() == 1) {
+    std::optional<uint64_t> tripCount = getTripCount(loop);
+    if (tripCount == 0)
+      return;
+    Step step;
+    step.kind = StepKind::Loop;
+    step.op = &op;
+    step.target = process.steps.size();
+    step.tripCount = tripCount;
+    step.counter = process.numCounters++;
+    process.mergeFrom = process.steps.size();
+    appendRegion(process, op.getRegion(0));
+    // A body that takes no time, e.g. with its lock operations in a branch
+    // that is never taken, would loop without ever advancing the clock.
+    if (llvm::none_of(
+            ArrayRef(process.steps).drop_front(step.target),
+            [](const Step &nested) { return nested.cycles > 0; })) {
+      process.steps.truncate(step.target);
+      return;
+    }
+    process.steps.push_back(step);
+    return;
+  }
+  if (auto ifOp = dyn_cast<scf::IfOp>(op)) {
+    std::optional<int64_t> condition =
+        getConstantIntValue(ifOp.getCondition());
+    if (!condition) {
+      if (!unknownBranch)
+        unknownBranch = ifOp;
+      return;
+    }
+    return appendRegion(process, *condition ? ifOp.getThenRegion()
+                                            : ifOp.getElseRegion());
+  }
+  if (auto call = dyn_cast<func::CallOp>(op))
+    if (func::FuncOp callee = getDefinedCallee(call)) {
+      // Recursive calls are not followed.
+      lockingFuncs[callee] = false;
+      appendRegion(process, callee.getBody());
+      lockingFuncs[callee] = true;
+      return;
+    }
+  for (Region &region : op.getRegions())
+    appendRegion(process, region);
+}
+
+void LockSimulator::appendRegion(Process &process, Region &region) {
+  for (Operation &op : region.getOps())
+    appendOp(process, op);
+}
+
+void LockSimulator::appendTransfer(Process &process, DMABDOp bd, bool send) {
+  Step step;
+  step.op = bd;
+  step.bytes = bd.getLenInBytes();
+  step.cycles = std::max<uint64_t>(
+      llvm::divideCeil(step.bytes, streamBytesPerCycle), 1);
+  // A channel whose other end is not simulated, e.g. a shim DMA programmed
+  // by the host, is never stalled by the stream.
+  if (process.streams.empty()) {
+    step.kind = StepKind::Work;
+    process.steps.push_back(step);
+    return;
+  }
+  step.kind = send ? StepKind::Send : StepKind::Receive;
+  step.streams = process.streams;
+  for (unsigned stream : step.streams)
+    streams[stream].capacity =
+        std::max(streams[stream].capacity, step.bytes);
+  process.steps.push_back(step);
+}
+
+void LockSimulator::appendBlock(Process &process, Block &block, bool send) {
+  for (Operation &op : block) {
+    if (auto useLock = dyn_cast<UseLockOp>(op))
+      appendLock(process, useLock);
+    else if (auto bd = dyn_cast<DMABDOp>(op))
+      appendTransfer(process, bd, send);
+  }
+}
+
+LogicalResult LockSimulator::build(DeviceOp device) {
+  for (CoreOp core : device.getOps<CoreOp>()) {
+    Process process;
+    llvm::raw_string_ostream(process.name)
+        << "core (" << core.colIndex() << ", " << core.rowIndex() << ")";
+    process.op = core;
+    process.isCore = true;
+    appendRegion(process, core.getBody());
+    Step end;
+    end.kind = StepKind::End;
+    process.steps.push_back(end);
+    processes.push_back(std::move(process));
+  }
+
+  // One process per DMA channel, in the dma_start or aie.dma form.
+  using ChannelKey = std::tuple<int, int, DMAChannelDir, int>;
+  std::map<ChannelKey, unsigned> channels;
+  auto memOps = llvm::to_vector_of<TileElement>(device.getOps<MemOp>());
+  llvm::append_range(memOps, device.getOps<MemTileDMAOp>());
+  llvm::append_range(memOps, device.getOps<ShimDMAOp>());
+  SmallVector<std::pair<unsigned, Operation *>> channelOps;
+  for (TileElement memOp : memOps) {
+    TileID tile = memOp.getTileID();
+    auto addChannel = [&](Operation *op, DMAChannelDir dir, int index) {
+      Process process;
+      llvm::raw_string_ostream(process.name)
+          << "DMA (" << tile.col << ", " << tile.row << ") "
+          << stringifyDMAChannelDir(dir) << " " << index;
+      process.op = op;
+      process.isCore = false;
+      channels[{tile.col, tile.row, dir, index}] = processes.size();
+      channelOps.push_back({processes.size(), op});
+      processes.push_back(std::move(process));
+    };
+    Region &body = memOp->getRegion(0);
+    for (DMAStartOp start : body.getOps<DMAStartOp>())
+      addChannel(start, start.getChannelDir(), start.getChannelIndex());
+    for (DMAOp dma : body.getOps<DMAOp>())
+      addChannel(dma, dma.getChannelDir(), dma.getChannelIndex());
+  }
+
+  for (FlowOp flow : device.getOps<FlowOp>()) {
+    if (flow.getSourceBundle() != WireBundle::DMA ||
+        flow.getDestBundle() != WireBundle::DMA)
+      continue;
+    auto source = cast<TileOp>(flow.getSource().getDefiningOp());
+    auto dest = cast<TileOp>(flow.getDest().getDefiningOp());
+    auto sender = channels.find({source.getCol(), source.getRow(),
+                                 DMAChannelDir::MM2S, flow.sourceIndex()});
+    auto receiver = channels.find(
+        {dest.getCol(), dest.getRow(), DMAChannelDir::S2MM, flow.destIndex()});
+    if (sender == channels.end() || receiver == channels.end())
+      continue;
+    processes[sender->second].streams.push_back(streams.size());
+    processes[receiver->second].streams.push_back(streams.size());
+    streams.push_back({sender->second, receiver->second});
+  }
+
+  for (auto [index, op] : channelOps) {
+    Process &process = processes[index];
+    Step end;
+    end.kind = StepKind::End;
+    if (auto dma = dyn_cast<DMAOp>(op)) {
+      bool send = dma.getChannelDir() == DMAChannelDir::MM2S;
+      for (Region &bd : dma.getBds())
+        appendBlock(process, bd.front(), send);
+      if (dma.getLoop()) {
+        end.kind = StepKind::Loop;
+        end.target = 0;
+      }
+      process.steps.push_back(end);
+      continue;
+    }
+    // Follow the chain of BDs until it ends or loops back.
+    auto start = cast<DMAStartOp>(op);
+    DenseMap<Block *, unsigned> blockSteps;
+    Block *block = start.getDest();
+    while (block && !block->getOps<DMABDOp>().empty()) {
+      if (auto it = blockSteps.find(block); it != blockSteps.end()) {
+        end.kind = StepKind::Loop;
+        end.target = it->second;
+        break;
+      }
+      blockSteps[block] = process.steps.size();
+      appendBlock(process, *block, start.isSend());
+      block = block->getNumSuccessors() ? block->getSuccessor(0) : nullptr;
+    }
+    process.steps.push_back(end);
+  }
+
+  for (Process &process : processes)
+    process.counters.assign(process.numCounters, 0);
+
+  if (unknownBranch)
+    return unknownBranch->emitWarning(
+        "lock operations under a condition that is not constant: the lock "
+        "protocol is not analyzed");
+  return success();
+}
+
+bool LockSimulator::canStart(const Step &step) const {
+  switch (step.kind) {
+  case StepKind::Acquire: {
+    const LockState &lock = locks[step.lock];
+    if (isAIE1)
+      return !lock.held && lock.value == step.value;
+    return step.equal ? lock.value == step.value : lock.value >= step.value;
+  }
+  case StepKind::Send:
+    return llvm::all_of(step.streams, [&](unsigned index) {
+      const Stream &stream = streams[index];
+      return stream.bytes == 0 ||
+             stream.bytes + step.bytes <= stream.capacity;
+    });
+  case StepKind::Receive:
+    return streams[step.streams.front()].bytes >= step.bytes;
+  default:
+    return true;
+  }
+}
+
+// Run `process` at time `now` until it blocks, starts a timed step or ends,
+// and return whether it made progress.
+bool LockSimulator::advance(Process &process, uint64_t now) {
+  bool progress = false;
+  while (!process.ended && process.readyAt <= now) {
+    Step &step = process.steps[process.pc];
+    if (!canStart(step)) {
+      if (!process.blockedSince)
+        process.blockedSince = now;
+      return progress;
+    }
+    if (process.blockedSince) {
+      uint64_t waited = now - *process.blockedSince;
+      if (step.kind == StepKind::Acquire)
+        process.lockWaits[step.lock] += waited;
+      else
+        process.streamWaits[step.streams.front()] += waited;
+      process.blockedSince.reset();
+    }
+    progress = true;
+
+    switch (step.kind) {
+    case StepKind::Acquire: {
+      LockState &lock = locks[step.lock];
+      if (isAIE1)
+        lock.held = true;
+      else
+        lock.value -= step.value;
+      if (lock.acquires++ == 0)
+        lock.firstAcquire = now;
+      lock.lastAcquire = now;
+      break;
+    }
+    case StepKind::Release: {
+      LockState &lock = locks[step.lock];
+      if (isAIE1) {
+        lock.held = false;
+        lock.value = step.value;
+      } else {
+        lock.value += step.value;
+      }
+      break;
+    }
+    case StepKind::Send:
+      for (unsigned stream : step.streams)
+        streams[stream].bytes += step.bytes;
+      break;
+    case StepKind::Receive:
+      streams[step.streams.front()].bytes -= step.bytes;
+      break;
+    case StepKind::Loop:
+      if (!step.tripCount) {
+        process.pc = step.target;
+      } else if (++process.counters[step.counter] < *step.tripCount) {
+        process.pc = step.target;
+      } else {
+        process.counters[step.counter] = 0;
+        process.pc++;
+      }
+      continue;
+    case StepKind::End:
+      process.ended = true;
+      continue;
+    case StepKind::Work:
+      break;
+    }
+    process.readyAt = now + step.cycles;
+    process.busyCycles += step.cycles;
+    process.pc++;
+  }
+  return progress;
+}
+
+void LockSimulator::run(uint64_t maxCycles) {
+  uint64_t now = 0;
+  while (true) {
+    // A release may unblock a process that was run before it.
+    bool progress = true;
+    while (progress) {
+      progress = false;
+      for (Process &process : processes)
+        progress |= advance(process, now);
+    }
+    std::optional<uint64_t> next;
+    for (Process &process : processes)
+      if (!process.ended && process.readyAt > now)
+        next = std::min(next.value_or(process.readyAt), process.readyAt);
+    if (!next)
+      break;
+    if (*next > maxCycles) {
+      now = maxCycles;
+      horizonReached = true;
+      break;
+    }
+    now = *next;
+  }
+  endTime = now;
+
+  // Only count the cycles up to the end of the simulation.
+  for (Process &process : processes) {
+    if (process.readyAt > endTime)
+      process.busyCycles -= process.readyAt - endTime;
+    if (!process.ended && process.blockedSince) {
+      const Step &step = process.steps[process.pc];
+      uint64_t waited = endTime - *process.blockedSince;
+      if (step.kind == StepKind::Acquire)
+        process.lockWaits[step.lock] += waited;
+      else
+        process.streamWaits[step.streams.front()] += waited;
+    }
+  }
+}
+
+void LockSimulator::describeWait(Diagnostic &note,
+                                 const Process &process) const {
+  const Step &step = process.steps[process.pc];
+  note << process.name;
+  switch (step.kind) {
+  case StepKind::Acquire: {
+    const LockState &lock = locks[step.lock];
+    note << " waits to acquire lock " << lock.name << " (value " << lock.value;
+    if (lock.held)
+      note << ", held";
+    note << ", needs " << (step.equal || isAIE1 ? "" : ">= ") << step.value
+         << ")";
+    break;
+  }
+  case StepKind::Send:
+    note << " waits to send " << step.bytes << " bytes to "
+         << processes[streams[step.streams.front()].receiver].name;
+    break;
+  case StepKind::Receive:
+    note << " waits to receive " << step.bytes << " bytes from "
+         << processes[streams[step.streams.front()].sender].name;
+    break;
+  default:
+    break;
+  }
+}
+
+bool LockSimulator::reportDeadlock(DeviceOp device) {
+  if (horizonReached) {
+    // Other processes may still be running, e.g. a free-running pipeline,
+    // so a core that waits since early on is only a potential deadlock.
+    auto isStuck = [&](const Process &process) {
+      return process.isCore && !process.ended && process.blockedSince &&
+             endTime - *process.blockedSince > endTime / 2;
+    };
+    if (llvm::none_of(processes, isStuck))
+      return false;
+    InFlightDiagnostic warning =
+        device.emitWarning("potential deadlock at the horizon of ")
+        << endTime << " cycles";
+    for (const Process &process : processes) {
+      if (!isStuck(process))
+        continue;
+      Diagnostic &note =
+          warning.attachNote(process.steps[process.pc].op->getLoc());
+      describeWait(note, process);
+      note << " since cycle " << *process.blockedSince;
+    }
+    return false;
+  }
+
+  if (llvm::none_of(processes, [](const Process &process) {
+        return process.isCore && !process.ended;
+      }))
+    return false;
+
+  InFlightDiagnostic warning = device.emitWarning("potential deadlock after ")
+                               << endTime << " cycles";
+  for (const Process &process : processes)
+    if (!process.ended)
+      describeWait(
+          warning.attachNote(process.steps[process.pc].op->getLoc()),
+          process);
+  return true;
+}
+
+void LockSimulator::reportThroughput(DeviceOp device) {
+  if (endTime == 0)
+    return;
+
+  const Process *bottleneck = nullptr;
+  for (const Process &process : processes) {
+    if (!bottleneck || process.busyCycles > bottleneck->busyCycles)
+      bottleneck = &process;
+
+    InFlightDiagnostic remark = process.op->emitRemark(process.name)
+                                << ": busy "
+                                << percent(process.busyCycles, endTime) << "%";
+    // Name what the process waited on the longest.
+    uint64_t longest = 0;
+    std::string waitedOn;
+    for (auto [lock, waited] : process.lockWaits)
+      if (waited > longest) {
+        longest = waited;
+        waitedOn = "lock " + locks[lock].name;
+      }
+    for (auto [index, waited] : process.streamWaits)
+      if (waited > longest) {
+        longest = waited;
+        const Stream &stream = streams[index];
+        waitedOn = stream.sender == unsigned(&process - processes.data())
+                       ? "the stream to " + processes[stream.receiver].name
+                       : "the stream from " + processes[stream.sender].name;
+      }
+    if (longest)
+      remark << ", waiting " << percent(longest, endTime) << "% on "
+             << waitedOn;
+  }
+
+  InFlightDiagnostic remark =
+      device.emitRemark("throughput bottleneck after ")
+      << endTime << " simulated cycles: " << bottleneck->name << ", busy "
+      << percent(bottleneck->busyCycles, endTime) << "%";
+  // The locks acquired by the bottleneck cycle no faster than it runs.
+  SmallVector<unsigned> acquired;
+  for (const Step &step : bottleneck->steps)
+    if (step.kind == StepKind::Acquire &&
+        !llvm::is_contained(acquired, step.lock))
+      acquired.push_back(step.lock);
+  for (unsigned index : acquired) {
+    const LockState &lock = locks[index];
+    if (lock.acquires < 2)
+      continue;
+    remark.attachNote(lock.op.getLoc())
+        << "lock " << lock.name << " is acquired every "
+        << (lock.lastAcquire - lock.firstAcquire) / (lock.acquires - 1)
+        << " cycles";
+  }
+}
+
+} // namespace
+
+struct AIEAnalyzeLocksPass : AIEAnalyzeLocksBase<AIEAnalyzeLocksPass> {
+  void runOnOperation() override {
+    DeviceOp device = getOperation();
+    LockSimulator simulator(device);
+    markAllAnalysesPreserved();
+    if (failed(simulator.build(device)))
+      return;
+    simulator.run(clMaxCycles);
+    if (!simulator.reportDeadlock(device))
+      simulator.reportThroughput(device);
+  }
+};
+
+std::unique_ptr<OperationPass<DeviceOp>> AIE::createAIEAnalyzeLocksPass() {
+  return std::make_unique<AIEAnalyzeLocksPass>();
+}
@@ -8,6 +8,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "aie/Dialect/AIE/IR/AIEDeviceIndex.h"
 #include "aie/Dialect/AIE/IR/AIEDialect.h"
 #include "aie/Dialect/AIE/Transforms/AIEPasses.h"
 
@@ -169,6 +170,8 @@ struct AIEAssignBufferDescriptorIDsPass
         }
       }
     }
+
+    markAnalysesPreserved<AIEDeviceIndex>();
   }
 };
 
@@ -8,6 +8,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "aie/Dialect/AIE/IR/AIEDeviceIndex.h"
 #include "aie/Dialect/AIE/IR/AIEDialect.h"
 #include "aie/Dialect/AIE/Transforms/AIEPasses.h"
 
@@ -53,24 +54,16 @@ LogicalResult checkAndPrintOverflow(TileOp tile, int address,
   return success();
 }
 
-LogicalResult basicAllocation(TileOp &tile) {
-  auto device = tile->getParentOfType<AIE::DeviceOp>();
-  if (!device)
-    return failure();
-
-  const auto &targetModel = getTargetModel(tile);
+LogicalResult basicAllocation(TileOp &tile, const AIEDeviceIndex &index) {
+  const auto &targetModel = index.getTargetModel();
   int maxDataMemorySize = 0;
   if (tile.isMemTile())
     maxDataMemorySize = targetModel.getMemTileSize();
   else
     maxDataMemorySize = targetModel.getLocalMemorySize();
 
-  SmallVector<BufferOp, 4> buffers;
   // Collect all the buffers for this tile.
-  device.walk<WalkOrder::PreOrder>([&](BufferOp buffer) {
-    if (buffer.getTileOp() == tile)
-      buffers.push_back(buffer);
-  });
+  SmallVector<BufferOp, 4> buffers(index.getBuffers(tile.getTileID()));
   // Sort by allocation size.
   std::sort(buffers.begin(), buffers.end(), [](BufferOp a, BufferOp b) {
     return a.getAllocationSize() > b.getAllocationSize();
@@ -113,14 +106,6 @@ typedef struct BankLimits {
   int64_t endAddr;
 } BankLimits;
 
-// TODO: add to target model
-int getNumBanks(TileOp tile) {
-  if (tile.isMemTile())
-    return 1;
-  else
-    return 4;
-}
-
 // Function that given a number of banks and their size, computes
 // the start and end addresses for each bank and fills in the entry
 // in the bankLimits vector.
@@ -274,11 +259,8 @@ LogicalResult checkAndPrintOverflow(TileOp tile, int numBanks, int stacksize,
   return success();
 }
 
-LogicalResult simpleBankAwareAllocation(TileOp tile) {
-  auto device = tile->getParentOfType<AIE::DeviceOp>();
-  if (!device)
-    return failure();
-
+LogicalResult simpleBankAwareAllocation(TileOp tile,
+                                        const AIEDeviceIndex &index) {
   std::vector<int64_t>
       nextAddrInBanks; // each entry is the next address available for use
                        // for that bank
@@ -287,14 +269,14 @@ LogicalResult simpleBankAwareAllocation(TileOp tile) {
   std::vector<BankLimits> bankLimits; // the entries contain pairs of start and
                                       // end addresses for each bank
 
-  const auto &targetModel = getTargetModel(tile);
+  const auto &targetModel = index.getTargetModel();
   int maxDataMemorySize = 0;
   if (tile.isMemTile())
     maxDataMemorySize = targetModel.getMemTileSize();
   else
     maxDataMemorySize = targetModel.getLocalMemorySize();
 
-  int numBanks = getNumBanks(tile);
+  int numBanks = targetModel.getNumBanks(tile.getCol(), tile.getRow());
   int bankSize = maxDataMemorySize / numBanks;
 
   // Address range owned by the MemTile is 0x80000.
@@ -311,12 +293,8 @@ LogicalResult simpleBankAwareAllocation(TileOp tile) {
   fillBankLimits(numBanks, bankSize, bankLimits);
 
   SmallVector<BufferOp, 4> buffersToAlloc;
-  SmallVector<BufferOp, 4> allBuffers;
   // Collect all the buffers for this tile.
-  device.walk<WalkOrder::PreOrder>([&](BufferOp buffer) {
-    if (buffer.getTileOp() == tile)
-      allBuffers.push_back(buffer);
-  });
+  SmallVector<BufferOp, 4> allBuffers(index.getBuffers(tile.getTileID()));
   // If possible, the buffers with an already specified address will not
   // be overwritten (the available address range of the bank the buffers
   // are in will start AFTER the specified adress + buffer size).
@@ -367,6 +345,7 @@ struct AIEAssignBufferAddressesPass
   void runOnOperation() override {
     DeviceOp device = getOperation();
     OpBuilder builder = OpBuilder::atBlockEnd(device.getBody());
+    const auto &index = getAnalysis<AIEDeviceIndex>();
     // Make sure all the buffers have a name
     int counter = 0;
     device.walk<WalkOrder::PreOrder>([&](BufferOp buffer) {
@@ -381,15 +360,19 @@ struct AIEAssignBufferAddressesPass
     // Select allocation scheme
     if (clBasicAlloc) {
       for (auto tile : device.getOps<TileOp>()) {
-        if (auto res = basicAllocation(tile); res.failed())
+        if (auto res = basicAllocation(tile, index); res.failed())
           return signalPassFailure();
       }
     } else {
       for (auto tile : device.getOps<TileOp>()) {
-        if (auto res = simpleBankAwareAllocation(tile); res.failed())
+        if (auto res = simpleBankAwareAllocation(tile, index); res.failed())
           return signalPassFailure();
       }
     }
+
+    // Only attributes were set, but naming buffers adds symbols.
+    if (counter == 0)
+      markAnalysesPreserved<AIEDeviceIndex>();
   }
 };
 
@@ -15,6 +15,7 @@
 // independently. If there are existing lock IDs, this pass is idempotent
 // and only assigns lock IDs to locks without an ID.
 
+#include "aie/Dialect/AIE/IR/AIEDeviceIndex.h"
 #include "aie/Dialect/AIE/IR/AIEDialect.h"
 #include "aie/Dialect/AIE/Transforms/AIEPasses.h"
 
@@ -95,6 +96,8 @@ struct AIEAssignLockIDsPass : AIEAssignLockIDsBase<AIEAssignLockIDsPass> {
         ++nextID;
       }
     }
+
+    markAnalysesPreserved<AIEDeviceIndex>();
   }
 };
 
@@ -21,9 +21,11 @@
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/IRMapping.h"
 #include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Tools/mlir-translate/MlirTranslateMain.h"
 #include "mlir/Transforms/DialectConversion.h"
+#include "mlir/Transforms/RegionUtils.h"
 
 using namespace mlir;
 using namespace mlir::vector;
@@ -518,78 +520,185 @@ struct AIEEventOpToStdLowering : OpConversionPattern<EventOp> {
   }
 };
 
+// Lower the cores of `device` into functions of `m`, and its buffers into
+// globals of `m`.  If tileCol and tileRow are not -1, only the core of that
+// tile is kept.
+static LogicalResult lowerDevice(ModuleOp m, DeviceOp device, int tileCol,
+                                 int tileRow) {
+  MLIRContext *ctx = m.getContext();
+  OpBuilder builder = OpBuilder::atBlockEnd(m.getBody());
+  const auto &targetModel = device.getTargetModel();
+
+  // Ensure that we don't have an incorrect target triple.  This may override
+  // some bogus target triple in the original mlir.
+  m->setAttr(LLVM::LLVMDialect::getTargetTripleAttrName(),
+             builder.getStringAttr(
+                 getArchIntrinsicString(targetModel.getTargetArch())));
+
+  DenseMap<Operation *, SmallVector<BufferOp, 4>> tileToBuffers;
+
+  // Populate intrinsic functions
+  // Intrinsic information:
+  // peano/llvm-project/llvm/lib/Target/AIE/AIEInstrInfo.td Also take a look
+  // at the tests: peano/llvm-project/llvm/test/CodeGen/AIE
+  builder.setInsertionPointToStart(m.getBody());
+  declareAIEIntrinsics(targetModel.getTargetArch(), builder);
+
+  IRMapping mapper;
+  ConversionTarget target(*ctx);
+  target.addLegalDialect<func::FuncDialect>();
+  target.addLegalDialect<cf::ControlFlowDialect>();
+  target.addLegalDialect<memref::MemRefDialect>();
+  target.addLegalDialect<VectorDialect>();
+  target.addLegalDialect<arith::ArithDialect>();
+  target.addLegalDialect<math::MathDialect>();
+  target.addLegalOp<func::FuncOp, ModuleOp>();
+
+  RewritePatternSet patterns(ctx);
+  patterns.add<AIEPutStreamToStdLowering, AIEGetStreamToStdLowering,
+               AIEPutCascadeToStdLowering, AIEGetCascadeToStdLowering,
+               AIEDebugOpToStdLowering, AIEUseLockToStdLowering,
+               AIEEventOpToStdLowering>(ctx, m);
+
+  patterns.add<AIEBufferToStandard>(ctx, m, /*benefit*/ 1, tileCol, tileRow);
+  if (failed(applyPartialConversion(m, target, std::move(patterns))))
+    return failure();
+
+  RewritePatternSet outlinePatterns(ctx);
+  outlinePatterns.add<AIECoreToStandardFunc>(ctx, m, mapper, tileToBuffers,
+                                             /*benefit*/ 1, tileCol, tileRow);
+  if (failed(applyPartialConversion(m, target, std::move(outlinePatterns))))
+    return failure();
+
+  // Move all the func.func ops and memref.globals from the device to the
+  // module
+  outlineOps<memref::GlobalOp>(device);
+  outlineOps<func::FuncOp>(device);
+
+  RewritePatternSet removepatterns(ctx);
+  removepatterns.add<
+      AIEOpRemoval<DeviceOp>, AIEOpRemoval<TileOp>, AIEOpRemoval<FlowOp>,
+      AIEOpRemoval<MemOp>, AIEOpRemoval<ShimDMAOp>, AIEOpRemoval<ShimMuxOp>,
+      AIEOpRemoval<SwitchboxOp>, AIEOpRemoval<LockOp>, AIEOpRemoval<BufferOp>,
+      AIEOpRemoval<ExternalBufferOp>, AIEOpRemoval<ShimDMAAllocationOp>,
+      AIEOpRemoval<CascadeFlowOp>, AIEOpRemoval<ConfigureCascadeOp>>(ctx, m);
+
+  return applyPartialConversion(m, target, std::move(removepatterns));
+}
+
+// Return the operations that `core` depends on, in program order: the values
+// it uses from its device, the symbols it refers to (also through the
+// functions it calls) and the initialized buffers of its tile, which its ELF
+// file carries.  Symbols are looked up in the device first, then in the
+// enclosing module.
+static SmallVector<Operation *> getCoreDependencies(
+    CoreOp core, ArrayRef<SymbolTable *> symbolTables,
+    DenseMap<Operation *, SmallVector<BufferOp, 4>> &initializedBuffers) {
+  Operation *device = core->getParentOp();
+  SetVector<Operation *> deps;
+  SmallVector<Operation *> worklist{core};
+  for (BufferOp buffer : initializedBuffers.lookup(core.getTileOp()))
+    worklist.push_back(buffer);
+
+  while (!worklist.empty()) {
+    Operation *op = worklist.pop_back_val();
+    if (!deps.insert(op))
+      continue;
+    SetVector<Value> used(op->operand_begin(), op->operand_end());
+    for (Region &region : op->getRegions())
+      getUsedValuesDefinedAbove(region, used);
+    for (Value value : used)
+      if (Operation *def = value.getDefiningOp();
+          def && def->getParentOp() == device)
+        worklist.push_back(def);
+    auto uses = SymbolTable::getSymbolUses(op);
+    if (!uses)
+      continue;
+    for (const SymbolTable::SymbolUse &use : *uses) {
+      StringAttr name = use.getSymbolRef().getRootReference();
+      for (SymbolTable *symbolTable : symbolTables)
+        if (Operation *symbol = symbolTable->lookup(name)) {
+          worklist.push_back(symbol);
+          break;
+        }
+    }
+  }
+
+  // Operations of the enclosing module come first, then those of the device.
+  SmallVector<Operation *> ordered = deps.takeVector();
+  llvm::sort(ordered, [&](Operation *a, Operation *b) {
+    if (a->getBlock() != b->getBlock())
+      return a->getParentOp() != device;
+    return a->isBeforeInBlock(b);
+  });
+  return ordered;
+}
+
 struct AIECoreToStandardPass : AIECoreToStandardBase<AIECoreToStandardPass> {
   void runOnOperation() override {
 
     ModuleOp m = getOperation();
-    OpBuilder builder = OpBuilder::atBlockEnd(m.getBody());
 
     if (m.getOps<DeviceOp>().empty()) {
       m.emitOpError("expected AIE.device operation at toplevel");
       return signalPassFailure();
     }
     DeviceOp device = *m.getOps<DeviceOp>().begin();
-    const auto &targetModel = device.getTargetModel();
 
-    // Ensure that we don't have an incorrect target triple.  This may override
-    // some bogus target triple in the original mlir.
-    m->setAttr(LLVM::LLVMDialect::getTargetTripleAttrName(),
-               builder.getStringAttr(
-                   getArchIntrinsicString(targetModel.getTargetArch())));
-
-    DenseMap<Operation *, SmallVector<BufferOp, 4>> tileToBuffers;
-
-    // Populate intrinsic functions
-    // Intrinsic information:
-    // peano/llvm-project/llvm/lib/Target/AIE/AIEInstrInfo.td Also take a look
-    // at the tests: peano/llvm-project/llvm/test/CodeGen/AIE
-    builder.setInsertionPointToStart(m.getBody());
-    declareAIEIntrinsics(targetModel.getTargetArch(), builder);
-
-    IRMapping mapper;
-    ConversionTarget target(getContext());
-    target.addLegalDialect<func::FuncDialect>();
-    target.addLegalDialect<cf::ControlFlowDialect>();
-    target.addLegalDialect<memref::MemRefDialect>();
-    target.addLegalDialect<VectorDialect>();
-    target.addLegalDialect<arith::ArithDialect>();
-    target.addLegalDialect<math::MathDialect>();
-    target.addLegalOp<func::FuncOp, ModuleOp>();
-
-    RewritePatternSet patterns(&getContext());
-    patterns.add<AIEPutStreamToStdLowering, AIEGetStreamToStdLowering,
-                 AIEPutCascadeToStdLowering, AIEGetCascadeToStdLowering,
-                 AIEDebugOpToStdLowering, AIEUseLockToStdLowering,
-                 AIEEventOpToStdLowering>(m.getContext(), m);
-
-    patterns.add<AIEBufferToStandard>(m.getContext(), m, /*benefit*/ 1, tileCol,
-                                      tileRow);
-    if (failed(applyPartialConversion(m, target, std::move(patterns))))
-      return signalPassFailure();
+    if (!splitCores) {
+      if (failed(lowerDevice(m, device, tileCol, tileRow)))
+        signalPassFailure();
+      return;
+    }
 
-    RewritePatternSet outlinePatterns(&getContext());
-    outlinePatterns.add<AIECoreToStandardFunc>(m.getContext(), m, mapper,
-                                               tileToBuffers, /*benefit*/ 1,
-                                               tileCol, tileRow);
-    if (failed(applyPartialConversion(m, target, std::move(outlinePatterns))))
-      return signalPassFailure();
+    // Copy every core, with what it depends on, into a device of its own
+    // module.  Only this step walks the shared device, so the cores can then
+    // be lowered independently of each other and of the size of the design.
+    SymbolTable deviceSymbols(device);
+    SymbolTable moduleSymbols(m);
+    SmallVector<SymbolTable *, 2> symbolTables{&deviceSymbols, &moduleSymbols};
+    DenseMap<Operation *, SmallVector<BufferOp, 4>> initializedBuffers;
+    for (BufferOp buffer : device.getOps<BufferOp>())
+      if (buffer.getInitialValueAttr())
+        initializedBuffers[buffer.getTile().getDefiningOp()].push_back(buffer);
+
+    SmallVector<ModuleOp> coreModules;
+    OpBuilder builder = OpBuilder::atBlockEnd(m.getBody());
+    for (CoreOp core : device.getOps<CoreOp>()) {
+      std::string coreName("core_" + std::to_string(core.colIndex()) + "_" +
+                           std::to_string(core.rowIndex()));
+      builder.setInsertionPointToEnd(m.getBody());
+      auto coreModule =
+          builder.create<ModuleOp>(core.getLoc(), StringRef(coreName));
+      OpBuilder moduleBuilder = OpBuilder::atBlockEnd(coreModule.getBody());
+      Operation *coreDevice = device->cloneWithoutRegions();
+      OpBuilder deviceBuilder = OpBuilder::atBlockEnd(
+          &coreDevice->getRegion(0).emplaceBlock());
+      IRMapping mapper;
+      for (Operation *op :
+           getCoreDependencies(core, symbolTables, initializedBuffers)) {
+        if (op->getParentOp() == device)
+          deviceBuilder.clone(*op, mapper);
+        else
+          moduleBuilder.clone(*op, mapper);
+      }
+      moduleBuilder.insert(coreDevice);
+      coreModules.push_back(coreModule);
+    }
 
-    // Move all the func.func ops and memref.globals from the device to the
-    // module
-    outlineOps<memref::GlobalOp>(device);
-    outlineOps<func::FuncOp>(device);
-
-    RewritePatternSet removepatterns(&getContext());
-    removepatterns.add<
-        AIEOpRemoval<DeviceOp>, AIEOpRemoval<TileOp>, AIEOpRemoval<FlowOp>,
-        AIEOpRemoval<MemOp>, AIEOpRemoval<ShimDMAOp>, AIEOpRemoval<ShimMuxOp>,
-        AIEOpRemoval<SwitchboxOp>, AIEOpRemoval<LockOp>, AIEOpRemoval<BufferOp>,
-        AIEOpRemoval<ExternalBufferOp>, AIEOpRemoval<ShimDMAAllocationOp>,
-        AIEOpRemoval<CascadeFlowOp>, AIEOpRemoval<ConfigureCascadeOp>>(
-        m.getContext(), m);
-
-    if (failed(applyPartialConversion(m, target, std::move(removepatterns))))
-      return signalPassFailure();
+    m->setAttr(LLVM::LLVMDialect::getTargetTripleAttrName(),
+               builder.getStringAttr(getArchIntrinsicString(
+                   device.getTargetModel().getTargetArch())));
+    device.erase();
+
+    if (failed(failableParallelForEach(
+            &getContext(), coreModules, [](ModuleOp coreModule) {
+              auto coreDevice = *coreModule.getOps<DeviceOp>().begin();
+              CoreOp core = *coreDevice.getOps<CoreOp>().begin();
+              return lowerDevice(coreModule, coreDevice, core.colIndex(),
+                                 core.rowIndex());
+            })))
+      signalPassFailure();
   }
 };
 
@@ -8,6 +8,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "aie/Dialect/AIE/IR/AIEDeviceIndex.h"
 #include "aie/Dialect/AIE/IR/AIEDialect.h"
 #include "aie/Dialect/AIE/Transforms/AIEPasses.h"
 
@@ -255,32 +256,22 @@ void buildPSRoute(
       std::make_pair(Connect{lastPort, destPort}, flowID));
 }
 
-SwitchboxOp getOrCreateSwitchbox(OpBuilder &builder, TileOp tile) {
-  for (auto i : tile.getResult().getUsers()) {
-    if (llvm::isa<SwitchboxOp>(*i)) {
-      return llvm::cast<SwitchboxOp>(*i);
-    }
-  }
-  return builder.create<SwitchboxOp>(builder.getUnknownLoc(), tile);
-}
 struct AIERoutePacketFlowsPass
     : AIERoutePacketFlowsBase<AIERoutePacketFlowsPass> {
+  AIEDeviceIndex *index = nullptr;
   // Map from tile coordinates to TileOp
   DenseMap<TileID, Operation *> tiles;
   Operation *getOrCreateTile(OpBuilder &builder, int col, int row) {
-    TileID index = {col, row};
-    Operation *tileOp = tiles[index];
-    if (!tileOp) {
-      auto tile = builder.create<TileOp>(builder.getUnknownLoc(), col, row);
-      tileOp = tile.getOperation();
-      tiles[index] = tileOp;
-    }
+    Operation *&tileOp = tiles[{col, row}];
+    if (!tileOp)
+      tileOp = index->getOrCreateTile(builder, col, row);
     return tileOp;
   }
   void runOnOperation() override {
 
     DeviceOp device = getOperation();
     OpBuilder builder = OpBuilder::atBlockEnd(device.getBody());
+    index = &getAnalysis<AIEDeviceIndex>();
 
     ConversionTarget target(getContext());
 
@@ -600,7 +591,7 @@ struct AIERoutePacketFlowsPass
 
       // Create a switchbox for the routes and insert inside it.
       builder.setInsertionPointAfter(tileOp);
-      SwitchboxOp swbox = getOrCreateSwitchbox(builder, tile);
+      SwitchboxOp swbox = index->getOrCreateSwitchbox(builder, tile);
       SwitchboxOp::ensureTerminator(swbox.getConnections(), builder,
                                     builder.getUnknownLoc());
       Block &b = swbox.getConnections().front();
@@ -214,6 +214,27 @@ void AIEPathfinderPass::runOnOperation() {
   if (failed(applyPartialConversion(d, target, std::move(patterns))))
     return signalPassFailure();
 
+  if (clAnnotateCongestion) {
+    std::map<TileID, SmallVector<Attribute>> congestion;
+    for (const Channel *ch : analyzer.pathfinder->getChannels())
+      congestion[ch->src].push_back(builder.getDictionaryAttr({
+          builder.getNamedAttr(
+              "bundle", builder.getStringAttr(stringifyWireBundle(ch->bundle))),
+          builder.getNamedAttr("max_capacity",
+                               builder.getI32IntegerAttr(ch->maxCapacity)),
+          builder.getNamedAttr("used_capacity",
+                               builder.getI32IntegerAttr(ch->usedCapacity)),
+          builder.getNamedAttr("demand", builder.getF64FloatAttr(ch->demand)),
+          builder.getNamedAttr(
+              "over_capacity_count",
+              builder.getI32IntegerAttr(ch->overCapacityCount)),
+      }));
+    for (auto &[coords, channels] : congestion)
+      if (analyzer.coordToSwitchbox.count(coords))
+        analyzer.coordToSwitchbox[coords]->setAttr(
+            "aie.congestion", builder.getArrayAttr(channels));
+  }
+
   // Populate wires between switchboxes and tiles.
   for (int col = 0; col <= analyzer.getMaxCol(); col++) {
     for (int row = 0; row <= analyzer.getMaxRow(); row++) {
@@ -0,0 +1,386 @@
+//===- AIEEstimateCycles.cpp ------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// This pass statically estimates the number of cycles taken by the code of
+// each core. The ops of a block are assigned to the VLIW slots they issue in
+// (loads, stores, vector, moves, scalar); the busiest slot bounds the number
+// of instruction bundles the block needs. Loops are assumed to be software
+// pipelined, so their cost is the trip count times the bound of the body plus
+// one pipeline fill. Trip counts come from constant bounds or, failing that,
+// from the aie.loop_range hint (chess_loop_range) of aie-loop-hints. Lock
+// acquires/releases, calls and conditionals do not overlap with the
+// surrounding code. The estimate is attached to the cores,
+// loops and called functions as attributes.
+
+#include "aie/Dialect/AIE/IR/AIEDialect.h"
+#include "aie/Dialect/AIE/Transforms/AIEPasses.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Interfaces/LoopLikeInterface.h"
+#include "mlir/Pass/Pass.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#define DEBUG_TYPE "aie-estimate-cycles"
+
+using namespace mlir;
+using namespace xilinx;
+using namespace xilinx::AIE;
+
+namespace {
+
+// Issue width and latencies of a core. The numbers are coarse: they are meant
+// to compare design alternatives, not to replace the simulator.
+struct CoreCycleModel {
+  // Number of ops that can issue per cycle in each slot.
+  unsigned loadSlots;
+  unsigned storeSlots;
+  unsigned vectorSlots;
+  unsigned moveSlots;
+  unsigned scalarSlots;
+  // Width of a load/store port, in bits. Wider accesses take several slots.
+  unsigned memoryPortBits;
+  // Latency of the longest vector and load pipelines; paid once per loop to
+  // fill the software pipeline.
+  unsigned vectorLatency;
+  unsigned loadLatency;
+  // Cycles spent on each lock acquire or release, assuming no contention.
+  unsigned lockCycles;
+  // Cycles spent on a call/return and on entering a loop.
+  unsigned callCycles;
+  unsigned loopSetupCycles;
+
+  static CoreCycleModel get(AIEArch arch) {
+    if (arch == AIEArch::AIE2)
+      return {2, 1, 1, 2, 1, 256, 6, 7, 3, 6, 3};
+    return {2, 1, 1, 2, 1, 256, 5, 5, 3, 6, 3};
+  }
+};
+
+enum class Slot { Load, Store, Vector, Move, Scalar, None };
+
+StringRef stringifySlot(Slot slot) {
+  switch (slot) {
+  case Slot::Load:
+    return "load";
+  case Slot::Store:
+    return "store";
+  case Slot::Vector:
+    return "vector";
+  case Slot::Move:
+    return "move";
+  case Slot::Scalar:
+    return "scalar";
+  case Slot::None:
+    break;
+  }
+  return "none";
+}
+
+// Number of bits accessed by a load or store of `type`.
+unsigned getAccessBits(Type type) {
+  if (auto shaped = dyn_cast<ShapedType>(type))
+    if (shaped.hasStaticShape())
+      return shaped.getNumElements() * shaped.getElementTypeBitWidth();
+  return type.isIntOrFloat() ? type.getIntOrFloatBitWidth() : 32;
+}
+
+// The ops of the aievec and xllvm dialects are recognized by name so that this
+// pass does not depend on those dialects.
+Slot getVectorDialectSlot(Operation *op) {
+  StringRef name = op->getName().stripDialect();
+  if (name == "upd")
+    return Slot::Load;
+  if (name == "cast")
+    return Slot::None;
+  for (StringRef move : {"select", "shift", "ext", "concat", "shuffle",
+                         "broadcast", "pack", "unpack", "srs", "ups", "set",
+                         "vshift", "vextract", "vbroadcast", "vinsert"})
+    if (name == move || name.starts_with(move.str() + "_") ||
+        name.starts_with("intr.aie2." + move.str()))
+      return Slot::Move;
+  return Slot::Vector;
+}
+
+Slot getSlot(Operation *op) {
+  if (op->hasTrait<OpTrait::ConstantLike>() ||
+      op->hasTrait<OpTrait::IsTerminator>())
+    return Slot::None;
+  StringRef dialect = op->getName().getDialectNamespace();
+  if (dialect == "aievec" || dialect == "xllvm")
+    return getVectorDialectSlot(op);
+  StringRef name = op->getName().stripDialect();
+  if (name.ends_with("load") || name == "transfer_read")
+    return Slot::Load;
+  if (name.ends_with("store") || name == "transfer_write")
+    return Slot::Store;
+  // Views and casts are folded into the addressing of the accesses.
+  if (dialect == "memref" || isa<arith::IndexCastOp, arith::BitcastOp>(op))
+    return Slot::None;
+  if (llvm::any_of(op->getResultTypes(),
+                   [](Type type) { return isa<VectorType>(type); }))
+    return Slot::Vector;
+  return Slot::Scalar;
+}
+
+// The number of iterations of a loop with constant bounds.
+std::optional<uint64_t> getTripCount(LoopLikeOpInterface loop) {
+  auto lb = loop.getSingleLowerBound();
+  auto ub = loop.getSingleUpperBound();
+  auto step = loop.getSingleStep();
+  if (!lb || !ub || !step)
+    return std::nullopt;
+  auto lbValue = getConstantIntValue(*lb);
+  auto ubValue = getConstantIntValue(*ub);
+  auto stepValue = getConstantIntValue(*step);
+  if (!lbValue || !ubValue || !stepValue || *stepValue <= 0)
+    return std::nullopt;
+  if (*ubValue <= *lbValue)
+    return 0;
+  return llvm::divideCeil(*ubValue - *lbValue, *stepValue);
+}
+
+// The trip count assumed for a loop with a `aie.loop_range = array<i64: min[,
+// max]>` hint: the middle of the range, or its minimum if it is open.
+std::optional<uint64_t> getHintedTripCount(Operation *loop) {
+  auto range = loop->getAttrOfType<DenseI64ArrayAttr>("aie.loop_range");
+  if (!range || range.empty() || range.size() > 2 || range[0] < 0)
+    return std::nullopt;
+  if (range.size() == 1)
+    return range[0];
+  if (range[1] < range[0])
+    return std::nullopt;
+  return range[0] + llvm::divideCeil(range[1] - range[0], 2);
+}
+
+class CycleEstimator {
+public:
+  CycleEstimator(const CoreCycleModel &model, uint64_t defaultTripCount,
+                 bool report)
+      : model(model), defaultTripCount(defaultTripCount), report(report) {}
+
+  // Estimate the cycles of one execution of `region`.
+  uint64_t estimateRegion(Region &region) {
+    uint64_t cycles = 0;
+    for (Block &block : region)
+      cycles = llvm::SaturatingAdd(cycles, estimateBlock(block));
+    return cycles;
+  }
+
+  // Statistics of the code estimated since the last reset. Functions are
+  // estimated once; every call adds their statistics to those of the caller.
+  uint64_t getNumLockOps() const { return numLockOps; }
+  ArrayRef<std::string> getExternalCallees() const { return externalCallees; }
+  void resetStats() {
+    numLockOps = 0;
+    externalCallees.clear();
+  }
+
+private:
+  uint64_t estimateBlock(Block &block) {
+    // Slot usage of the ops that issue in parallel, and the cycles of the
+    // ops that do not overlap with them.
+    uint64_t usage[5] = {0, 0, 0, 0, 0};
+    uint64_t serial = 0;
+    for (Operation &op : block) {
+      if (std::optional<uint64_t> cycles = estimateSerialOp(&op)) {
+        serial = llvm::SaturatingAdd(serial, *cycles);
+        continue;
+      }
+      Slot slot = getSlot(&op);
+      if (slot == Slot::None)
+        continue;
+      uint64_t issues = 1;
+      if (slot == Slot::Load && op.getNumResults() == 1)
+        issues = llvm::divideCeil(getAccessBits(op.getResult(0).getType()),
+                                  model.memoryPortBits);
+      else if (slot == Slot::Store && op.getNumOperands() > 0)
+        issues = llvm::divideCeil(getAccessBits(op.getOperand(0).getType()),
+                                  model.memoryPortBits);
+      usage[static_cast<unsigned>(slot)] += issues;
+    }
+
+    auto [bound, boundSlot] = getIssueBound(usage);
+    lastBoundSlot = boundSlot;
+    return llvm::SaturatingAdd(bound, serial);
+  }
+
+  std::pair<uint64_t, Slot> getIssueBound(const uint64_t (&usage)[5]) {
+    unsigned widths[5] = {model.loadSlots, model.storeSlots, model.vectorSlots,
+                          model.moveSlots, model.scalarSlots};
+    uint64_t bound = 0;
+    Slot boundSlot = Slot::None;
+    for (unsigned i = 0; i < 5; ++i) {
+      uint64_t cycles = llvm::divideCeil(usage[i], widths[i]);
+      if (cycles > bound) {
+        bound = cycles;
+        boundSlot = static_cast<Slot>(i);
+      }
+    }
+    return {bound, boundSlot};
+  }
+
+  // Return the cycles of an op that does not issue in parallel with its
+  // neighbours, or std::nullopt if it does.
+  std::optional<uint64_t> estimateSerialOp(Operation *op) {
+    if (isa<UseLockOp>(op)) {
+      numLockOps++;
+      return model.lockCycles;
+    }
+    if (auto loop = dyn_cast<LoopLikeOpInterface>(op);
+        loop && op->getNumRegions() == 1)
+      return estimateLoop(loop);
+    if (auto ifOp = dyn_cast<scf::IfOp>(op)) {
+      uint64_t thenCycles = estimateRegion(ifOp.getThenRegion());
+      uint64_t elseCycles = estimateRegion(ifOp.getElseRegion());
+      return 1 + std::max(thenCycles, elseCycles);
+    }
+    if (auto callOp = dyn_cast<func::CallOp>(op))
+      return llvm::SaturatingAdd<uint64_t>(model.callCycles,
+                                           estimateCall(callOp));
+    if (op->getNumRegions() > 0) {
+      uint64_t cycles = 0;
+      for (Region &region : op->getRegions())
+        cycles = llvm::SaturatingAdd(cycles, estimateRegion(region));
+      return cycles;
+    }
+    return std::nullopt;
+  }
+
+  uint64_t estimateLoop(LoopLikeOpInterface loop) {
+    Operation *op = loop.getOperation();
+    std::optional<uint64_t> tripCount = getTripCount(loop);
+    std::optional<uint64_t> hintedTripCount;
+    if (!tripCount)
+      hintedTripCount = getHintedTripCount(op);
+    uint64_t perIteration = estimateRegion(op->getRegion(0));
+    Slot boundSlot = lastBoundSlot;
+    uint64_t fill = model.loopSetupCycles;
+    op->walk([&](Operation *nested) {
+      Slot slot = getSlot(nested);
+      if (slot == Slot::Vector)
+        fill = std::max<uint64_t>(fill, model.vectorLatency);
+      else if (slot == Slot::Load)
+        fill = std::max<uint64_t>(fill, model.loadLatency);
+    });
+    uint64_t cycles = llvm::SaturatingAdd(
+        llvm::SaturatingMultiply(
+            tripCount.value_or(hintedTripCount.value_or(defaultTripCount)),
+            perIteration),
+        fill);
+
+    MLIRContext *ctx = op->getContext();
+    op->setAttr("aie.estimated_cycles_per_iteration",
+                IntegerAttr::get(IntegerType::get(ctx, 64), perIteration));
+    op->setAttr("aie.estimated_cycles",
+                IntegerAttr::get(IntegerType::get(ctx, 64), cycles));
+    if (report) {
+      InFlightDiagnostic remark = op->emitRemark("loop: ");
+      if (tripCount) {
+        remark << *tripCount;
+      } else if (hintedTripCount) {
+        auto range = op->getAttrOfType<DenseI64ArrayAttr>("aie.loop_range");
+        if (range.size() > 1)
+          remark << "range " << range[0] << "-" << range[1];
+        else
+          remark << "at least " << range[0];
+        remark << " (assumed " << *hintedTripCount << ")";
+      } else {
+        remark << "unknown (assumed " << defaultTripCount << ")";
+      }
+      remark << " iterations x " << perIteration << " cycles";
+      if (boundSlot != Slot::None)
+        remark << " (" << stringifySlot(boundSlot) << " bound)";
+      remark << " = " << cycles << " cycles";
+    }
+    return cycles;
+  }
+
+  uint64_t estimateCall(func::CallOp callOp) {
+    auto callee = SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(
+        callOp, callOp.getCalleeAttr());
+    if (!callee || callee.isExternal()) {
+      externalCallees.push_back(callOp.getCallee().str());
+      return 0;
+    }
+    auto it = funcSummaries.find(callee);
+    if (it == funcSummaries.end()) {
+      // Recursive calls are not followed.
+      funcSummaries[callee] = FuncSummary();
+      uint64_t callerLockOps = std::exchange(numLockOps, 0);
+      SmallVector<std::string> callerExternalCallees =
+          std::exchange(externalCallees, {});
+      FuncSummary summary;
+      summary.cycles = estimateRegion(callee.getBody());
+      summary.numLockOps = std::exchange(numLockOps, callerLockOps);
+      summary.externalCallees =
+          std::exchange(externalCallees, std::move(callerExternalCallees));
+      callee->setAttr(
+          "aie.estimated_cycles",
+          IntegerAttr::get(IntegerType::get(callee.getContext(), 64),
+                           summary.cycles));
+      it = funcSummaries.insert_or_assign(callee, std::move(summary)).first;
+    }
+    numLockOps += it->second.numLockOps;
+    externalCallees.append(it->second.externalCallees.begin(),
+                           it->second.externalCallees.end());
+    return it->second.cycles;
+  }
+
+  // What one call of a function costs, including its callees.
+  struct FuncSummary {
+    uint64_t cycles = 0;
+    uint64_t numLockOps = 0;
+    SmallVector<std::string> externalCallees;
+  };
+
+  const CoreCycleModel &model;
+  uint64_t defaultTripCount;
+  bool report;
+  Slot lastBoundSlot = Slot::None;
+  uint64_t numLockOps = 0;
+  SmallVector<std::string> externalCallees;
+  DenseMap<Operation *, FuncSummary> funcSummaries;
+};
+
+} // namespace
+
+struct AIEEstimateCyclesPass : AIEEstimateCyclesBase<AIEEstimateCyclesPass> {
+  void runOnOperation() override {
+    DeviceOp device = getOperation();
+    CoreCycleModel model =
+        CoreCycleModel::get(device.getTargetModel().getTargetArch());
+
+    CycleEstimator estimator(model, clDefaultTripCount, clReport);
+    for (CoreOp core : device.getOps<CoreOp>()) {
+      estimator.resetStats();
+      uint64_t cycles = estimator.estimateRegion(core.getBody());
+      core->setAttr("aie.estimated_cycles",
+                    IntegerAttr::get(IntegerType::get(&getContext(), 64),
+                                     cycles));
+      if (!clReport)
+        continue;
+      InFlightDiagnostic remark = core.emitRemark("core (")
+                                  << core.colIndex() << ", "
+                                  << core.rowIndex() << "): " << cycles
+                                  << " cycles, " << estimator.getNumLockOps()
+                                  << " lock operations";
+      for (const std::string &callee : estimator.getExternalCallees())
+        remark << ", external call to @" << callee << " not estimated";
+    }
+  }
+};
+
+std::unique_ptr<OperationPass<DeviceOp>> AIE::createAIEEstimateCyclesPass() {
+  return std::make_unique<AIEEstimateCyclesPass>();
+}
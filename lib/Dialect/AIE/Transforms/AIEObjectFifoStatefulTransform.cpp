@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "aie/Dialect/AIE/IR/AIEDeviceIndex.h"
 #include "aie/Dialect/AIE/IR/AIEDialect.h"
 #include "aie/Dialect/AIE/Transforms/AIEPasses.h"
 
@@ -40,22 +41,22 @@ using namespace xilinx::AIE;
 // Lock Analysis
 //===----------------------------------------------------------------------===//
 class LockAnalysis {
+  const AIEDeviceIndex &index;
   DenseMap<std::pair<Value, int>, int> locksPerTile;
+  DenseSet<Value> visitedTiles;
 
 public:
-  LockAnalysis(DeviceOp &device) {
-    // go over the locks created for each tile and update the index in
-    // locksPerTile
-    for (auto lockOp : device.getOps<LockOp>()) {
-      auto tile = lockOp.getTile();
-      auto lockID = lockOp.getLockIDValue();
-      locksPerTile[{tile, lockID}] = 1;
-    }
-  }
+  LockAnalysis(const AIEDeviceIndex &index) : index(index) {}
 
   /// Given a tile, returns next usable lockID for that tile.
   int getLockID(TileOp &tileOp) {
-    const auto &targetModel = getTargetModel(tileOp);
+    // The first time a tile is seen, mark the locks it already has as used.
+    if (visitedTiles.insert(tileOp).second)
+      for (auto lockOp : index.getLocks(tileOp.getTileID()))
+        if (auto lockID = lockOp.getLockID())
+          locksPerTile[{tileOp, *lockID}] = 1;
+
+    const auto &targetModel = index.getTargetModel();
     for (unsigned i = 0;
          i < targetModel.getNumLocks(tileOp.getCol(), tileOp.getRow()); i++)
       if (int usageCnt = locksPerTile[{tileOp, i}]; usageCnt == 0) {
@@ -70,43 +71,43 @@ public:
 // TileDMA Channel Analysis
 //===----------------------------------------------------------------------===//
 class DMAChannelAnalysis {
+  const AIEDeviceIndex &index;
   DenseMap<Value, int> masterChannelsPerTile;
   DenseMap<Value, int> slaveChannelsPerTile;
 
-public:
-  DMAChannelAnalysis(DeviceOp &device) {
-    // go over the channels used for each tile and update the master/slave
-    // channel maps
-    for (auto memOp : device.getOps<MemOp>()) {
-      Region &r = memOp.getBody();
-      for (auto &bl : r.getBlocks()) {
-        for (auto op : bl.getOps<DMAStartOp>()) {
-          if (op.isSend())
-            getMasterDMAChannel(memOp.getTile());
-          else
-            getSlaveDMAChannel(memOp.getTile());
-        }
-      }
-    }
+  /// Returns the number of channels in direction `dir` that the MemOp of
+  /// `tile` uses before the transform.
+  int getNumUsedChannels(Value tile, DMAChannelDir dir) {
+    TileID id = tile.getDefiningOp<TileOp>().getTileID();
+    if (!isa_and_nonnull<MemOp>(index.getDMA(id)))
+      return 0;
+    return llvm::count_if(index.getDMAStarts(id), [&](DMAStartOp op) {
+      return op.getChannelDir() == dir;
+    });
   }
 
+public:
+  DMAChannelAnalysis(const AIEDeviceIndex &index) : index(index) {}
+
   /// Given an AIE tile, returns its next usable master channel.
   DMAChannel getMasterDMAChannel(Value tile) {
-    if (masterChannelsPerTile.find(tile) == masterChannelsPerTile.end())
-      masterChannelsPerTile[tile] = 0;
+    auto [it, inserted] = masterChannelsPerTile.try_emplace(tile, 0);
+    if (inserted)
+      it->second = getNumUsedChannels(tile, DMAChannelDir::MM2S);
     else
-      masterChannelsPerTile[tile]++;
-    DMAChannel dmaChan = {DMAChannelDir::MM2S, masterChannelsPerTile[tile]};
+      it->second++;
+    DMAChannel dmaChan = {DMAChannelDir::MM2S, it->second};
     return dmaChan;
   }
 
   /// Given an AIE tile, returns its next usable slave channel.
   DMAChannel getSlaveDMAChannel(Value tile) {
-    if (slaveChannelsPerTile.find(tile) == slaveChannelsPerTile.end())
-      slaveChannelsPerTile[tile] = 0;
+    auto [it, inserted] = slaveChannelsPerTile.try_emplace(tile, 0);
+    if (inserted)
+      it->second = getNumUsedChannels(tile, DMAChannelDir::S2MM);
     else
-      slaveChannelsPerTile[tile]++;
-    DMAChannel dmaChan = {DMAChannelDir::S2MM, slaveChannelsPerTile[tile]};
+      it->second++;
+    DMAChannel dmaChan = {DMAChannelDir::S2MM, it->second};
     return dmaChan;
   }
 };
@@ -1186,8 +1187,9 @@ struct AIEObjectFifoStatefulTransformPass
 
   void runOnOperation() override {
     DeviceOp device = getOperation();
-    LockAnalysis lockAnalysis(device);
-    DMAChannelAnalysis dmaAnalysis(device);
+    const auto &deviceIndex = getAnalysis<AIEDeviceIndex>();
+    LockAnalysis lockAnalysis(deviceIndex);
+    DMAChannelAnalysis dmaAnalysis(deviceIndex);
     OpBuilder builder = OpBuilder::atBlockEnd(device.getBody());
     auto ctx = device->getContext();
     std::set<TileOp>
@@ -0,0 +1,586 @@
+//===- AIEPlaceTiles.cpp ----------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// This pass places the tiles marked `aie.unplaced` by simulated annealing.
+// Every tile of the device is a node of a netlist: objectFifos, flows and
+// packet flows are weighted nets, and shared buffers and cascade flows are
+// pairs of nodes that must be neighbours. The cost of a placement is the
+// weighted half-perimeter wirelength of the nets, plus a penalty larger than
+// any wirelength for each violated constraint, so that the search first
+// looks for a legal placement and then for a short one. A move only updates
+// the terms of the cost that involve the tiles it moves.
+
+#include "aie/Dialect/AIE/IR/AIEDialect.h"
+#include "aie/Dialect/AIE/Transforms/AIEPasses.h"
+
+#include "mlir/Pass/Pass.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#define DEBUG_TYPE "aie-place-tiles"
+
+using namespace mlir;
+using namespace xilinx;
+using namespace xilinx::AIE;
+
+static constexpr StringLiteral unplacedAttrName = "aie.unplaced";
+
+namespace {
+
+enum class TileKind { Core, Mem, Shim };
+
+struct PlacementNode {
+  TileOp tile;
+  TileKind kind;
+  bool movable;
+  // Bytes of the aie.buffers of the tile and of its memory.
+  uint64_t bufferBytes = 0;
+  uint64_t capacity = 0;
+};
+
+// An objectFifo, flow or packet flow from nodes[0] to the other nodes.
+struct PlacementNet {
+  SmallVector<unsigned, 2> nodes;
+  uint64_t weight = 1;
+  // For objectFifos: whether the producer and consumer may share a memory
+  // module instead of using DMAs, the bytes of an element and the depth of
+  // each endpoint.
+  bool isObjectFifo = false;
+  bool shareable = false;
+  uint64_t elementBytes = 0;
+  SmallVector<int64_t, 2> depths;
+};
+
+// The core of `core` accesses the memory of `memory`, or a cascade connects
+// the two.
+struct PlacementPair {
+  unsigned core, memory;
+  bool cascade;
+};
+
+class TilePlacer {
+public:
+  TilePlacer(DeviceOp device, unsigned seed)
+      : targetModel(device.getTargetModel()), rng(seed) {
+    build(device);
+  }
+
+  unsigned getNumMovable() const { return movable.size(); }
+
+  // Check that the unplaced tiles fit the free tiles of their kind.
+  LogicalResult initialize(DeviceOp device);
+
+  // Anneal and keep the best placement found; return whether it is legal.
+  bool anneal(unsigned movesPerTile);
+
+  void apply() {
+    for (unsigned node : movable) {
+      TileOp tile = nodes[node].tile;
+      OpBuilder builder(tile);
+      tile.setColAttr(builder.getI32IntegerAttr(positions[node].col));
+      tile.setRowAttr(builder.getI32IntegerAttr(positions[node].row));
+      tile->removeAttr(unplacedAttrName);
+    }
+  }
+
+private:
+  void build(DeviceOp device);
+  unsigned nodeOf(Value tile) const {
+    return nodeIndex.lookup(tile.getDefiningOp());
+  }
+
+  bool canShare(unsigned a, unsigned b) const;
+  double getCost() const { return wirelength + penalty * violations; }
+  // Compute the cost of the current placement from scratch.
+  void resetCost();
+  // Add (sign 1) or remove (sign -1) the wirelength of `net` and the
+  // memory and DMA channels it uses in each tile.
+  void updateNet(const PlacementNet &net, int sign);
+  unsigned getNodeViolations(unsigned node) const;
+  bool isViolated(const PlacementPair &pair) const;
+  // Collect the nets, pairs and nodes whose cost terms depend on the
+  // position of `moved`, and add or remove those terms.
+  void collectTerms(ArrayRef<unsigned> moved);
+  void updateTerms(int sign);
+
+  // Move `node` to `slot`, swapping it with the unplaced tile there if any.
+  void move(unsigned node, TileID slot);
+  // Move `node` to `slot` and update the cost.
+  void moveAndUpdate(unsigned node, TileID slot);
+
+  uint32_t random(uint32_t n) { return rng() % n; }
+  double randomUnit() { return rng() / 4294967296.0; }
+
+  const AIETargetModel &targetModel;
+  std::mt19937 rng;
+  SmallVector<PlacementNode> nodes;
+  SmallVector<PlacementNet> nets;
+  SmallVector<PlacementPair> pairs;
+  DenseMap<Operation *, unsigned> nodeIndex;
+  SmallVector<unsigned> movable;
+  // The nets and pairs each node is part of.
+  SmallVector<SmallVector<unsigned, 4>> netsOf, pairsOf;
+
+  SmallVector<TileID> positions;
+  DenseMap<TileID, unsigned> occupant;
+  // The tiles of each kind not taken by a fixed tile.
+  SmallVector<TileID> slots[3];
+  double penalty = 1;
+
+  // The cost of the current placement: the weighted wirelength, the number
+  // of violations, and the bytes and DMA channels used in each tile.
+  double wirelength = 0;
+  int64_t violations = 0;
+  SmallVector<uint64_t> bytes;
+  SmallVector<unsigned> mm2s, s2mm;
+  // The terms collected for the current move, and the last move each net,
+  // pair and node was collected for.
+  SmallVector<unsigned> termNets, termPairs, termNodes;
+  SmallVector<unsigned> netEpoch, pairEpoch, nodeEpoch;
+  unsigned epoch = 0;
+};
+
+} // namespace
+
+void TilePlacer::build(DeviceOp device) {
+  for (TileOp tile : device.getOps<TileOp>()) {
+    PlacementNode node;
+    node.tile = tile;
+    int col = tile.getCol(), row = tile.getRow();
+    node.kind = targetModel.isShimNOCorPLTile(col, row) ? TileKind::Shim
+                : targetModel.isMemTile(col, row)       ? TileKind::Mem
+                                                        : TileKind::Core;
+    node.movable = tile->hasAttr(unplacedAttrName);
+    switch (node.kind) {
+    case TileKind::Core:
+      node.capacity = targetModel.getLocalMemorySize();
+      if (CoreOp core = tile.getCoreOp())
+        node.capacity -= std::min<uint64_t>(core.getStackSize(), node.capacity);
+      break;
+    case TileKind::Mem:
+      node.capacity = targetModel.getMemTileSize();
+      break;
+    case TileKind::Shim:
+      node.capacity = std::numeric_limits<uint64_t>::max();
+      break;
+    }
+    nodeIndex[tile] = nodes.size();
+    if (node.movable)
+      movable.push_back(nodes.size());
+    positions.push_back(tile.getTileID());
+    nodes.push_back(node);
+  }
+
+  for (BufferOp buffer : device.getOps<BufferOp>())
+    nodes[nodeOf(buffer.getTile())].bufferBytes += buffer.getAllocationSize();
+
+  // The objectFifos that are part of a link always use DMAs.
+  DenseSet<Operation *> linked;
+  for (ObjectFifoLinkOp link : device.getOps<ObjectFifoLinkOp>()) {
+    for (ObjectFifoCreateOp fifo : link.getInputObjectFifos())
+      linked.insert(fifo);
+    for (ObjectFifoCreateOp fifo : link.getOutputObjectFifos())
+      linked.insert(fifo);
+  }
+
+  uint64_t totalWeight = 0;
+  for (ObjectFifoCreateOp fifo : device.getOps<ObjectFifoCreateOp>()) {
+    PlacementNet net;
+    net.isObjectFifo = true;
+    net.nodes.push_back(nodeOf(fifo.getProducerTile()));
+    for (Value consumer : fifo.getConsumerTiles())
+      net.nodes.push_back(nodeOf(consumer));
+    auto elemType = llvm::cast<MemRefType>(
+        llvm::cast<AIEObjectFifoType>(fifo.getElemType()).getElementType());
+    net.elementBytes =
+        elemType.getNumElements() * elemType.getElementTypeBitWidth() / 8;
+    net.weight = std::max<uint64_t>(net.elementBytes, 1);
+    for (unsigned i = 0; i < net.nodes.size(); i++)
+      net.depths.push_back(fifo.size(i));
+    net.shareable =
+        !fifo.getVia_DMA() && net.nodes.size() == 2 &&
+        fifo.getDimensionsToStream().empty() && !linked.contains(fifo) &&
+        llvm::all_of(fifo.getDimensionsFromStreamPerConsumer(),
+                     [](BDDimLayoutArrayAttr dims) { return dims.empty(); });
+    totalWeight += net.weight;
+    nets.push_back(std::move(net));
+  }
+
+  for (FlowOp flow : device.getOps<FlowOp>()) {
+    PlacementNet net;
+    net.nodes = {nodeOf(flow.getSource()), nodeOf(flow.getDest())};
+    totalWeight += net.weight;
+    nets.push_back(std::move(net));
+  }
+
+  for (PacketFlowOp packetFlow : device.getOps<PacketFlowOp>()) {
+    PlacementNet net;
+    for (PacketSourceOp source :
+         packetFlow.getPorts().getOps<PacketSourceOp>())
+      net.nodes.push_back(nodeOf(source.getTile()));
+    for (PacketDestOp dest : packetFlow.getPorts().getOps<PacketDestOp>())
+      net.nodes.push_back(nodeOf(dest.getTile()));
+    if (net.nodes.size() < 2)
+      continue;
+    totalWeight += net.weight;
+    nets.push_back(std::move(net));
+  }
+
+  for (CoreOp core : device.getOps<CoreOp>()) {
+    unsigned coreNode = nodeOf(core.getTile());
+    DenseSet<unsigned> memories;
+    core.walk([&](Operation *op) {
+      for (Value operand : op->getOperands()) {
+        Operation *def = operand.getDefiningOp();
+        Value tile;
+        if (auto buffer = dyn_cast_or_null<BufferOp>(def))
+          tile = buffer.getTile();
+        else if (auto lock = dyn_cast_or_null<LockOp>(def))
+          tile = lock.getTile();
+        if (tile && nodeOf(tile) != coreNode &&
+            memories.insert(nodeOf(tile)).second)
+          pairs.push_back({coreNode, nodeOf(tile), /*cascade=*/false});
+      }
+    });
+  }
+
+  for (CascadeFlowOp cascade : device.getOps<CascadeFlowOp>())
+    pairs.push_back({nodeOf(cascade.getSourceTile()),
+                     nodeOf(cascade.getDestTile()), /*cascade=*/true});
+
+  // No wirelength is worth a violated constraint.
+  penalty = 1 + double(totalWeight) *
+                    (targetModel.columns() + targetModel.rows());
+
+  netsOf.resize(nodes.size());
+  pairsOf.resize(nodes.size());
+  for (auto [index, net] : llvm::enumerate(nets))
+    for (unsigned node : net.nodes)
+      if (!llvm::is_contained(netsOf[node], index))
+        netsOf[node].push_back(index);
+  for (auto [index, pair] : llvm::enumerate(pairs)) {
+    pairsOf[pair.core].push_back(index);
+    if (pair.memory != pair.core)
+      pairsOf[pair.memory].push_back(index);
+  }
+  netEpoch.assign(nets.size(), 0);
+  pairEpoch.assign(pairs.size(), 0);
+  nodeEpoch.assign(nodes.size(), 0);
+}
+
+LogicalResult TilePlacer::initialize(DeviceOp device) {
+  DenseSet<TileID> fixed;
+  for (auto [node, position] : llvm::enumerate(positions))
+    if (!nodes[node].movable)
+      fixed.insert(position);
+
+  for (int col = 0; col < targetModel.columns(); col++)
+    for (int row = 0; row < targetModel.rows(); row++) {
+      if (fixed.contains({col, row}))
+        continue;
+      // Only shim NOC tiles have DMAs to move data from external memory.
+      if (targetModel.isShimNOCTile(col, row))
+        slots[int(TileKind::Shim)].push_back({col, row});
+      else if (targetModel.isMemTile(col, row))
+        slots[int(TileKind::Mem)].push_back({col, row});
+      else if (targetModel.isCoreTile(col, row))
+        slots[int(TileKind::Core)].push_back({col, row});
+    }
+
+  unsigned required[3] = {0, 0, 0};
+  for (unsigned node : movable)
+    required[int(nodes[node].kind)]++;
+  static const char *kindNames[] = {"core tiles", "mem tiles",
+                                    "shim NOC tiles"};
+  for (int kind = 0; kind < 3; kind++)
+    if (required[kind] > slots[kind].size())
+      return device.emitOpError("cannot place ")
+             << required[kind] << " unplaced " << kindNames[kind]
+             << ": only " << slots[kind].size() << " are free";
+
+  // Start from the given coordinates when they are free tiles of the right
+  // kind, and from the first free tiles otherwise.
+  for (unsigned node : movable)
+    if (llvm::is_contained(slots[int(nodes[node].kind)], positions[node]) &&
+        !occupant.count(positions[node]))
+      occupant[positions[node]] = node;
+  for (unsigned node : movable) {
+    auto it = occupant.find(positions[node]);
+    if (it != occupant.end() && it->second == node)
+      continue;
+    for (TileID slot : slots[int(nodes[node].kind)])
+      if (!occupant.count(slot)) {
+        positions[node] = slot;
+        occupant[slot] = node;
+        break;
+      }
+  }
+  return success();
+}
+
+bool TilePlacer::canShare(unsigned a, unsigned b) const {
+  if (nodes[a].kind == TileKind::Shim || nodes[a].kind != nodes[b].kind)
+    return false;
+  TileID pa = positions[a], pb = positions[b];
+  return targetModel.isLegalMemAffinity(pa.col, pa.row, pb.col, pb.row) ||
+         targetModel.isLegalMemAffinity(pb.col, pb.row, pa.col, pa.row);
+}
+
+void TilePlacer::updateNet(const PlacementNet &net, int sign) {
+  auto add = [&](auto &value, uint64_t amount) {
+    if (sign > 0)
+      value += amount;
+    else
+      value -= amount;
+  };
+
+  unsigned producer = net.nodes[0];
+  if (net.isObjectFifo && net.shareable && canShare(producer, net.nodes[1])) {
+    // The buffers live in the memory of the producer if the consumer can
+    // access it, and in that of the consumer otherwise.
+    TileID p = positions[producer], c = positions[net.nodes[1]];
+    unsigned holder =
+        targetModel.isLegalMemAffinity(c.col, c.row, p.col, p.row)
+            ? producer
+            : net.nodes[1];
+    add(bytes[holder], net.depths[0] * net.elementBytes);
+    return;
+  }
+
+  int minCol = positions[producer].col, maxCol = minCol;
+  int minRow = positions[producer].row, maxRow = minRow;
+  for (unsigned node : net.nodes) {
+    minCol = std::min(minCol, positions[node].col);
+    maxCol = std::max(maxCol, positions[node].col);
+    minRow = std::min(minRow, positions[node].row);
+    maxRow = std::max(maxRow, positions[node].row);
+  }
+  wirelength +=
+      sign * double(net.weight) * (maxCol - minCol + maxRow - minRow);
+
+  if (!net.isObjectFifo)
+    return;
+  for (auto [i, node] : llvm::enumerate(net.nodes)) {
+    add(bytes[node], net.depths[i] * net.elementBytes);
+    add(i == 0 ? mm2s[node] : s2mm[node], 1);
+  }
+}
+
+unsigned TilePlacer::getNodeViolations(unsigned node) const {
+  const PlacementNode &info = nodes[node];
+  unsigned count = bytes[node] > info.capacity;
+  int col = positions[node].col, row = positions[node].row;
+  bool shim = info.kind == TileKind::Shim;
+  unsigned maxMM2S =
+      shim ? targetModel.getNumSourceShimMuxConnections(col, row,
+                                                        WireBundle::DMA)
+           : targetModel.getNumSourceSwitchboxConnections(col, row,
+                                                          WireBundle::DMA);
+  unsigned maxS2MM =
+      shim ? targetModel.getNumDestShimMuxConnections(col, row,
+                                                      WireBundle::DMA)
+           : targetModel.getNumDestSwitchboxConnections(col, row,
+                                                        WireBundle::DMA);
+  count += std::max(mm2s[node], maxMM2S) - maxMM2S;
+  count += std::max(s2mm[node], maxS2MM) - maxS2MM;
+  return count;
+}
+
+bool TilePlacer::isViolated(const PlacementPair &pair) const {
+  TileID c = positions[pair.core], m = positions[pair.memory];
+  if (pair.cascade)
+    return std::abs(c.col - m.col) + std::abs(c.row - m.row) != 1;
+  return !targetModel.isLegalMemAffinity(c.col, c.row, m.col, m.row);
+}
+
+void TilePlacer::resetCost() {
+  wirelength = 0;
+  violations = 0;
+  bytes.clear();
+  for (const PlacementNode &node : nodes)
+    bytes.push_back(node.bufferBytes);
+  mm2s.assign(nodes.size(), 0);
+  s2mm.assign(nodes.size(), 0);
+  for (const PlacementNet &net : nets)
+    updateNet(net, 1);
+  for (unsigned node = 0; node < nodes.size(); node++)
+    violations += getNodeViolations(node);
+  for (const PlacementPair &pair : pairs)
+    violations += isViolated(pair);
+}
+
+void TilePlacer::collectTerms(ArrayRef<unsigned> moved) {
+  epoch++;
+  termNets.clear();
+  termPairs.clear();
+  termNodes.clear();
+  auto addNode = [&](unsigned node) {
+    if (nodeEpoch[node] != epoch) {
+      nodeEpoch[node] = epoch;
+      termNodes.push_back(node);
+    }
+  };
+  for (unsigned node : moved) {
+    // The DMA channels of a tile depend on its position.
+    addNode(node);
+    for (unsigned net : netsOf[node])
+      if (netEpoch[net] != epoch) {
+        netEpoch[net] = epoch;
+        termNets.push_back(net);
+        for (unsigned other : nets[net].nodes)
+          addNode(other);
+      }
+    for (unsigned pair : pairsOf[node])
+      if (pairEpoch[pair] != epoch) {
+        pairEpoch[pair] = epoch;
+        termPairs.push_back(pair);
+      }
+  }
+}
+
+void TilePlacer::updateTerms(int sign) {
+  // The violations of a node depend on the nets through it, so they are
+  // removed before and added after the nets.
+  if (sign < 0)
+    for (unsigned node : termNodes)
+      violations -= getNodeViolations(node);
+  for (unsigned net : termNets)
+    updateNet(nets[net], sign);
+  if (sign > 0)
+    for (unsigned node : termNodes)
+      violations += getNodeViolations(node);
+  for (unsigned pair : termPairs)
+    violations += sign * int64_t(isViolated(pairs[pair]));
+}
+
+void TilePlacer::move(unsigned node, TileID slot) {
+  TileID from = positions[node];
+  auto it = occupant.find(slot);
+  if (it != occupant.end()) {
+    unsigned other = it->second;
+    positions[other] = from;
+    occupant[from] = other;
+  } else {
+    occupant.erase(from);
+  }
+  positions[node] = slot;
+  occupant[slot] = node;
+}
+
+void TilePlacer::moveAndUpdate(unsigned node, TileID slot) {
+  SmallVector<unsigned, 2> moved = {node};
+  auto it = occupant.find(slot);
+  if (it != occupant.end())
+    moved.push_back(it->second);
+  collectTerms(moved);
+  updateTerms(-1);
+  move(node, slot);
+  updateTerms(1);
+}
+
+bool TilePlacer::anneal(unsigned movesPerTile) {
+  resetCost();
+  double current = getCost();
+  SmallVector<TileID> best = positions;
+  double bestCost = current;
+  int64_t bestViolations = violations;
+
+  // Pick a random move of a random unplaced tile, or return false if the
+  // slot drawn is its own.
+  auto propose = [&](unsigned &node, TileID &slot) {
+    node = movable[random(movable.size())];
+    const SmallVector<TileID> &candidates = slots[int(nodes[node].kind)];
+    slot = candidates[random(candidates.size())];
+    return slot != positions[node];
+  };
+
+  // Start hot enough to accept a typical uphill move most of the time.
+  double totalDelta = 0;
+  unsigned uphill = 0;
+  for (unsigned i = 0; i < 2 * movable.size() + 16; i++) {
+    unsigned node;
+    TileID slot;
+    if (!propose(node, slot))
+      continue;
+    TileID from = positions[node];
+    moveAndUpdate(node, slot);
+    double delta = getCost() - current;
+    moveAndUpdate(node, from);
+    if (delta > 0) {
+      totalDelta += delta;
+      uphill++;
+    }
+  }
+  // If no sampled move went uphill, e.g. from a poor starting placement,
+  // still search: costs are integers, so at one unit of cost per move the
+  // annealing is close to a greedy descent.
+  double initialTemperature = uphill ? totalDelta / uphill : 1.0;
+
+  unsigned movesPerRound = movesPerTile * movable.size();
+  for (double temperature = initialTemperature;
+       temperature > initialTemperature * 1e-4; temperature *= 0.9) {
+    for (unsigned i = 0; i < movesPerRound; i++) {
+      unsigned node;
+      TileID slot;
+      if (!propose(node, slot))
+        continue;
+      TileID from = positions[node];
+      moveAndUpdate(node, slot);
+      double next = getCost();
+      double delta = next - current;
+      if (delta > 0 && randomUnit() >= std::exp(-delta / temperature)) {
+        moveAndUpdate(node, from);
+        continue;
+      }
+      current = next;
+      if (current < bestCost) {
+        bestCost = current;
+        bestViolations = violations;
+        best = positions;
+      }
+    }
+  }
+
+  positions = best;
+  return bestViolations == 0;
+}
+
+namespace {
+
+struct AIEPlaceTilesPass : AIEPlaceTilesBase<AIEPlaceTilesPass> {
+  void runOnOperation() override {
+    DeviceOp device = getOperation();
+    TilePlacer placer(device, clSeed);
+    if (placer.getNumMovable() == 0) {
+      markAllAnalysesPreserved();
+      return;
+    }
+    if (failed(placer.initialize(device)))
+      return signalPassFailure();
+    if (!placer.anneal(std::max(clMovesPerTile.getValue(), 1u))) {
+      device.emitOpError("could not find a legal placement of the unplaced "
+                         "tiles");
+      return signalPassFailure();
+    }
+    placer.apply();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<DeviceOp>> AIE::createAIEPlaceTilesPass() {
+  return std::make_unique<AIEPlaceTilesPass>();
+}
@@ -0,0 +1,460 @@
+//===- AIETilingDSE.cpp -----------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// The search enumerates, loop by loop, the divisor chains
+// l1Tile | l1Tile * spatial | l2Tile | bound. The memory footprints and the
+// number of cores only grow as tiles grow, so a partial tiling that already
+// exceeds the memories or the cores is not extended; the DMA dimensions are
+// checked once a tiling is complete. Each complete tiling is then evaluated
+// for every loop order and kept if no other tiling is at least as fast in
+// both compute and communication. This is exhaustive over the divisor
+// tilings, so the result does not depend on a solver or on its time limits.
+
+#include "aie/Dialect/AIE/Transforms/AIETilingDSE.h"
+
+#include "aie/Dialect/AIE/IR/AIEDialect.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+
+using namespace llvm;
+using namespace xilinx;
+using namespace xilinx::AIE;
+
+// A core reserves this many bytes of its data memory for its stack, the
+// default of aie.core.
+static constexpr uint64_t defaultStackBytes = 0x400;
+// Width of a stream switch port, in bytes per cycle.
+static constexpr double streamBytesPerCycle = 4;
+
+TilingLimits xilinx::AIE::getTilingLimits(const AIETargetModel &targetModel) {
+  TilingLimits limits;
+  limits.l1Bytes = targetModel.getLocalMemorySize() - defaultStackBytes;
+  limits.l2Bytes = targetModel.getMemTileSize();
+
+  // Only the columns with a shim NOC tile can reach external memory.
+  int shimCol = -1;
+  limits.numColumns = 0;
+  for (int col = 0; col < targetModel.columns(); col++) {
+    if (!targetModel.isShimNOCTile(col, 0))
+      continue;
+    if (shimCol < 0)
+      shimCol = col;
+    limits.numColumns++;
+  }
+  if (shimCol < 0)
+    return limits;
+
+  limits.coresPerColumn = 0;
+  int memTileRow = -1;
+  for (int row = 0; row < targetModel.rows(); row++) {
+    if (targetModel.isCoreTile(shimCol, row))
+      limits.coresPerColumn++;
+    else if (memTileRow < 0 && targetModel.isMemTile(shimCol, row))
+      memTileRow = row;
+  }
+
+  limits.l3BytesPerCycle =
+      streamBytesPerCycle * targetModel.getNumSourceShimMuxConnections(
+                                shimCol, 0, WireBundle::DMA);
+  limits.l2BytesPerCycle =
+      memTileRow < 0
+          ? limits.l3BytesPerCycle
+          : streamBytesPerCycle *
+                targetModel.getNumSourceSwitchboxConnections(
+                    shimCol, memTileRow, WireBundle::DMA);
+
+  // AIE1 BDs address memory linearly. On AIE2 the shim and core tile DMAs
+  // generate 3D addresses (the mem tile ones 4D).
+  bool isAIE1 = targetModel.getTargetArch() == AIEArch::AIE1;
+  limits.dmaDims = isAIE1 ? 1 : 3;
+  // Peak multiply-accumulates per cycle for 16-bit operands.
+  limits.macsPerCycle = isAIE1 ? 32 : 64;
+  return limits;
+}
+
+namespace {
+
+class TilingExplorer {
+public:
+  explicit TilingExplorer(const TilingProblem &problem)
+      : problem(problem), limits(problem.limits),
+        numLoops(problem.loops.size()), l1Tile(numLoops, 1),
+        spatial(numLoops, 1), l2Tile(numLoops, 1) {
+    hasL2 = limits.l2Bytes != 0;
+    maxCores = limits.numColumns * limits.coresPerColumn;
+    for (const TilingLoop &loop : problem.loops) {
+      bounds.push_back(loop.bound);
+      SmallVector<int64_t> loopDivisors;
+      for (int64_t d = 1; d * d <= loop.bound; d++)
+        if (loop.bound % d == 0) {
+          loopDivisors.push_back(d);
+          if (d * d != loop.bound)
+            loopDivisors.push_back(loop.bound / d);
+        }
+      llvm::sort(loopDivisors);
+      divisors.push_back(std::move(loopDivisors));
+    }
+    for (unsigned loop = 0; loop < numLoops; loop++)
+      parallel.push_back(llvm::all_of(problem.tensors, [&](auto &tensor) {
+        return !tensor.output || llvm::is_contained(tensor.loops, loop);
+      }));
+  }
+
+  std::vector<TilingSolution> run() {
+    if (maxCores == 0 || !fits())
+      return {};
+    search(0, 1);
+    llvm::stable_sort(pareto,
+                      [](const TilingSolution &a, const TilingSolution &b) {
+                        return std::make_tuple(a.cycles(),
+                                               a.communicationCycles,
+                                               a.computeCycles) <
+                               std::make_tuple(b.cycles(),
+                                               b.communicationCycles,
+                                               b.computeCycles);
+                      });
+    return std::move(pareto);
+  }
+
+private:
+  // Bytes of the tiles `tile` of all tensors, including the extra buffers.
+  uint64_t footprint(ArrayRef<int64_t> tile) const {
+    uint64_t bytes = 0;
+    for (const TilingTensor &tensor : problem.tensors) {
+      uint64_t elements = 1;
+      for (unsigned loop : tensor.loops)
+        elements *= tile[loop];
+      bytes += elements * tensor.elementBytes;
+    }
+    return bytes * limits.bufferCount;
+  }
+
+  static unsigned columnsFor(unsigned cores, unsigned coresPerColumn) {
+    return llvm::divideCeil(cores, coresPerColumn);
+  }
+
+  // Whether the tiles chosen so far fit the memories. The loops not tiled
+  // yet have unit tiles, so this bounds the footprint of any extension.
+  bool fits() const {
+    if (footprint(l1Tile) > limits.l1Bytes)
+      return false;
+    return !hasL2 ||
+           footprint(l2Tile) <= limits.l2Bytes * uint64_t(limits.numColumns);
+  }
+
+  // The number of dimensions a DMA needs to move the `tile` of `tensor` out
+  // of a buffer holding its `extent`. Contiguous rows of the innermost
+  // dimensions fold into one dimension; every outer dimension with more than
+  // one row in the tile adds a stride.
+  static unsigned dmaDimsFor(const TilingTensor &tensor, ArrayRef<int64_t> tile,
+                             ArrayRef<int64_t> extent) {
+    int dim = int(tensor.loops.size()) - 1;
+    while (dim > 0 && tile[tensor.loops[dim]] == extent[tensor.loops[dim]])
+      dim--;
+    unsigned dims = 1;
+    for (--dim; dim >= 0; dim--)
+      if (tile[tensor.loops[dim]] > 1)
+        dims++;
+    return dims;
+  }
+
+  bool fitsDMAs() const {
+    for (const TilingTensor &tensor : problem.tensors) {
+      if (!hasL2) {
+        if (dmaDimsFor(tensor, l1Tile, bounds) > limits.dmaDims)
+          return false;
+        continue;
+      }
+      if (dmaDimsFor(tensor, l2Tile, bounds) > limits.dmaDims ||
+          dmaDimsFor(tensor, l1Tile, l2Tile) > limits.dmaDims)
+        return false;
+    }
+    return true;
+  }
+
+  void search(unsigned loop, unsigned cores) {
+    if (loop == numLoops) {
+      if (fitsDMAs())
+        evaluate(cores);
+      return;
+    }
+    int64_t bound = problem.loops[loop].bound;
+    for (int64_t l1 : divisors[loop]) {
+      l1Tile[loop] = l1;
+      if (footprint(l1Tile) > limits.l1Bytes)
+        break;
+      for (int64_t sp : divisors[loop]) {
+        if (sp * l1 > bound || bound % (sp * l1) != 0)
+          continue;
+        if (cores * sp > maxCores || (sp > 1 && !parallel[loop]))
+          break;
+        spatial[loop] = sp;
+        for (int64_t l2 : divisors[loop]) {
+          if (l2 % (sp * l1) != 0)
+            continue;
+          if (!hasL2 && l2 != sp * l1)
+            continue;
+          l2Tile[loop] = l2;
+          // Larger L2 tiles only use more memory.
+          if (!fits())
+            break;
+          search(loop + 1, cores * sp);
+        }
+        l2Tile[loop] = 1;
+      }
+      spatial[loop] = 1;
+    }
+    l1Tile[loop] = 1;
+  }
+
+  void evaluate(unsigned cores) {
+    TilingSolution solution;
+    solution.l1Tile.assign(l1Tile.begin(), l1Tile.end());
+    solution.spatial.assign(spatial.begin(), spatial.end());
+    solution.l2Tile.assign(l2Tile.begin(), l2Tile.end());
+    solution.cores = cores;
+    solution.columns = columnsFor(cores, limits.coresPerColumn);
+    solution.l1Bytes = footprint(l1Tile);
+    solution.l2Bytes =
+        hasL2 ? llvm::divideCeil(footprint(l2Tile), solution.columns) : 0;
+    if (solution.l2Bytes > limits.l2Bytes)
+      return;
+
+    double iterations = 1;
+    uint64_t l2Blocks = 1;
+    for (unsigned loop = 0; loop < numLoops; loop++) {
+      iterations *= bounds[loop];
+      l2Blocks *= bounds[loop] / l2Tile[loop];
+    }
+    solution.computeCycles = iterations / cores / limits.macsPerCycle;
+
+    SmallVector<unsigned, 4> order(numLoops);
+    std::iota(order.begin(), order.end(), 0);
+    SmallVector<unsigned, 4> position(numLoops);
+    do {
+      for (unsigned i = 0; i < numLoops; i++)
+        position[order[i]] = i;
+      uint64_t l3Traffic = 0, l2Traffic = 0;
+      for (const TilingTensor &tensor : problem.tensors) {
+        // A tile is reused across the loops inside the innermost loop that
+        // indexes its tensor, and reloaded by all the others.
+        unsigned last = 0;
+        for (unsigned loop : tensor.loops)
+          last = std::max(last, position[loop] + 1);
+        uint64_t l3Loads = 1, l2Loads = 1;
+        for (unsigned i = 0; i < last; i++) {
+          unsigned loop = order[i];
+          l3Loads *= bounds[loop] / l2Tile[loop];
+          l2Loads *= l2Tile[loop] / (l1Tile[loop] * spatial[loop]);
+        }
+        // The cores that share a tile receive it in one broadcast.
+        uint64_t l2Elements = 1, l1Elements = 1;
+        for (unsigned loop : tensor.loops) {
+          l2Elements *= l2Tile[loop];
+          l1Elements *= l1Tile[loop] * spatial[loop];
+        }
+        l3Traffic += l3Loads * l2Elements * tensor.elementBytes;
+        l2Traffic += l2Blocks * l2Loads * l1Elements * tensor.elementBytes;
+      }
+      if (!hasL2)
+        l2Traffic = 0;
+
+      solution.order.assign(order.begin(), order.end());
+      solution.l3Traffic = l3Traffic;
+      solution.l2Traffic = l2Traffic;
+      solution.communicationCycles = std::max(
+          l3Traffic / (solution.columns * limits.l3BytesPerCycle),
+          l2Traffic / (solution.columns * limits.l2BytesPerCycle));
+      insert(solution);
+    } while (std::next_permutation(order.begin(), order.end()));
+  }
+
+  // Whether `a` is at least as good as `b` in both objectives. Among the
+  // tilings that tie, prefer the ones using fewer cores, then moving fewer
+  // bytes, then with larger L1 tiles (fewer kernel invocations).
+  static bool dominates(const TilingSolution &a, const TilingSolution &b) {
+    if (a.computeCycles != b.computeCycles ||
+        a.communicationCycles != b.communicationCycles)
+      return a.computeCycles <= b.computeCycles &&
+             a.communicationCycles <= b.communicationCycles;
+    auto key = [](const TilingSolution &s) {
+      return std::make_tuple(s.cores, s.l3Traffic + s.l2Traffic,
+                             -int64_t(s.l1Bytes));
+    };
+    return key(a) <= key(b);
+  }
+
+  void insert(const TilingSolution &solution) {
+    if (llvm::any_of(pareto, [&](const TilingSolution &other) {
+          return dominates(other, solution);
+        }))
+      return;
+    llvm::erase_if(pareto, [&](const TilingSolution &other) {
+      return dominates(solution, other);
+    });
+    pareto.push_back(solution);
+  }
+
+  const TilingProblem &problem;
+  const TilingLimits &limits;
+  unsigned numLoops;
+  bool hasL2;
+  unsigned maxCores;
+  SmallVector<int64_t, 4> bounds;
+  // Whether each loop indexes all the outputs, and can be spread over cores.
+  SmallVector<bool, 4> parallel;
+  SmallVector<SmallVector<int64_t>, 4> divisors;
+  SmallVector<int64_t, 4> l1Tile, spatial, l2Tile;
+  std::vector<TilingSolution> pareto;
+};
+
+} // namespace
+
+std::vector<TilingSolution>
+xilinx::AIE::exploreTilings(const TilingProblem &problem) {
+  return TilingExplorer(problem).run();
+}
+
+template <typename T>
+static bool mapLimit(const json::Object &limits, StringRef key, T &out,
+                     json::Path path) {
+  const json::Value *value = limits.get(key);
+  if (!value)
+    return true;
+  if constexpr (std::is_floating_point_v<T>) {
+    auto number = value->getAsNumber();
+    if (number && *number > 0) {
+      out = *number;
+      return true;
+    }
+    path.field(key).report("expected a positive number");
+  } else {
+    auto number = value->getAsInteger();
+    if (number && *number >= 0) {
+      out = *number;
+      return true;
+    }
+    path.field(key).report("expected a non-negative integer");
+  }
+  return false;
+}
+
+bool xilinx::AIE::fromJSON(const json::Value &value, TilingProblem &problem,
+                           json::Path path) {
+  const json::Object *object = value.getAsObject();
+  if (!object) {
+    path.report("expected an object");
+    return false;
+  }
+
+  if (const json::Value *device = object->get("device")) {
+    auto name = device->getAsString();
+    std::optional<AIEDevice> aieDevice =
+        name ? symbolizeAIEDevice(*name) : std::nullopt;
+    if (!aieDevice) {
+      path.field("device").report("expected the name of a device");
+      return false;
+    }
+    problem.limits = getTilingLimits(getTargetModel(*aieDevice));
+  }
+
+  if (const json::Object *limits = object->getObject("limits")) {
+    json::Path limitsPath = path.field("limits");
+    TilingLimits &l = problem.limits;
+    if (!mapLimit(*limits, "l1_bytes", l.l1Bytes, limitsPath) ||
+        !mapLimit(*limits, "l2_bytes", l.l2Bytes, limitsPath) ||
+        !mapLimit(*limits, "num_columns", l.numColumns, limitsPath) ||
+        !mapLimit(*limits, "cores_per_column", l.coresPerColumn,
+                  limitsPath) ||
+        !mapLimit(*limits, "dma_dims", l.dmaDims, limitsPath) ||
+        !mapLimit(*limits, "l3_bytes_per_cycle", l.l3BytesPerCycle,
+                  limitsPath) ||
+        !mapLimit(*limits, "l2_bytes_per_cycle", l.l2BytesPerCycle,
+                  limitsPath) ||
+        !mapLimit(*limits, "macs_per_cycle", l.macsPerCycle, limitsPath) ||
+        !mapLimit(*limits, "buffer_count", l.bufferCount, limitsPath))
+      return false;
+  }
+
+  const json::Array *loops = object->getArray("loops");
+  if (!loops) {
+    path.field("loops").report("expected an array");
+    return false;
+  }
+  json::Path loopsPath = path.field("loops");
+  for (auto [i, loopValue] : llvm::enumerate(*loops)) {
+    TilingLoop loop;
+    json::ObjectMapper o(loopValue, loopsPath.index(i));
+    if (!o || !o.map("name", loop.name) || !o.map("bound", loop.bound))
+      return false;
+    if (loop.bound < 1) {
+      loopsPath.index(i).field("bound").report("expected a positive bound");
+      return false;
+    }
+    problem.loops.push_back(std::move(loop));
+  }
+
+  const json::Array *tensors = object->getArray("tensors");
+  if (!tensors) {
+    path.field("tensors").report("expected an array");
+    return false;
+  }
+  json::Path tensorsPath = path.field("tensors");
+  for (auto [i, tensorValue] : llvm::enumerate(*tensors)) {
+    TilingTensor tensor;
+    std::vector<std::string> loopNames;
+    int64_t elementBytes = tensor.elementBytes;
+    json::ObjectMapper o(tensorValue, tensorsPath.index(i));
+    if (!o || !o.map("name", tensor.name) || !o.map("loops", loopNames) ||
+        !o.mapOptional("element_bytes", elementBytes) ||
+        !o.mapOptional("output", tensor.output))
+      return false;
+    if (elementBytes < 1) {
+      tensorsPath.index(i).field("element_bytes").report("expected a size");
+      return false;
+    }
+    tensor.elementBytes = elementBytes;
+    for (const std::string &loopName : loopNames) {
+      auto *it = llvm::find_if(problem.loops, [&](const TilingLoop &loop) {
+        return loop.name == loopName;
+      });
+      if (it == problem.loops.end()) {
+        tensorsPath.index(i).field("loops").report("unknown loop");
+        return false;
+      }
+      tensor.loops.push_back(it - problem.loops.begin());
+    }
+    problem.tensors.push_back(std::move(tensor));
+  }
+  return true;
+}
+
+json::Value xilinx::AIE::toJSON(const TilingSolution &solution) {
+  return json::Object{
+      {"l1_tile", json::Array(solution.l1Tile)},
+      {"spatial", json::Array(solution.spatial)},
+      {"l2_tile", json::Array(solution.l2Tile)},
+      {"order", json::Array(solution.order)},
+      {"cores", solution.cores},
+      {"columns", solution.columns},
+      {"l1_bytes", solution.l1Bytes},
+      {"l2_bytes", solution.l2Bytes},
+      {"l3_traffic", solution.l3Traffic},
+      {"l2_traffic", solution.l2Traffic},
+      {"compute_cycles", solution.computeCycles},
+      {"communication_cycles", solution.communicationCycles},
+      {"cycles", solution.cycles()},
+  };
+}
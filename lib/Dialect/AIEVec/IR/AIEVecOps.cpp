@@ -1442,10 +1442,13 @@ LogicalResult verifyPackUnpackOp(T op) {
     if (rtypeWidth != 8)
       return op.emitError("output must be an int8 vector");
   } else {
-    if (stypeWidth != 8)
-      return op.emitError("input must be an int8 vector");
-    if (rtypeWidth != 16)
-      return op.emitError("output must be an int16 vector");
+    // The datatype of source must be i8 or i4, and datatype of result must
+    // be twice as wide
+    if (stypeWidth != 8 && stypeWidth != 4)
+      return op.emitError("input must be an int8 or int4 vector");
+    if (rtypeWidth != 2 * stypeWidth)
+      return op.emitError("output must be an int16 vector for int8 input, "
+                          "or an int8 vector for int4 input");
   }
 
   return success();
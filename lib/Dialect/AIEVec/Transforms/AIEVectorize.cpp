@@ -14,6 +14,7 @@
 
 #include "aie/Dialect/AIEVec/AIEVecUtils.h"
 #include "aie/Dialect/AIEVec/IR/AIEVecOps.h"
+#include "aie/Dialect/AIEVec/Transforms/CostModel.h"
 #include "aie/Dialect/AIEVec/Transforms/IntervalReuse.h"
 #include "aie/Dialect/AIEVec/Transforms/Passes.h"
 
@@ -28,7 +29,9 @@
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/Passes.h"
 
+#include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/Support/Debug.h"
 
 using namespace mlir;
 using namespace arith;
@@ -47,6 +50,21 @@ static llvm::cl::opt<bool> AIEML("aieml", llvm::cl::desc("AI Engine-ML"),
                                  llvm::cl::init(false));
 
 namespace {
+// The vectorization choices that are made per loop nest. The lane counts are
+// fixed by the affine super-vectorizer, so what remains to be chosen is how
+// the mul/fma ops of a nest are combined into AIE intrinsics.
+struct VectSchemeChoice {
+  // Fuse chains of fma ops to use the column topology of the AIE mul/mac
+  // intrinsics (e.g., 16x2 instead of 16x1 for i16xi16).
+  bool fuseColumns = true;
+  // Fuse mul/fma chains into mul_conv/fma_conv ops (AIE-ML only).
+  bool fuseConv = true;
+
+  void print(raw_ostream &os) const {
+    os << "fuse-columns=" << fuseColumns << " fuse-conv=" << fuseConv;
+  }
+};
+
 // A struct to pack the global state required for vectorization at one place.
 // Local to this translation unit.
 struct VectState {
@@ -105,14 +123,28 @@ struct VectState {
   int32_t dupFactor;
 
   bool unalignedLoadsCheck, aieml;
+  // Report the vector loads per iteration of each loop, with and without data
+  // reuse, as remarks.
+  bool reportReuse = false;
+  // The load port accesses performed by the UPD ops generated so far.
+  unsigned updLoads = 0;
+  // The scheme chosen for each outermost loop nest of the function, and the
+  // scheme used for nests that have no entry.
+  DenseMap<Operation *, VectSchemeChoice> schemeChoices;
+  VectSchemeChoice defaultChoice;
 
   // Constructors
   VectState(MLIRContext *context, int8_t s, int32_t z, int32_t d,
             bool unalignedLoadsCheck, bool aieml)
       : builder(context), shift(s), zeroOffset(z), dupFactor(d),
         unalignedLoadsCheck(unalignedLoadsCheck), aieml(aieml) {}
+  ~VectState() {
+    for (auto *interval : reuseIntervals)
+      delete interval;
+  }
 
   IntervalReuse *getIntervalForOperation(Operation *op);
+  VectSchemeChoice getSchemeChoice(Operation *op);
 };
 
 // Get the IntervalReuse object for a given read operation
@@ -122,6 +154,17 @@ IntervalReuse *VectState::getIntervalForOperation(Operation *op) {
   return opToIntervalMap[op];
 }
 
+// Get the scheme chosen for the outermost loop nest that contains op
+VectSchemeChoice VectState::getSchemeChoice(Operation *op) {
+  Operation *nest = nullptr;
+  for (Operation *parent = op->getParentOp();
+       parent && !isa<func::FuncOp>(parent); parent = parent->getParentOp())
+    if (isa<affine::AffineForOp>(parent))
+      nest = parent;
+  auto it = nest ? schemeChoices.find(nest) : schemeChoices.end();
+  return it == schemeChoices.end() ? defaultChoice : it->second;
+}
+
 // A struct to store the attributes (start, lo/hi offset, step, square) for an
 // AIE fma, mul, or select operation.
 struct AIEOpAttributes {
@@ -967,6 +1010,12 @@ static Operation *generateMulOp(T mulOp, AIEOpAttributes &opAttr,
   return xmulOp;
 }
 
+// Return the number of accesses to a load port needed to load `bits` bits.
+static unsigned getLoadPortAccesses(int32_t bits, VectState *state) {
+  unsigned portBits = VectCostParams::get(state->aieml).loadPortBits;
+  return (bits + portBits - 1) / portBits;
+}
+
 // For a transfer_read op, generate a corresponding UPD op. Multiple
 // transfer_read ops will have the same UPD op if their read access extent is
 // subsumed by the same interval. The updOps will have to be inserted at the
@@ -1074,6 +1123,7 @@ generateUPDOp(TransferReadOp readOp,
           readOp.getLoc(), updVecType, readOp.getSource(), indices,
           start - offset, idx - 1,
           updOp ? updOp.getResult() : TypedValue<VectorType>(nullptr));
+      state->updLoads += getLoadPortAccesses(end - start, state);
 
       LLVM_DEBUG(llvm::dbgs() << "\n\nCreated UPD op " << updOp
                               << " for read op " << readOp);
@@ -2031,8 +2081,9 @@ static void fuseFMAOpsForColumnTopology(func::FuncOp func, VectState *state) {
   // Fuse FMA ops to exploit column topology
   func.walk([&](Operation *op) {
     if (isa<MulIOp, MulFOp, vector::FMAOp>(op)) {
-      // Only process fma ops that are not already fused with another mul/fma
-      if (!fusedOpSet.count(op)) {
+      // Only process fma ops that are not already fused with another mul/fma,
+      // and only in loop nests that use the column topology.
+      if (!fusedOpSet.count(op) && state->getSchemeChoice(op).fuseColumns) {
         auto [lanes, cols] = getNumRowsAndCols(op, state);
         // Try fusing a linear chain of FMA ops (max length = cols) starting at
         // op.
@@ -2265,7 +2316,8 @@ static void fuseMulFMAOpsForInt16(Operation *Op, VectState *state) {
 
 static void fuseMulFMAOpsByMulFMAConv(func::FuncOp func, VectState *state) {
   func.walk([&](Operation *Op) {
-    if (isa<aievec::FMAOp>(Op) && canFuseMulFMAOpsForInt16(Op))
+    if (isa<aievec::FMAOp>(Op) && state->getSchemeChoice(Op).fuseConv &&
+        canFuseMulFMAOpsForInt16(Op))
       fuseMulFMAOpsForInt16(Op, state);
   });
 }
@@ -2425,6 +2477,51 @@ static void generateAIEAddOrSubOpsInFunc(func::FuncOp func, VectState *state) {
   });
 }
 
+// AIE-ML intrinsics have no lane selection on their operands. So for a read
+// whose interval is wider than the read itself, derive the read's window from
+// the interval vector: extract the 512-bit chunk(s) that hold the window, and
+// shift them by the window's start. Each interval is then loaded only once,
+// and all the reads that overlap it become register shifts.
+static Value generateWindowOp(Value source, VectorType windowType,
+                              int32_t start, VectState *state, Location loc) {
+  auto srcType = source.getType().cast<VectorType>();
+  int32_t elementSizeInBits = getElementSizeInBits(srcType);
+  int32_t windowBits = getVectorSizeInBits(windowType);
+  assert(windowBits <= 512 && "window is wider than an AIE-ML shift");
+
+  // The shifts operate on 512-bit vectors, so widen narrower intervals.
+  if (getVectorSizeInBits(srcType) < 512) {
+    VectorType concatType =
+        createVectorType(512 / elementSizeInBits, srcType.getElementType());
+    SmallVector<Value> sources(512 / getVectorSizeInBits(srcType), source);
+    source = generateConcatOp(sources, state, loc, concatType);
+    srcType = concatType;
+  }
+  int32_t chunkLanes = 512 / elementSizeInBits;
+  int32_t numChunks = getVectorLaneSize(srcType) / chunkLanes;
+  auto getChunk = [&](int32_t idx) -> Value {
+    if (numChunks == 1)
+      return source;
+    return generateExtOp(source, chunkLanes, idx, state, loc);
+  };
+
+  int32_t startBits = start * elementSizeInBits;
+  int32_t idx = startBits / 512, shiftBits = startBits % 512;
+  Value window = getChunk(idx);
+  if (shiftBits) {
+    // The window straddles two chunks unless it fits in the remainder of the
+    // first one.
+    Value next = shiftBits + windowBits > 512 && idx + 1 < numChunks
+                     ? getChunk(idx + 1)
+                     : window;
+    window = generateShiftOp(window, next, shiftBits / 8, state, loc);
+  }
+  if (windowBits < 512)
+    window =
+        generateExtOp(window, getVectorLaneSize(windowType), 0, state, loc);
+  return window;
+}
+
 // Generate UPD ops to subsume all the transfer_read ops of affine dialect. To
 // generate the UPD ops, we first visit the innermost for op, and for each
 // transfer_read instruction nested inside that op, create a set of UPD ops,
@@ -2445,19 +2542,54 @@ static void insertUPDOpsInLoop(affine::AffineForOp forOp, VectState *state) {
   // A map from a read operation to its corresponding UPD operation. The idea
   // is that multiple read ops will derive from the same bigger vector
   // register.
-  DenseMap<Operation *, aievec::UPDOp> readOpToUpdMap;
+  llvm::MapVector<Operation *, aievec::UPDOp> readOpToUpdMap;
+  // The load port accesses needed if every read were loaded on its own.
+  unsigned readLoads = 0;
+  unsigned updLoadsBefore = state->updLoads;
   // Iterate over all the transfer_read ops within this loop
   Region &region = forOp.getRegion();
   for (TransferReadOp readOp : region.getOps<TransferReadOp>()) {
+    IntervalReuse *iv = state->getIntervalForOperation(readOp);
+    auto extent = iv->getAccessExtent(readOp);
+    readLoads += getLoadPortAccesses(extent.second - extent.first, state);
     aievec::UPDOp updOp = generateUPDOp(readOp, memToUpdMap, region, state);
     readOpToUpdMap[readOp] = updOp;
   }
 
-  // Now replace all the uses of a transfer_read op with its UPD op
+  // Now replace all the uses of a transfer_read op with its UPD op. The AIE
+  // ops created so far (mul/fma/add/sub with their start/offset attributes,
+  // and the mul_conv/fma_conv and shuffle ops of the i8 path) work on the
+  // whole interval vector. On AIE-ML, every user outside the AIEVec dialect
+  // gets the window it reads.
   for (auto &map : readOpToUpdMap) {
-    Operation *op = map.first;
-    op->replaceAllUsesWith(map.second);
-    op->erase();
+    auto readOp = cast<TransferReadOp>(map.first);
+    aievec::UPDOp updOp = map.second;
+    auto readType = readOp.getVector().getType().cast<VectorType>();
+    if (state->aieml && updOp.getType() != readType &&
+        getVectorSizeInBits(readType) <= 512) {
+      Value window;
+      for (OpOperand &use : llvm::make_early_inc_range(readOp->getUses())) {
+        if (isAIEOp(use.getOwner()))
+          continue;
+        if (!window) {
+          state->builder.setInsertionPointAfter(updOp);
+          window = generateWindowOp(updOp, readType,
+                                    computeStartInAIEVec(readOp, state),
+                                    state, readOp.getLoc());
+        }
+        use.set(window);
+      }
+    }
+    readOp->replaceAllUsesWith(updOp);
+    readOp->erase();
+  }
+
+  if (state->reportReuse && !readOpToUpdMap.empty()) {
+    unsigned updLoads = state->updLoads - updLoadsBefore;
+    forOp.emitRemark() << "vector loads per iteration: " << updLoads
+                       << " with reuse, " << readLoads << " without ("
+                       << readLoads - std::min(readLoads, updLoads)
+                       << " saved)";
   }
 }
 
@@ -2972,6 +3104,128 @@ static void reassociateOpsInFunc(func::FuncOp func, VectState *state) {
   reassociateAddOpInFunc(func, state);
 }
 
+// Record the sext ops and the loops enclosing each block of the function.
+static void analyzeFunc(func::FuncOp func, VectState *state) {
+  // record the sext op and its operand's def op to sextTruncDefMap
+  recordSextOps(func, state);
+
+  // First compute the loops surrounding each load/store operation. This is
+  // necessary to identify loads/stores that are nested together.
+  for (auto forOp : func.getOps<affine::AffineForOp>()) {
+    SmallVector<Operation *, 8> enclosingLoops;
+    enclosingLoops.push_back(forOp);
+    computeEnclosingLoopsPerBlock(forOp, state, enclosingLoops);
+  }
+}
+
+// Rewrite the vector dialect ops of an analyzed function into AIE dialect ops.
+static void vectorizeFunc(func::FuncOp func, VectState *state) {
+  // Compute the reuse for all the transfer_read operations, and form the
+  // initial vector sizes.
+  computeReuseInFunc(func, state);
+  // We leverage the assumption that pointwise addition and multiplication
+  // are commutative and associative to reassociate the operands of some
+  // operators. This IR massaging makes it feasible to generate aie dialect
+  // fma/msc intrinsics.
+  reassociateOpsInFunc(func, state);
+  // Rewrite vector dialect add and mul operation chains as vector dialect
+  // fma operation if feasible.
+  rewriteFMAOpsInFunc(func, state);
+  // Coalesce vectors that only appear as LHS operands of mul/fma op if their
+  // size is <= 256 bits.
+  coalesceLHSOpVectorsInFunc(func, state);
+  // Check for opportunities of fusing FMA ops to exploit the column topology
+  // of the AIE vector intrinsic.
+  fuseFMAOpsForColumnTopology(func, state);
+  // For each vector dialect mul/fma op, compute the start and offset values
+  // of its operands. Finally, generate AIE dialect mul/FMA ops.
+  generateAIEMulOrFMAOpsInFunc(func, state);
+  // Insert SRS ops to move data from accumulator to vector when the producer
+  // is an AIE dialect op that writes to an accumulator, and the consumer
+  // isn't an AIE dialect op.
+  insertSRSOpsInFunc(func, state);
+  // For each vector dialect add/sub op, compute the start and offset values
+  // of its operands. Finally, generate AIE dialect add/sub ops. This should
+  // be done after srs ops are generated, so that the input to the add op is
+  // always vectors.
+  generateAIEAddOrSubOpsInFunc(func, state);
+  // Generate UPD ops that subsume all the transfer_read ops in affine
+  // dialect. This happens after generating aie dialect add/sub ops because
+  // those ops need to query transfer reads to know if their operand is
+  // splat.
+  insertUPDOpsInFunc(func, state);
+  // Check for the opportunities of fusing Mul and FMA ops by Mul_Conv or
+  // FMA_Conv.
+  if (state->aieml)
+    fuseMulFMAOpsByMulFMAConv(func, state);
+}
+
+// Choose a vectorization scheme for each outermost loop nest of the function.
+// Each candidate scheme is applied to a copy of the function, and the AIEVec
+// code it produces for each nest is priced with the cost model. A nest gets
+// the cheapest candidate; ties go to the default scheme, which is tried first.
+static void selectVectSchemes(func::FuncOp func, VectState *state) {
+  SmallVector<VectSchemeChoice, 4> candidates = {{true, true}, {false, true}};
+  if (state->aieml)
+    candidates.append({{true, false}, {false, false}});
+
+  SmallVector<Operation *, 4> nests;
+  for (auto forOp : func.getOps<affine::AffineForOp>())
+    nests.push_back(forOp);
+  if (nests.empty())
+    return;
+
+  VectCostParams params = VectCostParams::get(state->aieml);
+  // The cost of each candidate, per nest.
+  SmallVector<SmallVector<VectCost, 4>, 4> costs(nests.size());
+  MLIRContext *context = func.getContext();
+  for (auto &candidate : candidates) {
+    OwningOpRef<ModuleOp> scratch = ModuleOp::create(func.getLoc());
+    auto clone = cast<func::FuncOp>(func->clone());
+    scratch->push_back(clone);
+
+    VectState cloneState(context, state->shift, state->zeroOffset,
+                         state->dupFactor, state->unalignedLoadsCheck,
+                         state->aieml);
+    cloneState.defaultChoice = candidate;
+    {
+      // A candidate that cannot be applied is simply not selected.
+      ScopedDiagnosticHandler silence(context,
+                                      [](Diagnostic &) { return success(); });
+      analyzeFunc(clone, &cloneState);
+      vectorizeFunc(clone, &cloneState);
+    }
+
+    SmallVector<Operation *, 4> cloneNests;
+    for (auto forOp : clone.getOps<affine::AffineForOp>())
+      cloneNests.push_back(forOp);
+    if (cloneNests.size() != nests.size())
+      return;
+    for (auto [idx, nest] : llvm::enumerate(cloneNests))
+      costs[idx].push_back(estimateVectCost(nest, params));
+  }
+
+  for (auto [idx, nest] : llvm::enumerate(nests)) {
+    unsigned best = 0;
+    for (unsigned i = 1; i < candidates.size(); ++i)
+      if (costs[idx][i].getCycles() < costs[idx][best].getCycles())
+        best = i;
+    state->schemeChoices[nest] = candidates[best];
+
+    LLVM_DEBUG({
+      llvm::dbgs() << "aie-vectorize: " << func.getSymName() << " nest " << idx
+                   << "\n";
+      for (auto [i, candidate] : llvm::enumerate(candidates)) {
+        llvm::dbgs() << (i == best ? "  * " : "    ");
+        candidate.print(llvm::dbgs());
+        llvm::dbgs() << ": ";
+        costs[idx][i].print(llvm::dbgs());
+        llvm::dbgs() << "\n";
+      }
+    });
+  }
+}
+
 struct AIEVectorize : AIEVectorizeBase<AIEVectorize> {
   AIEVectorize() = default;
   void runOnOperation() override;
@@ -3006,17 +3260,9 @@ void AIEVectorize::runOnOperation() {
       aieml = this->aieml;
     auto *state = new VectState(func.getContext(), shiftParam, zeroOffset,
                                 dupFactor, unallignedCheck, aieml);
+    state->reportReuse = reportReuse;
 
-    // record the sext op and its operand's def op to sextTruncDefMap
-    recordSextOps(func, state);
-
-    // First compute the loops surrounding each load/store operation. This is
-    // necessary to identify loads/stores that are nested together.
-    for (auto forOp : func.getOps<affine::AffineForOp>()) {
-      SmallVector<Operation *, 8> enclosingLoops;
-      enclosingLoops.push_back(forOp);
-      computeEnclosingLoopsPerBlock(forOp, state, enclosingLoops);
-    }
+    analyzeFunc(func, state);
 
     // Check whether there is any unalignment loads.
     if (state->unalignedLoadsCheck && failed(hasUnalignedLoads(func, state))) {
@@ -3025,44 +3271,12 @@ void AIEVectorize::runOnOperation() {
       return;
     }
 
-    // Compute the reuse for all the transfer_read operations, and form the
-    // initial vector sizes.
-    computeReuseInFunc(func, state);
-    // We leverage the assumption that pointwise addition and multiplication
-    // are commutative and associative to reassociate the operands of some
-    // operators. This IR massaging makes it feasible to generate aie dialect
-    // fma/msc intrinsics.
-    reassociateOpsInFunc(func, state);
-    // Rewrite vector dialect add and mul operation chains as vector dialect
-    // fma operation if feasible.
-    rewriteFMAOpsInFunc(func, state);
-    // Coalesce vectors that only appear as LHS operands of mul/fma op if their
-    // size is <= 256 bits.
-    coalesceLHSOpVectorsInFunc(func, state);
-    // Check for opportunities of fusing FMA ops to exploit the column topology
-    // of the AIE vector intrinsic.
-    fuseFMAOpsForColumnTopology(func, state);
-    // For each vector dialect mul/fma op, compute the start and offset values
-    // of its operands. Finally, generate AIE dialect mul/FMA ops.
-    generateAIEMulOrFMAOpsInFunc(func, state);
-    // Insert SRS ops to move data from accumulator to vector when the producer
-    // is an AIE dialect op that writes to an accumulator, and the consumer
-    // isn't an AIE dialect op.
-    insertSRSOpsInFunc(func, state);
-    // For each vector dialect add/sub op, compute the start and offset values
-    // of its operands. Finally, generate AIE dialect add/sub ops. This should
-    // be done after srs ops are generated, so that the input to the add op is
-    // always vectors.
-    generateAIEAddOrSubOpsInFunc(func, state);
-    // Generate UPD ops that subsume all the transfer_read ops in affine
-    // dialect. This happens after generating aie dialect add/sub ops because
-    // those ops need to query transfer reads to know if their operand is
-    // splat.
-    insertUPDOpsInFunc(func, state);
-    // Check for the opportunities of fusing Mul and FMA ops by Mul_Conv or
-    // FMA_Conv.
-    if (state->aieml)
-      fuseMulFMAOpsByMulFMAConv(func, state);
+    // Pick the vectorization scheme of each loop nest by estimating the cost
+    // of the alternatives.
+    if (costModel)
+      selectVectSchemes(func, state);
+
+    vectorizeFunc(func, state);
   }
 
   // Canonicalize the IR of all the functions in the module by running a set of
@@ -0,0 +1,306 @@
+//===- BlockMatMul.cpp - Register-blocked matmul for AIE-ML -----*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+// This file implements the rewrite of `linalg.matmul` ops on core-local
+// memrefs into loops of `vector.contract` ops with the shapes supported by
+// `aievec.matmul`. The accumulators of a block of output tiles are kept in
+// registers for the whole reduction, as in the hand-written AIE2 matmul
+// kernels.
+//===----------------------------------------------------------------------===//
+
+#include "aie/Dialect/AIEVec/Transforms/Passes.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/IR/AffineExpr.h"
+
+#define DEBUG_TYPE "aie-block-matmul"
+
+using namespace mlir;
+using namespace xilinx;
+using namespace xilinx::aievec;
+
+namespace {
+
+// The shape of one `aievec.matmul`: an r x s lhs tile times an s x t rhs
+// tile, accumulated into an r x t tile of `accType` elements.
+struct MatMulShape {
+  int64_t r, s, t;
+  Type accType;
+};
+
+// Select the `aievec.matmul` shape for the element types of a matmul. These
+// are the `aie::mmul` shapes used by the hand-written AIE2 kernels. When the
+// lhs is narrower than the rhs (i4 x i8, i8 x i16), which the hardware does
+// not support, the shape of the rhs type is used and the lhs tiles are
+// unpacked in registers by the conversion to AIEVec.
+static std::optional<MatMulShape> getMatMulShape(Type lhsType, Type rhsType,
+                                                 Type outType) {
+  MLIRContext *ctx = lhsType.getContext();
+  Type i32Type = IntegerType::get(ctx, 32);
+  Type i64Type = IntegerType::get(ctx, 64);
+  std::optional<MatMulShape> shape;
+  if (lhsType.isInteger(8) && rhsType.isInteger(4))
+    shape = MatMulShape{4, 16, 8, i32Type};
+  else if ((lhsType.isInteger(8) || lhsType.isInteger(4)) &&
+           rhsType.isInteger(8))
+    shape = MatMulShape{4, 8, 8, i32Type};
+  else if (lhsType.isInteger(16) && rhsType.isInteger(8))
+    shape = MatMulShape{4, 4, 8, i32Type};
+  else if ((lhsType.isInteger(16) || lhsType.isInteger(8)) &&
+           rhsType.isInteger(16))
+    shape = outType.isInteger(64) ? MatMulShape{4, 4, 4, i64Type}
+                                  : MatMulShape{4, 2, 8, i32Type};
+  else if (lhsType.isBF16() && rhsType.isBF16())
+    shape = MatMulShape{4, 8, 4, Float32Type::get(ctx)};
+  if (!shape)
+    return std::nullopt;
+
+  // The output elements must fit in the accumulator.
+  if (isa<FloatType>(shape->accType) != isa<FloatType>(outType) ||
+      outType.getIntOrFloatBitWidth() >
+          shape->accType.getIntOrFloatBitWidth())
+    return std::nullopt;
+  return shape;
+}
+
+// Reads and writes r x c tiles of a 2-d memref. With the tiled layout, the
+// memref holds the matrix as row-major blocks of contiguous row-major tiles,
+// which is how the DMAs of the AIE2 matmul designs lay out the operands, and
+// each tile is accessed with a single 1-d transfer.
+class TileAccessor {
+public:
+  TileAccessor(OpBuilder &builder, Location loc, Value memref, int64_t rows,
+               int64_t cols, bool tiled)
+      : memref(memref), rows(rows), cols(cols), tiled(tiled) {
+    auto type = cast<MemRefType>(memref.getType());
+    numTileCols = type.getDimSize(1) / cols;
+    if (tiled) {
+      ReassociationIndices dims = {0, 1};
+      flat = builder.create<memref::CollapseShapeOp>(
+          loc, memref, ArrayRef<ReassociationIndices>{dims});
+    }
+  }
+
+  // Read the tile at block coordinates (`tileRow` + `i`, `tileCol` + `j`).
+  Value read(OpBuilder &b, Location loc, Value tileRow, int64_t i,
+             Value tileCol, int64_t j) {
+    Type elemType = cast<MemRefType>(memref.getType()).getElementType();
+    auto tileType = VectorType::get({rows, cols}, elemType);
+    if (!tiled) {
+      auto [row, col] = getElementIndices(b, loc, tileRow, i, tileCol, j);
+      return b.create<vector::TransferReadOp>(
+          loc, tileType, memref, ValueRange{row, col},
+          ArrayRef<bool>{true, true});
+    }
+    auto flatType = VectorType::get({rows * cols}, elemType);
+    Value offset = getTileOffset(b, loc, tileRow, i, tileCol, j);
+    Value tile = b.create<vector::TransferReadOp>(
+        loc, flatType, flat, ValueRange{offset}, ArrayRef<bool>{true});
+    return b.create<vector::ShapeCastOp>(loc, tileType, tile);
+  }
+
+  void write(OpBuilder &b, Location loc, Value tile, Value tileRow, int64_t i,
+             Value tileCol, int64_t j) {
+    if (!tiled) {
+      auto [row, col] = getElementIndices(b, loc, tileRow, i, tileCol, j);
+      b.create<vector::TransferWriteOp>(loc, tile, memref,
+                                        ValueRange{row, col},
+                                        ArrayRef<bool>{true, true});
+      return;
+    }
+    auto tileType = cast<VectorType>(tile.getType());
+    auto flatType =
+        VectorType::get({rows * cols}, tileType.getElementType());
+    Value offset = getTileOffset(b, loc, tileRow, i, tileCol, j);
+    Value flatTile = b.create<vector::ShapeCastOp>(loc, flatType, tile);
+    b.create<vector::TransferWriteOp>(loc, flatTile, flat, ValueRange{offset},
+                                      ArrayRef<bool>{true});
+  }
+
+private:
+  std::pair<Value, Value> getElementIndices(OpBuilder &b, Location loc,
+                                            Value tileRow, int64_t i,
+                                            Value tileCol, int64_t j) {
+    AffineExpr d0 = b.getAffineDimExpr(0);
+    Value row = b.create<affine::AffineApplyOp>(
+        loc, AffineMap::get(1, 0, (d0 + i) * rows), ValueRange{tileRow});
+    Value col = b.create<affine::AffineApplyOp>(
+        loc, AffineMap::get(1, 0, (d0 + j) * cols), ValueRange{tileCol});
+    return {row, col};
+  }
+
+  Value getTileOffset(OpBuilder &b, Location loc, Value tileRow, int64_t i,
+                      Value tileCol, int64_t j) {
+    AffineExpr d0 = b.getAffineDimExpr(0);
+    AffineExpr d1 = b.getAffineDimExpr(1);
+    AffineExpr offset = ((d0 + i) * numTileCols + d1 + j) * (rows * cols);
+    return b.create<affine::AffineApplyOp>(loc, AffineMap::get(2, 0, offset),
+                                           ValueRange{tileRow, tileCol});
+  }
+
+  Value memref;
+  Value flat;
+  int64_t rows, cols;
+  int64_t numTileCols;
+  bool tiled;
+};
+
+// Convert `value` to a vector of `elemType` elements.
+static Value castElements(OpBuilder &b, Location loc, Value value,
+                          Type elemType) {
+  auto type = cast<VectorType>(value.getType());
+  if (type.getElementType() == elemType)
+    return value;
+  auto resType = VectorType::get(type.getShape(), elemType);
+  unsigned srcWidth = type.getElementTypeBitWidth();
+  unsigned dstWidth = elemType.getIntOrFloatBitWidth();
+  if (isa<FloatType>(elemType))
+    return srcWidth < dstWidth
+               ? b.create<arith::ExtFOp>(loc, resType, value).getResult()
+               : b.create<arith::TruncFOp>(loc, resType, value).getResult();
+  return srcWidth < dstWidth
+             ? b.create<arith::ExtSIOp>(loc, resType, value).getResult()
+             : b.create<arith::TruncIOp>(loc, resType, value).getResult();
+}
+
+struct AIEBlockMatMulPass : AIEBlockMatMulBase<AIEBlockMatMulPass> {
+  void runOnOperation() override {
+    func::FuncOp func = getOperation();
+    SmallVector<linalg::MatmulOp> matmuls;
+    func.walk([&](linalg::MatmulOp op) { matmuls.push_back(op); });
+    for (linalg::MatmulOp op : matmuls)
+      if (succeeded(blockMatMul(op)))
+        op->erase();
+  }
+
+  LogicalResult blockMatMul(linalg::MatmulOp op) {
+    Value lhs = op.getInputs()[0];
+    Value rhs = op.getInputs()[1];
+    Value out = op.getOutputs()[0];
+    auto lhsType = dyn_cast<MemRefType>(lhs.getType());
+    auto rhsType = dyn_cast<MemRefType>(rhs.getType());
+    auto outType = dyn_cast<MemRefType>(out.getType());
+    if (!lhsType || !rhsType || !outType)
+      return op.emitWarning() << "expected a matmul on memrefs";
+    if (!lhsType.hasStaticShape() || !rhsType.hasStaticShape() ||
+        !outType.hasStaticShape())
+      return op.emitWarning() << "expected static shapes";
+    if (clTiledLayout &&
+        (!lhsType.getLayout().isIdentity() ||
+         !rhsType.getLayout().isIdentity() ||
+         !outType.getLayout().isIdentity()))
+      return op.emitWarning() << "the tiled layout requires identity layouts";
+
+    auto shape = getMatMulShape(lhsType.getElementType(),
+                                rhsType.getElementType(),
+                                outType.getElementType());
+    if (!shape)
+      return op.emitWarning() << "no aievec.matmul shape for "
+                              << lhsType.getElementType() << " x "
+                              << rhsType.getElementType() << " into "
+                              << outType.getElementType();
+
+    int64_t m = lhsType.getDimSize(0);
+    int64_t k = lhsType.getDimSize(1);
+    int64_t n = rhsType.getDimSize(1);
+    int64_t blockM = clBlockM, blockN = clBlockN;
+    if (blockM < 1 || blockN < 1 || m % (shape->r * blockM) ||
+        n % (shape->t * blockN) || k % shape->s)
+      return op.emitWarning()
+             << "matmul of size " << m << "x" << k << "x" << n
+             << " is not a multiple of the " << shape->r * blockM << "x"
+             << shape->s << "x" << shape->t * blockN << " register block";
+
+    OpBuilder b(op);
+    Location loc = op.getLoc();
+    TileAccessor lhsTiles(b, loc, lhs, shape->r, shape->s, clTiledLayout);
+    TileAccessor rhsTiles(b, loc, rhs, shape->s, shape->t, clTiledLayout);
+    TileAccessor outTiles(b, loc, out, shape->r, shape->t, clTiledLayout);
+
+    MLIRContext *ctx = op.getContext();
+    AffineExpr dm, dn, dk;
+    bindDims(ctx, dm, dn, dk);
+    SmallVector<AffineExpr> lhsExprs = {dm, dk}, rhsExprs = {dk, dn},
+                            accExprs = {dm, dn};
+    SmallVector<ArrayRef<AffineExpr>> indexingExprs = {lhsExprs, rhsExprs,
+                                                       accExprs};
+    SmallVector<vector::IteratorType> iteratorTypes = {
+        vector::IteratorType::parallel, vector::IteratorType::parallel,
+        vector::IteratorType::reduction};
+    auto c0 = b.create<arith::ConstantIndexOp>(loc, 0);
+    auto c1 = b.create<arith::ConstantIndexOp>(loc, 1);
+    auto cBlockM = b.create<arith::ConstantIndexOp>(loc, blockM);
+    auto cBlockN = b.create<arith::ConstantIndexOp>(loc, blockN);
+    auto cTilesM = b.create<arith::ConstantIndexOp>(loc, m / shape->r);
+    auto cTilesN = b.create<arith::ConstantIndexOp>(loc, n / shape->t);
+    auto cTilesK = b.create<arith::ConstantIndexOp>(loc, k / shape->s);
+
+    // Loop over blocks of blockM x blockN output tiles.
+    auto rowLoop = b.create<scf::ForOp>(loc, c0, cTilesM, cBlockM);
+    b.setInsertionPointToStart(rowLoop.getBody());
+    auto colLoop = b.create<scf::ForOp>(loc, c0, cTilesN, cBlockN);
+    b.setInsertionPointToStart(colLoop.getBody());
+    Value tileRow = rowLoop.getInductionVar();
+    Value tileCol = colLoop.getInductionVar();
+
+    // Load the accumulators of the block once.
+    SmallVector<Value> accs;
+    for (int64_t i = 0; i < blockM; ++i)
+      for (int64_t j = 0; j < blockN; ++j)
+        accs.push_back(castElements(
+            b, loc, outTiles.read(b, loc, tileRow, i, tileCol, j),
+            shape->accType));
+
+    // Reduce over K with the accumulators carried in registers. Each step
+    // loads blockM lhs tiles and blockN rhs tiles, and issues
+    // blockM x blockN matmuls.
+    auto reductionLoop = b.create<scf::ForOp>(
+        loc, c0, cTilesK, c1, accs,
+        [&](OpBuilder &nb, Location nloc, Value tileK, ValueRange iterAccs) {
+          SmallVector<Value> lhsTileValues, rhsTileValues;
+          for (int64_t i = 0; i < blockM; ++i)
+            lhsTileValues.push_back(castElements(
+                nb, nloc, lhsTiles.read(nb, nloc, tileRow, i, tileK, 0),
+                shape->accType));
+          for (int64_t j = 0; j < blockN; ++j)
+            rhsTileValues.push_back(castElements(
+                nb, nloc, rhsTiles.read(nb, nloc, tileK, 0, tileCol, j),
+                shape->accType));
+          SmallVector<Value> newAccs;
+          for (int64_t i = 0; i < blockM; ++i)
+            for (int64_t j = 0; j < blockN; ++j)
+              newAccs.push_back(nb.create<vector::ContractionOp>(
+                  nloc, lhsTileValues[i], rhsTileValues[j],
+                  iterAccs[i * blockN + j], indexingExprs, iteratorTypes));
+          nb.create<scf::YieldOp>(nloc, newAccs);
+        });
+
+    // Store the block of results.
+    for (int64_t i = 0; i < blockM; ++i)
+      for (int64_t j = 0; j < blockN; ++j)
+        outTiles.write(b, loc,
+                       castElements(b, loc,
+                                    reductionLoop.getResult(i * blockN + j),
+                                    outType.getElementType()),
+                       tileRow, i, tileCol, j);
+    return success();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<Pass> aievec::createAIEBlockMatMulPass() {
+  return std::make_unique<AIEBlockMatMulPass>();
+}
@@ -0,0 +1,198 @@
+//===- CostModel.cpp - AIE Vector Code Cost Estimation ----------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+// This file implements a static cost model for AIEVec operations. It is used
+// by aie-vectorize to choose between alternative vectorization schemes.
+//===----------------------------------------------------------------------===//
+
+#include "aie/Dialect/AIEVec/Transforms/CostModel.h"
+#include "aie/Dialect/AIEVec/AIEVecUtils.h"
+#include "aie/Dialect/AIEVec/IR/AIEVecOps.h"
+
+#include "llvm/ADT/TypeSwitch.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+
+using namespace mlir;
+using namespace xilinx::aievec;
+
+VectCostParams VectCostParams::get(bool aieml) {
+  // Both architectures have two 256-bit load units. AIE1 has eight 256-bit
+  // vector registers and six 384-bit accumulators; AIE-ML has twenty-four
+  // 256-bit vector registers and nine 1024-bit accumulators.
+  if (aieml)
+    return {true, 2, 256, 24 * 256, 9 * 1024, 256};
+  return {false, 2, 256, 8 * 256, 6 * 384, 256};
+}
+
+unsigned VectCost::getCycles() const {
+  unsigned cycles = std::max({vectorOps, shuffles, moves, loads});
+  return cycles + 2 * spills;
+}
+
+VectCost &VectCost::operator+=(const VectCost &other) {
+  vectorOps += other.vectorOps;
+  loads += other.loads;
+  shuffles += other.shuffles;
+  moves += other.moves;
+  peakVectorBits = std::max(peakVectorBits, other.peakVectorBits);
+  peakAccBits = std::max(peakAccBits, other.peakAccBits);
+  spills += other.spills;
+  return *this;
+}
+
+void VectCost::print(raw_ostream &os) const {
+  os << "cycles=" << getCycles() << " vector=" << vectorOps
+     << " load=" << loads << " shuffle=" << shuffles << " move=" << moves
+     << " vregs=" << peakVectorBits << "b accs=" << peakAccBits
+     << "b spills=" << spills;
+}
+
+namespace {
+
+enum class ValueKind { None, Vector, Acc };
+
+// Return the register file the results of `op` live in. Multiplications
+// produce accumulators, except for floating point on AIE1, where the fp
+// datapath writes back to vector registers.
+ValueKind getResultKind(Operation *op, bool aieml) {
+  if (op->getNumResults() != 1)
+    return ValueKind::None;
+  auto type = dyn_cast<VectorType>(op->getResult(0).getType());
+  if (!type)
+    return ValueKind::None;
+  if (isa<UPSOp, MatMulOp>(op))
+    return ValueKind::Acc;
+  if (auto castOp = dyn_cast<CastOp>(op))
+    return castOp.getIsResAcc() ? ValueKind::Acc : ValueKind::Vector;
+  if (isa<MulOp, FMAOp, MulElemOp, FMAElemOp, MulConvOp, FMAConvOp>(op)) {
+    if (!aieml && isa<FloatType>(type.getElementType()))
+      return ValueKind::Vector;
+    return ValueKind::Acc;
+  }
+  return ValueKind::Vector;
+}
+
+unsigned getSizeInBits(Value value) {
+  if (auto type = dyn_cast<VectorType>(value.getType()))
+    return getVectorSizeInBits(type);
+  return 0;
+}
+
+class CostEstimator {
+public:
+  explicit CostEstimator(const VectCostParams &params) : params(params) {}
+
+  void countOp(Operation *op) {
+    TypeSwitch<Operation *>(op)
+        .Case<MulOp, FMAOp, MulElemOp, FMAElemOp, MulConvOp, FMAConvOp,
+              MatMulOp, AddOp, SubOp, AddElemOp, SubElemOp, MinOp, MaxOp,
+              CmpOp, SelOp, NegOp, BxorOp, BnegOp, BorOp, BandOp>(
+            [&](auto) { cost.vectorOps++; })
+        .Case<UPDOp>([&](UPDOp updOp) {
+          // The two UPD ops of a lo/hi pair each load half of the vector.
+          unsigned bits = getVectorSizeInBits(updOp.getResult().getType());
+          if (updOp.getVector() ||
+              llvm::any_of(updOp->getUsers(),
+                           [](Operation *user) { return isa<UPDOp>(user); }))
+            bits /= 2;
+          cost.loads += (bits + params.loadPortBits - 1) / params.loadPortBits;
+        })
+        .Case<SelectOp, ShiftOp, ExtOp, ConcatOp, ShuffleOp, BroadcastOp,
+              BroadcastScalarOp, PackOp, UnpackOp, ExtElemOp>(
+            [&](auto) { cost.shuffles++; })
+        .Case<SRSOp, UPSOp>([&](auto) { cost.moves++; });
+  }
+
+  // Scan `block` in program order, tracking the bits of live vector and
+  // accumulator values. `outerVector` and `outerAcc` are the bits that are
+  // live across the op that owns the block.
+  void scanBlock(Block &block, unsigned outerVector, unsigned outerAcc) {
+    // Index of the last op of the block that uses each value defined in it.
+    DenseMap<Operation *, unsigned> position;
+    unsigned index = 0;
+    for (Operation &op : block)
+      position[&op] = index++;
+    auto getLastUse = [&](Value value) {
+      unsigned last = 0;
+      for (Operation *user : value.getUsers())
+        if (Operation *ancestor = block.findAncestorOpInBlock(*user))
+          last = std::max(last, position[ancestor]);
+      return last;
+    };
+
+    // Bits that stop being live after the op at each index.
+    DenseMap<unsigned, std::pair<unsigned, unsigned>> dying;
+    unsigned liveVector = outerVector, liveAcc = outerAcc;
+    auto addLive = [&](unsigned bits, ValueKind kind, unsigned lastUse) {
+      if (kind == ValueKind::Acc) {
+        liveAcc += bits;
+        dying[lastUse].second += bits;
+      } else {
+        liveVector += bits;
+        dying[lastUse].first += bits;
+      }
+    };
+    for (BlockArgument arg : block.getArguments())
+      if (unsigned bits = getSizeInBits(arg))
+        addLive(bits, ValueKind::Vector, getLastUse(arg));
+    record(liveVector, liveAcc);
+
+    index = 0;
+    for (Operation &op : block) {
+      countOp(&op);
+      for (Region &region : op.getRegions())
+        for (Block &nested : region)
+          scanBlock(nested, liveVector, liveAcc);
+      ValueKind kind = getResultKind(&op, params.aieml);
+      if (kind != ValueKind::None && !op.getResult(0).use_empty())
+        addLive(getSizeInBits(op.getResult(0)), kind,
+                getLastUse(op.getResult(0)));
+      record(liveVector, liveAcc);
+      auto it = dying.find(index++);
+      if (it != dying.end()) {
+        liveVector -= it->second.first;
+        liveAcc -= it->second.second;
+      }
+    }
+  }
+
+  VectCost getCost() {
+    auto excess = [&](unsigned peak, unsigned capacity) {
+      if (peak <= capacity)
+        return 0u;
+      return (peak - capacity + params.registerBits - 1) / params.registerBits;
+    };
+    cost.spills = excess(cost.peakVectorBits, params.vectorRegisterBits) +
+                  excess(cost.peakAccBits, params.accRegisterBits);
+    return cost;
+  }
+
+private:
+  void record(unsigned liveVector, unsigned liveAcc) {
+    cost.peakVectorBits = std::max(cost.peakVectorBits, liveVector);
+    cost.peakAccBits = std::max(cost.peakAccBits, liveAcc);
+  }
+
+  const VectCostParams &params;
+  VectCost cost;
+};
+
+} // namespace
+
+VectCost xilinx::aievec::estimateVectCost(Operation *root,
+                                          const VectCostParams &params) {
+  CostEstimator estimator(params);
+  estimator.countOp(root);
+  for (Region &region : root->getRegions())
+    for (Block &block : region)
+      estimator.scanBlock(block, 0, 0);
+  return estimator.getCost();
+}
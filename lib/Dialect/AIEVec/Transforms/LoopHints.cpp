@@ -0,0 +1,265 @@
+//===- LoopHints.cpp - Loop and aliasing hints for kernels ------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+// This file implements the derivation of the facts the backend compilers need
+// to software-pipeline kernel loops: bounds on the trip count of each
+// `scf.for` and the memref arguments of each function that never alias. They
+// are attached as attributes, which the C++ emitter turns into chess pragmas
+// and the LLVM lowering into loop metadata and `noalias` arguments.
+//===----------------------------------------------------------------------===//
+
+#include "aie/Dialect/AIE/IR/AIEDialect.h"
+#include "aie/Dialect/AIEVec/Transforms/Passes.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/LLVMIR/LLVMDialect.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+#include "mlir/Support/MathExtras.h"
+
+#define DEBUG_TYPE "aie-loop-hints"
+
+using namespace mlir;
+using namespace xilinx;
+using namespace xilinx::aievec;
+
+namespace {
+
+// Constant lower and upper bounds (both inclusive) of an integer value.
+struct Bounds {
+  std::optional<int64_t> lo, hi;
+};
+
+static std::optional<int64_t> add(std::optional<int64_t> a,
+                                  std::optional<int64_t> b) {
+  if (!a || !b)
+    return std::nullopt;
+  return *a + *b;
+}
+
+// Return the constant bounds of `value` that can be derived from constants,
+// integer arithmetic, affine.min/max/apply and the bounds of enclosing loops.
+static Bounds getBounds(Value value, unsigned depth = 0) {
+  if (depth > 8)
+    return {};
+
+  if (auto iv = dyn_cast<BlockArgument>(value)) {
+    auto forOp = dyn_cast<scf::ForOp>(iv.getOwner()->getParentOp());
+    if (!forOp || forOp.getInductionVar() != iv)
+      return {};
+    Bounds lb = getBounds(forOp.getLowerBound(), depth + 1);
+    Bounds ub = getBounds(forOp.getUpperBound(), depth + 1);
+    return {lb.lo, add(ub.hi, -1)};
+  }
+
+  Operation *op = value.getDefiningOp();
+  if (!op)
+    return {};
+
+  APInt cst;
+  if (matchPattern(value, m_ConstantInt(&cst)))
+    return {cst.getSExtValue(), cst.getSExtValue()};
+
+  if (isa<arith::IndexCastOp, arith::IndexCastUIOp, arith::ExtSIOp>(op))
+    return getBounds(op->getOperand(0), depth + 1);
+
+  if (isa<arith::AddIOp, arith::SubIOp, arith::MinSIOp, arith::MaxSIOp>(op)) {
+    Bounds lhs = getBounds(op->getOperand(0), depth + 1);
+    Bounds rhs = getBounds(op->getOperand(1), depth + 1);
+    auto neg = [](std::optional<int64_t> v) -> std::optional<int64_t> {
+      if (!v)
+        return std::nullopt;
+      return -*v;
+    };
+    auto minOf = [](std::optional<int64_t> a, std::optional<int64_t> b) {
+      return a && b ? std::min(a, b) : std::nullopt;
+    };
+    auto maxOf = [](std::optional<int64_t> a, std::optional<int64_t> b) {
+      return a && b ? std::max(a, b) : std::nullopt;
+    };
+    // A bound of one operand is enough to bound a min from above or a max
+    // from below.
+    auto anyMin = [](std::optional<int64_t> a, std::optional<int64_t> b) {
+      return a && b ? std::min(a, b) : (a ? a : b);
+    };
+    auto anyMax = [](std::optional<int64_t> a, std::optional<int64_t> b) {
+      return a && b ? std::max(a, b) : (a ? a : b);
+    };
+    if (isa<arith::AddIOp>(op))
+      return {add(lhs.lo, rhs.lo), add(lhs.hi, rhs.hi)};
+    if (isa<arith::SubIOp>(op))
+      return {add(lhs.lo, neg(rhs.hi)), add(lhs.hi, neg(rhs.lo))};
+    if (isa<arith::MinSIOp>(op))
+      return {minOf(lhs.lo, rhs.lo), anyMin(lhs.hi, rhs.hi)};
+    return {anyMax(lhs.lo, rhs.lo), maxOf(lhs.hi, rhs.hi)};
+  }
+
+  // The results of affine.min and affine.max that are constants bound them
+  // from above and from below, respectively.
+  auto getConstantResults = [](AffineMap map) {
+    SmallVector<int64_t> results;
+    for (AffineExpr expr : map.getResults())
+      if (auto cstExpr = dyn_cast<AffineConstantExpr>(expr))
+        results.push_back(cstExpr.getValue());
+    return results;
+  };
+  if (auto minOp = dyn_cast<affine::AffineMinOp>(op)) {
+    SmallVector<int64_t> results = getConstantResults(minOp.getMap());
+    if (results.empty())
+      return {};
+    Bounds bounds{std::nullopt, *llvm::min_element(results)};
+    if (results.size() == minOp.getMap().getNumResults())
+      bounds.lo = bounds.hi;
+    return bounds;
+  }
+  if (auto maxOp = dyn_cast<affine::AffineMaxOp>(op)) {
+    SmallVector<int64_t> results = getConstantResults(maxOp.getMap());
+    if (results.empty())
+      return {};
+    Bounds bounds{*llvm::max_element(results), std::nullopt};
+    if (results.size() == maxOp.getMap().getNumResults())
+      bounds.hi = bounds.lo;
+    return bounds;
+  }
+  if (auto applyOp = dyn_cast<affine::AffineApplyOp>(op)) {
+    if (auto cstExpr =
+            dyn_cast<AffineConstantExpr>(applyOp.getAffineMap().getResult(0)))
+      return {cstExpr.getValue(), cstExpr.getValue()};
+  }
+  return {};
+}
+
+// Return the bounds of the number of iterations of `forOp`, or std::nullopt if
+// nothing is known about them.
+static std::optional<std::pair<int64_t, std::optional<int64_t>>>
+getTripCountBounds(scf::ForOp forOp) {
+  Bounds step = getBounds(forOp.getStep());
+  if (!step.lo || step.lo != step.hi || *step.lo <= 0)
+    return std::nullopt;
+  Bounds lb = getBounds(forOp.getLowerBound());
+  Bounds ub = getBounds(forOp.getUpperBound());
+
+  int64_t minTrip = 0;
+  if (lb.hi && ub.lo)
+    minTrip = std::max<int64_t>(0, ceilDiv(*ub.lo - *lb.hi, *step.lo));
+  std::optional<int64_t> maxTrip;
+  if (lb.lo && ub.hi)
+    maxTrip = std::max<int64_t>(0, ceilDiv(*ub.hi - *lb.lo, *step.lo));
+  if (!minTrip && !maxTrip)
+    return std::nullopt;
+  return std::make_pair(minTrip, maxTrip);
+}
+
+// The memory a memref points into: an allocation, a global or a buffer of a
+// tile. Distinct roots never overlap.
+struct MemRoot {
+  Operation *op = nullptr;
+  StringRef global;
+
+  bool operator==(const MemRoot &other) const {
+    if (!global.empty() || !other.global.empty())
+      return global == other.global;
+    return op == other.op;
+  }
+};
+
+static std::optional<MemRoot> getMemRoot(Value memref) {
+  while (auto viewOp = memref.getDefiningOp<ViewLikeOpInterface>())
+    memref = viewOp.getViewSource();
+  Operation *op = memref.getDefiningOp();
+  if (!op)
+    return std::nullopt;
+  if (auto getGlobalOp = dyn_cast<memref::GetGlobalOp>(op))
+    return MemRoot{op, getGlobalOp.getName()};
+  if (isa<AIE::BufferOp, AIE::ExternalBufferOp, memref::AllocOp,
+          memref::AllocaOp>(op))
+    return MemRoot{op, {}};
+  return std::nullopt;
+}
+
+struct AIELoopHintsPass : AIELoopHintsBase<AIELoopHintsPass> {
+  void runOnOperation() override {
+    ModuleOp moduleOp = getOperation();
+    moduleOp.walk([&](scf::ForOp forOp) { annotateLoop(forOp); });
+
+    DenseMap<StringAttr, SmallVector<func::CallOp>> calls;
+    moduleOp.walk([&](func::CallOp callOp) {
+      calls[callOp.getCalleeAttr().getAttr()].push_back(callOp);
+    });
+    moduleOp.walk([&](func::FuncOp funcOp) {
+      annotateArguments(funcOp, calls.lookup(funcOp.getSymNameAttr()));
+    });
+  }
+
+  void annotateLoop(scf::ForOp forOp) {
+    MLIRContext *ctx = forOp.getContext();
+    if (auto tripCount = getTripCountBounds(forOp)) {
+      SmallVector<int64_t, 2> range{tripCount->first};
+      if (tripCount->second)
+        range.push_back(*tripCount->second);
+      forOp->setAttr("aie.loop_range", DenseI64ArrayAttr::get(ctx, range));
+    }
+    if (!clPipeline)
+      return;
+    auto pipeline = LLVM::LoopPipelineAttr::get(
+        ctx, BoolAttr::get(ctx, false), IntegerAttr());
+    auto annotation = LLVM::LoopAnnotationAttr::get(
+        ctx, {}, {}, {}, {}, {}, {}, {}, pipeline, {}, {},
+        BoolAttr::get(ctx, true), {}, {}, {}, {});
+    forOp->setAttr(LLVM::LLVMDialect::getLoopAnnotationAttrName(),
+                   annotation);
+  }
+
+  // Mark the memref arguments of `funcOp` that do not alias any other memref
+  // argument at any of its call sites. Only functions whose callers are all
+  // known are considered: private ones, and those of an AIE device, which are
+  // only called from its cores.
+  void annotateArguments(func::FuncOp funcOp, ArrayRef<func::CallOp> calls) {
+    if (funcOp.isDeclaration() || calls.empty() ||
+        (funcOp.isPublic() && !funcOp->getParentOfType<AIE::DeviceOp>()))
+      return;
+
+    // Globals accessed directly from the body may alias an argument too.
+    SmallVector<MemRoot> bodyRoots;
+    funcOp.walk([&](memref::GetGlobalOp getGlobalOp) {
+      bodyRoots.push_back(MemRoot{getGlobalOp, getGlobalOp.getName()});
+    });
+
+    for (auto [idx, argType] : llvm::enumerate(funcOp.getArgumentTypes())) {
+      if (!isa<MemRefType>(argType))
+        continue;
+      bool noAlias = llvm::all_of(calls, [&](func::CallOp callOp) {
+        auto root = getMemRoot(callOp.getOperand(idx));
+        if (!root || llvm::is_contained(bodyRoots, *root))
+          return false;
+        for (auto [otherIdx, other] : llvm::enumerate(callOp.getOperands())) {
+          if (otherIdx == idx || !isa<MemRefType>(other.getType()))
+            continue;
+          auto otherRoot = getMemRoot(other);
+          if (!otherRoot || *otherRoot == *root)
+            return false;
+        }
+        return true;
+      });
+      if (noAlias)
+        funcOp.setArgAttr(idx, LLVM::LLVMDialect::getNoAliasAttrName(),
+                          UnitAttr::get(funcOp.getContext()));
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<Pass> xilinx::aievec::createAIELoopHintsPass() {
+  return std::make_unique<AIELoopHintsPass>();
+}
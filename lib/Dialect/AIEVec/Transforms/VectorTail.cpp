@@ -0,0 +1,362 @@
+//===- VectorTail.cpp - Vector prologues and epilogues ----------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+// This file implements the splitting of the loops produced by the affine
+// super-vectorizer into a main loop that only accesses whole, aligned vectors,
+// and prologue/epilogue code for the leftover iterations. The leftovers are
+// either peeled into narrower vectors and scalar code, or, where the
+// full-width accesses stay within their memrefs, computed with full-width
+// vectors whose stores are masked with a select.
+//===----------------------------------------------------------------------===//
+
+#include "aie/Dialect/AIEVec/Transforms/Passes.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/IR/IRMapping.h"
+
+#define DEBUG_TYPE "aie-vector-tail"
+
+using namespace mlir;
+using namespace xilinx;
+using namespace xilinx::aievec;
+
+namespace {
+
+// Return true if the transfer accesses consecutive elements of the innermost
+// dimension, or, for reads, broadcasts a single element.
+static bool isSupportedTransfer(VectorTransferOpInterface op) {
+  if (op.getMask())
+    return false;
+  AffineMap map = op.getPermutationMap();
+  if (map.isMinorIdentity())
+    return true;
+  return isa<vector::TransferReadOp>(op) && map.isConstant();
+}
+
+// Return the number of lanes of the vectors in the body of `forOp`, if it is a
+// loop produced by the affine super-vectorizer that can be split: it has
+// constant bounds, a step equal to the number of lanes, and a body made only
+// of supported transfers, scalar broadcasts, splat constants and element-wise
+// ops on 1-d vectors.
+static std::optional<int64_t> getVectorLanes(affine::AffineForOp forOp) {
+  int64_t step = forOp.getStepAsInt();
+  if (!forOp.hasConstantBounds() || step <= 1 ||
+      forOp.getConstantLowerBound() < 0 || forOp.getNumIterOperands())
+    return std::nullopt;
+
+  bool hasVectors = false;
+  auto isVectorOfLanes = [&](Type type) {
+    auto vecType = dyn_cast<VectorType>(type);
+    if (!vecType)
+      return true;
+    hasVectors = true;
+    return vecType.getRank() == 1 && vecType.getDimSize(0) == step &&
+           !vecType.isScalable();
+  };
+  auto isVector = [](Type type) { return isa<VectorType>(type); };
+  for (Operation &op : forOp.getBody()->without_terminator()) {
+    if (op.getNumRegions())
+      return std::nullopt;
+    if (!llvm::all_of(op.getOperandTypes(), isVectorOfLanes) ||
+        !llvm::all_of(op.getResultTypes(), isVectorOfLanes))
+      return std::nullopt;
+    if (auto transferOp = dyn_cast<VectorTransferOpInterface>(op)) {
+      if (!isSupportedTransfer(transferOp))
+        return std::nullopt;
+      continue;
+    }
+    // Ops that do not touch vectors are kept as they are.
+    if (llvm::none_of(op.getOperandTypes(), isVector) &&
+        llvm::none_of(op.getResultTypes(), isVector))
+      continue;
+    if (auto bcastOp = dyn_cast<vector::BroadcastOp>(op)) {
+      if (isa<VectorType>(bcastOp.getSourceType()))
+        return std::nullopt;
+      continue;
+    }
+    if (auto cstOp = dyn_cast<arith::ConstantOp>(op)) {
+      if (!isa<SplatElementsAttr>(cstOp.getValue()))
+        return std::nullopt;
+      continue;
+    }
+    if (!OpTrait::hasElementwiseMappableTraits(&op) ||
+        llvm::none_of(op.getResultTypes(), isVector))
+      return std::nullopt;
+  }
+  if (!hasVectors)
+    return std::nullopt;
+  return step;
+}
+
+// Return `type` with `lanes` lanes, or its element type for a single lane.
+static Type getNarrowedType(Type type, int64_t lanes) {
+  auto vecType = dyn_cast<VectorType>(type);
+  if (!vecType)
+    return type;
+  if (lanes == 1)
+    return vecType.getElementType();
+  return VectorType::get({lanes}, vecType.getElementType());
+}
+
+static SmallVector<Value> lookupOrDefault(IRMapping &mapping,
+                                          ValueRange values) {
+  return llvm::to_vector(llvm::map_range(
+      values, [&](Value value) { return mapping.lookupOrDefault(value); }));
+}
+
+// Clone the body of `forOp` into `b`, with `iv` in place of the induction
+// variable and `lanes` lanes per vector. With one lane, the body is
+// scalarized: transfers become memref loads and stores.
+static void cloneNarrowedBody(OpBuilder &b, affine::AffineForOp forOp,
+                              Value iv, int64_t lanes) {
+  IRMapping mapping;
+  mapping.map(forOp.getInductionVar(), iv);
+  for (Operation &op : forOp.getBody()->without_terminator()) {
+    Location loc = op.getLoc();
+    if (lanes == 1) {
+      if (auto readOp = dyn_cast<vector::TransferReadOp>(op)) {
+        Value load = b.create<memref::LoadOp>(
+            loc, mapping.lookupOrDefault(readOp.getSource()),
+            lookupOrDefault(mapping, readOp.getIndices()));
+        mapping.map(readOp.getVector(), load);
+        continue;
+      }
+      if (auto writeOp = dyn_cast<vector::TransferWriteOp>(op)) {
+        b.create<memref::StoreOp>(
+            loc, mapping.lookupOrDefault(writeOp.getVector()),
+            mapping.lookupOrDefault(writeOp.getSource()),
+            lookupOrDefault(mapping, writeOp.getIndices()));
+        continue;
+      }
+      if (auto bcastOp = dyn_cast<vector::BroadcastOp>(op)) {
+        mapping.map(bcastOp.getVector(),
+                    mapping.lookupOrDefault(bcastOp.getSource()));
+        continue;
+      }
+    }
+    if (auto cstOp = dyn_cast<arith::ConstantOp>(op)) {
+      if (auto splat = dyn_cast<SplatElementsAttr>(cstOp.getValue())) {
+        Type type = getNarrowedType(splat.getType(), lanes);
+        auto value = splat.getSplatValue<Attribute>();
+        if (lanes > 1)
+          value = DenseElementsAttr::get(cast<ShapedType>(type), value);
+        mapping.map(cstOp.getResult(),
+                    b.create<arith::ConstantOp>(loc, cast<TypedAttr>(value)));
+        continue;
+      }
+    }
+    Operation *newOp = b.clone(op, mapping);
+    for (OpResult result : newOp->getResults())
+      result.setType(getNarrowedType(result.getType(), lanes));
+  }
+}
+
+// Return the constant `c` if `index` is `iv + c`, either `iv` itself or an
+// affine.apply of it.
+static std::optional<int64_t> getOffsetFromIV(Value index, Value iv) {
+  if (index == iv)
+    return 0;
+  auto applyOp = index.getDefiningOp<affine::AffineApplyOp>();
+  if (!applyOp || applyOp.getMapOperands().size() != 1 ||
+      applyOp.getMapOperands()[0] != iv ||
+      applyOp.getAffineMap().getNumDims() != 1)
+    return std::nullopt;
+  AffineExpr offset = simplifyAffineExpr(
+      applyOp.getAffineMap().getResult(0) -
+          getAffineDimExpr(0, index.getContext()),
+      /*numDims=*/1, /*numSymbols=*/0);
+  if (auto cst = dyn_cast<AffineConstantExpr>(offset))
+    return cst.getValue();
+  return std::nullopt;
+}
+
+// Return true if every transfer in the body of `forOp`, run for the full
+// vector of iterations starting at `base`, stays within the static shape of
+// its memref. Accesses that do not depend on the induction variable are the
+// same as in the original loop.
+static bool isMaskedBodyInBounds(affine::AffineForOp forOp, int64_t base) {
+  int64_t lanes = forOp.getStepAsInt();
+  Value iv = forOp.getInductionVar();
+  for (Operation &op : forOp.getBody()->without_terminator()) {
+    auto transferOp = dyn_cast<VectorTransferOpInterface>(op);
+    if (!transferOp)
+      continue;
+    ValueRange indices = transferOp.getIndices();
+    if (llvm::any_of(indices.drop_back(), [&](Value index) {
+          return !forOp.isDefinedOutsideOfLoop(index);
+        }))
+      return false;
+    if (forOp.isDefinedOutsideOfLoop(indices.back()))
+      continue;
+    auto memrefType = dyn_cast<MemRefType>(transferOp.getSource().getType());
+    if (!memrefType || memrefType.isDynamicDim(memrefType.getRank() - 1))
+      return false;
+    std::optional<int64_t> offset = getOffsetFromIV(indices.back(), iv);
+    if (!offset)
+      return false;
+    // Broadcasting reads access a single element.
+    int64_t width =
+        transferOp.getPermutationMap().isMinorIdentity() ? lanes : 1;
+    int64_t first = base + *offset;
+    if (first < 0 ||
+        first + width > memrefType.getDimSize(memrefType.getRank() - 1))
+      return false;
+  }
+  return true;
+}
+
+// Clone the body of `forOp` into `b` for a full vector of iterations starting
+// at `iv`, of which only lanes [`first`, `last`) are in the iteration space.
+// The other lanes of each store keep the value in memory.
+static void cloneMaskedBody(OpBuilder &b, affine::AffineForOp forOp, Value iv,
+                            int64_t first, int64_t last) {
+  int64_t lanes = forOp.getStepAsInt();
+  SmallVector<bool> maskBits(lanes, false);
+  for (int64_t lane = first; lane < last; ++lane)
+    maskBits[lane] = true;
+  auto maskType = VectorType::get({lanes}, b.getI1Type());
+  Value mask = b.create<arith::ConstantOp>(
+      forOp.getLoc(), DenseElementsAttr::get(maskType, maskBits));
+
+  IRMapping mapping;
+  mapping.map(forOp.getInductionVar(), iv);
+  for (Operation &op : forOp.getBody()->without_terminator()) {
+    auto writeOp = dyn_cast<vector::TransferWriteOp>(op);
+    if (!writeOp) {
+      b.clone(op, mapping);
+      continue;
+    }
+    Location loc = writeOp.getLoc();
+    Value source = mapping.lookupOrDefault(writeOp.getSource());
+    SmallVector<Value> indices = lookupOrDefault(mapping, writeOp.getIndices());
+    VectorType vecType = writeOp.getVectorType();
+    Type elemType = vecType.getElementType();
+    Value padding = b.create<arith::ConstantOp>(loc, b.getZeroAttr(elemType));
+    Value old = b.create<vector::TransferReadOp>(loc, vecType, source, indices,
+                                                 padding);
+    Value value = b.create<arith::SelectOp>(
+        loc, mask, mapping.lookupOrDefault(writeOp.getVector()), old);
+    b.create<vector::TransferWriteOp>(loc, value, source, indices);
+  }
+}
+
+struct AIEVectorTailPass : AIEVectorTailBase<AIEVectorTailPass> {
+  void runOnOperation() override {
+    std::string mode = clMode;
+    if (mode != "peel" && mode != "mask") {
+      getOperation().emitError() << "unknown tail mode '" << mode << "'";
+      return signalPassFailure();
+    }
+
+    SmallVector<std::pair<affine::AffineForOp, int64_t>> loops;
+    getOperation().walk([&](affine::AffineForOp forOp) {
+      if (auto lanes = getVectorLanes(forOp))
+        loops.push_back({forOp, *lanes});
+    });
+    for (auto [forOp, lanes] : loops)
+      splitLoop(forOp, lanes, mode == "mask");
+  }
+
+  // Split `forOp` into an alignment prologue, a main loop over whole aligned
+  // vectors, and an epilogue for the leftover iterations.
+  void splitLoop(affine::AffineForOp forOp, int64_t lanes, bool masked) {
+    int64_t lb = forOp.getConstantLowerBound();
+    int64_t ub = forOp.getConstantUpperBound();
+    int64_t alignedLb = std::min<int64_t>(llvm::alignTo(lb, lanes), ub);
+    int64_t mainUb = alignedLb + (ub - alignedLb) / lanes * lanes;
+    if (alignedLb == lb && mainUb == ub)
+      return;
+
+    OpBuilder b(forOp);
+    emitPartialIterations(b, forOp, lanes, lb, alignedLb, masked);
+    b.setInsertionPointAfter(forOp);
+    emitPartialIterations(b, forOp, lanes, mainUb, ub, masked);
+
+    if (mainUb == alignedLb) {
+      forOp.erase();
+      return;
+    }
+    forOp.setConstantLowerBound(alignedLb);
+    forOp.setConstantUpperBound(mainUb);
+  }
+
+  // Emit the iterations [`from`, `to`) of `forOp`, which all fall in one
+  // aligned vector.
+  void emitPartialIterations(OpBuilder &b, affine::AffineForOp forOp,
+                             int64_t lanes, int64_t from, int64_t to,
+                             bool masked) {
+    if (from == to)
+      return;
+    auto emitLoop = [&](int64_t lb, int64_t ub, int64_t step,
+                        function_ref<void(OpBuilder &, Value)> bodyBuilder) {
+      b.create<affine::AffineForOp>(
+          forOp.getLoc(), lb, ub, step, ValueRange{},
+          [&](OpBuilder &nested, Location loc, Value iv, ValueRange) {
+            bodyBuilder(nested, iv);
+            nested.create<affine::AffineYieldOp>(loc);
+          });
+    };
+
+    int64_t base = from / lanes * lanes;
+    if (masked && isMaskedBodyInBounds(forOp, base)) {
+      emitLoop(base, base + lanes, lanes, [&](OpBuilder &nested, Value iv) {
+        cloneMaskedBody(nested, forOp, iv, from - base, to - base);
+      });
+      return;
+    }
+
+    // Peel the iterations into the widest aligned vectors that fit, and
+    // scalar code for what is too narrow to be vectorized.
+    int64_t minLanes = getMinLanes(forOp);
+    int64_t pos = from;
+    while (pos < to) {
+      int64_t width = lanes / 2;
+      while (width >= minLanes && (pos % width || pos + width > to))
+        width /= 2;
+      if (width >= minLanes) {
+        emitLoop(pos, pos + width, width, [&](OpBuilder &nested, Value iv) {
+          cloneNarrowedBody(nested, forOp, iv, width);
+        });
+        pos += width;
+        continue;
+      }
+      int64_t end = std::min<int64_t>(llvm::alignTo(pos + 1, minLanes), to);
+      emitLoop(pos, end, 1, [&](OpBuilder &nested, Value iv) {
+        cloneNarrowedBody(nested, forOp, iv, 1);
+      });
+      pos = end;
+    }
+  }
+
+  // Return the fewest lanes for which every vector in the body of `forOp` is
+  // at least `min-vector-bits` wide.
+  int64_t getMinLanes(affine::AffineForOp forOp) {
+    int64_t minLanes = 2;
+    forOp.getBody()->walk([&](Operation *op) {
+      for (Type type : op->getResultTypes())
+        if (auto vecType = dyn_cast<VectorType>(type)) {
+          int64_t bits = vecType.getElementTypeBitWidth();
+          minLanes = std::max<int64_t>(
+              minLanes, llvm::PowerOf2Ceil(llvm::divideCeil(clMinVectorBits,
+                                                            bits)));
+        }
+    });
+    return minLanes;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<Pass> xilinx::aievec::createAIEVectorTailPass() {
+  return std::make_unique<AIEVectorTailPass>();
+}
@@ -22,6 +22,7 @@
 #include "mlir/Dialect/Math/IR/Math.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Matchers.h"
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/IR/TypeUtilities.h"
 #include "mlir/Pass/PassManager.h"
@@ -372,6 +373,16 @@ static aievec::CmpOp createCmpOpAieML(ConversionPatternRewriter &rewriter,
   return nullptr;
 }
 
+// Replace `srcOp` with `result`, the reduction of its vector operand, folding
+// in the accumulator operand if there is one.
+static void replaceReductionOp(ConversionPatternRewriter &rewriter,
+                               vector::ReductionOp srcOp, Value result) {
+  if (Value acc = srcOp.getAcc())
+    result = vector::makeArithReduction(rewriter, srcOp.getLoc(),
+                                        srcOp.getKind(), result, acc);
+  rewriter.replaceOp(srcOp, result);
+}
+
 template <typename DstOpTy>
 static void generateAIEVecOpsForReductionOp(ConversionPatternRewriter &rewriter,
                                             vector::ReductionOp srcOp,
@@ -401,8 +412,9 @@ static void generateAIEVecOpsForReductionOp(ConversionPatternRewriter &rewriter,
 
   auto zeroConstOp =
       rewriter.create<arith::ConstantOp>(loc, rewriter.getI32IntegerAttr(0));
-  rewriter.replaceOpWithNewOp<aievec::ExtElemOp>(srcOp, scalarType, curOp,
-                                                 zeroConstOp.getResult());
+  auto extElemOp = rewriter.create<aievec::ExtElemOp>(loc, scalarType, curOp,
+                                                      zeroConstOp.getResult());
+  replaceReductionOp(rewriter, srcOp, extElemOp.getResult());
 }
 
 //===----------------------------------------------------------------------===//
@@ -1355,6 +1367,9 @@ using LowerVectorCmpFOpToAIEVecCmpOp =
 struct LowerVectorSelectOpToAIEVecSelOp : OpConversionPattern<arith::SelectOp> {
   using OpConversionPattern::OpConversionPattern;
 
+  LowerVectorSelectOpToAIEVecSelOp(MLIRContext *context, bool cppBackend)
+      : OpConversionPattern(context), cppBackend(cppBackend) {}
+
   LogicalResult
   matchAndRewrite(arith::SelectOp srcOp, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
@@ -1378,15 +1393,45 @@ struct LowerVectorSelectOpToAIEVecSelOp : OpConversionPattern<arith::SelectOp> {
         mlir::IntegerType::get(srcOp.getContext(), laneSize <= 32 ? 32 : 64,
                                mlir::IntegerType::Unsigned);
 
-    auto convertOp = rewriter.create<UnrealizedConversionCastOp>(
-        srcOp.getLoc(), type, adaptor.getCondition());
+    // A constant condition, e.g. the lane mask of a partial vector, is folded
+    // into an immediate bitmask where bit i selects lane i of the true value.
+    // arith.constant only takes signless integers, so for LLVM IR the mask is
+    // cast to the unsigned type; the emitter prints emitc.constant directly.
+    Value mask;
+    DenseIntElementsAttr condAttr;
+    if (matchPattern(srcOp.getCondition(), m_Constant(&condAttr))) {
+      uint64_t bits = 0;
+      for (auto [i, lane] : llvm::enumerate(condAttr.getValues<bool>()))
+        if (lane)
+          bits |= uint64_t(1) << i;
+      if (cppBackend) {
+        mask = rewriter.create<emitc::ConstantOp>(
+            srcOp.getLoc(), type, rewriter.getIntegerAttr(type, bits));
+      } else {
+        Type signlessType =
+            rewriter.getIntegerType(type.getIntOrFloatBitWidth());
+        Value bitsCst = rewriter.create<arith::ConstantOp>(
+            srcOp.getLoc(), rewriter.getIntegerAttr(signlessType, bits));
+        mask = rewriter
+                   .create<UnrealizedConversionCastOp>(srcOp.getLoc(), type,
+                                                       bitsCst)
+                   .getResult(0);
+      }
+    } else {
+      mask = rewriter
+                 .create<UnrealizedConversionCastOp>(srcOp.getLoc(), type,
+                                                     adaptor.getCondition())
+                 .getResult(0);
+    }
 
     rewriter.replaceOpWithNewOp<aievec::SelOp>(
         srcOp, srcOp.getResult().getType(), srcOp.getTrueValue(),
-        srcOp.getFalseValue(), convertOp.getResult(0));
+        srcOp.getFalseValue(), mask);
 
     return success();
   }
+
+  bool cppBackend;
 };
 
 struct LowerVectorReductionMinOp : OpConversionPattern<vector::ReductionOp> {
@@ -1535,8 +1580,9 @@ struct LowerVectorReductionAddFloatOp
 
     auto zeroConstOp =
         rewriter.create<arith::ConstantOp>(loc, rewriter.getI32IntegerAttr(0));
-    rewriter.replaceOpWithNewOp<aievec::ExtElemOp>(srcOp, scalarType, curOp,
-                                                   zeroConstOp.getResult());
+    auto extElemOp = rewriter.create<aievec::ExtElemOp>(
+        loc, scalarType, curOp, zeroConstOp.getResult());
+    replaceReductionOp(rewriter, srcOp, extElemOp.getResult());
     return success();
   }
 };
@@ -1597,8 +1643,9 @@ struct LowerVectorReductionAddBfloat16Op
 
     auto zeroConstOp =
         rewriter.create<arith::ConstantOp>(loc, rewriter.getI32IntegerAttr(0));
-    rewriter.replaceOpWithNewOp<aievec::ExtElemOp>(srcOp, scalarType, concatOp,
-                                                   zeroConstOp.getResult());
+    auto extElemOp = rewriter.create<aievec::ExtElemOp>(
+        loc, scalarType, concatOp, zeroConstOp.getResult());
+    replaceReductionOp(rewriter, srcOp, extElemOp.getResult());
     return success();
   }
 };
@@ -2014,6 +2061,58 @@ struct ComputeAbsOpPattern : OpConversionPattern<SrcOpTy> {
 using ComputeAbsFOpPattern = ComputeAbsOpPattern<math::AbsFOp>;
 using ComputeAbsIOpPattern = ComputeAbsOpPattern<math::AbsIOp>;
 
+// Return the number of lanes of `aievec.unpack` when it widens `srcType` to
+// `dstType` elements: i4 to i8 and, for vectors too short for `aievec.ups`,
+// i8 to i16. Return 0 if the conversion is not done by unpacking.
+static unsigned getUnpackLanes(VectorType srcType, VectorType dstType) {
+  auto srcElemType = dyn_cast<IntegerType>(srcType.getElementType());
+  auto dstElemType = dyn_cast<IntegerType>(dstType.getElementType());
+  if (!srcElemType || !dstElemType)
+    return 0;
+  unsigned srcWidth = srcElemType.getWidth();
+  unsigned dstWidth = dstElemType.getWidth();
+  unsigned lanes = getVectorLaneSize(srcType);
+  unsigned unpackLanes = 0;
+  if (srcWidth == 4 && dstWidth == 8)
+    unpackLanes = 64;
+  else if (srcWidth == 8 && dstWidth == 16 && lanes < 32)
+    unpackLanes = 32;
+  // Shorter vectors are replicated up to the unpacked size, of which at most
+  // an eighth can be extracted.
+  if (!unpackLanes || !llvm::isPowerOf2_32(lanes) || lanes > unpackLanes ||
+      unpackLanes / lanes > 8)
+    return 0;
+  return unpackLanes;
+}
+
+// Widen `source` to `dstType` with an `aievec.unpack`. Multi-dimensional
+// vectors are flattened, and vectors shorter than `unpackLanes` are
+// replicated with an `aievec.concat`, and the result extracted with an
+// `aievec.ext`.
+static Value widenByUnpack(ConversionPatternRewriter &rewriter, Location loc,
+                           Value source, VectorType dstType,
+                           unsigned unpackLanes) {
+  auto srcType = cast<VectorType>(source.getType());
+  unsigned lanes = getVectorLaneSize(srcType);
+  Type srcElemType = srcType.getElementType();
+  Type dstElemType = dstType.getElementType();
+  if (srcType.getRank() != 1)
+    source = rewriter.create<vector::ShapeCastOp>(
+        loc, createVectorType(lanes, srcElemType), source);
+  if (lanes < unpackLanes)
+    source = rewriter.create<aievec::ConcatOp>(
+        loc, createVectorType(unpackLanes, srcElemType),
+        SmallVector<Value>(unpackLanes / lanes, source));
+  Value result = rewriter.create<aievec::UnpackOp>(
+      loc, createVectorType(unpackLanes, dstElemType), source);
+  if (lanes < unpackLanes)
+    result = rewriter.create<aievec::ExtOp>(
+        loc, createVectorType(lanes, dstElemType), result, 0);
+  if (dstType.getRank() != 1)
+    result = rewriter.create<vector::ShapeCastOp>(loc, dstType, result);
+  return result;
+}
+
 template <typename SrcOpTy>
 struct LowerExtOpPattern : OpConversionPattern<SrcOpTy> {
   using OpConversionPattern<SrcOpTy>::OpConversionPattern;
@@ -2025,6 +2124,15 @@ struct LowerExtOpPattern : OpConversionPattern<SrcOpTy> {
     VectorType srcType = dyn_cast<VectorType>(extOp.getIn().getType());
     VectorType dstType = dyn_cast<VectorType>(extOp.getOut().getType());
 
+    if constexpr (std::is_same_v<SrcOpTy, arith::ExtSIOp>) {
+      if (unsigned unpackLanes = getUnpackLanes(srcType, dstType)) {
+        rewriter.replaceOp(extOp,
+                           widenByUnpack(rewriter, extOp.getLoc(),
+                                         extOp.getIn(), dstType, unpackLanes));
+        return success();
+      }
+    }
+
     auto accType = getVectorOpDestType(srcType, /*AIEML =*/true);
     auto upsOp =
         rewriter.create<aievec::UPSOp>(extOp.getLoc(), accType, extOp.getIn());
@@ -2250,6 +2358,135 @@ struct ComputeSigmoidOpPattern : OpConversionPattern<arith::DivFOp> {
   }
 };
 
+// Replace `op` with a call to `callee` from poly_approx_ops.h. A nonzero
+// `order` is passed as template argument, selecting the accuracy of the
+// approximation.
+static void replaceOpWithPolyApproxCall(ConversionPatternRewriter &rewriter,
+                                        Operation *op, Type resultType,
+                                        Value operand, StringRef callee,
+                                        unsigned order) {
+  StringRef includeName = "poly_approx_ops.h";
+  auto moduleOp = op->getParentOfType<mlir::ModuleOp>();
+  rewriter.setInsertionPointToStart(&moduleOp.getRegion().getBlocks().front());
+  rewriter.create<emitc::IncludeOp>(moduleOp.getLoc(), includeName, false);
+
+  rewriter.setInsertionPoint(op);
+  ArrayAttr templateArgs = nullptr;
+  if (order)
+    templateArgs = rewriter.getArrayAttr({rewriter.getI32IntegerAttr(order)});
+  rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
+      op, TypeRange{resultType}, callee, nullptr, templateArgs,
+      SmallVector<Value>{operand});
+}
+
+// Convert math.exp, math.tanh, math.erf and math.rsqrt on v16bfloat16 and
+// v32bfloat16 to a call to the polynomial approximation `callee`.
+template <typename SrcOpTy>
+struct ComputeOpByPolyApproxPattern : OpConversionPattern<SrcOpTy> {
+  using OpConversionPattern<SrcOpTy>::OpConversionPattern;
+  using OpAdaptor = typename SrcOpTy::Adaptor;
+
+  ComputeOpByPolyApproxPattern(MLIRContext *context, StringRef callee,
+                               unsigned order)
+      : OpConversionPattern<SrcOpTy>(context), callee(callee), order(order) {}
+
+  LogicalResult
+  matchAndRewrite(SrcOpTy srcOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto srcType = dyn_cast<VectorType>(adaptor.getOperand().getType());
+    if (!srcType)
+      return failure();
+
+    Type scalarType = srcType.getElementType();
+    if (!isa<FloatType>(scalarType))
+      return failure();
+
+    unsigned laneSize = getVectorLaneSize(srcType);
+    unsigned elWidth = scalarType.getIntOrFloatBitWidth();
+    if (elWidth != 16 || (laneSize != 16 && laneSize != 32))
+      return failure();
+
+    replaceOpWithPolyApproxCall(rewriter, srcOp, srcType, adaptor.getOperand(),
+                                callee, order);
+    return success();
+  }
+
+  std::string callee;
+  unsigned order;
+};
+
+// Convert the sigmoid computation chain matched by ComputeSigmoidOpPattern to
+// a call to getSigmoidBf16Poly.
+struct ComputeSigmoidOpByPolyApproxPattern
+    : OpConversionPattern<arith::DivFOp> {
+  using OpConversionPattern::OpConversionPattern;
+
+  ComputeSigmoidOpByPolyApproxPattern(MLIRContext *context, unsigned order)
+      : OpConversionPattern(context), order(order) {}
+
+  LogicalResult
+  matchAndRewrite(arith::DivFOp divfOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto srcType = dyn_cast<VectorType>(adaptor.getLhs().getType());
+    if (!srcType)
+      return failure();
+
+    Type scalarType = srcType.getElementType();
+    if (!isa<FloatType>(scalarType))
+      return failure();
+
+    unsigned laneSize = getVectorLaneSize(srcType);
+    unsigned elWidth = scalarType.getIntOrFloatBitWidth();
+    if (elWidth != 16 || (laneSize != 16 && laneSize != 32))
+      return failure();
+
+    arith::NegFOp negOp = nullptr;
+    if (!hasSigmoidComputationChain(adaptor, negOp))
+      return failure();
+
+    replaceOpWithPolyApproxCall(rewriter, divfOp, srcType, negOp.getOperand(),
+                                "getSigmoidBf16Poly", order);
+    return success();
+  }
+
+  unsigned order;
+};
+
+// Convert the scalar inverse matched by ComputeInvOpByLUTPattern to a call to
+// getInvBf16Poly.
+struct ComputeInvOpByPolyApproxPattern : OpConversionPattern<arith::DivFOp> {
+  using OpConversionPattern::OpConversionPattern;
+
+  ComputeInvOpByPolyApproxPattern(MLIRContext *context, unsigned order)
+      : OpConversionPattern(context), order(order) {}
+
+  LogicalResult
+  matchAndRewrite(arith::DivFOp divOp, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Type srcType = adaptor.getLhs().getType();
+    if (!divOp->hasOneUse() || isa<VectorType>(srcType) ||
+        !isa<FloatType>(srcType))
+      return failure();
+
+    auto truncOp = dyn_cast<arith::TruncFOp>(*divOp->getUsers().begin());
+    if (!truncOp || cast<FloatType>(srcType).getWidth() != 32)
+      return failure();
+
+    auto constOp = dyn_cast<arith::ConstantOp>(divOp.getLhs().getDefiningOp());
+    if (!constOp ||
+        constOp.getValue().cast<FloatAttr>().getValue().convertToDouble() !=
+            1.0f)
+      return failure();
+
+    replaceOpWithPolyApproxCall(rewriter, truncOp, truncOp.getType(),
+                                adaptor.getRhs(), "getInvBf16Poly", order);
+    rewriter.eraseOp(divOp);
+    return success();
+  }
+
+  unsigned order;
+};
+
 // Convert math.ceil to a function call to compute ceil(x) for v16bfloat16
 struct ComputeCeilOpPattern : OpConversionPattern<math::CeilOp> {
   using OpConversionPattern::OpConversionPattern;
@@ -2595,6 +2832,28 @@ struct LowerVectorContractionOpToAIEVecMatMulPattern
         matmulOp = rewriter.create<aievec::MatMulOp>(
             contractOp.getLoc(), acc.getType(), lhs, rhs, acc);
       }
+      // The hardware does not multiply an lhs narrower than the rhs, e.g. i4
+      // x i8 or i8 x i16. Widen the lhs to the type of the rhs; the widening
+      // is lowered to `aievec.unpack` later on.
+      auto lhsTy = cast<VectorType>(lhs.getType());
+      auto rhsTy = cast<VectorType>(rhs.getType());
+      if (failed(matmulOp.verifyInvariants()) &&
+          isa<IntegerType>(lhsTy.getElementType()) &&
+          isa<IntegerType>(rhsTy.getElementType()) &&
+          lhsTy.getElementTypeBitWidth() < rhsTy.getElementTypeBitWidth() &&
+          !adaptor.getLhs().getDefiningOp<arith::ExtUIOp>()) {
+        rewriter.eraseOp(matmulOp);
+        auto wideLhs = rewriter.create<arith::ExtSIOp>(
+            contractOp.getLoc(),
+            VectorType::get(lhsTy.getShape(), rhsTy.getElementType()), lhs);
+        matmulOp = rewriter.create<aievec::MatMulOp>(
+            contractOp.getLoc(), acc.getType(), wideLhs, rhs, acc);
+        if (failed(matmulOp.verifyInvariants())) {
+          rewriter.eraseOp(matmulOp);
+          rewriter.eraseOp(wideLhs);
+          return failure();
+        }
+      }
       if (failed(matmulOp.verifyInvariants()))
         return failure();
     }
@@ -2635,26 +2894,47 @@ static void populateAIEVecV1ConversionPatterns(RewritePatternSet &patterns,
   // clang-format on
 }
 
+// Add the patterns lowering transcendental math ops to library calls. With
+// `polyApprox` set, exp, inv, tanh, erf, rsqrt and sigmoid are computed by
+// polynomial approximations of order `order` instead of lookup tables.
+static void populateAIEVecV2MathPatterns(RewritePatternSet &patterns,
+                                         bool polyApprox, unsigned order) {
+  MLIRContext *context = patterns.getContext();
+  patterns.add<ComputeSqrtOpPattern>(context);
+  if (!polyApprox) {
+    patterns.add<ComputeExpOpByLUTPattern, ComputeInvOpByLUTPattern,
+                 ComputeTanhOpByLUTPattern, ComputeRsqrtOpPattern,
+                 ComputeErfOpPattern, ComputeSigmoidOpPattern>(context);
+    return;
+  }
+  patterns.add<ComputeOpByPolyApproxPattern<math::ExpOp>>(
+      context, "getExpBf16Poly", order);
+  patterns.add<ComputeOpByPolyApproxPattern<math::TanhOp>>(
+      context, "getTanhBf16Poly", order);
+  patterns.add<ComputeOpByPolyApproxPattern<math::ErfOp>>(
+      context, "getErfBf16Poly", order);
+  patterns.add<ComputeOpByPolyApproxPattern<math::RsqrtOp>>(
+      context, "getRsqrtBf16Poly", order);
+  patterns.add<ComputeInvOpByPolyApproxPattern,
+               ComputeSigmoidOpByPolyApproxPattern>(context, order);
+}
+
 static void populateAIEVecV2ConversionPatterns(RewritePatternSet &patterns,
-                                               TargetBackend backend) {
+                                               TargetBackend backend,
+                                               bool polyApprox,
+                                               unsigned order) {
   if (backend == TargetBackend::CPP) {
     patterns.add<LowerVectorTransferReadToAIEUPD>(patterns.getContext(), 128,
                                                   1024, 256, 1024);
   }
+  populateAIEVecV2MathPatterns(patterns, polyApprox, order);
   // clang-format off
   // TODO: Reorder these alphabetically
   patterns.add<
       LowerVectorAddIOpToAIEVecAddElemOp,
       LowerVectorSubIOpToAIEVecSubElemOp,
-      ComputeExpOpByLUTPattern,
-      ComputeInvOpByLUTPattern,
-      ComputeTanhOpByLUTPattern,
-      ComputeSqrtOpPattern,
-      ComputeRsqrtOpPattern,
-      ComputeErfOpPattern,
       ComputeAbsFOpPattern,
       ComputeAbsIOpPattern,
-      ComputeSigmoidOpPattern,
       ComputeCeilOpPattern,
       ComputeFloorOpPattern,
       ComputeNegOpPattern,
@@ -2672,7 +2952,6 @@ static void populateAIEVecV2ConversionPatterns(RewritePatternSet &patterns,
       LowerVectorMaximumFOpToAIEVecMaxOp,
       LowerVectorCmpIOpToAIEVecCmpOp,
       LowerVectorCmpFOpToAIEVecCmpOp,
-      LowerVectorSelectOpToAIEVecSelOp,
       LowerVectorReductionMinOp,
       LowerVectorReductionMaxOp,
       LowerVectorReductionAddIntOp,
@@ -2683,7 +2962,8 @@ static void populateAIEVecV2ConversionPatterns(RewritePatternSet &patterns,
       ConvertMulAddToAIEVecFMAElemOpPattern,
       LowerVectorExtractStridedSliceOpAIEMLPattern
       >(patterns.getContext());
-  patterns.add<LowerVectorContractionOpToAIEVecMatMulPattern
+  patterns.add<LowerVectorContractionOpToAIEVecMatMulPattern,
+               LowerVectorSelectOpToAIEVecSelOp
       >(patterns.getContext(), backend == TargetBackend::CPP);
   // clang-format on
 }
@@ -2750,14 +3030,20 @@ static bool isInSigmoidOperationChain(math::ExpOp expOp) {
 }
 
 static void configureAIEVecCommonLegalizations(ConversionTarget &target,
-                                               TargetBackend backend) {
+                                               TargetBackend backend,
+                                               bool polyApprox) {
   target.addLegalDialect<xilinx::aievec::AIEVecDialect, arith::ArithDialect,
                          emitc::EmitCDialect>();
   if (backend == TargetBackend::CPP) {
     target.addIllegalOp<vector::TransferReadOp>();
   }
   target.addIllegalOp<vector::ExtractStridedSliceOp>();
-  target.addDynamicallyLegalOp<math::ExpOp>([](math::ExpOp expOp) {
+  // The lookup tables cover 16 lanes; the polynomial approximations also
+  // handle 32 lanes.
+  auto isUnsupportedLaneSize = [=](unsigned laneSize) {
+    return laneSize != 16 && (!polyApprox || laneSize != 32);
+  };
+  target.addDynamicallyLegalOp<math::ExpOp>([=](math::ExpOp expOp) {
     auto srcType = dyn_cast<VectorType>(expOp.getOperand().getType());
     if (!srcType)
       return true;
@@ -2765,7 +3051,8 @@ static void configureAIEVecCommonLegalizations(ConversionTarget &target,
     Type scalarType = srcType.getElementType();
     unsigned elWidth = scalarType.getIntOrFloatBitWidth();
     unsigned laneSize = getVectorLaneSize(srcType);
-    if (!isa<FloatType>(scalarType) || laneSize != 16 || elWidth != 16)
+    if (!isa<FloatType>(scalarType) || isUnsupportedLaneSize(laneSize) ||
+        elWidth != 16)
       return true;
     if (expOp->hasOneUse() && isInSigmoidOperationChain(expOp))
       return true;
@@ -2773,7 +3060,7 @@ static void configureAIEVecCommonLegalizations(ConversionTarget &target,
     return false;
   });
 
-  target.addDynamicallyLegalOp<math::TanhOp>([](math::TanhOp tanhOp) {
+  target.addDynamicallyLegalOp<math::TanhOp>([=](math::TanhOp tanhOp) {
     auto srcType = dyn_cast<VectorType>(tanhOp.getOperand().getType());
     if (!srcType)
       return true;
@@ -2784,7 +3071,7 @@ static void configureAIEVecCommonLegalizations(ConversionTarget &target,
 
     unsigned laneSize = getVectorLaneSize(srcType);
     unsigned elWidth = scalarType.getIntOrFloatBitWidth();
-    if (elWidth != 16 || laneSize != 16)
+    if (elWidth != 16 || isUnsupportedLaneSize(laneSize))
       return true;
 
     return false;
@@ -3286,6 +3573,8 @@ struct LowerVectorToAIEVec : PassWrapper<LowerVectorToAIEVec, OperationPass<>> {
       : LowerVectorToAIEVec() {
     aieTarget = options.aieTarget;
     targetBackend = options.targetBackend;
+    mathApprox = options.mathApprox;
+    mathApproxOrder = options.mathApproxOrder;
   }
 
   // In case we want to register this pass as a standalone pass for test
@@ -3313,6 +3602,18 @@ struct LowerVectorToAIEVec : PassWrapper<LowerVectorToAIEVec, OperationPass<>> {
                      "from vector dialect."),
       llvm::cl::init("cpp")};
 
+  Option<std::string> mathApprox{
+      *this, "math-approx",
+      llvm::cl::desc("Select how AIE-ML transcendental functions are "
+                     "computed: \"lut\" or \"poly\"."),
+      llvm::cl::init("lut")};
+
+  Option<unsigned> mathApproxOrder{
+      *this, "math-approx-order",
+      llvm::cl::desc("Order (2-5) of the polynomial approximations used with "
+                     "math-approx=poly. 0 selects the library default."),
+      llvm::cl::init(0)};
+
   void runOnOperation() override {
     auto op = getOperation();
     MLIRContext *context = &getContext();
@@ -3346,12 +3647,25 @@ struct LowerVectorToAIEVec : PassWrapper<LowerVectorToAIEVec, OperationPass<>> {
       }
     }
 
-    configureAIEVecCommonLegalizations(target, backend);
+    bool polyApprox = mathApprox == "poly";
+    if (!polyApprox && mathApprox != "lut") {
+      op->emitError() << "unknown math approximation '" << mathApprox << "'";
+      return signalPassFailure();
+    }
+    if (mathApproxOrder == 1 || mathApproxOrder > 5) {
+      op->emitError() << "unsupported polynomial approximation order "
+                      << mathApproxOrder;
+      return signalPassFailure();
+    }
+    polyApprox &= aieVersion == AIEArch::AIE_ML;
+
+    configureAIEVecCommonLegalizations(target, backend, polyApprox);
     if (aieVersion == AIEArch::AIE) {
       populateAIEVecV1ConversionPatterns(patterns, backend);
       configureAIEVecV1Legalizations(target, backend);
     } else {
-      populateAIEVecV2ConversionPatterns(patterns, backend);
+      populateAIEVecV2ConversionPatterns(patterns, backend, polyApprox,
+                                         mathApproxOrder);
       configureAIEVecV2Legalizations(target, backend);
     }
 
@@ -3411,6 +3725,9 @@ struct ProcessExtOpsPass : PassWrapper<ProcessExtOpsPass, OperationPass<>> {
       if (!isa<IntegerType>(srcScalarType) || !isa<IntegerType>(dstScalarType))
         return true;
 
+      if (getUnpackLanes(srcType, dstType))
+        return false;
+
       unsigned srcLaneSize = getVectorLaneSize(srcType);
       unsigned dstLaneSize = getVectorLaneSize(dstType);
       unsigned srcElWidth = srcScalarType.getIntOrFloatBitWidth();
@@ -19,8 +19,10 @@
 #include "mlir/Dialect/Affine/IR/AffineOps.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
 #include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/LoopLikeInterface.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
@@ -253,6 +255,196 @@ struct HoistCastOpToDataSourcePattern : public RewritePattern {
   }
 };
 
+// Return the neutral element of reductions of kind `kind` over `elType`, or a
+// null attribute if the kind is not supported.
+static TypedAttr getReductionIdentity(CombiningKind kind, Type elType) {
+  if (auto floatType = dyn_cast<FloatType>(elType)) {
+    const llvm::fltSemantics &sem = floatType.getFloatSemantics();
+    switch (kind) {
+    case CombiningKind::ADD:
+      return FloatAttr::get(floatType, APFloat::getZero(sem));
+    case CombiningKind::MAXIMUMF:
+      return FloatAttr::get(floatType, APFloat::getInf(sem, /*Negative=*/true));
+    case CombiningKind::MINIMUMF:
+      return FloatAttr::get(floatType, APFloat::getInf(sem));
+    default:
+      return {};
+    }
+  }
+  auto intType = dyn_cast<IntegerType>(elType);
+  if (!intType)
+    return {};
+  unsigned width = intType.getWidth();
+  switch (kind) {
+  case CombiningKind::ADD:
+  case CombiningKind::MAXUI:
+    return IntegerAttr::get(intType, APInt::getZero(width));
+  case CombiningKind::MAXSI:
+    return IntegerAttr::get(intType, APInt::getSignedMinValue(width));
+  case CombiningKind::MINSI:
+    return IntegerAttr::get(intType, APInt::getSignedMaxValue(width));
+  case CombiningKind::MINUI:
+    return IntegerAttr::get(intType, APInt::getMaxValue(width));
+  default:
+    return {};
+  }
+}
+
+// Return true if `op` is the scalar arith op combining values with `kind`.
+static bool isCombiningOp(Operation *op, CombiningKind kind) {
+  switch (kind) {
+  case CombiningKind::ADD:
+    return isa<arith::AddIOp, arith::AddFOp>(op);
+  case CombiningKind::MAXSI:
+    return isa<arith::MaxSIOp>(op);
+  case CombiningKind::MAXUI:
+    return isa<arith::MaxUIOp>(op);
+  case CombiningKind::MINSI:
+    return isa<arith::MinSIOp>(op);
+  case CombiningKind::MINUI:
+    return isa<arith::MinUIOp>(op);
+  case CombiningKind::MAXIMUMF:
+    return isa<arith::MaximumFOp>(op);
+  case CombiningKind::MINIMUMF:
+    return isa<arith::MinimumFOp>(op);
+  default:
+    return false;
+  }
+}
+
+// Return true if `op` carries the `reassoc` fastmath flag, which `fast`
+// includes.
+static bool allowsReassociation(Operation *op) {
+  auto fmfOp = dyn_cast<arith::ArithFastMathInterface>(op);
+  return fmfOp &&
+         arith::bitEnumContainsAll(fmfOp.getFastMathFlagsAttr().getValue(),
+                                   arith::FastMathFlags::reassoc);
+}
+
+// This pattern moves the reduction of a vector into a loop-carried scalar out
+// of the loop. A loop like:
+//
+//   %r = scf.for ... iter_args(%acc = %init) -> (i32) {
+//     %v = ...
+//     %s = vector.reduction <add>, %v, %acc : vector<16xi32> into i32
+//     scf.yield %s : i32
+//   }
+//
+// becomes a loop carrying an elementwise partial reduction, initialized with
+// the neutral element, followed by a single reduction of the partial vector
+// combined with %init. The loop body then does one vector op per iteration
+// instead of a full shift-and-combine tree. The reduction may also be written
+// as a `vector.reduction` without accumulator followed by the matching scalar
+// arith op. When `widenBF16` is set, bf16 sums are carried in f32 so they stay
+// in `accfloat` registers and don't lose precision across iterations.
+//
+// This reassociates the sum, so floating point sums are only rewritten when
+// the reduction and the combining op allow it with the `reassoc` fastmath
+// flag. Floating point min and max are associative and always rewritten.
+struct ReassociateLoopCarriedReductionPattern
+    : public OpRewritePattern<vector::ReductionOp> {
+  ReassociateLoopCarriedReductionPattern(MLIRContext *context, bool widenBF16)
+      : OpRewritePattern<vector::ReductionOp>(context),
+        widenBF16(widenBF16) {}
+
+  LogicalResult matchAndRewrite(vector::ReductionOp redOp,
+                                PatternRewriter &rewriter) const override {
+    Operation *parentOp = redOp->getParentOp();
+    if (!isa<scf::ForOp, affine::AffineForOp>(parentOp))
+      return failure();
+    auto loop = cast<LoopLikeOpInterface>(parentOp);
+
+    CombiningKind kind = redOp.getKind();
+    VectorType vecType = redOp.getSourceVectorType();
+    Type elType = vecType.getElementType();
+    if (vecType.getRank() != 1 || !getReductionIdentity(kind, elType))
+      return failure();
+
+    // Find the loop-carried scalar this reduction is folded into.
+    Value acc = redOp.getAcc();
+    Operation *combineOp = redOp;
+    if (!acc) {
+      if (!redOp->hasOneUse())
+        return failure();
+      combineOp = *redOp->getUsers().begin();
+      if (!isCombiningOp(combineOp, kind))
+        return failure();
+      acc = combineOp->getOperand(0) == redOp.getDest()
+                ? combineOp->getOperand(1)
+                : combineOp->getOperand(0);
+    }
+    auto iterArg = dyn_cast<BlockArgument>(acc);
+    if (!iterArg || !iterArg.hasOneUse() ||
+        iterArg.getOwner() != redOp->getBlock() ||
+        combineOp->getBlock() != redOp->getBlock())
+      return failure();
+    auto iterArgs = loop.getRegionIterArgs();
+    auto it = llvm::find(iterArgs, iterArg);
+    if (it == iterArgs.end())
+      return failure();
+    unsigned idx = std::distance(iterArgs.begin(), it);
+    Value next = combineOp->getResult(0);
+    if (!next.hasOneUse() || loop.getYieldedValues()[idx] != next)
+      return failure();
+    if (kind == CombiningKind::ADD && isa<FloatType>(elType) &&
+        (!allowsReassociation(redOp) || !allowsReassociation(combineOp)))
+      return failure();
+
+    bool widen = widenBF16 && kind == CombiningKind::ADD && elType.isBF16();
+    auto accType = widen ? VectorType::get(vecType.getShape(),
+                                           rewriter.getF32Type())
+                         : vecType;
+    Location loc = redOp.getLoc();
+    rewriter.setInsertionPoint(loop);
+    auto identity = DenseElementsAttr::get(
+        accType, getReductionIdentity(kind, accType.getElementType()));
+    Value partialInit = rewriter
+                            .create<arith::ConstantOp>(
+                                loc, accType, cast<TypedAttr>(identity))
+                            .getResult();
+    Value vector = redOp.getVector();
+    auto newLoop = loop.replaceWithAdditionalYields(
+        rewriter, partialInit, /*replaceInitOperandsUsesInLoop=*/false,
+        [&](OpBuilder &b, Location, ArrayRef<BlockArgument> newBbArgs) {
+          Value value = vector;
+          if (widen)
+            value = b.create<arith::ExtFOp>(loc, accType, value).getResult();
+          return SmallVector<Value>{
+              vector::makeArithReduction(b, loc, kind, value, newBbArgs[0])};
+        });
+    if (failed(newLoop))
+      return failure();
+
+    // The scalar is now passed through the loop unchanged.
+    rewriter.replaceOp(combineOp, newLoop->getRegionIterArgs()[idx]);
+    if (combineOp != redOp)
+      rewriter.eraseOp(redOp);
+
+    // Reduce the partial vector once, after the loop.
+    Operation *loopOp = newLoop->getOperation();
+    rewriter.setInsertionPointAfter(loopOp);
+    Value scalar = loopOp->getResult(idx);
+    Value result =
+        rewriter
+            .create<vector::ReductionOp>(loc, kind, loopOp->getResults().back())
+            .getDest();
+    Value scalarAcc = scalar;
+    if (widen)
+      scalarAcc =
+          rewriter.create<arith::ExtFOp>(loc, rewriter.getF32Type(), scalar);
+    result = vector::makeArithReduction(rewriter, loc, kind, result, scalarAcc);
+    Operation *scalarUser = scalarAcc.getDefiningOp();
+    if (widen)
+      result = rewriter.create<arith::TruncFOp>(loc, elType, result);
+    else
+      scalarUser = result.getDefiningOp();
+    rewriter.replaceAllUsesExcept(scalar, result, scalarUser);
+    return success();
+  }
+
+  bool widenBF16;
+};
+
 static SmallVector<Value> collapseInnerMostDimIndices(PatternRewriter &b,
                                                       Location loc, int numDims,
                                                       ValueRange indices,
@@ -609,6 +801,34 @@ static std::unique_ptr<::mlir::Pass> createHoistCastOpToDataSourcePass() {
   return std::make_unique<HoistCastOpToDataSourcePass>();
 }
 
+struct ReassociateLoopCarriedReductionsPass
+    : public PassWrapper<ReassociateLoopCarriedReductionsPass,
+                         OperationPass<>> {
+  ReassociateLoopCarriedReductionsPass(bool widenBF16)
+      : widenBF16(widenBF16) {}
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<arith::ArithDialect, vector::VectorDialect>();
+  }
+
+  void runOnOperation() override {
+    auto op = getOperation();
+    MLIRContext *context = &getContext();
+    RewritePatternSet patterns(context);
+
+    patterns.add<ReassociateLoopCarriedReductionPattern>(context, widenBF16);
+
+    (void)applyPatternsAndFoldGreedily(op, std::move(patterns));
+  }
+
+  bool widenBF16;
+};
+
+static std::unique_ptr<::mlir::Pass>
+createReassociateLoopCarriedReductionsPass(bool widenBF16) {
+  return std::make_unique<ReassociateLoopCarriedReductionsPass>(widenBF16);
+}
+
 //============================================================================//
 //=============== Main Vector2Vector Pipeline Configuration ==================//
 //============================================================================//
@@ -619,6 +839,9 @@ void xilinx::aievec::buildCanonicalizeVectorForAIEVec(
   // TODO: Add passes to unroll vector with unsupported types
   // TODO: Add passes to split vectors that won't fit in registers
   pm.addPass(createCopyRemovalPass());
+  // bf16 sums are carried in f32 on AIE-ML, which accumulates in accfloat.
+  std::string aieTarget = options.aieTarget;
+  pm.addPass(createReassociateLoopCarriedReductionsPass(aieTarget == "aieml"));
   pm.addPass(createCanonicalizeVectorForAIEVecPass(options));
   pm.addPass(createHoistCastOpToDataSourcePass());
 }
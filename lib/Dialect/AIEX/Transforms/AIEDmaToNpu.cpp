@@ -8,6 +8,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "aie/Dialect/AIE/IR/AIEDeviceIndex.h"
 #include "aie/Dialect/AIE/IR/AIEDialect.h"
 #include "aie/Dialect/AIEX/IR/AIEXDialect.h"
 #include "aie/Dialect/AIEX/Transforms/AIEXPasses.h"
@@ -21,55 +22,6 @@ using namespace mlir;
 using namespace xilinx;
 using namespace xilinx::AIEX;
 
-namespace {
-
-// Helper class to get a ShimDMAAllocationOp for a given <device, symbol name>
-// pair. An object of this class is invalidated if, for any symbol_name, a
-// ShimDMAAllocationOp that uses it changes, as the cache is not updated in this
-// case.
-struct ShimDMAllocationGetter {
-
-public:
-  // Return the first ShimDMAAllocationOp nested inside the DeviceOp 'dev' that
-  // uses the symbol 'sym_name'
-  std::optional<AIE::ShimDMAAllocationOp> get(AIE::DeviceOp dev,
-                                              StringRef sym_name) {
-
-    auto key = std::make_pair(dev, sym_name);
-    auto it = allocGetter.find(key);
-    if (it != allocGetter.end())
-      return it->second;
-
-    auto allocOp = cachelessGet(dev, sym_name);
-    allocGetter[key] = allocOp;
-    return allocOp;
-  }
-
-private:
-  llvm::DenseMap<std::pair<AIE::DeviceOp, StringRef>,
-                 std::optional<AIE::ShimDMAAllocationOp>>
-      allocGetter;
-
-  // Finding the ShimDMAAllocationOp for a given <DeviceOp, symbol_name> pair
-  // can be slow when the symbol is used in many places. This version of the
-  // function is only called when the cache does not have a ShimDMAAllocationOp
-  // stored from a previous lookup.
-  std::optional<AIE::ShimDMAAllocationOp> cachelessGet(AIE::DeviceOp dev,
-                                                       StringRef sym_name) {
-    auto *sym = dev.lookupSymbol(sym_name);
-    if (!sym)
-      return std::nullopt;
-
-    auto uses = SymbolTable::getSymbolUses(sym, dev);
-    for (auto use : *uses)
-      if (auto infoOp = dyn_cast<AIE::ShimDMAAllocationOp>(use.getUser()))
-        return infoOp;
-
-    return std::nullopt;
-  }
-};
-} // namespace
-
 struct RtpToNpuPattern : OpConversionPattern<NpuWriteRTPOp> {
   using OpConversionPattern::OpConversionPattern;
 
@@ -121,14 +73,14 @@ struct RtpToNpuPattern : OpConversionPattern<NpuWriteRTPOp> {
 struct PushToNpuPattern : OpConversionPattern<NpuShimTilePushQueueOp> {
 
 private:
-  ShimDMAllocationGetter &allocGetter;
+  const AIE::AIEDeviceIndex &index;
 
 public:
   using OpConversionPattern::OpConversionPattern;
 
-  PushToNpuPattern(MLIRContext *context, ShimDMAllocationGetter &getter,
+  PushToNpuPattern(MLIRContext *context, const AIE::AIEDeviceIndex &index,
                    PatternBenefit benefit = 1)
-      : OpConversionPattern(context, benefit), allocGetter(getter) {}
+      : OpConversionPattern(context, benefit), index(index) {}
 
   LogicalResult
   matchAndRewrite(NpuShimTilePushQueueOp op, OpAdaptor adaptor,
@@ -146,15 +98,15 @@ public:
     if (!dev)
       return op->emitOpError("couldn't find parent of type DeviceOp");
 
-    auto infoOp = allocGetter.get(dev, op.getMetadata());
+    auto infoOp = index.getShimDMAAllocation(op.getMetadata());
     if (!infoOp)
       return op->emitOpError("couldn't find shim_dma_allocation op.");
 
-    auto channelDir = infoOp->getChannelDir();
+    auto channelDir = infoOp.getChannelDir();
     bool isMM2S = channelDir == AIE::DMAChannelDir::MM2S;
-    channel_num += infoOp->getChannelIndex();
+    channel_num += infoOp.getChannelIndex();
 
-    IntegerAttr column = IntegerAttr::get(i32ty, infoOp->getCol());
+    IntegerAttr column = IntegerAttr::get(i32ty, infoOp.getCol());
 
     uint32_t queue_offset;
     if (isMM2S)
@@ -186,12 +138,12 @@ struct DmaToNpuPattern : OpConversionPattern<NpuDmaMemcpyNdOp> {
   using OpConversionPattern::OpConversionPattern;
 
 private:
-  ShimDMAllocationGetter &allocGetter;
+  const AIE::AIEDeviceIndex &index;
 
 public:
-  DmaToNpuPattern(MLIRContext *context, ShimDMAllocationGetter &getter,
+  DmaToNpuPattern(MLIRContext *context, const AIE::AIEDeviceIndex &index,
                   PatternBenefit benefit = 1)
-      : OpConversionPattern(context, benefit), allocGetter(getter) {}
+      : OpConversionPattern(context, benefit), index(index) {}
 
   LogicalResult
   matchAndRewrite(NpuDmaMemcpyNdOp op, OpAdaptor adaptor,
@@ -205,14 +157,14 @@ public:
     if (!dev)
       return failure();
 
-    auto infoOp = allocGetter.get(dev, op.getMetadata());
+    auto infoOp = index.getShimDMAAllocation(op.getMetadata());
     if (!infoOp) {
       return op->emitOpError("couldn't find shim_dma_allocation op.");
     }
 
-    auto channelDir = infoOp->getChannelDir();
+    auto channelDir = infoOp.getChannelDir();
     bool isMM2S = channelDir == AIE::DMAChannelDir::MM2S;
-    int col = infoOp->getCol();
+    int col = infoOp.getCol();
 
     // initialize fields to zero
     auto column = zero;
@@ -385,14 +337,14 @@ public:
 struct DmaWaitToNpuPattern : OpConversionPattern<NpuDmaWaitOp> {
 
 private:
-  ShimDMAllocationGetter &allocGetter;
+  const AIE::AIEDeviceIndex &index;
 
 public:
   using OpConversionPattern::OpConversionPattern;
 
-  DmaWaitToNpuPattern(MLIRContext *context, ShimDMAllocationGetter &getter,
+  DmaWaitToNpuPattern(MLIRContext *context, const AIE::AIEDeviceIndex &index,
                       PatternBenefit benefit = 1)
-      : OpConversionPattern(context, benefit), allocGetter(getter) {}
+      : OpConversionPattern(context, benefit), index(index) {}
 
   LogicalResult
   matchAndRewrite(NpuDmaWaitOp op, OpAdaptor adaptor,
@@ -401,15 +353,15 @@ public:
     if (!dev)
       return op->emitError("couldn't find parent of type DeviceOp");
 
-    std::optional<AIE::ShimDMAAllocationOp> shimDmaAllocOp =
-        allocGetter.get(dev, op.getSymbol());
+    AIE::ShimDMAAllocationOp shimDmaAllocOp =
+        index.getShimDMAAllocation(op.getSymbol());
     if (!shimDmaAllocOp) {
       return op->emitError("couldn't find shim_dma_allocation op");
     }
-    AIE::DMAChannelDir channelDir = shimDmaAllocOp->getChannelDir();
-    int channel = shimDmaAllocOp->getChannelIndex();
+    AIE::DMAChannelDir channelDir = shimDmaAllocOp.getChannelDir();
+    int channel = shimDmaAllocOp.getChannelIndex();
     int direction = (int)(channelDir == AIE::DMAChannelDir::MM2S);
-    int column = shimDmaAllocOp->getCol();
+    int column = shimDmaAllocOp.getCol();
 
     // Create with `column_num == 1` and `row_num == 1` to check for a single
     // column and row. Row is always 0 for shim tiles.
@@ -422,9 +374,8 @@ public:
 struct AIEDmaToNpuPass : AIEDmaToNpuBase<AIEDmaToNpuPass> {
   void runOnOperation() override {
 
-    ShimDMAllocationGetter cachingGetter;
-
     AIE::DeviceOp device = getOperation();
+    const auto &index = getAnalysis<AIE::AIEDeviceIndex>();
 
     ConversionTarget target(getContext());
     target.addLegalDialect<AIEXDialect>();
@@ -436,13 +387,16 @@ struct AIEDmaToNpuPass : AIEDmaToNpuBase<AIEDmaToNpuPass> {
     target.addIllegalOp<NpuShimTilePushQueueOp>();
 
     RewritePatternSet patterns(&getContext());
-    patterns.insert<DmaToNpuPattern>(&getContext(), cachingGetter);
-    patterns.insert<DmaWaitToNpuPattern>(&getContext(), cachingGetter);
-    patterns.insert<PushToNpuPattern>(&getContext(), cachingGetter);
+    patterns.insert<DmaToNpuPattern>(&getContext(), index);
+    patterns.insert<DmaWaitToNpuPattern>(&getContext(), index);
+    patterns.insert<PushToNpuPattern>(&getContext(), index);
     patterns.insert<RtpToNpuPattern>(&getContext());
 
     if (failed(applyPartialConversion(device, target, std::move(patterns))))
-      signalPassFailure();
+      return signalPassFailure();
+
+    // Only the runtime sequence is rewritten.
+    markAnalysesPreserved<AIE::AIEDeviceIndex>();
   }
 };
 
@@ -0,0 +1,248 @@
+//===- AIEDMAEmulator.cpp ---------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+#include "aie/Targets/AIEDMAEmulator.h"
+#include "aie/Targets/AIENPUInstructions.h"
+
+#include <algorithm>
+#include <set>
+
+using namespace xilinx::AIE;
+using namespace xilinx::AIE::npu;
+
+DMABufferDescriptor DMABufferDescriptor::fromDims(
+    uint64_t bufferOffset, uint32_t bufferLength,
+    const std::vector<std::pair<uint32_t, uint32_t>> &sizesAndStrides) {
+  DMABufferDescriptor bd;
+  bd.bufferOffset = bufferOffset;
+  bd.bufferLength = bufferLength;
+  for (auto [size, stride] : sizesAndStrides)
+    bd.dims.push_back({size, stride});
+  return bd;
+}
+
+void DMAEmulator::setBufferDescriptor(uint32_t bdId,
+                                      const DMABufferDescriptor &bd) {
+  bds[bdId] = bd;
+}
+
+const DMABufferDescriptor *
+DMAEmulator::getBufferDescriptor(uint32_t bdId) const {
+  auto it = bds.find(bdId);
+  return it == bds.end() ? nullptr : &it->second;
+}
+
+std::vector<DMAAccess> DMAEmulator::generate(const DMABufferDescriptor &bd) {
+  std::vector<DMAAccess> accesses;
+  accesses.reserve(bd.bufferLength);
+
+  uint64_t base = static_cast<uint64_t>(bd.iterationCurrent) *
+                  bd.iterationStride;
+  size_t numDims = bd.dims.size();
+  std::vector<uint64_t> index(numDims, 0);
+  for (uint32_t i = 0; i < bd.bufferLength; i++) {
+    if (numDims == 0) {
+      accesses.push_back({bd.ddrId, bd.bufferOffset + 4 * (base + i)});
+      continue;
+    }
+
+    uint64_t offset = base;
+    for (size_t d = 0; d < numDims; d++)
+      offset += index[d] * bd.dims[d].stride;
+    accesses.push_back({bd.ddrId, bd.bufferOffset + 4 * offset});
+
+    // Step the address generator: the innermost dimension always advances and
+    // carries into the next one when it wraps. The outermost dimension (and
+    // any dimension with size 0) never wraps.
+    index[0]++;
+    for (size_t d = 0; d + 1 < numDims; d++) {
+      if (bd.dims[d].size == 0 || index[d] < bd.dims[d].size)
+        break;
+      index[d] = 0;
+      index[d + 1]++;
+    }
+  }
+  return accesses;
+}
+
+std::optional<std::vector<DMAAccess>>
+DMAEmulator::run(const DMATask &task, std::string *error) {
+  auto fail = [&](const std::string &msg) {
+    if (error)
+      *error = msg;
+    return std::nullopt;
+  };
+
+  std::vector<DMAAccess> accesses;
+  for (uint32_t r = 0; r <= task.repeatCount; r++) {
+    std::set<uint32_t> visited;
+    std::optional<uint32_t> bdId = task.startBd;
+    while (bdId) {
+      auto it = bds.find(*bdId);
+      if (it == bds.end())
+        return fail("BD " + std::to_string(*bdId) + " is not defined");
+      DMABufferDescriptor &bd = it->second;
+      if (!bd.valid)
+        return fail("BD " + std::to_string(*bdId) + " is not valid");
+      if (!visited.insert(*bdId).second)
+        return fail("BD chain starting at " + std::to_string(task.startBd) +
+                    " does not terminate");
+
+      auto bdAccesses = generate(bd);
+      accesses.insert(accesses.end(), bdAccesses.begin(), bdAccesses.end());
+      if (bd.iterationSize > 0)
+        bd.iterationCurrent = (bd.iterationCurrent + 1) % bd.iterationSize;
+      bdId = bd.nextBd;
+    }
+  }
+  return accesses;
+}
+
+std::vector<uint32_t>
+DMAEmulator::read(const std::vector<DMAAccess> &accesses,
+                  const std::vector<std::vector<uint32_t>> &buffers) {
+  std::vector<uint32_t> stream;
+  stream.reserve(accesses.size());
+  for (const DMAAccess &a : accesses) {
+    uint64_t word = a.address / 4;
+    if (a.ddrId < buffers.size() && word < buffers[a.ddrId].size())
+      stream.push_back(buffers[a.ddrId][word]);
+    else
+      stream.push_back(0);
+  }
+  return stream;
+}
+
+bool DMAEmulator::write(const std::vector<DMAAccess> &accesses,
+                        const std::vector<uint32_t> &stream,
+                        std::vector<std::vector<uint32_t>> &buffers) {
+  bool inBounds = true;
+  size_t n = std::min(accesses.size(), stream.size());
+  for (size_t i = 0; i < n; i++) {
+    const DMAAccess &a = accesses[i];
+    uint64_t word = a.address / 4;
+    if (a.ddrId >= buffers.size() || word >= buffers[a.ddrId].size()) {
+      inBounds = false;
+      continue;
+    }
+    buffers[a.ddrId][word] = stream[i];
+  }
+  return inBounds;
+}
+
+DMABurstStats
+DMAEmulator::computeStats(const std::vector<DMAAccess> &accesses) {
+  DMABurstStats stats;
+  stats.words = accesses.size();
+
+  auto closeRun = [&](uint64_t start, uint64_t length) {
+    stats.runs++;
+    if (stats.runs == 1 || length < stats.minRunLength)
+      stats.minRunLength = length;
+    stats.maxRunLength = std::max(stats.maxRunLength, length);
+    if (start % 16 == 0)
+      stats.runs128BitAligned++;
+    else
+      stats.runs32BitAligned++;
+    uint64_t end = start + 4 * length;
+    stats.beats128Bit += (end - 1) / 16 - start / 16 + 1;
+  };
+
+  size_t runStart = 0;
+  for (size_t i = 1; i <= accesses.size(); i++) {
+    if (i < accesses.size() && accesses[i].ddrId == accesses[i - 1].ddrId &&
+        accesses[i].address == accesses[i - 1].address + 4)
+      continue;
+    if (i > runStart)
+      closeRun(accesses[runStart].address, i - runStart);
+    runStart = i;
+  }
+  return stats;
+}
+
+std::pair<uint32_t, DMABufferDescriptor>
+xilinx::AIE::decodeNPUShimBD(const uint32_t *words) {
+  DMABufferDescriptor bd;
+  uint32_t bdId = words[0] & 0xf;
+  bd.ddrId = (words[0] >> 4) & 0xf;
+  bd.bufferLength = words[2];
+  bd.bufferOffset = words[3];
+
+  // Strides are encoded minus one; a d0 size of zero selects linear mode.
+  uint32_t d0Size = (words[5] >> 20) & 0x3ff;
+  if (d0Size != 0) {
+    bd.dims.push_back({d0Size, (words[5] & 0xfffff) + 1});
+    bd.dims.push_back({(words[6] >> 20) & 0x3ff, (words[6] & 0xfffff) + 1});
+    bd.dims.push_back({0, (words[7] & 0xfffff) + 1});
+  }
+
+  bd.iterationCurrent = (words[8] >> 26) & 0x3f;
+  bd.iterationSize = ((words[8] >> 20) & 0x3f) + 1;
+  bd.iterationStride = (words[8] & 0xfffff) + 1;
+
+  if ((words[9] >> 26) & 0x1)
+    bd.nextBd = (words[9] >> 27) & 0xf;
+  bd.valid = (words[9] >> 25) & 0x1;
+  return {bdId, bd};
+}
+
+std::vector<NPUDMATrace>
+xilinx::AIE::emulateNPUInstructions(const std::vector<uint32_t> &instructions) {
+  std::vector<NPUDMATrace> traces;
+  std::map<uint32_t, DMAEmulator> columns;
+
+  size_t i = std::min(PROLOG_WORDS, instructions.size());
+  while (i < instructions.size()) {
+    uint32_t opCode = getOpCode(instructions[i]);
+    uint32_t column = getColumn(instructions[i]);
+    size_t size = getInstructionSize(opCode);
+    if (size == 0) {
+      NPUDMATrace trace;
+      trace.error = "unknown NPU opcode " + std::to_string(opCode);
+      traces.push_back(trace);
+      break;
+    }
+    if (i + size > instructions.size()) {
+      NPUDMATrace trace;
+      trace.error = "truncated NPU instruction";
+      traces.push_back(trace);
+      break;
+    }
+
+    const uint32_t *words = &instructions[i];
+    if (opCode == OPCODE_WRITEBD_SHIMTILE) {
+      auto [bdId, bd] = decodeNPUShimBD(words);
+      columns[column].setBufferDescriptor(bdId, bd);
+    } else if (opCode == OPCODE_WRITE32) {
+      uint32_t row = (words[0] >> 8) & 0xff;
+      uint32_t address = words[1];
+      uint32_t value = words[2];
+      if (row == 0 && (address == SHIM_S2MM_0_TASK_QUEUE ||
+                       address == SHIM_S2MM_1_TASK_QUEUE ||
+                       address == SHIM_MM2S_0_TASK_QUEUE ||
+                       address == SHIM_MM2S_1_TASK_QUEUE)) {
+        NPUDMATrace trace;
+        trace.task.column = column;
+        trace.task.isMM2S = address == SHIM_MM2S_0_TASK_QUEUE ||
+                            address == SHIM_MM2S_1_TASK_QUEUE;
+        trace.task.channel = address == SHIM_S2MM_1_TASK_QUEUE ||
+                             address == SHIM_MM2S_1_TASK_QUEUE;
+        trace.task.startBd = value & 0xf;
+        trace.task.repeatCount = (value >> 16) & 0xff;
+        trace.task.issueToken = (value >> 31) & 0x1;
+        if (auto accesses = columns[column].run(trace.task, &trace.error))
+          trace.accesses = std::move(*accesses);
+        traces.push_back(std::move(trace));
+      }
+    }
+    i += size;
+  }
+  return traces;
+}
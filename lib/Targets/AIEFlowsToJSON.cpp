@@ -11,16 +11,26 @@
 /*
  * Takes as input the mlir after AIECreateFlows and AIEFindFlows.
  * Converts the flows into a JSON file to be read by other tools.
+ * For every switchbox, the channels to its neighbours are reported with their
+ * utilization and the bytes per iteration of the flows going through them,
+ * along with the congestion recorded by
+ * aie-create-pathfinder-flows{annotate-congestion}. tools/aie-vis renders them
+ * as a heatmap.
  */
 
 #include "aie/Targets/AIETargets.h"
 
+#include "aie/Dialect/AIE/IR/AIEDeviceIndex.h"
 #include "aie/Dialect/AIE/IR/AIEDialect.h"
 
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/IR/Attributes.h"
 #include "mlir/Target/LLVMIR/Import.h"
 #include "mlir/Tools/mlir-translate/MlirTranslateMain.h"
 
+#include "llvm/Support/FormatVariadic.h"
+
+#include <cmath>
 #include <queue>
 #include <set>
 
@@ -46,6 +56,36 @@ TileID getNextCoords(int col, int row, WireBundle bundle) {
   }
 }
 
+// Estimate the bytes a flow starting at `port` of `source` carries per
+// iteration: the length of the first BD of the DMA channel feeding it or, for
+// shim channels driven by the runtime sequence, the size of the ObjectFifo
+// elements allocated to them.
+static std::optional<int64_t>
+getBytesPerIteration(const AIEDeviceIndex &index, TileOp source, Port port) {
+  if (port.bundle != WireBundle::DMA)
+    return std::nullopt;
+
+  for (DMAStartOp start : index.getDMAStarts(source.getTileID()))
+    if (start.getChannelDir() == DMAChannelDir::MM2S &&
+        start.getChannelIndex() == port.channel)
+      for (auto bd : start.getDest()->getOps<DMABDOp>())
+        return bd.getLenInBytes();
+
+  DeviceOp device = index.getDevice();
+  for (auto alloc : device.getOps<ShimDMAAllocationOp>()) {
+    if (alloc.getCol() != source.colIndex() ||
+        alloc.getChannelDir() != DMAChannelDir::MM2S ||
+        alloc.getChannelIndex() != port.channel)
+      continue;
+    if (auto global = SymbolTable::lookupNearestSymbolFrom<memref::GlobalOp>(
+            device, alloc.getSymNameAttr())) {
+      MemRefType type = global.getType();
+      return type.getNumElements() * type.getElementTypeBitWidth() / 8;
+    }
+  }
+  return std::nullopt;
+}
+
 mlir::LogicalResult AIEFlowsToJSON(ModuleOp module, raw_ostream &output) {
   output << "{\n";
   if (module.getOps<DeviceOp>().empty()) {
@@ -65,44 +105,11 @@ mlir::LogicalResult AIEFlowsToJSON(ModuleOp module, raw_ostream &output) {
     destinationCounts[dstID]++;
   }
 
-  // for each switchbox, write name, coordinates, and routing demand info
-  for (SwitchboxOp switchboxOp : targetOp.getOps<SwitchboxOp>()) {
-    int col = switchboxOp.colIndex();
-    int row = switchboxOp.rowIndex();
-    std::string switchString = "\"switchbox" + std::to_string(col) +
-                               std::to_string(row) + "\": {\n" +
-                               "\"col\": " + std::to_string(col) + ",\n" +
-                               "\"row\": " + std::to_string(row) + ",\n";
-
-    // write source and destination info
-    switchString +=
-        "\"source_count\": " + std::to_string(sourceCounts[{col, row}]) + ",\n";
-    switchString += "\"destination_count\": " +
-                    std::to_string(destinationCounts[{col, row}]) + ",\n";
-
-    // write routing demand info
-    uint32_t connectCounts[10];
-    for (auto &connectCount : connectCounts)
-      connectCount = 0;
-    for (ConnectOp connectOp : switchboxOp.getOps<ConnectOp>())
-      connectCounts[int(connectOp.getDestBundle())]++;
-
-    switchString += "\"northbound\": " +
-                    std::to_string(connectCounts[int(WireBundle::North)]) +
-                    ",\n";
-    switchString += "\"eastbound\": " +
-                    std::to_string(connectCounts[int(WireBundle::East)]) +
-                    ",\n";
-    switchString += "\"southbound\": " +
-                    std::to_string(connectCounts[int(WireBundle::South)]) +
-                    ",\n";
-    switchString += "\"westbound\": " +
-                    std::to_string(connectCounts[int(WireBundle::West)]) + "\n";
-    switchString += "},\n";
-    output << switchString;
-  }
-
-  // for each flow, trace it through switchboxes and write the route to JSON
+  // for each flow, trace it through switchboxes and write the route to JSON,
+  // adding the bytes it carries per iteration to every channel it goes through
+  AIEDeviceIndex index(targetOp);
+  std::map<std::pair<TileID, WireBundle>, int64_t> channelBytes;
+  std::string routesString, flowsString;
   int flowCount = 0;
   std::set<std::pair<TileOp, Port>> flowSources;
   for (FlowOp flowOp : targetOp.getOps<FlowOp>()) {
@@ -120,6 +127,16 @@ mlir::LogicalResult AIEFlowsToJSON(ModuleOp module, raw_ostream &output) {
     }
     flowSources.insert(flowSource);
 
+    std::optional<int64_t> bytes =
+        getBytesPerIteration(index, source, currPort);
+    if (!flowsString.empty())
+      flowsString += ",\n";
+    flowsString += "{\"route\": \"route" + std::to_string(flowCount) +
+                   "\", \"source\": [" + std::to_string(source.colIndex()) +
+                   ", " + std::to_string(source.rowIndex()) +
+                   "], \"bytes_per_iteration\": " +
+                   (bytes ? std::to_string(*bytes) : "null") + "}";
+
     std::string routeString =
         "\"route" + std::to_string(flowCount++) + "\": [ ";
 
@@ -195,6 +212,9 @@ mlir::LogicalResult AIEFlowsToJSON(ModuleOp module, raw_ostream &output) {
           if (opCount++ > 0)
             dirString += ", ";
           dirCount++;
+          if (bytes)
+            channelBytes[{currSwitchbox.getTileID(),
+                          connectOp.getDestBundle()}] += *bytes;
           dirString +=
               "\"" +
               (std::string)stringifyWireBundle(connectOp.getDestBundle()) +
@@ -217,8 +237,96 @@ mlir::LogicalResult AIEFlowsToJSON(ModuleOp module, raw_ostream &output) {
     } while (!done);
     // write string to JSON
     routeString += std::string(" ],\n");
-    output << routeString;
+    routesString += routeString;
   }
+
+  // for each switchbox, write name, coordinates, and routing demand info
+  for (SwitchboxOp switchboxOp : targetOp.getOps<SwitchboxOp>()) {
+    int col = switchboxOp.colIndex();
+    int row = switchboxOp.rowIndex();
+    std::string switchString = "\"switchbox" + std::to_string(col) +
+                               std::to_string(row) + "\": {\n" +
+                               "\"col\": " + std::to_string(col) + ",\n" +
+                               "\"row\": " + std::to_string(row) + ",\n";
+
+    // write source and destination info
+    switchString +=
+        "\"source_count\": " + std::to_string(sourceCounts[{col, row}]) + ",\n";
+    switchString += "\"destination_count\": " +
+                    std::to_string(destinationCounts[{col, row}]) + ",\n";
+
+    // write routing demand info
+    uint32_t connectCounts[10];
+    for (auto &connectCount : connectCounts)
+      connectCount = 0;
+    for (ConnectOp connectOp : switchboxOp.getOps<ConnectOp>())
+      connectCounts[int(connectOp.getDestBundle())]++;
+
+    switchString += "\"northbound\": " +
+                    std::to_string(connectCounts[int(WireBundle::North)]) +
+                    ",\n";
+    switchString += "\"eastbound\": " +
+                    std::to_string(connectCounts[int(WireBundle::East)]) +
+                    ",\n";
+    switchString += "\"southbound\": " +
+                    std::to_string(connectCounts[int(WireBundle::South)]) +
+                    ",\n";
+    switchString += "\"westbound\": " +
+                    std::to_string(connectCounts[int(WireBundle::West)]) +
+                    ",\n";
+
+    // write the utilization of the channels to the neighbours, along with the
+    // congestion Pathfinder recorded for them, if any
+    DenseMap<StringRef, DictionaryAttr> congestion;
+    if (auto channels =
+            switchboxOp->getAttrOfType<ArrayAttr>("aie.congestion"))
+      for (auto channel : channels.getAsRange<DictionaryAttr>())
+        if (auto bundle = channel.getAs<StringAttr>("bundle"))
+          congestion[bundle.getValue()] = channel;
+    const auto &targetModel = targetOp.getTargetModel();
+    std::string channelsString;
+    for (WireBundle bundle : {WireBundle::North, WireBundle::East,
+                              WireBundle::South, WireBundle::West}) {
+      uint32_t capacity =
+          targetModel.getNumDestSwitchboxConnections(col, row, bundle);
+      if (!capacity)
+        continue;
+      uint32_t used = connectCounts[int(bundle)];
+      if (!channelsString.empty())
+        channelsString += ",\n";
+      channelsString +=
+          llvm::formatv("\"{0}\": {{\"used\": {1}, \"capacity\": {2}, "
+                        "\"utilization\": {3:F3}, "
+                        "\"bytes_per_iteration\": {4}",
+                        stringifyWireBundle(bundle), used, capacity,
+                        double(used) / capacity,
+                        channelBytes[{{col, row}, bundle}])
+              .str();
+      if (auto channel = congestion.lookup(stringifyWireBundle(bundle))) {
+        auto getInt = [&](StringRef name) {
+          auto attr = channel.getAs<IntegerAttr>(name);
+          return attr ? std::to_string(attr.getInt()) : "null";
+        };
+        // Channels Pathfinder may not use at all have an infinite demand.
+        auto demand = channel.getAs<FloatAttr>("demand");
+        channelsString +=
+            ", \"used_capacity\": " + getInt("used_capacity") +
+            ", \"max_capacity\": " + getInt("max_capacity") +
+            ", \"over_capacity_count\": " + getInt("over_capacity_count") +
+            ", \"demand\": " +
+            (demand && std::isfinite(demand.getValueAsDouble())
+                 ? llvm::formatv("{0:F3}", demand.getValueAsDouble()).str()
+                 : std::string("null"));
+      }
+      channelsString += "}";
+    }
+    switchString += "\"channels\": {\n" + channelsString + "\n}\n";
+    switchString += "},\n";
+    output << switchString;
+  }
+
+  output << routesString;
+  output << "\"flows\": [\n" << flowsString << "\n],\n";
   output << "\"route_all\": [],\n";
   output << "\n\"end json\": 0\n"; // dummy line to avoid errors from commas
   output << "}";
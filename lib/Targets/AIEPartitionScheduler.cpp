@@ -0,0 +1,261 @@
+//===- AIEPartitionScheduler.cpp --------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+#include "aie/Targets/AIEPartitionScheduler.h"
+#include "aie/Targets/AIENPUInstructions.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace xilinx::AIE;
+using namespace xilinx::AIE::npu;
+
+namespace {
+
+bool fail(std::string *error, const std::string &msg) {
+  if (error)
+    *error = msg;
+  return false;
+}
+
+// Call `f(offset, opCode)` for each instruction of `instructions` after the
+// prolog. Returns false if the stream is malformed.
+template <typename F>
+bool forEachInstruction(const std::vector<uint32_t> &instructions,
+                        std::string *error, F f) {
+  if (instructions.size() < PROLOG_WORDS)
+    return fail(error, "NPU instruction stream is missing its prolog");
+  for (size_t i = PROLOG_WORDS; i < instructions.size();) {
+    uint32_t opCode = getOpCode(instructions[i]);
+    size_t size = getInstructionSize(opCode);
+    if (size == 0)
+      return fail(error, "unknown NPU opcode " + std::to_string(opCode));
+    if (i + size > instructions.size())
+      return fail(error, "truncated NPU instruction");
+    if (!f(i, opCode))
+      return false;
+    i += size;
+  }
+  return true;
+}
+
+} // namespace
+
+std::optional<std::vector<uint32_t>>
+xilinx::AIE::packPartitions(const std::vector<uint32_t> &widths,
+                            uint32_t numDeviceColumns, uint32_t firstColumn) {
+  std::vector<size_t> order(widths.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b) { return widths[a] > widths[b]; });
+
+  std::vector<bool> used(numDeviceColumns, false);
+  std::vector<uint32_t> startColumns(widths.size());
+  for (size_t d : order) {
+    uint32_t width = std::max<uint32_t>(widths[d], 1);
+    std::optional<uint32_t> start;
+    for (uint32_t s = firstColumn; s + width <= numDeviceColumns && !start;
+         s++)
+      if (std::none_of(used.begin() + s, used.begin() + s + width,
+                       [](bool u) { return u; }))
+        start = s;
+    if (!start)
+      return std::nullopt;
+    std::fill(used.begin() + *start, used.begin() + *start + width, true);
+    startColumns[d] = *start;
+  }
+  return startColumns;
+}
+
+bool xilinx::AIE::relocateNPUInstructions(std::vector<uint32_t> &instructions,
+                                          int32_t columnOffset,
+                                          std::string *error) {
+  // Validate the whole stream before touching it so a failed relocation
+  // leaves the instructions unchanged.
+  std::vector<size_t> offsets;
+  bool valid =
+      forEachInstruction(instructions, error, [&](size_t i, uint32_t) {
+        int64_t column =
+            static_cast<int64_t>(getColumn(instructions[i])) + columnOffset;
+        if (column < 0 || column > 0xff)
+          return fail(error, "relocated column " + std::to_string(column) +
+                                 " is out of range");
+        offsets.push_back(i);
+        return true;
+      });
+  if (!valid)
+    return false;
+  for (size_t i : offsets)
+    instructions[i] =
+        setColumn(instructions[i], getColumn(instructions[i]) + columnOffset);
+  return true;
+}
+
+bool EmulatedPartitionBackend::configure(uint32_t slot,
+                                         const PartitionDesign &design,
+                                         uint32_t startColumn,
+                                         std::string *error) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (partitions.count(slot))
+    return fail(error, "slot " + std::to_string(slot) + " is already in use");
+  if (startColumn + design.numColumns > owners.size())
+    return fail(error, "design '" + design.name + "' does not fit the device");
+  for (uint32_t c = startColumn; c < startColumn + design.numColumns; c++)
+    if (owners[c])
+      return fail(error, "design '" + design.name + "' overlaps column " +
+                             std::to_string(c) + " of slot " +
+                             std::to_string(*owners[c]));
+  for (uint32_t c = startColumn; c < startColumn + design.numColumns; c++)
+    owners[c] = slot;
+  partitions[slot] = {startColumn, design.numColumns};
+  return true;
+}
+
+bool EmulatedPartitionBackend::execute(
+    uint32_t slot, const std::vector<uint32_t> &instructions,
+    std::string *error) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = partitions.find(slot);
+  if (it == partitions.end())
+    return fail(error, "slot " + std::to_string(slot) + " is not configured");
+  Partition &partition = it->second;
+  uint64_t numExecuted = 0;
+  bool valid = forEachInstruction(
+      instructions, error, [&](size_t i, uint32_t opCode) {
+        uint32_t column = getColumn(instructions[i]);
+        if (column < partition.startColumn ||
+            column >= partition.startColumn + partition.numColumns)
+          return fail(error, "slot " + std::to_string(slot) +
+                                 " issued opcode " + std::to_string(opCode) +
+                                 " to column " + std::to_string(column) +
+                                 " outside its partition");
+        numExecuted++;
+        return true;
+      });
+  if (!valid)
+    return false;
+  partition.numExecuted += numExecuted;
+  return true;
+}
+
+void EmulatedPartitionBackend::release(uint32_t slot) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = partitions.find(slot);
+  if (it == partitions.end())
+    return;
+  for (uint32_t c = it->second.startColumn;
+       c < it->second.startColumn + it->second.numColumns; c++)
+    owners[c].reset();
+  partitions.erase(it);
+}
+
+std::optional<uint32_t>
+EmulatedPartitionBackend::getOwner(uint32_t column) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return column < owners.size() ? owners[column] : std::nullopt;
+}
+
+uint64_t EmulatedPartitionBackend::getNumExecuted(uint32_t slot) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = partitions.find(slot);
+  return it == partitions.end() ? 0 : it->second.numExecuted;
+}
+
+PartitionScheduler::~PartitionScheduler() { unload(); }
+
+bool PartitionScheduler::load(std::vector<PartitionDesign> designs,
+                              std::string *error) {
+  unload();
+
+  std::vector<uint32_t> widths;
+  for (const PartitionDesign &design : designs)
+    widths.push_back(design.numColumns);
+  auto startColumns = packPartitions(widths, numDeviceColumns, firstColumn);
+  if (!startColumns)
+    return fail(error, "designs do not fit in " +
+                           std::to_string(numDeviceColumns - firstColumn) +
+                           " columns");
+
+  for (size_t i = 0; i < designs.size(); i++) {
+    auto slot = std::make_unique<Slot>();
+    slot->design = std::move(designs[i]);
+    slot->startColumn = (*startColumns)[i];
+    int32_t offset = static_cast<int32_t>(slot->startColumn) -
+                     static_cast<int32_t>(slot->design.baseColumn);
+    std::string reason;
+    if (!relocateNPUInstructions(slot->design.npuInstructions, offset,
+                                 &reason) ||
+        !backend.configure(i, slot->design, slot->startColumn, &reason)) {
+      unload();
+      return fail(error, "cannot load design '" + slot->design.name +
+                             "': " + reason);
+    }
+    slots.push_back(std::move(slot));
+  }
+
+  for (uint32_t i = 0; i < slots.size(); i++)
+    slots[i]->worker = std::thread(&PartitionScheduler::work, this, i);
+  return true;
+}
+
+std::future<bool> PartitionScheduler::submit(uint32_t slot,
+                                             std::string *error) {
+  Slot &s = *slots[slot];
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.queue.push_back({std::promise<bool>(), error});
+  std::future<bool> result = s.queue.back().result.get_future();
+  s.cv.notify_all();
+  return result;
+}
+
+void PartitionScheduler::wait() {
+  for (auto &slot : slots) {
+    std::unique_lock<std::mutex> lock(slot->mutex);
+    slot->cv.wait(lock, [&] { return slot->queue.empty() && !slot->busy; });
+  }
+}
+
+void PartitionScheduler::work(uint32_t slot) {
+  Slot &s = *slots[slot];
+  std::unique_lock<std::mutex> lock(s.mutex);
+  while (true) {
+    s.cv.wait(lock, [&] { return s.stop || !s.queue.empty(); });
+    if (s.queue.empty())
+      return;
+    Run run = std::move(s.queue.front());
+    s.queue.pop_front();
+    s.busy = true;
+    lock.unlock();
+
+    bool ok = backend.execute(slot, s.design.npuInstructions, run.error);
+    run.result.set_value(ok);
+
+    lock.lock();
+    s.busy = false;
+    s.cv.notify_all();
+  }
+}
+
+void PartitionScheduler::unload() {
+  // Workers drain their queues before exiting.
+  for (auto &slot : slots) {
+    if (!slot->worker.joinable())
+      continue;
+    {
+      std::lock_guard<std::mutex> lock(slot->mutex);
+      slot->stop = true;
+    }
+    slot->cv.notify_all();
+    slot->worker.join();
+  }
+  for (uint32_t i = 0; i < slots.size(); i++)
+    backend.release(i);
+  slots.clear();
+}
@@ -8,6 +8,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "aie/Targets/AIEDMAEmulator.h"
+#include "aie/Targets/AIEPartitionScheduler.h"
 #include "aie/Targets/AIETargets.h"
 
 #include "aie/Dialect/AIE/IR/AIEDialect.h"
@@ -17,6 +19,7 @@
 #include "mlir/Tools/mlir-translate/MlirTranslateMain.h"
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/TypeSwitch.h"
 #include "llvm/Support/Format.h"
 
@@ -129,13 +132,9 @@ void appendWriteBdShimTile(std::vector<uint32_t> &instructions,
   words[9] |= op.getLockAcqId() & 0xf;
 }
 
-} // namespace
-
-std::vector<uint32_t> xilinx::AIE::AIETranslateToNPU(ModuleOp module) {
-
+std::vector<uint32_t> translateDeviceToNPU(DeviceOp deviceOp) {
   std::vector<uint32_t> instructions = getProlog();
 
-  DeviceOp deviceOp = *module.getOps<DeviceOp>().begin();
   auto funcOps = deviceOp.getOps<func::FuncOp>();
   for (auto f : funcOps) {
     if (f.isDeclaration())
@@ -153,10 +152,124 @@ std::vector<uint32_t> xilinx::AIE::AIETranslateToNPU(ModuleOp module) {
   return instructions;
 }
 
+// The contiguous range of columns used by the tiles and NPU instructions of
+// `deviceOp`, as (first column, number of columns).
+std::pair<uint32_t, uint32_t> getColumnSpan(DeviceOp deviceOp) {
+  std::optional<int> minCol, maxCol;
+  auto addColumn = [&](int col) {
+    minCol = minCol ? std::min(*minCol, col) : col;
+    maxCol = maxCol ? std::max(*maxCol, col) : col;
+  };
+  deviceOp.walk([&](Operation *op) {
+    llvm::TypeSwitch<Operation *>(op)
+        .Case<TileOp>([&](auto tile) { addColumn(tile.getCol()); })
+        .Case<NpuSyncOp, NpuWrite32Op, NpuWriteBdExShimTileOp>(
+            [&](auto npuOp) { addColumn(npuOp.getColumn()); });
+  });
+  if (!minCol)
+    return {0, 1};
+  return {*minCol, *maxCol - *minCol + 1};
+}
+
+} // namespace
+
+std::vector<uint32_t> xilinx::AIE::AIETranslateToNPU(ModuleOp module) {
+  DeviceOp deviceOp = *module.getOps<DeviceOp>().begin();
+  return translateDeviceToNPU(deviceOp);
+}
+
 LogicalResult xilinx::AIE::AIETranslateToNPU(ModuleOp module,
-                                             raw_ostream &output) {
+                                             raw_ostream &output,
+                                             int columnOffset) {
   auto instructions = AIETranslateToNPU(module);
+  std::string error;
+  if (!relocateNPUInstructions(instructions, columnOffset, &error))
+    return module.emitError("cannot relocate NPU instructions: ") << error;
   for (auto w : instructions)
     output << llvm::format("%08X\n", w);
   return success();
 }
+
+LogicalResult xilinx::AIE::AIETranslateNPUToPartitionSchedule(
+    ModuleOp module, raw_ostream &output, int numRuns) {
+  if (module.getOps<DeviceOp>().empty())
+    return module.emitOpError("expected AIE.device operation at toplevel");
+
+  // Every device in the module is one design; they are packed onto the device
+  // of the first one.
+  std::vector<PartitionDesign> designs;
+  for (auto [i, deviceOp] : llvm::enumerate(module.getOps<DeviceOp>())) {
+    PartitionDesign design;
+    design.name = "design" + std::to_string(i);
+    std::tie(design.baseColumn, design.numColumns) = getColumnSpan(deviceOp);
+    design.npuInstructions = translateDeviceToNPU(deviceOp);
+    designs.push_back(std::move(design));
+  }
+  DeviceOp targetOp = *module.getOps<DeviceOp>().begin();
+  uint32_t numColumns = targetOp.getTargetModel().columns();
+
+  EmulatedPartitionBackend backend(numColumns);
+  PartitionScheduler scheduler(backend, numColumns);
+  std::string error;
+  if (!scheduler.load(designs, &error))
+    return module.emitError("partition scheduling failed: ") << error;
+
+  std::vector<std::future<bool>> runs;
+  std::vector<std::string> errors(designs.size() * numRuns);
+  for (int r = 0; r < numRuns; r++)
+    for (uint32_t i = 0; i < designs.size(); i++)
+      runs.push_back(scheduler.submit(i, &errors[r * designs.size() + i]));
+  scheduler.wait();
+  for (auto [run, runError] : llvm::zip(runs, errors))
+    if (!run.get())
+      return module.emitError("partition execution failed: ") << runError;
+
+  for (uint32_t i = 0; i < designs.size(); i++) {
+    uint32_t start = scheduler.getStartColumn(i);
+    output << designs[i].name << ": columns " << start << "-"
+           << start + designs[i].numColumns - 1 << " offset "
+           << static_cast<int>(start) -
+                  static_cast<int>(designs[i].baseColumn)
+           << " executed " << backend.getNumExecuted(i) << "\n";
+    for (auto w : scheduler.getInstructions(i))
+      output << llvm::format("  %08X\n", w);
+  }
+  return success();
+}
+
+LogicalResult xilinx::AIE::AIETranslateNPUToDMATrace(ModuleOp module,
+                                                     raw_ostream &output) {
+  auto instructions = AIETranslateToNPU(module);
+  auto traces = emulateNPUInstructions(instructions);
+  for (auto [i, trace] : llvm::enumerate(traces)) {
+    const DMATask &task = trace.task;
+    output << "task " << i << ": col " << task.column << " "
+           << (task.isMM2S ? "mm2s" : "s2mm") << " " << task.channel
+           << " bd " << task.startBd << " repeat " << task.repeatCount << "\n";
+    if (!trace.error.empty())
+      return module.emitError("DMA emulation failed: ") << trace.error;
+
+    auto stats = DMAEmulator::computeStats(trace.accesses);
+    output << "  words " << stats.words << " runs " << stats.runs
+           << " min_run " << stats.minRunLength << " max_run "
+           << stats.maxRunLength << " avg_run "
+           << llvm::format("%.2f", stats.averageRunLength()) << "\n";
+    output << "  aligned_128b " << stats.runs128BitAligned << " aligned_32b "
+           << stats.runs32BitAligned << " beats_128b " << stats.beats128Bit
+           << " efficiency "
+           << llvm::format("%.2f", stats.efficiency128Bit()) << "\n";
+
+    // Print the address stream as runs of consecutive words.
+    auto &accesses = trace.accesses;
+    for (size_t start = 0, end = 0; start < accesses.size(); start = end) {
+      end = start + 1;
+      while (end < accesses.size() &&
+             accesses[end].ddrId == accesses[start].ddrId &&
+             accesses[end].address == accesses[end - 1].address + 4)
+        end++;
+      output << "  ddr " << accesses[start].ddrId << " offset "
+             << accesses[start].address << " words " << end - start << "\n";
+    }
+  }
+  return success();
+}
@@ -0,0 +1,542 @@
+//===- AIETargetResourceReport.cpp ------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+//
+// Reports how much of the hardware resources of every tile a design uses:
+// data memory by bank, locks, buffer descriptors, DMA channels and stream
+// switch ports, along with the number of switchboxes every routed flow goes
+// through and the depth of every ObjectFifo. The resources closest to their
+// limit are summarized first, as they are the ones keeping a design from
+// growing. The report is JSON, or a standalone HTML page.
+//
+// Buffer addresses and routes are only known after AIEAssignBufferAddresses
+// and the routing passes; ObjectFifos only before
+// AIEObjectFifoStatefulTransform, so run it at both stages for the full
+// picture.
+//
+//===----------------------------------------------------------------------===//
+
+#include "aie/Dialect/AIE/IR/AIEDeviceIndex.h"
+#include "aie/Dialect/AIE/IR/AIEDialect.h"
+#include "aie/Targets/AIETargets.h"
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+
+#include <map>
+#include <set>
+
+using namespace mlir;
+using namespace xilinx;
+using namespace xilinx::AIE;
+
+namespace {
+
+// The number of resources of one kind a tile uses, and how many it has.
+struct Usage {
+  int64_t used = 0;
+  int64_t available = 0;
+
+  double utilization() const {
+    return available ? double(used) / double(available) : 0.0;
+  }
+  llvm::json::Value toJSON() const {
+    return llvm::json::Object{{"used", used}, {"available", available}};
+  }
+};
+
+struct StreamUsage {
+  WireBundle bundle;
+  Usage in, out;
+};
+
+struct TileReport {
+  TileID id;
+  StringRef kind;
+  // Bytes of each data memory bank, including the stack in the first one.
+  SmallVector<Usage, 4> banks;
+  int64_t stackSize = 0;
+  // Bytes of buffers that have no address yet.
+  int64_t unassigned = 0;
+  Usage locks, bds, s2mm, mm2s;
+  SmallVector<StreamUsage> streams;
+};
+
+struct Endpoint {
+  TileID tile;
+  Port port;
+};
+
+struct FlowReport {
+  Endpoint source, dest;
+  // The number of switchboxes the flow goes through.
+  int hops;
+  // Whether the flow is routed, or its hops are the shortest route possible.
+  bool routed;
+};
+
+struct ObjectFifoReport {
+  StringRef name;
+  TileID producer, consumer;
+  int producerDepth, consumerDepth;
+};
+
+// The most utilized tile of a kind of resource.
+struct Bottleneck {
+  std::string resource;
+  TileID tile;
+  Usage usage;
+};
+
+struct DeviceReport {
+  StringRef device;
+  std::vector<TileReport> tiles;
+  std::vector<FlowReport> flows;
+  std::vector<ObjectFifoReport> objectFifos;
+  std::vector<Bottleneck> bottlenecks;
+};
+
+} // namespace
+
+static StringRef getTileKind(const AIETargetModel &targetModel, TileID id) {
+  if (targetModel.isShimNOCTile(id.col, id.row))
+    return "shim_noc";
+  if (targetModel.isShimPLTile(id.col, id.row))
+    return "shim_pl";
+  if (targetModel.isMemTile(id.col, id.row))
+    return "mem";
+  return "core";
+}
+
+static TileReport getTileReport(TileOp tile, const AIEDeviceIndex &index) {
+  const AIETargetModel &targetModel = index.getTargetModel();
+  TileID id = tile.getTileID();
+  TileReport report;
+  report.id = id;
+  report.kind = getTileKind(targetModel, id);
+
+  if (targetModel.isCoreTile(id.col, id.row) ||
+      targetModel.isMemTile(id.col, id.row)) {
+    int64_t memorySize = targetModel.isMemTile(id.col, id.row)
+                             ? targetModel.getMemTileSize()
+                             : targetModel.getLocalMemorySize();
+    int64_t numBanks = targetModel.getNumBanks(id.col, id.row);
+    int64_t bankSize = memorySize / numBanks;
+    report.banks.assign(numBanks, Usage{0, bankSize});
+
+    // Add the bytes of [start, end) to the banks they fall in.
+    auto addRange = [&](int64_t start, int64_t end) {
+      for (int64_t bank = 0; bank < numBanks; ++bank) {
+        int64_t lo = std::max(start, bank * bankSize);
+        int64_t hi = std::min(end, (bank + 1) * bankSize);
+        if (lo < hi)
+          report.banks[bank].used += hi - lo;
+      }
+    };
+    if (CoreOp core = index.getCore(id)) {
+      report.stackSize = core.getStackSize();
+      addRange(0, report.stackSize);
+    }
+    for (BufferOp buffer : index.getBuffers(id)) {
+      if (std::optional<int> address = buffer.getAddress())
+        addRange(*address, *address + buffer.getAllocationSize());
+      else
+        report.unassigned += buffer.getAllocationSize();
+    }
+  }
+
+  report.locks = {int64_t(index.getLocks(id).size()),
+                  targetModel.getNumLocks(id.col, id.row)};
+  report.bds = {int64_t(index.getBDs(id).size()),
+                targetModel.getNumBDs(id.col, id.row)};
+
+  // The channels started by the DMA of the tile and, for shim tiles, those
+  // allocated to the runtime sequence.
+  std::set<std::pair<DMAChannelDir, int>> channels;
+  for (DMAStartOp start : index.getDMAStarts(id))
+    channels.insert({start.getChannelDir(), start.getChannelIndex()});
+  if (tile.isShimTile())
+    for (auto alloc : index.getDevice().getOps<ShimDMAAllocationOp>())
+      if (alloc.getCol() == id.col)
+        channels.insert({alloc.getChannelDir(), alloc.getChannelIndex()});
+  // An MM2S channel feeds the stream switch (or the shim mux) and an S2MM
+  // channel is fed by it. Shim PL tiles have no DMA.
+  if (tile.isShimNOCTile()) {
+    report.mm2s.available = targetModel.getNumSourceShimMuxConnections(
+        id.col, id.row, WireBundle::DMA);
+    report.s2mm.available = targetModel.getNumDestShimMuxConnections(
+        id.col, id.row, WireBundle::DMA);
+  } else if (tile.isShimTile()) {
+    report.mm2s.available = 0;
+    report.s2mm.available = 0;
+  } else {
+    report.mm2s.available = targetModel.getNumSourceSwitchboxConnections(
+        id.col, id.row, WireBundle::DMA);
+    report.s2mm.available = targetModel.getNumDestSwitchboxConnections(
+        id.col, id.row, WireBundle::DMA);
+  }
+  for (auto [dir, channel] : channels)
+    ++(dir == DMAChannelDir::S2MM ? report.s2mm : report.mm2s).used;
+
+  // The ports of the switchbox used by each bundle.
+  SmallVector<int64_t> in(getMaxEnumValForWireBundle() + 1),
+      out(getMaxEnumValForWireBundle() + 1);
+  if (SwitchboxOp switchbox = index.getSwitchbox(id)) {
+    for (ConnectOp connect : switchbox.getOps<ConnectOp>()) {
+      ++in[int(connect.getSourceBundle())];
+      ++out[int(connect.getDestBundle())];
+    }
+    for (auto rules : switchbox.getOps<PacketRulesOp>())
+      ++in[int(rules.getSourceBundle())];
+    for (auto masterSet : switchbox.getOps<MasterSetOp>())
+      ++out[int(masterSet.getDestBundle())];
+  }
+  for (auto [i, used] : llvm::enumerate(llvm::zip_equal(in, out))) {
+    auto bundle = static_cast<WireBundle>(i);
+    StreamUsage stream{
+        bundle,
+        {std::get<0>(used), targetModel.getNumSourceSwitchboxConnections(
+                                id.col, id.row, bundle)},
+        {std::get<1>(used), targetModel.getNumDestSwitchboxConnections(
+                                id.col, id.row, bundle)}};
+    if (stream.in.used || stream.in.available || stream.out.used ||
+        stream.out.available)
+      report.streams.push_back(stream);
+  }
+  return report;
+}
+
+// Return whether a circuit-switched flow can start or end at `port` of the
+// switchbox of `tile`, rather than continue from or to a neighbour.
+static bool isFlowEndpoint(TileID tile, Port port) {
+  switch (port.bundle) {
+  case WireBundle::North:
+  case WireBundle::East:
+  case WireBundle::West:
+    return false;
+  case WireBundle::South:
+    return tile.row == 0;
+  default:
+    return true;
+  }
+}
+
+static TileID getNeighbour(TileID tile, WireBundle bundle) {
+  switch (bundle) {
+  case WireBundle::North:
+    return {tile.col, tile.row + 1};
+  case WireBundle::South:
+    return {tile.col, tile.row - 1};
+  case WireBundle::East:
+    return {tile.col + 1, tile.row};
+  case WireBundle::West:
+    return {tile.col - 1, tile.row};
+  default:
+    return tile;
+  }
+}
+
+// Trace the connections of the switchboxes from every flow source to its
+// destinations.
+static void getRoutedFlows(const AIEDeviceIndex &index,
+                           std::vector<FlowReport> &flows) {
+  DenseMap<std::pair<Operation *, Port>, SmallVector<Port, 1>> connections;
+  for (auto switchbox : index.getDevice().getOps<SwitchboxOp>())
+    for (ConnectOp connect : switchbox.getOps<ConnectOp>())
+      connections[{switchbox, connect.sourcePort()}].push_back(
+          connect.destPort());
+
+  for (auto switchbox : index.getDevice().getOps<SwitchboxOp>()) {
+    TileID sourceTile = switchbox.getTileID();
+    std::set<Port> sources;
+    for (ConnectOp connect : switchbox.getOps<ConnectOp>())
+      if (isFlowEndpoint(sourceTile, connect.sourcePort()))
+        sources.insert(connect.sourcePort());
+
+    for (Port source : sources) {
+      SmallVector<std::tuple<SwitchboxOp, Port, int>> worklist{
+          {switchbox, source, 1}};
+      DenseSet<std::pair<Operation *, Port>> visited;
+      while (!worklist.empty()) {
+        auto [current, port, hops] = worklist.pop_back_val();
+        if (!visited.insert({current, port}).second)
+          continue;
+        TileID tile = current.getTileID();
+        for (Port dest : connections.lookup({current, port})) {
+          if (isFlowEndpoint(tile, dest)) {
+            flows.push_back({{sourceTile, source}, {tile, dest}, hops, true});
+            continue;
+          }
+          if (SwitchboxOp next =
+                  index.getSwitchbox(getNeighbour(tile, dest.bundle)))
+            worklist.push_back(
+                {next, {getConnectingBundle(dest.bundle), dest.channel},
+                 hops + 1});
+        }
+      }
+    }
+  }
+}
+
+static DeviceReport getDeviceReport(DeviceOp device) {
+  AIEDeviceIndex index(device);
+  DeviceReport report;
+  report.device = stringifyAIEDevice(device.getDevice());
+
+  for (TileOp tile : device.getOps<TileOp>())
+    report.tiles.push_back(getTileReport(tile, index));
+  llvm::sort(report.tiles, [](const TileReport &a, const TileReport &b) {
+    return a.id < b.id;
+  });
+
+  getRoutedFlows(index, report.flows);
+  // Flows that are not routed yet go through at least the switchboxes of a
+  // shortest path.
+  for (FlowOp flow : device.getOps<FlowOp>()) {
+    TileID source = cast<TileOp>(flow.getSource().getDefiningOp()).getTileID();
+    TileID dest = cast<TileOp>(flow.getDest().getDefiningOp()).getTileID();
+    report.flows.push_back(
+        {{source, {flow.getSourceBundle(), flow.getSourceChannel()}},
+         {dest, {flow.getDestBundle(), flow.getDestChannel()}},
+         std::abs(source.col - dest.col) + std::abs(source.row - dest.row) +
+             1,
+         false});
+  }
+
+  for (auto fifo : device.getOps<ObjectFifoCreateOp>()) {
+    bool perTile = isa<ArrayAttr>(fifo.getElemNumber());
+    for (auto [i, consumer] : llvm::enumerate(fifo.getConsumerTiles()))
+      report.objectFifos.push_back(
+          {fifo.getSymName(), fifo.getProducerTileOp().getTileID(),
+           cast<TileOp>(consumer.getDefiningOp()).getTileID(), fifo.size(),
+           perTile ? fifo.size(i + 1) : fifo.size()});
+  }
+
+  // For every kind of resource, the tile that uses the largest share of it.
+  std::map<std::string, Bottleneck> worst;
+  auto consider = [&](const std::string &resource, TileID tile, Usage usage) {
+    if (!usage.used)
+      return;
+    auto [it, inserted] = worst.insert({resource, {resource, tile, usage}});
+    if (!inserted && usage.utilization() > it->second.usage.utilization())
+      it->second = {resource, tile, usage};
+  };
+  for (const TileReport &tile : report.tiles) {
+    for (const Usage &bank : tile.banks)
+      consider("memory_bank", tile.id, bank);
+    consider("locks", tile.id, tile.locks);
+    consider("bds", tile.id, tile.bds);
+    consider("dma_s2mm", tile.id, tile.s2mm);
+    consider("dma_mm2s", tile.id, tile.mm2s);
+    for (const StreamUsage &stream : tile.streams) {
+      std::string bundle = stringifyWireBundle(stream.bundle).str();
+      consider("stream_in_" + bundle, tile.id, stream.in);
+      consider("stream_out_" + bundle, tile.id, stream.out);
+    }
+  }
+  for (auto &entry : worst)
+    report.bottlenecks.push_back(entry.second);
+  llvm::stable_sort(report.bottlenecks,
+                    [](const Bottleneck &a, const Bottleneck &b) {
+                      return a.usage.utilization() > b.usage.utilization();
+                    });
+  return report;
+}
+
+static llvm::json::Value toJSON(TileID id) {
+  return llvm::json::Array{id.col, id.row};
+}
+
+static llvm::json::Value toJSON(const Endpoint &endpoint) {
+  return llvm::json::Object{
+      {"tile", toJSON(endpoint.tile)},
+      {"bundle", stringifyWireBundle(endpoint.port.bundle)},
+      {"channel", endpoint.port.channel}};
+}
+
+static llvm::json::Value toJSON(const DeviceReport &report) {
+  llvm::json::Array tiles;
+  for (const TileReport &tile : report.tiles) {
+    llvm::json::Object tileJSON{{"tile", toJSON(tile.id)},
+                                {"kind", tile.kind},
+                                {"locks", tile.locks.toJSON()},
+                                {"bds", tile.bds.toJSON()},
+                                {"dma_s2mm", tile.s2mm.toJSON()},
+                                {"dma_mm2s", tile.mm2s.toJSON()}};
+    if (!tile.banks.empty()) {
+      llvm::json::Array banks;
+      for (const Usage &bank : tile.banks)
+        banks.push_back(bank.toJSON());
+      tileJSON["memory_banks"] = std::move(banks);
+      tileJSON["stack_size"] = tile.stackSize;
+      tileJSON["unassigned_bytes"] = tile.unassigned;
+    }
+    llvm::json::Object streams;
+    for (const StreamUsage &stream : tile.streams)
+      streams[stringifyWireBundle(stream.bundle)] = llvm::json::Object{
+          {"in", stream.in.toJSON()}, {"out", stream.out.toJSON()}};
+    tileJSON["streams"] = std::move(streams);
+    tiles.push_back(std::move(tileJSON));
+  }
+
+  llvm::json::Array flows;
+  for (const FlowReport &flow : report.flows)
+    flows.push_back(llvm::json::Object{{"source", toJSON(flow.source)},
+                                       {"dest", toJSON(flow.dest)},
+                                       {"hops", flow.hops},
+                                       {"routed", flow.routed}});
+
+  llvm::json::Array objectFifos;
+  for (const ObjectFifoReport &fifo : report.objectFifos)
+    objectFifos.push_back(
+        llvm::json::Object{{"name", fifo.name},
+                           {"producer", toJSON(fifo.producer)},
+                           {"consumer", toJSON(fifo.consumer)},
+                           {"producer_depth", fifo.producerDepth},
+                           {"consumer_depth", fifo.consumerDepth}});
+
+  llvm::json::Array bottlenecks;
+  for (const Bottleneck &bottleneck : report.bottlenecks)
+    bottlenecks.push_back(llvm::json::Object{
+        {"resource", bottleneck.resource},
+        {"tile", toJSON(bottleneck.tile)},
+        {"used", bottleneck.usage.used},
+        {"available", bottleneck.usage.available},
+        {"utilization", bottleneck.usage.utilization()}});
+
+  return llvm::json::Object{{"device", report.device},
+                            {"bottlenecks", std::move(bottlenecks)},
+                            {"tiles", std::move(tiles)},
+                            {"flows", std::move(flows)},
+                            {"objectfifos", std::move(objectFifos)}};
+}
+
+static std::string toString(TileID id) {
+  return llvm::formatv("({0}, {1})", id.col, id.row);
+}
+
+static std::string toString(const Endpoint &endpoint) {
+  return llvm::formatv("{0} {1}:{2}", toString(endpoint.tile),
+                       stringifyWireBundle(endpoint.port.bundle),
+                       endpoint.port.channel);
+}
+
+// A table cell with `usage`, highlighted as it gets close to the limit.
+static void writeUsageCell(raw_ostream &output, const Usage &usage) {
+  StringRef level = usage.used > usage.available ? "over"
+                    : usage.utilization() >= 1.0  ? "full"
+                    : usage.utilization() >= 0.75 ? "high"
+                                                  : "low";
+  output << "<td class=\"" << level << "\">" << usage.used << " / "
+         << usage.available << "</td>";
+}
+
+static void writeHTML(raw_ostream &output, const DeviceReport &report) {
+  output << "<h1>";
+  llvm::printHTMLEscaped(report.device, output);
+  output << "</h1>\n";
+
+  output << "<h2>Bottlenecks</h2>\n<table>\n<tr><th>Resource</th><th>Tile</th>"
+            "<th>Used / available</th><th>Utilization</th></tr>\n";
+  for (const Bottleneck &bottleneck : report.bottlenecks) {
+    output << "<tr><td>";
+    llvm::printHTMLEscaped(bottleneck.resource, output);
+    output << "</td><td>" << toString(bottleneck.tile) << "</td>";
+    writeUsageCell(output, bottleneck.usage);
+    output << llvm::formatv("<td>{0:P}</td></tr>\n",
+                            bottleneck.usage.utilization());
+  }
+  output << "</table>\n";
+
+  output << "<h2>Tiles</h2>\n<table>\n<tr><th>Tile</th><th>Kind</th>"
+            "<th>Memory banks (bytes)</th><th>Locks</th><th>BDs</th>"
+            "<th>DMA S2MM</th><th>DMA MM2S</th>"
+            "<th>Streams in / out</th></tr>\n";
+  for (const TileReport &tile : report.tiles) {
+    output << "<tr><td>" << toString(tile.id) << "</td><td>" << tile.kind
+           << "</td><td><table>";
+    for (const Usage &bank : tile.banks) {
+      output << "<tr>";
+      writeUsageCell(output, bank);
+      output << "</tr>";
+    }
+    output << "</table></td>";
+    writeUsageCell(output, tile.locks);
+    writeUsageCell(output, tile.bds);
+    writeUsageCell(output, tile.s2mm);
+    writeUsageCell(output, tile.mm2s);
+    output << "<td><table>";
+    for (const StreamUsage &stream : tile.streams) {
+      output << "<tr><td>" << stringifyWireBundle(stream.bundle) << "</td>";
+      writeUsageCell(output, stream.in);
+      writeUsageCell(output, stream.out);
+      output << "</tr>";
+    }
+    output << "</table></td></tr>\n";
+  }
+  output << "</table>\n";
+
+  output << "<h2>Flows</h2>\n<table>\n<tr><th>Source</th><th>Destination</th>"
+            "<th>Hops</th></tr>\n";
+  for (const FlowReport &flow : report.flows)
+    output << "<tr><td>" << toString(flow.source) << "</td><td>"
+           << toString(flow.dest) << "</td><td>" << flow.hops
+           << (flow.routed ? "" : " (unrouted)") << "</td></tr>\n";
+  output << "</table>\n";
+
+  output << "<h2>ObjectFifos</h2>\n<table>\n<tr><th>Name</th><th>Producer</th>"
+            "<th>Consumer</th><th>Producer depth</th>"
+            "<th>Consumer depth</th></tr>\n";
+  for (const ObjectFifoReport &fifo : report.objectFifos) {
+    // Symbol names may contain any character.
+    output << "<tr><td>";
+    llvm::printHTMLEscaped(fifo.name, output);
+    output << "</td><td>" << toString(fifo.producer) << "</td><td>"
+           << toString(fifo.consumer) << "</td><td>" << fifo.producerDepth
+           << "</td><td>" << fifo.consumerDepth << "</td></tr>\n";
+  }
+  output << "</table>\n";
+}
+
+LogicalResult xilinx::AIE::AIETranslateToResourceReport(ModuleOp module,
+                                                        raw_ostream &output,
+                                                        bool html) {
+  if (module.getOps<DeviceOp>().empty())
+    return module.emitOpError("expected aie.device operation at toplevel");
+
+  std::vector<DeviceReport> reports;
+  for (DeviceOp device : module.getOps<DeviceOp>())
+    reports.push_back(getDeviceReport(device));
+
+  if (!html) {
+    llvm::json::Array devices;
+    for (const DeviceReport &report : reports)
+      devices.push_back(toJSON(report));
+    output << llvm::formatv("{0:2}",
+                            llvm::json::Value(llvm::json::Object{
+                                {"devices", std::move(devices)}}))
+           << "\n";
+    return success();
+  }
+
+  output << "<!DOCTYPE html>\n<html>\n<head>\n"
+            "<meta charset=\"utf-8\">\n"
+            "<title>AIE resource report</title>\n<style>\n"
+            "table { border-collapse: collapse; }\n"
+            "td, th { border: 1px solid #ccc; padding: 2px 6px; }\n"
+            "td.high { background: #fff3b0; }\n"
+            "td.full { background: #ffc680; }\n"
+            "td.over { background: #ff8080; }\n"
+            "</style>\n</head>\n<body>\n";
+  for (const DeviceReport &report : reports)
+    writeHTML(output, report);
+  output << "</body>\n</html>\n";
+  return success();
+}
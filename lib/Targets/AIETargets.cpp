@@ -151,6 +151,15 @@ void registerAIETranslations() {
   static llvm::cl::opt<size_t> cdoEnableCores(
       "cdo-enable-cores", llvm::cl::init(true),
       llvm::cl::desc("Enable cores in CDO"));
+  static llvm::cl::opt<int> npuColumnOffset(
+      "npu-column-offset", llvm::cl::init(0),
+      llvm::cl::desc("Relocate NPU instructions by this many columns"));
+  static llvm::cl::opt<bool> resourceReportHTML(
+      "resource-report-html", llvm::cl::init(false),
+      llvm::cl::desc("Emit the resource report as HTML instead of JSON"));
+  static llvm::cl::opt<int> npuScheduleRuns(
+      "npu-schedule-runs", llvm::cl::init(1),
+      llvm::cl::desc("Number of runs of each design to dispatch"));
 
   TranslateFromMLIRRegistration registrationMMap(
       "aie-generate-mmap", "Generate AIE memory map",
@@ -293,6 +302,14 @@ void registerAIETranslations() {
   TranslateFromMLIRRegistration registrationXJSON(
       "aie-flows-to-json", "Translate AIE flows to JSON", AIEFlowsToJSON,
       registerDialects);
+  TranslateFromMLIRRegistration registrationResourceReport(
+      "aie-generate-resource-report",
+      "Report the resources every tile uses against its limits",
+      [](ModuleOp module, raw_ostream &output) {
+        return AIETranslateToResourceReport(module, output,
+                                            resourceReportHTML);
+      },
+      registerDialects);
   TranslateFromMLIRRegistration registrationXPE(
       "aie-mlir-to-xpe", "Translate AIE design to XPE file for simulation",
       AIETranslateGraphXPE, registerDialects);
@@ -323,7 +340,20 @@ void registerAIETranslations() {
   TranslateFromMLIRRegistration registrationNPU(
       "aie-npu-instgen", "Generate instructions for NPU",
       [](ModuleOp module, raw_ostream &output) {
-        return AIETranslateToNPU(module, output);
+        return AIETranslateToNPU(module, output, npuColumnOffset);
+      },
+      registerDialects);
+  TranslateFromMLIRRegistration registrationNPUDMATrace(
+      "aie-npu-dma-trace",
+      "Emulate the shim DMA transfers of the NPU instruction stream",
+      AIETranslateNPUToDMATrace, registerDialects);
+  TranslateFromMLIRRegistration registrationNPUPartitionSchedule(
+      "aie-npu-partition-schedule",
+      "Pack every device of the module into disjoint columns and run their "
+      "relocated NPU instructions on an emulated device",
+      [](ModuleOp module, raw_ostream &output) {
+        return AIETranslateNPUToPartitionSchedule(module, output,
+                                                  npuScheduleRuns);
       },
       registerDialects);
 }
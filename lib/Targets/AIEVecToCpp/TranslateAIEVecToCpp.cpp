@@ -2287,7 +2287,8 @@ static LogicalResult printOperation(CppEmitter &emitter,
       callOp.getCallee() == "getErfBf16" || callOp.getCallee() == "getAbs" ||
       callOp.getCallee() == "getSigmoidBf16" ||
       callOp.getCallee() == "getCeilBf16" ||
-      callOp.getCallee() == "getFloorBf16") {
+      callOp.getCallee() == "getFloorBf16" ||
+      callOp.getCallee().ends_with("Poly")) {
     if (failed(emitter.emitAssignPrefix(op, /*isAcc*/ false)))
       return failure();
   } else if (failed(emitter.emitAssignPrefix(op, /*isAcc*/ true)))
@@ -2401,10 +2402,19 @@ static LogicalResult printOperation(CppEmitter &emitter, scf::ForOp forOp) {
   os << emitter.getOrCreateName(forOp.getStep());
   os << ")\n";
   os << "chess_prepare_for_pipelining\n";
-  // Try to find the upper bound and step of the for operator.
-  // If the bounds are found, print them
-  if (auto [constantLoopBound, tripCount] = getTripCount(forOp);
-      constantLoopBound) {
+  // Print the bounds on the number of iterations derived by aie-loop-hints,
+  // if any. Otherwise, try to find the upper bound and step of the for
+  // operator, and if they are found, print them.
+  if (auto range = forOp->getAttrOfType<DenseI64ArrayAttr>("aie.loop_range");
+      range && !range.empty()) {
+    os << "chess_loop_range(";
+    os << std::to_string(range[0]);
+    os << ", ";
+    if (range.size() > 1)
+      os << std::to_string(range[1]);
+    os << ")\n";
+  } else if (auto [constantLoopBound, tripCount] = getTripCount(forOp);
+             constantLoopBound) {
     auto [constantStep, step] = getStep(forOp);
     int64_t lb = constantStep && step > 0 ? floorDiv(tripCount, step) : 1;
     int64_t ub = constantStep && step > 0 ? ceilDiv(tripCount, step) : 0;
@@ -3241,6 +3251,12 @@ CppEmitter::genCppTypeName(Type type, bool stdintType, bool isAcc) {
     switch (iType.getWidth()) {
     case 1:
       return "bool";
+    case 4:
+      // 4-bit integers only exist as vector elements (v64int4); there is no
+      // scalar or pointer type for them.
+      if (stdintType)
+        return {};
+      [[fallthrough]];
     case 8:
     case 16:
     case 32:
@@ -3365,8 +3381,13 @@ CppEmitter::genCppTypeName(Type type, bool stdintType, bool isAcc) {
 LogicalResult CppEmitter::emitType(Location loc, Type type, bool stdintType,
                                    bool isAcc) {
   auto typeName = genCppTypeName(type, stdintType, isAcc);
-  if (!typeName)
+  if (!typeName) {
+    auto memRefType = dyn_cast<MemRefType>(type);
+    if (memRefType && memRefType.getElementType().isInteger(4))
+      return emitError(loc, "cannot emit type ")
+             << type << ": 4-bit elements are not addressable";
     return emitError(loc, "cannot emit type ") << type;
+  }
   os << *typeName;
   return success();
 }
@@ -7,6 +7,7 @@
 
 #include "aie-c/Dialects.h"
 #include "aie-c/Registration.h"
+#include "aie-c/TilingDSE.h"
 #include "aie-c/Translation.h"
 
 #include "mlir-c/IR.h"
@@ -132,6 +133,28 @@ PYBIND11_MODULE(_aie, m) {
       },
       "module"_a, "col"_a, "row"_a);
 
+  m.def(
+      "generate_hsa",
+      [&stealCStr](MlirOperation op) {
+        return stealCStr(aieTranslateToHSA(op));
+      },
+      "module"_a);
+
+  m.def(
+      "generate_ldscript",
+      [&stealCStr](MlirOperation op, int col, int row) {
+        return stealCStr(aieTranslateToLdScript(op, col, row));
+      },
+      "module"_a, "col"_a, "row"_a);
+
+  m.def(
+      "generate_target_arch",
+      [&stealCStr](MlirOperation op) {
+        py::str arch = stealCStr(aieTranslateToTargetArch(op));
+        return arch.attr("strip")();
+      },
+      "module"_a);
+
   m.def(
       "aie_llvm_link",
       [&stealCStr](std::vector<std::string> moduleStrs) {
@@ -143,4 +166,20 @@ PYBIND11_MODULE(_aie, m) {
         return stealCStr(aieLLVMLink(modules.data(), modules.size()));
       },
       "modules"_a);
+
+  m.def(
+      "explore_tilings",
+      [](const std::string &problem) {
+        std::string result;
+        auto append = [](MlirStringRef str, void *userData) {
+          static_cast<std::string *>(userData)->append(str.data, str.length);
+        };
+        if (mlirLogicalResultIsFailure(aieExploreTilings(
+                {problem.data(), problem.size()}, append, &result)))
+          throw py::value_error("Invalid tiling problem: " + result);
+        return result;
+      },
+      "Return the JSON list of the Pareto-optimal tilings of the loop nest "
+      "described by the JSON `problem`.",
+      "problem"_a);
 }
@@ -8,6 +8,7 @@ __all__ = [
     "ObjectFifoSubviewType",
     "ObjectFifoType",
     "aie_llvm_link",
+    "explore_tilings",
     "generate_bcf",
     "generate_cdo",
     "generate_xaie",
@@ -18,6 +19,7 @@ __all__ = [
 ]
 
 def aie_llvm_link(modules: list[str]) -> str: ...
+def explore_tilings(problem: str) -> str: ...
 def generate_bcf(module: Operation, col: int, row: int) -> str: ...
 def generate_cdo(
     module: Operation,
@@ -35,6 +35,13 @@ def parse_args(args=None):
         action="store_true",
         help="Trace commands as they are executed",
     )
+    parser.add_argument(
+        "--text-intermediates",
+        dest="text_intermediates",
+        default=False,
+        action="store_true",
+        help="Write intermediate MLIR files as text instead of bytecode",
+    )
     parser.add_argument(
         "--vectorize",
         dest="vectorize",
@@ -16,7 +16,6 @@ import random
 import re
 import shutil
 import stat
-import subprocess
 import sys
 import tempfile
 from textwrap import dedent
@@ -32,7 +31,7 @@ import rich.progress as progress
 import aie.compiler.aiecc.cl_arguments
 import aie.compiler.aiecc.configure
 from aie.dialects import aie as aiedialect
-from aie.ir import Context, Location, Module
+from aie.ir import Context, InsertionPoint, Location, Module
 from aie.passmanager import PassManager
 
 INPUT_WITH_SWITCHBOXES_PIPELINE = (
@@ -84,6 +83,33 @@ AIE_LOWER_TO_LLVM = (
     + LOWER_TO_LLVM_PIPELINE
 )
 
+# Lowers every core into a nested module of its own, in a single invocation.
+# The pass manager runs the nested pipelines of the cores in parallel.
+AIE_LOWER_CORES_TO_LLVM = (
+    Pipeline()
+    .Nested(
+        "aie.device",
+        Pipeline()
+        .add_pass("aie-localize-locks")
+        .add_pass("aie-normalize-address-spaces"),
+    )
+    .add_pass("aie-standard-lowering", split_cores=True)
+    .add_pass("aiex-standard-lowering")
+    .Nested("builtin.module", LOWER_TO_LLVM_PIPELINE)
+)
+
+ASSIGN_BUFFER_ADDRESSES = lambda basic_alloc=False: Pipeline().Nested(
+    "aie.device",
+    Pipeline().add_pass("aie-assign-buffer-addresses", basic_alloc=basic_alloc),
+)
+
+ROUTE_FLOWS = Pipeline().Nested(
+    "aie.device",
+    Pipeline()
+    .add_pass("aie-create-pathfinder-flows")
+    .add_pass("aie-create-packet-flows"),
+)
+
 CREATE_PATH_FINDER_FLOWS = Pipeline().Nested(
     "aie.device", Pipeline().add_pass("aie-create-pathfinder-flows")
 )
@@ -224,20 +250,21 @@ def emit_partition(mlir_module_str, kernel_id="0x901", start_columns=None):
     }
 
 
-def generate_cores_list(mlir_module_str):
-    with Context(), Location.unknown():
-        module = Module.parse(mlir_module_str)
-        return [
-            (
-                c.tile.owner.opview.col.value,
-                c.tile.owner.opview.row.value,
-                c.elf_file.value if c.elf_file is not None else None,
-            )
-            for c in find_ops(
-                module.operation,
-                lambda o: isinstance(o.operation.opview, aiedialect.CoreOp),
-            )
-        ]
+def generate_cores_list(mlir_module):
+    if isinstance(mlir_module, str):
+        with Context(), Location.unknown():
+            return generate_cores_list(Module.parse(mlir_module))
+    return [
+        (
+            c.tile.owner.opview.col.value,
+            c.tile.owner.opview.row.value,
+            c.elf_file.value if c.elf_file is not None else None,
+        )
+        for c in find_ops(
+            mlir_module.operation,
+            lambda o: isinstance(o.operation.opview, aiedialect.CoreOp),
+        )
+    ]
 
 
 def emit_design_bif(root_path, has_cores=True, enable_cores=True):
@@ -272,25 +299,15 @@ async def extract_input_files(file_core_bcf):
     return " ".join(re.findall(r"^_include _file (.*)", core_bcf, re.MULTILINE))
 
 
-def do_run(command, verbose=False):
-    if verbose:
-        print(" ".join(command))
-    m = subprocess.PIPE
-    ret = subprocess.run(command, stdout=m, stderr=m, universal_newlines=True)
-    return ret
-
-
-def run_passes(pass_pipeline, mlir_module_str, outputfile=None, verbose=False):
-    if verbose:
-        print("Running:", pass_pipeline)
-    with Context() as ctx, Location.unknown():
-        module = Module.parse(mlir_module_str)
-        PassManager.parse(pass_pipeline).run(module.operation)
-        mlir_module_str = str(module)
-        if outputfile:
-            with open(outputfile, "w") as g:
-                g.write(mlir_module_str)
-    return mlir_module_str
+# Return a copy of `module` that passes can lower without changing it.
+def clone_module(module):
+    clone = Module.create(module.operation.location)
+    for attr in module.operation.attributes:
+        clone.operation.attributes[attr.name] = attr.attr
+    with InsertionPoint(clone.body):
+        for op in module.body.operations:
+            op.operation.clone()
+    return clone
 
 
 def corefile(dirname, core, ext):
@@ -343,6 +360,10 @@ class FlowRunner:
         self.peano_clang_path = os.path.join(opts.peano_install_dir, "bin", "clang")
         self.peano_opt_path = os.path.join(opts.peano_install_dir, "bin", "opt")
         self.peano_llc_path = os.path.join(opts.peano_install_dir, "bin", "llc")
+        self.ctx = Context()
+        self.module_with_addresses = None
+        self.module_physical = None
+        self.file_physical = self.intermediate_path("input_physical")
 
     def prepend_tmp(self, x):
         return os.path.join(self.tmpdirname, x)
@@ -378,6 +399,58 @@ class FlowRunner:
             print("Error encountered while running: " + commandstr, file=sys.stderr)
             sys.exit(ret)
 
+    # Like do_call, but runs `fn` in this process instead of spawning a tool.
+    async def do_in_process(self, task, description, fn, force=False):
+        if self.stopall:
+            return
+
+        if task:
+            self.progress_bar.update(task, advance=0, command=description[0:30])
+        start = time.time()
+        if self.opts.verbose:
+            print(description)
+        result = None
+        if self.opts.execute or force:
+            try:
+                result = fn()
+            except Exception as e:
+                if task:
+                    self.progress_bar._tasks[task].description = "[red] Error"
+                print("Error encountered while running: " + description, file=sys.stderr)
+                print(e, file=sys.stderr)
+                sys.exit(1)
+        end = time.time()
+        if self.opts.verbose:
+            print(f"Done in {end - start:.3f} sec: {description}")
+        self.runtimes[description] = end - start
+        if task:
+            self.progress_bar.update(task, advance=1, command="")
+            self.maxtasks = max(self.progress_bar._tasks[task].completed, self.maxtasks)
+            self.progress_bar._tasks[task].total = self.maxtasks
+        return result
+
+    # Intermediates are only kept for debugging and for the tools that still
+    # run as separate processes, which read bytecode as well as text.
+    def intermediate_path(self, name):
+        ext = ".mlir" if self.opts.text_intermediates else ".mlirbc"
+        return self.prepend_tmp(name + ext)
+
+    def write_intermediate(self, module, name):
+        path = self.intermediate_path(name)
+        if self.opts.text_intermediates:
+            with open(path, "w") as f:
+                f.write(str(module.operation))
+        else:
+            with open(path, "wb") as f:
+                module.operation.write_bytecode(f)
+        return path
+
+    # Run `pipeline` on `module` in place and keep the result as intermediate
+    # `name`.
+    def lower(self, pipeline, module, name):
+        PassManager.parse(str(pipeline), module.context).run(module.operation)
+        return self.write_intermediate(module, name)
+
     # In order to run xchesscc on modern ll code, we need a bunch of hacks.
     async def chesshack(self, task, llvmir, chess_intrinsic_wrapper_ll_path):
         llvmir_chesshack = llvmir + "chesshack.ll"
@@ -442,7 +515,6 @@ class FlowRunner:
         aie_target,
         aie_peano_target,
         chess_intrinsic_wrapper_ll_path,
-        file_with_addresses,
     ):
         async with self.limit:
             if self.stopall:
@@ -489,20 +561,19 @@ class FlowRunner:
 
             # fmt: off
             corecol, corerow, elf_file = core
-            if not opts.unified:
-                file_core = corefile(self.tmpdirname, core, "mlir")
-                await self.do_call(task, ["aie-opt", "--aie-localize-locks", "--aie-normalize-address-spaces", "--aie-standard-lowering=tilecol=%d tilerow=%d" % core[0:2], "--aiex-standard-lowering", file_with_addresses, "-o", file_core])
-                file_opt_core = corefile(self.tmpdirname, core, "opt.mlir")
-                await self.do_call(task, ["aie-opt", f"--pass-pipeline={LOWER_TO_LLVM_PIPELINE}", file_core, "-o", file_opt_core])
+            def write_translation(translate, path):
+                with open(path, "w") as f:
+                    f.write(translate(self.module_with_addresses.operation, corecol, corerow))
+
             if self.opts.xbridge:
                 file_core_bcf = corefile(self.tmpdirname, core, "bcf")
-                await self.do_call(task, ["aie-translate", file_with_addresses, "--aie-generate-bcf", "--tilecol=%d" % corecol, "--tilerow=%d" % corerow, "-o", file_core_bcf])
+                await self.do_in_process(task, "aie-generate-bcf %d %d" % core[0:2], lambda: write_translation(aiedialect.generate_bcf, file_core_bcf))
             else:
                 file_core_ldscript = corefile(self.tmpdirname, core, "ld.script")
-                await self.do_call(task, ["aie-translate", file_with_addresses, "--aie-generate-ldscript", "--tilecol=%d" % corecol, "--tilerow=%d" % corerow, "-o", file_core_ldscript])
+                await self.do_in_process(task, "aie-generate-ldscript %d %d" % core[0:2], lambda: write_translation(aiedialect.generate_ldscript, file_core_ldscript))
             if not self.opts.unified:
+                # Lowered for all cores at once by run_flow.
                 file_core_llvmir = corefile(self.tmpdirname, core, "ll")
-                await self.do_call(task, ["aie-translate", "--mlir-to-llvmir", file_opt_core, "-o", file_core_llvmir])
                 file_core_obj = corefile(self.tmpdirname, core, "o")
 
             file_core_elf = elf_file if elf_file else corefile(".", core, "elf")
@@ -546,21 +617,17 @@ class FlowRunner:
     async def process_cdo(self):
         from aie.dialects.aie import generate_cdo
 
-        with Context(), Location.unknown():
-            for elf in glob.glob("*.elf"):
-                try:
-                    shutil.copy(elf, self.tmpdirname)
-                except shutil.SameFileError:
-                    pass
-            for elf_map in glob.glob("*.elf.map"):
-                try:
-                    shutil.copy(elf_map, self.tmpdirname)
-                except shutil.SameFileError:
-                    pass
-            input_physical = Module.parse(
-                await read_file_async(self.prepend_tmp("input_physical.mlir"))
-            )
-            generate_cdo(input_physical.operation, self.tmpdirname)
+        for elf in glob.glob("*.elf"):
+            try:
+                shutil.copy(elf, self.tmpdirname)
+            except shutil.SameFileError:
+                pass
+        for elf_map in glob.glob("*.elf.map"):
+            try:
+                shutil.copy(elf_map, self.tmpdirname)
+            except shutil.SameFileError:
+                pass
+        generate_cdo(self.module_physical.operation, self.tmpdirname)
 
     async def process_xclbin_gen(self, has_cores):
         if opts.progress:
@@ -604,7 +671,7 @@ class FlowRunner:
         await self.do_call(task, ["xclbinutil", "--add-replace-section", "MEM_TOPOLOGY:JSON:" + self.prepend_tmp("mem_topology.json"), "--add-kernel", self.prepend_tmp("kernels.json"), "--add-replace-section", "AIE_PARTITION:JSON:" + self.prepend_tmp("aie_partition.json"), "--force", "--output", opts.xclbin_name])
         # fmt: on
 
-    async def process_host_cgen(self, aie_target, file_with_addresses):
+    async def process_host_cgen(self, aie_target):
         async with self.limit:
             if self.stopall:
                 return
@@ -617,18 +684,17 @@ class FlowRunner:
                 task = None
 
             # Generate the included host interface
-            file_physical = self.prepend_tmp("input_physical.mlir")
-            await self.do_call(
-                task,
-                [
-                    "aie-opt",
-                    "--aie-create-pathfinder-flows",
-                    "--aie-create-packet-flows",
-                    file_with_addresses,
-                    "-o",
-                    file_physical,
-                ],
-            )
+            def lower_to_physical():
+                self.module_physical = clone_module(self.module_with_addresses)
+                self.file_physical = self.lower(
+                    ROUTE_FLOWS, self.module_physical, "input_physical"
+                )
+
+            await self.do_in_process(task, str(ROUTE_FLOWS), lower_to_physical)
+
+            def write_translation(translate, path):
+                with open(path, "w") as f:
+                    f.write(translate(self.module_physical.operation))
 
             if opts.airbin:
                 file_airbin = self.prepend_tmp("air.bin")
@@ -637,35 +703,25 @@ class FlowRunner:
                     [
                         "aie-translate",
                         "--aie-generate-airbin",
-                        file_physical,
+                        self.file_physical,
                         "-o",
                         file_airbin,
                     ],
                 )
             else:
                 file_inc_cpp = self.prepend_tmp("aie_inc.cpp")
-                await self.do_call(
+                await self.do_in_process(
                     task,
-                    [
-                        "aie-translate",
-                        "--aie-generate-xaie",
-                        file_physical,
-                        "-o",
-                        file_inc_cpp,
-                    ],
+                    "aie-generate-xaie",
+                    lambda: write_translation(aiedialect.generate_xaie, file_inc_cpp),
                 )
 
             if opts.link_against_hsa:
-                file_inc_cpp = self.prepend_tmp("aie_data_movement.cpp")
-                await self.do_call(
+                file_hsa_cpp = self.prepend_tmp("aie_data_movement.cpp")
+                await self.do_in_process(
                     task,
-                    [
-                        "aie-translate",
-                        "--aie-generate-hsa",
-                        file_physical,
-                        "-o",
-                        file_inc_cpp,
-                    ],
+                    "aie-generate-hsa",
+                    lambda: write_translation(aiedialect.generate_hsa, file_hsa_cpp),
                 )
 
             cmd = ["clang++", "-std=c++17"]
@@ -815,7 +871,7 @@ class FlowRunner:
         )
         sim_makefile = os.path.join(runtime_simlib_path, "Makefile")
         sim_genwrapper = os.path.join(runtime_simlib_path, "genwrapper_for_ps.cpp")
-        file_physical = self.prepend_tmp("input_physical.mlir")
+        file_physical = self.file_physical
         memory_allocator = os.path.join(
             runtime_testlib_path, "libmemory_allocator_sim_aie.a"
         )
@@ -982,51 +1038,32 @@ class FlowRunner:
                 "[green] MLIR compilation:", total=1, command="1 Worker"
             )
 
-            file_with_switchboxes = self.prepend_tmp("input_with_switchboxes.mlir")
-            pass_pipeline = INPUT_WITH_SWITCHBOXES_PIPELINE.materialize(module=True)
-            run_passes(
-                pass_pipeline,
-                self.mlir_module_str,
-                file_with_switchboxes,
-                self.opts.verbose,
-            )
+            # The design is parsed once and stays in memory: passes and
+            # translations run in-process on it, or on copies of it.
+            module = Module.parse(self.mlir_module_str, self.ctx)
 
-            file_with_addresses = self.prepend_tmp("input_with_addresses.mlir")
-            if opts.basic_alloc_scheme:
-                r = do_run(
-                    [
-                        "aie-opt",
-                        "--aie-assign-buffer-addresses=basic-alloc",
-                        file_with_switchboxes,
-                        "-o",
-                        file_with_addresses,
-                    ],
-                )
-            else:
-                r = do_run(
-                    [
-                        "aie-opt",
-                        "--aie-assign-buffer-addresses",
-                        file_with_switchboxes,
-                        "-o",
-                        file_with_addresses,
-                    ],
-                )
-            if r.returncode != 0:
-                print("Error encountered while assigning buffer addresses. Exiting...")
-                print(r.stderr, file=sys.stderr)
-                sys.exit(r.returncode)
+            await self.do_in_process(
+                progress_bar.task,
+                str(INPUT_WITH_SWITCHBOXES_PIPELINE),
+                lambda: self.lower(
+                    INPUT_WITH_SWITCHBOXES_PIPELINE, module, "input_with_switchboxes"
+                ),
+                force=True,
+            )
 
-            cores = generate_cores_list(await read_file_async(file_with_addresses))
-            t = do_run(
-                [
-                    "aie-translate",
-                    "--aie-generate-target-arch",
-                    file_with_addresses,
-                ],
-                self.opts.verbose,
+            assign_buffer_addresses = ASSIGN_BUFFER_ADDRESSES(opts.basic_alloc_scheme)
+            await self.do_in_process(
+                progress_bar.task,
+                str(assign_buffer_addresses),
+                lambda: self.lower(
+                    assign_buffer_addresses, module, "input_with_addresses"
+                ),
+                force=True,
             )
-            aie_target = t.stdout.strip()
+            self.module_with_addresses = module
+
+            cores = generate_cores_list(module)
+            aie_target = aiedialect.generate_target_arch(module.operation)
             if not re.fullmatch("AIE.?", aie_target):
                 print(
                     "Unexpected target " + aie_target + ". Exiting...",
@@ -1037,26 +1074,18 @@ class FlowRunner:
 
             # Optionally generate insts.txt for NPU instruction stream
             if opts.npu or opts.only_npu:
-                generated_insts_mlir = self.prepend_tmp("generated_npu_insts.mlir")
-                await self.do_call(
-                    progress_bar.task,
-                    [
-                        "aie-opt",
-                        "--aie-dma-to-npu",
-                        file_with_addresses,
-                        "-o",
-                        generated_insts_mlir,
-                    ],
-                )
-                await self.do_call(
+
+                def generate_npu_insts():
+                    npu_module = clone_module(module)
+                    self.lower(DMA_TO_NPU, npu_module, "generated_npu_insts")
+                    insts = aiedialect.npu_instgen(npu_module.operation)
+                    with open(opts.insts_name, "w") as f:
+                        f.write("\n".join(insts) + "\n")
+
+                await self.do_in_process(
                     progress_bar.task,
-                    [
-                        "aie-translate",
-                        "--aie-npu-instgen",
-                        generated_insts_mlir,
-                        "-o",
-                        opts.insts_name,
-                    ],
+                    str(DMA_TO_NPU) + " | aie-npu-instgen",
+                    generate_npu_insts,
                 )
                 if opts.only_npu:
                     return
@@ -1065,13 +1094,40 @@ class FlowRunner:
                 progress_bar.task, aie_target
             )
 
+            # All cores are lowered by a single pipeline, which the pass manager
+            # runs on the cores in parallel.
+            def lower_cores():
+                cores_module = clone_module(module)
+                self.lower(AIE_LOWER_CORES_TO_LLVM, cores_module, "input_opt_cores")
+                for op in cores_module.body.operations:
+                    op = op.operation
+                    if "sym_name" not in op.attributes:
+                        continue
+                    name = op.attributes["sym_name"].value
+                    if not re.fullmatch(r"core_\d+_\d+", name):
+                        continue
+                    self.write_intermediate(op, name + ".opt")
+                    with open(self.prepend_tmp(name + ".ll"), "w") as f:
+                        f.write(aiedialect.translate_mlir_to_llvmir(op))
+
+            if not opts.unified and cores:
+                await self.do_in_process(
+                    progress_bar.task,
+                    str(AIE_LOWER_CORES_TO_LLVM) + " | mlir-to-llvmir",
+                    lower_cores,
+                )
+
             # fmt: off
             if opts.unified:
-                file_opt_with_addresses = self.prepend_tmp("input_opt_with_addresses.mlir")
-                await self.do_call(progress_bar.task, ["aie-opt", f"--pass-pipeline={AIE_LOWER_TO_LLVM()}", file_with_addresses, "-o", file_opt_with_addresses])
-
                 file_llvmir = self.prepend_tmp("input.ll")
-                await self.do_call(progress_bar.task, ["aie-translate", "--mlir-to-llvmir", file_opt_with_addresses, "-o", file_llvmir])
+
+                def lower_unified():
+                    unified_module = clone_module(module)
+                    self.lower(AIE_LOWER_TO_LLVM(), unified_module, "input_opt_with_addresses")
+                    with open(file_llvmir, "w") as f:
+                        f.write(aiedialect.translate_mlir_to_llvmir(unified_module.operation))
+
+                await self.do_in_process(progress_bar.task, str(AIE_LOWER_TO_LLVM()) + " | mlir-to-llvmir", lower_unified)
 
                 self.unified_file_core_obj = self.prepend_tmp("input.o")
                 if opts.compile and opts.xchesscc:
@@ -1090,7 +1146,7 @@ class FlowRunner:
                 command="%d Workers" % nworkers,
             )
 
-            processes = [self.process_host_cgen(aie_target, file_with_addresses)]
+            processes = [self.process_host_cgen(aie_target)]
             await asyncio.gather(
                 *processes
             )  # ensure that process_host_cgen finishes before running gen_sim
@@ -1104,7 +1160,6 @@ class FlowRunner:
                         aie_target,
                         aie_peano_target,
                         chess_intrinsic_wrapper_ll_path,
-                        file_with_addresses,
                     )
                 )
             await asyncio.gather(*processes)
@@ -20,6 +20,9 @@ from .._mlir_libs._aie import (
     aie_llvm_link,
     generate_bcf,
     generate_cdo,
+    generate_hsa,
+    generate_ldscript,
+    generate_target_arch,
     generate_xaie,
     npu_instgen,
     register_dialect,
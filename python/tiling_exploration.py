@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+# This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+# (c) Copyright 2021 Xilinx Inc.
+# ===============================================================================#
+# This file explores the tilings of a GEMM loop nest with the tiling
+# design-space exploration engine (aie.utils.tiling).
+# ===============================================================================#
+
+import argparse
+import time
+
+from aie.utils.tiling import Tensor, explore_tilings
+
+# -------------------------------------------------------------------------------#
+# Algorithmic parameters
+# -------------------------------------------------------------------------------#
+
+# The loop bounds of C[i][j] += A[i][k] * B[k][j]
+loop_bounds = {"i": 64, "j": 64, "k": 64}
+
+# How data tensors are related with loop induction variables
+# +--------------------+
+# |     | i  | j  | k  |
+# +--------------------+
+# | in1 | 1  | 0  | 1  |
+# +--------------------+
+# | in2 | 0  | 1  | 1  |
+# +--------------------+
+# | out | 1  | 1  | 0  |
+# +--------------------+
+tensors = [
+    Tensor("in1", ["i", "k"]),
+    Tensor("in2", ["k", "j"]),
+    Tensor("out", ["i", "j"], output=True),
+]
+
+# -------------------------------------------------------------------------------#
+# Architectural parameters
+# -------------------------------------------------------------------------------#
+
+# In AIE, we typically have three architectural (memory/compute) hierarchy levels.
+# L3->L2 copies data from L3 memory to L2 shared cache. L2->L1 copies data from
+# L2 cache to L1 private cache. L2->L1 also indicates the transition from
+# temporal to spatial execution. L1 indicates the transition from spatial
+# to temporal task on each compute core.
+
+# frequency
+freq = 600 * 10**6
+
+# compute cores of which L2 is in charge: columns x cores per column
+spatial_dim = [8, 8]
+
+# memory capacity for L2 (per column) and L1 (per core), and memory bandwidth
+# for L3-L2 and L2-L1 (over all columns, in bytes per second)
+limits = {
+    "l2_bytes": 2**16,
+    "l1_bytes": 2**11,
+    "num_columns": spatial_dim[0],
+    "cores_per_column": spatial_dim[1],
+    "dma_dims": 4,
+    "l3_bytes_per_cycle": 2**30 / freq / spatial_dim[0],
+    "l2_bytes_per_cycle": 2 * 2**30 / freq / spatial_dim[0],
+    "macs_per_cycle": 1,
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Explore the tilings of a GEMM loop nest."
+    )
+    parser.add_argument(
+        "--device",
+        help="take the limits of this device (e.g. npu) instead of the "
+        "architectural parameters above",
+    )
+    args = parser.parse_args()
+
+    begin_time = time.time()
+    if args.device:
+        tilings = explore_tilings(loop_bounds, tensors, device=args.device)
+    else:
+        tilings = explore_tilings(loop_bounds, tensors, **limits)
+    runtime = time.time() - begin_time
+
+    print("---runtime--- ", runtime)
+    for t in tilings:
+        print("---tiling---")
+        print("L1 tile:", t["l1_tile"])
+        print("spatial:", t["spatial"])
+        print("L2 tile:", t["l2_tile"])
+        print("loop order:", t["order"])
+        print("cores:", t["cores"], "columns:", t["columns"])
+        print("L1 bytes:", t["l1_bytes"], "L2 bytes:", t["l2_bytes"])
+        print("L3_L2_traffic:", t["l3_traffic"], "L2_L1_traffic:", t["l2_traffic"])
+        print("compute cycles:", t["compute_cycles"])
+        print("communication cycles:", t["communication_cycles"])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,65 @@
+# tiling.py -*- Python -*-
+#
+# This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+# (c) Copyright 2024 Advanced Micro Devices, Inc.
+
+import json
+from dataclasses import dataclass, field
+
+from .._mlir_libs._aie import explore_tilings as _explore_tilings
+
+
+@dataclass
+class Tensor:
+    """A tensor of a loop nest, indexed by the named loops, outermost first.
+
+    Loops that do not index an output are reductions and are not spread over
+    cores.
+    """
+
+    name: str
+    loops: list = field(default_factory=list)
+    element_bytes: int = 4
+    output: bool = False
+
+
+def explore_tilings(loops, tensors, device=None, **limits):
+    """Return the Pareto-optimal tilings of a perfect loop nest.
+
+    `loops` maps the loop names to their bounds, `tensors` is a list of
+    `Tensor`. `device` (e.g. "npu") selects the memories, cores and DMAs of a
+    target; the keyword arguments override them (l1_bytes, l2_bytes,
+    num_columns, cores_per_column, dma_dims, l3_bytes_per_cycle,
+    l2_bytes_per_cycle, macs_per_cycle, buffer_count).
+
+    Each tiling is a dict whose "l1_tile", "spatial" and "l2_tile" map the
+    loop names to the tile computed by a core, the number of cores the loop
+    is spread over and the tile staged in the mem tiles; "order" lists the
+    loops outermost first. The tilings are sorted by estimated cycles.
+    """
+    names = list(loops)
+    problem = {
+        "loops": [{"name": n, "bound": b} for n, b in loops.items()],
+        "tensors": [
+            {
+                "name": t.name,
+                "loops": list(t.loops),
+                "element_bytes": t.element_bytes,
+                "output": t.output,
+            }
+            for t in tensors
+        ],
+        "limits": limits,
+    }
+    if device is not None:
+        problem["device"] = str(device).split(".")[-1]
+
+    solutions = json.loads(_explore_tilings(json.dumps(problem)))
+    for s in solutions:
+        for key in ("l1_tile", "spatial", "l2_tile"):
+            s[key] = dict(zip(names, s[key]))
+        s["order"] = [names[i] for i in s["order"]]
+    return solutions
@@ -12,34 +12,40 @@
 #include "memory_allocator.h"
 #include "xioutils.h"
 #include <assert.h>
-#include <iostream>
+
+// Buffers live in host memory; device addresses index the SystemC DDR model
+// and are handed out a backing chunk at a time by the host pool backend.
+static aie_mem_pool_t &getMemPool(aie_libxaie_ctx_t *_xaie) {
+  if (!_xaie->memPool)
+    _xaie->memPool.reset(new aie_mem_pool_t(
+        std::unique_ptr<aie_mem_pool_backend_t>(
+            new aie_host_mem_pool_backend_t())));
+  return *_xaie->memPool;
+}
 
 int *mlir_aie_mem_alloc(aie_libxaie_ctx_t *_xaie, ext_mem_model_t &handle,
                         int size) {
-  int size_bytes = size * sizeof(int);
-  handle.virtualAddr = std::malloc(size_bytes);
-  if (handle.virtualAddr) {
-    handle.size = size_bytes;
-    // assign physical space in SystemC DDR memory controller
-    handle.physicalAddr = nextAlignedAddr;
-    // adjust nextAlignedAddr to the next 128-bit aligned address
-    nextAlignedAddr = nextAlignedAddr + size_bytes;
-    uint64_t gapToAligned = nextAlignedAddr % 16; // 16byte (128bit)
-    if (gapToAligned > 0)
-      nextAlignedAddr += (16 - gapToAligned);
-  } else {
-    printf("ExtMemModel: Failed to allocate %d memory.\n", size_bytes);
+  size_t size_bytes = size * sizeof(int);
+  aie_mem_block_t block;
+  if (!getMemPool(_xaie).allocate(size_bytes, block)) {
+    printf("ExtMemModel: Failed to allocate %zu memory.\n", size_bytes);
+    handle.virtualAddr = NULL;
+    return NULL;
   }
 
-  _xaie->allocations.push_back(handle);
-
-  std::cout << "ExtMemModel constructor: " << _xaie << " virtual address "
-            << std::hex << handle.virtualAddr << ", physical address "
-            << handle.physicalAddr << ", size " << std::dec << handle.size
-            << std::endl;
+  handle.virtualAddr = block.virtualAddr;
+  handle.physicalAddr = block.physicalAddr;
+  handle.size = size_bytes;
+  handle.fd = block.chunk->fd;
   return (int *)handle.virtualAddr;
 }
 
+void mlir_aie_mem_free(aie_libxaie_ctx_t *_xaie, ext_mem_model_t &handle) {
+  if (_xaie->memPool && handle.virtualAddr)
+    _xaie->memPool->deallocate(handle.virtualAddr);
+  handle.virtualAddr = NULL;
+}
+
 void mlir_aie_sync_mem_cpu(ext_mem_model_t &handle) {
   aiesim_ReadGM(handle.physicalAddr, handle.virtualAddr, handle.size);
 }
@@ -49,17 +55,10 @@ void mlir_aie_sync_mem_dev(ext_mem_model_t &handle) {
 }
 
 u64 mlir_aie_get_device_address(aie_libxaie_ctx_t *_xaie, void *VA) {
-  std::cout << "get_device_address: " << _xaie << " VA " << std::hex << VA
-            << std::dec << "\n";
-  for (auto i : _xaie->allocations) {
-    std::cout << "get_device_address: virtual address " << std::hex
-              << i.virtualAddr << ", physical address " << i.physicalAddr
-              << ", size " << std::dec << i.size << std::endl;
-
-    if (i.virtualAddr == VA)
-      return i.physicalAddr;
-  }
+  uint64_t PA;
+  if (_xaie->memPool && _xaie->memPool->getDeviceAddress(VA, PA))
+    return PA;
   printf("ERROR: cannot get device address for allocation!\n");
   assert(false);
   return 0;
-}
\ No newline at end of file
+}
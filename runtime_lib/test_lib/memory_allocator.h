@@ -37,9 +37,11 @@ extern "C" {
 /// buffers and device addresses are modeled in a simulator-specific way. Other
 /// combinations are also possible, largely representing different tradeoffs
 /// between efficiency of host data access vs. efficiency of accelerator access.
-
-// static variable for tracking current DDR physical addr during AIESIM
-static uint16_t nextAlignedAddr;
+///
+/// The ION and AIESIM allocators carve buffers out of a few large backing
+/// allocations through the context's aie_mem_pool_t (see memory_pool.h), so
+/// individual allocations are cheap and all device memory is released by
+/// mlir_aie_deinit_libxaie.
 
 /// @brief Allocate a buffer in device memory
 /// @param bufIdx The index of the buffer to allocate.
@@ -49,6 +51,10 @@ static uint16_t nextAlignedAddr;
 int *mlir_aie_mem_alloc(aie_libxaie_ctx_t *_xaie, ext_mem_model_t &handle,
                         int size);
 
+/// @brief Free a buffer allocated by mlir_aie_mem_alloc.
+/// @param handle The handle passed to mlir_aie_mem_alloc.
+void mlir_aie_mem_free(aie_libxaie_ctx_t *_xaie, ext_mem_model_t &handle);
+
 /// @brief Synchronize the buffer from the device to the host CPU.
 /// This is expected to be called after the device writes data into
 /// device memory, so that the data can be read by the CPU.  In
@@ -36,6 +36,12 @@ int *mlir_aie_mem_alloc(aie_libxaie_ctx_t *_xaie, ext_mem_model_t &handle,
   return (int *)handle.virtualAddr;
 }
 
+void mlir_aie_mem_free(aie_libxaie_ctx_t *_xaie, ext_mem_model_t &handle) {
+  if (handle.virtualAddr)
+    hsa_amd_memory_pool_free(handle.virtualAddr);
+  handle.virtualAddr = NULL;
+}
+
 /*
   The device memory allocator directly maps device memory over
   PCIe MMIO. These accesses are uncached and thus don't require
@@ -34,33 +34,46 @@
 /***************************** Macro Definitions *****************************/
 #define XAIE_128BIT_ALIGN_MASK 0xFF
 
-/**
- * This is the memory function to allocate a memory
- *
- * @param	handle: Device Instance
- * @param	size: Size of the memory
- *
- * @return	Pointer to the allocated memory instance.
- *******************************************************************************/
-int *mlir_aie_mem_alloc(struct aie_libxaie_ctx_t *ctx, ext_mem_model_t &handle,
-                        int size) {
-  int RC;
-  int Fd, Ret;
-  uint32_t HeapNum;
-  void *VAddr;
-  struct ion_allocation_data AllocArgs;
+namespace {
+
+/// Pool backend that allocates physically contiguous dmabufs from ION and
+/// attaches them to the libXAIE device instance. The ION heap is looked up
+/// once and reused for every backing chunk.
+class aie_ion_mem_pool_backend_t : public aie_mem_pool_backend_t {
+public:
+  aie_ion_mem_pool_backend_t(struct aie_libxaie_ctx_t *ctx) : ctx(ctx) {}
+
+  ~aie_ion_mem_pool_backend_t() override {
+    if (IonFd >= 0)
+      close(IonFd);
+  }
+
+  bool allocate(size_t size, aie_mem_chunk_t &chunk) override;
+  void release(aie_mem_chunk_t &chunk) override;
+
+private:
+  bool openHeap();
+
+  struct aie_libxaie_ctx_t *ctx;
+  int IonFd = -1;
+  uint32_t HeapIdMask = 0;
+};
+
+} // namespace
+
+bool aie_ion_mem_pool_backend_t::openHeap() {
+  int Ret;
   struct ion_heap_query Query;
   struct ion_heap_data *Heaps;
-  u64 DevAddr = 0;
 
-  Fd = open("/dev/ion", O_RDONLY);
-  if (Fd < 0) {
+  IonFd = open("/dev/ion", O_RDONLY);
+  if (IonFd < 0) {
     XAIE_ERROR("Failed to open ion.\n");
-    return NULL;
+    return false;
   }
 
   memset(&Query, 0, sizeof(Query));
-  Ret = ioctl(Fd, ION_IOC_HEAP_QUERY, &Query);
+  Ret = ioctl(IonFd, ION_IOC_HEAP_QUERY, &Query);
   if (Ret != 0) {
     XAIE_ERROR("Failed to enquire ion heaps.\n");
     goto error_ion;
@@ -73,70 +86,147 @@ int *mlir_aie_mem_alloc(struct aie_libxaie_ctx_t *ctx, ext_mem_model_t &handle,
   }
 
   Query.heaps = (uint64_t)Heaps;
-  Ret = ioctl(Fd, ION_IOC_HEAP_QUERY, &Query);
+  Ret = ioctl(IonFd, ION_IOC_HEAP_QUERY, &Query);
   if (Ret != 0) {
     XAIE_ERROR("Failed to enquire ion heap details.\n");
     free(Heaps);
     goto error_ion;
   }
 
-  HeapNum = UINT_MAX;
   for (uint32_t i = 0; i < Query.cnt; i++) {
     XAIE_DBG("Heap id: %u, Heap name: %s, Heap type: %u\n", Heaps[i].heap_id,
              Heaps[i].name, Heaps[i].type);
     if (Heaps[i].type == ION_HEAP_TYPE_SYSTEM_CONTIG) {
-      HeapNum = i;
+      HeapIdMask = 1 << Heaps[i].heap_id;
       break;
     }
   }
+  free(Heaps);
 
-  if (HeapNum == UINT_MAX) {
+  if (HeapIdMask == 0) {
     XAIE_ERROR("Failed to find contiguous heap\n");
-    free(Heaps);
     goto error_ion;
   }
+  return true;
+
+error_ion:
+  close(IonFd);
+  IonFd = -1;
+  return false;
+}
+
+/**
+ * This is the memory function to allocate a backing chunk for the pool
+ *
+ * @param	size: Size of the memory
+ * @param	chunk: Filled in with the mapping of the allocation
+ *
+ * @return	true on success.
+ *******************************************************************************/
+bool aie_ion_mem_pool_backend_t::allocate(size_t size, aie_mem_chunk_t &chunk) {
+  int Ret;
+  void *VAddr;
+  struct ion_allocation_data AllocArgs;
+  XAie_MemInst *MemInst;
+  u64 DevAddr = 0;
+
+  if (IonFd < 0 && !openHeap())
+    return false;
 
   memset(&AllocArgs, 0, sizeof(AllocArgs));
   AllocArgs.len = size;
-  AllocArgs.heap_id_mask = 1 << Heaps[HeapNum].heap_id;
-  free(Heaps);
+  AllocArgs.heap_id_mask = HeapIdMask;
   // if(Cache == XAIE_MEM_CACHEABLE) {
   // 	AllocArgs.flags = ION_FLAG_CACHED;
   // }
 
-  Ret = ioctl(Fd, ION_IOC_ALLOC, &AllocArgs);
+  Ret = ioctl(IonFd, ION_IOC_ALLOC, &AllocArgs);
   if (Ret != 0) {
-    XAIE_ERROR("Failed to allocate memory of %lu bytes\n");
-    goto error_ion;
+    XAIE_ERROR("Failed to allocate memory of %lu bytes\n", size);
+    return false;
   }
 
   VAddr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, AllocArgs.fd, 0);
-  if (VAddr == NULL) {
+  if (VAddr == MAP_FAILED) {
     XAIE_ERROR("Failed to mmap\n");
     goto error_alloc_fd;
   }
 
-  handle.fd = AllocArgs.fd;
-  handle.virtualAddr = VAddr;
-  handle.size = size;
+  MemInst = (XAie_MemInst *)calloc(1, sizeof(*MemInst));
+  if (MemInst == NULL) {
+    XAIE_ERROR("Failed to allocate memory instance\n");
+    goto error_mmap;
+  }
 
   // Map the memory
-  if (XAie_MemAttach(&(ctx->DevInst), &(handle.MemInst), DevAddr, (u64)VAddr,
-                     size, XAIE_MEM_NONCACHEABLE, handle.fd) != XAIE_OK) {
+  if (XAie_MemAttach(&(ctx->DevInst), MemInst, DevAddr, (u64)VAddr, size,
+                     XAIE_MEM_NONCACHEABLE, AllocArgs.fd) != XAIE_OK) {
     XAIE_ERROR("dmabuf map failed\n");
     goto error_map;
   }
 
-  close(Fd);
-  return (int *)VAddr;
+  chunk.virtualAddr = VAddr;
+  chunk.physicalAddr = (u64)VAddr; // LibXAIE converts this for us.
+  chunk.size = size;
+  chunk.fd = AllocArgs.fd;
+  chunk.backendHandle = MemInst;
+  return true;
 
 error_map:
+  free(MemInst);
+error_mmap:
   munmap(VAddr, size);
 error_alloc_fd:
-  close(handle.fd);
-error_ion:
-  close(Fd);
-  return NULL;
+  close(AllocArgs.fd);
+  return false;
+}
+
+void aie_ion_mem_pool_backend_t::release(aie_mem_chunk_t &chunk) {
+  XAie_MemInst *MemInst = (XAie_MemInst *)chunk.backendHandle;
+  if (XAie_MemDetach(MemInst) != XAIE_OK)
+    XAIE_ERROR("Failed to detach dmabuf\n");
+  free(MemInst);
+  munmap(chunk.virtualAddr, chunk.size);
+  close(chunk.fd);
+  chunk.virtualAddr = NULL;
+}
+
+/**
+ * This is the memory function to allocate a memory
+ *
+ * @param	handle: Device Instance
+ * @param	size: Size of the memory in 32-bit words
+ *
+ * @return	Pointer to the allocated memory instance.
+ *******************************************************************************/
+int *mlir_aie_mem_alloc(struct aie_libxaie_ctx_t *ctx, ext_mem_model_t &handle,
+                        int size) {
+  size_t size_bytes = size * sizeof(int);
+  aie_mem_block_t block;
+
+  if (!ctx->memPool)
+    ctx->memPool.reset(
+        new aie_mem_pool_t(std::unique_ptr<aie_mem_pool_backend_t>(
+            new aie_ion_mem_pool_backend_t(ctx))));
+
+  if (!ctx->memPool->allocate(size_bytes, block)) {
+    handle.virtualAddr = NULL;
+    return NULL;
+  }
+
+  handle.fd = block.chunk->fd;
+  handle.virtualAddr = block.virtualAddr;
+  handle.physicalAddr = block.physicalAddr;
+  handle.size = size_bytes;
+  handle.MemInst = *(XAie_MemInst *)block.chunk->backendHandle;
+  return (int *)block.virtualAddr;
+}
+
+void mlir_aie_mem_free(struct aie_libxaie_ctx_t *ctx,
+                       ext_mem_model_t &handle) {
+  if (ctx->memPool && handle.virtualAddr)
+    ctx->memPool->deallocate(handle.virtualAddr);
+  handle.virtualAddr = NULL;
 }
 
 /*****************************************************************************/
@@ -0,0 +1,303 @@
+//===- memory_pool.h --------------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef AIE_MEMORY_POOL_H
+#define AIE_MEMORY_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/// A large backing allocation obtained from a memory pool backend.
+struct aie_mem_chunk_t {
+  void *virtualAddr = nullptr;
+  uint64_t physicalAddr = 0;
+  size_t size = 0;
+  int fd = -1;
+  /// Backend specific state (e.g. the libXAIE memory instance).
+  void *backendHandle = nullptr;
+};
+
+/// Provides the backing allocations for an aie_mem_pool_t. Implementations
+/// exist for ION (memory_allocator_ion.cpp), the AIE simulator
+/// (memory_allocator.cpp) and plain host memory (below).
+class aie_mem_pool_backend_t {
+public:
+  virtual ~aie_mem_pool_backend_t() = default;
+  /// Allocate `size` bytes and fill in `chunk`. Returns false on failure.
+  virtual bool allocate(size_t size, aie_mem_chunk_t &chunk) = 0;
+  virtual void release(aie_mem_chunk_t &chunk) = 0;
+};
+
+/// Backend that allocates page aligned host memory and assigns device
+/// addresses from a monotonically increasing counter, much like the DDR model
+/// of the simulator. Useful for testing the pool without a device. A non-zero
+/// `capacity` bounds the bytes outstanding at any time, to model a device
+/// running out of memory.
+class aie_host_mem_pool_backend_t : public aie_mem_pool_backend_t {
+public:
+  explicit aie_host_mem_pool_backend_t(uint64_t deviceBaseAddr = 0,
+                                       size_t capacity = 0)
+      : nextDeviceAddr(deviceBaseAddr), capacity(capacity) {}
+
+  bool allocate(size_t size, aie_mem_chunk_t &chunk) override {
+    size = alignTo(size, pageSize);
+    if (capacity && bytesAllocated + size > capacity)
+      return false;
+    void *va = aligned_alloc(pageSize, size);
+    if (!va)
+      return false;
+    chunk.virtualAddr = va;
+    chunk.physicalAddr = nextDeviceAddr;
+    chunk.size = size;
+    nextDeviceAddr += size;
+    bytesAllocated += size;
+    return true;
+  }
+
+  void release(aie_mem_chunk_t &chunk) override {
+    free(chunk.virtualAddr);
+    chunk.virtualAddr = nullptr;
+    bytesAllocated -= chunk.size;
+  }
+
+  size_t getBytesAllocated() const { return bytesAllocated; }
+
+  static size_t alignTo(size_t size, size_t align) {
+    return (size + align - 1) / align * align;
+  }
+
+private:
+  static constexpr size_t pageSize = 4096;
+  uint64_t nextDeviceAddr;
+  size_t capacity;
+  size_t bytesAllocated = 0;
+};
+
+/// A block handed out by aie_mem_pool_t.
+struct aie_mem_block_t {
+  void *virtualAddr = nullptr;
+  uint64_t physicalAddr = 0;
+  size_t size = 0;
+  /// The backing allocation the block was carved from.
+  const aie_mem_chunk_t *chunk = nullptr;
+};
+
+/// Pooled device memory allocator.
+///
+/// Requests are rounded up to power-of-two size classes (starting at
+/// `minBlockSize`, which keeps every block 128-bit aligned) and served from
+/// per-class free lists. Blocks are managed buddy-style within a few large
+/// backing chunks: an empty free list is refilled by splitting the smallest
+/// larger free block in halves, and a freed block is merged with its buddy
+/// whenever that is free too, so freed neighbours become available to larger
+/// requests again. Requests larger than a quarter of the chunk size get a
+/// dedicated chunk that is returned to the backend as soon as it is freed.
+/// Host to device address translation uses an interval map over the chunks
+/// and is O(log n) in the number of chunks. All chunks are released when the
+/// pool is destroyed.
+class aie_mem_pool_t {
+public:
+  static constexpr size_t minBlockSize = 64;
+  static constexpr size_t defaultChunkSize = 16 * 1024 * 1024;
+
+  explicit aie_mem_pool_t(std::unique_ptr<aie_mem_pool_backend_t> backend,
+                          size_t chunkSize = defaultChunkSize)
+      : backend(std::move(backend)), chunkSize(chunkSize) {
+    for (size_t s = minBlockSize; s <= chunkSize / 4; s *= 2)
+      freeLists.emplace_back();
+  }
+  aie_mem_pool_t(const aie_mem_pool_t &) = delete;
+  aie_mem_pool_t &operator=(const aie_mem_pool_t &) = delete;
+  ~aie_mem_pool_t() { release(); }
+
+  /// Allocate at least `size` bytes. Returns false if the backend is out of
+  /// memory.
+  bool allocate(size_t size, aie_mem_block_t &block) {
+    if (size == 0)
+      size = 1;
+    int sizeClass = getSizeClass(size);
+    if (sizeClass < 0)
+      return allocateDedicated(size, block);
+
+    std::set<uintptr_t> &freeList = freeLists[sizeClass];
+    if (freeList.empty() && !refill(sizeClass))
+      return false;
+    uintptr_t va = *freeList.begin();
+    freeList.erase(freeList.begin());
+    liveBlocks[va] = sizeClass;
+    bytesInUse += getClassSize(sizeClass);
+    return lookup(reinterpret_cast<void *>(va), getClassSize(sizeClass),
+                  block);
+  }
+
+  /// Return a block to the pool. `virtualAddr` must have been returned by
+  /// allocate(). Returns false if it was not.
+  bool deallocate(void *virtualAddr) {
+    auto it = liveBlocks.find(reinterpret_cast<uintptr_t>(virtualAddr));
+    if (it == liveBlocks.end())
+      return false;
+    int sizeClass = it->second;
+    liveBlocks.erase(it);
+    if (sizeClass >= 0) {
+      bytesInUse -= getClassSize(sizeClass);
+      insertFree(reinterpret_cast<uintptr_t>(virtualAddr), sizeClass);
+      return true;
+    }
+
+    // Dedicated chunks go straight back to the backend.
+    auto chunkIt = chunks.find(reinterpret_cast<uintptr_t>(virtualAddr));
+    bytesInUse -= chunkIt->second.size;
+    backend->release(chunkIt->second);
+    chunks.erase(chunkIt);
+    return true;
+  }
+
+  /// Find the block containing `virtualAddr` (which may point into the
+  /// middle of an allocation) and return its device address.
+  bool getDeviceAddress(const void *virtualAddr, uint64_t &physicalAddr) const {
+    const aie_mem_chunk_t *chunk = findChunk(virtualAddr);
+    if (!chunk)
+      return false;
+    physicalAddr = chunk->physicalAddr +
+                   (reinterpret_cast<uintptr_t>(virtualAddr) -
+                    reinterpret_cast<uintptr_t>(chunk->virtualAddr));
+    return true;
+  }
+
+  /// Return the backing chunk containing `virtualAddr`, or nullptr.
+  const aie_mem_chunk_t *findChunk(const void *virtualAddr) const {
+    uintptr_t va = reinterpret_cast<uintptr_t>(virtualAddr);
+    auto it = chunks.upper_bound(va);
+    if (it == chunks.begin())
+      return nullptr;
+    --it;
+    if (va >= it->first + it->second.size)
+      return nullptr;
+    return &it->second;
+  }
+
+  /// Release every chunk back to the backend. Outstanding blocks become
+  /// invalid.
+  void release() {
+    for (auto &chunk : chunks)
+      backend->release(chunk.second);
+    chunks.clear();
+    liveBlocks.clear();
+    for (auto &freeList : freeLists)
+      freeList.clear();
+    bytesInUse = 0;
+  }
+
+  size_t getNumChunks() const { return chunks.size(); }
+  size_t getBytesInUse() const { return bytesInUse; }
+
+private:
+  size_t getClassSize(int sizeClass) const {
+    return minBlockSize << sizeClass;
+  }
+
+  // Smallest size class that fits `size`, or -1 if it needs its own chunk.
+  int getSizeClass(size_t size) const {
+    if (freeLists.empty())
+      return -1;
+    int sizeClass = 0;
+    while (getClassSize(sizeClass) < size) {
+      if (++sizeClass >= static_cast<int>(freeLists.size()))
+        return -1;
+    }
+    return sizeClass;
+  }
+
+  bool lookup(void *virtualAddr, size_t size, aie_mem_block_t &block) const {
+    block.chunk = findChunk(virtualAddr);
+    if (!block.chunk)
+      return false;
+    block.virtualAddr = virtualAddr;
+    block.size = size;
+    getDeviceAddress(virtualAddr, block.physicalAddr);
+    return true;
+  }
+
+  bool allocateDedicated(size_t size, aie_mem_block_t &block) {
+    aie_mem_chunk_t chunk;
+    if (!backend->allocate(size, chunk))
+      return false;
+    uintptr_t va = reinterpret_cast<uintptr_t>(chunk.virtualAddr);
+    chunks[va] = chunk;
+    liveBlocks[va] = -1;
+    bytesInUse += chunk.size;
+    return lookup(chunk.virtualAddr, chunk.size, block);
+  }
+
+  // Put at least one block of `sizeClass` on its free list by splitting the
+  // smallest larger free block, taking a fresh chunk if there is none.
+  bool refill(int sizeClass) {
+    int topClass = static_cast<int>(freeLists.size()) - 1;
+    int from = sizeClass;
+    while (from <= topClass && freeLists[from].empty())
+      from++;
+    if (from > topClass) {
+      aie_mem_chunk_t chunk;
+      if (!backend->allocate(chunkSize, chunk))
+        return false;
+      uintptr_t va = reinterpret_cast<uintptr_t>(chunk.virtualAddr);
+      chunks[va] = chunk;
+      size_t topSize = getClassSize(topClass);
+      for (size_t offset = 0; offset + topSize <= chunk.size;
+           offset += topSize)
+        freeLists[topClass].insert(va + offset);
+      from = topClass;
+    }
+    for (; from > sizeClass; from--) {
+      uintptr_t va = *freeLists[from].begin();
+      freeLists[from].erase(freeLists[from].begin());
+      freeLists[from - 1].insert(va);
+      freeLists[from - 1].insert(va + getClassSize(from - 1));
+    }
+    return true;
+  }
+
+  // Return a block to the free lists, merging it with its buddy (the other
+  // half of the block it was split from) for as long as that is free.
+  void insertFree(uintptr_t va, int sizeClass) {
+    const aie_mem_chunk_t *chunk = findChunk(reinterpret_cast<void *>(va));
+    uintptr_t base = reinterpret_cast<uintptr_t>(chunk->virtualAddr);
+    int topClass = static_cast<int>(freeLists.size()) - 1;
+    for (; sizeClass < topClass; sizeClass++) {
+      uintptr_t buddy = base + ((va - base) ^ getClassSize(sizeClass));
+      auto it = freeLists[sizeClass].find(buddy);
+      if (it == freeLists[sizeClass].end())
+        break;
+      freeLists[sizeClass].erase(it);
+      va = va < buddy ? va : buddy;
+    }
+    freeLists[sizeClass].insert(va);
+  }
+
+  std::unique_ptr<aie_mem_pool_backend_t> backend;
+  size_t chunkSize;
+  // Backing chunks keyed by their host virtual address.
+  std::map<uintptr_t, aie_mem_chunk_t> chunks;
+  // Free blocks per size class, ordered by address so allocations pack
+  // towards the start of the chunks.
+  std::vector<std::set<uintptr_t>> freeLists;
+  // Size class of every outstanding block, -1 for dedicated chunks.
+  std::unordered_map<uintptr_t, int> liveBlocks;
+  size_t bytesInUse = 0;
+};
+
+#endif
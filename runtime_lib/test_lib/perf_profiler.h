@@ -0,0 +1,363 @@
+//===- perf_profiler.h ------------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef AIE_PERF_PROFILER_H
+#define AIE_PERF_PROFILER_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/// The module of a tile a performance counter belongs to. Shim tiles expose
+/// their counters through the PL module.
+enum aie_perf_module_t { AIE_PERF_MEM = 0, AIE_PERF_CORE = 1, AIE_PERF_PL = 2 };
+
+/// Identifies one hardware performance counter.
+struct aie_perf_counter_id_t {
+  int col;
+  int row;
+  aie_perf_module_t module;
+  int counter;
+
+  bool operator<(const aie_perf_counter_id_t &other) const {
+    return std::tie(col, row, module, counter) <
+           std::tie(other.col, other.row, other.module, other.counter);
+  }
+};
+
+/// The number of events a 32-bit counter counted between reading `start` and
+/// reading `end`. Unsigned subtraction is correct across one wrap of the
+/// counter.
+inline uint32_t aie_perf_counter_delta(uint32_t start, uint32_t end) {
+  return end - start;
+}
+
+/// Write `s` as a JSON string literal, quotes included.
+inline void aie_perf_write_json_string(FILE *f, const std::string &s) {
+  fputc('"', f);
+  for (unsigned char c : s) {
+    switch (c) {
+    case '"':
+      fputs("\\\"", f);
+      break;
+    case '\\':
+      fputs("\\\\", f);
+      break;
+    case '\n':
+      fputs("\\n", f);
+      break;
+    case '\t':
+      fputs("\\t", f);
+      break;
+    default:
+      if (c < 0x20)
+        fprintf(f, "\\u%04x", c);
+      else
+        fputc(c, f);
+    }
+  }
+  fputc('"', f);
+}
+
+/// Write `s` as a CSV field, quoting it if it contains a separator, a quote
+/// or a line break.
+inline void aie_perf_write_csv_field(FILE *f, const std::string &s) {
+  if (s.find_first_of(",\"\r\n") == std::string::npos) {
+    fputs(s.c_str(), f);
+    return;
+  }
+  fputc('"', f);
+  for (char c : s) {
+    if (c == '"')
+      fputc('"', f);
+    fputc(c, f);
+  }
+  fputc('"', f);
+}
+
+/// Access to the performance counters of a device. The test library provides
+/// a libXAIE implementation (mlir_aie_get_perf_backend);
+/// aie_emulated_perf_backend_t below models the counters in host memory.
+class aie_perf_backend_t {
+public:
+  virtual ~aie_perf_backend_t() = default;
+  /// Number of counters of `module` in the tile at (col, row).
+  virtual int getNumCounters(int col, int row, aie_perf_module_t module) = 0;
+  /// Count the cycles between `startEvent` and `stopEvent`. Event numbers are
+  /// XAie_Events values.
+  virtual bool configure(const aie_perf_counter_id_t &id, uint32_t startEvent,
+                         uint32_t stopEvent) = 0;
+  virtual uint32_t read(const aie_perf_counter_id_t &id) = 0;
+};
+
+/// Counters held in host memory. Counters advance only when told to, and wrap
+/// at 32 bits like the hardware ones, so profiling harnesses can be tested
+/// without a device.
+class aie_emulated_perf_backend_t : public aie_perf_backend_t {
+public:
+  explicit aie_emulated_perf_backend_t(int numCoreCounters = 4,
+                                       int numMemCounters = 2,
+                                       int numPLCounters = 2)
+      : numCounters{numMemCounters, numCoreCounters, numPLCounters} {}
+
+  int getNumCounters(int, int, aie_perf_module_t module) override {
+    return numCounters[module];
+  }
+
+  bool configure(const aie_perf_counter_id_t &id, uint32_t startEvent,
+                 uint32_t stopEvent) override {
+    if (id.counter < 0 || id.counter >= numCounters[id.module])
+      return false;
+    counter_t &c = counters[id];
+    c.startEvent = startEvent;
+    c.stopEvent = stopEvent;
+    c.configured = true;
+    return true;
+  }
+
+  uint32_t read(const aie_perf_counter_id_t &id) override {
+    auto it = counters.find(id);
+    return it == counters.end() ? 0 : it->second.value;
+  }
+
+  /// Advance a configured counter by `delta`, wrapping at 32 bits.
+  void advance(const aie_perf_counter_id_t &id, uint64_t delta) {
+    auto it = counters.find(id);
+    if (it != counters.end() && it->second.configured)
+      it->second.value = static_cast<uint32_t>(it->second.value + delta);
+  }
+  void set(const aie_perf_counter_id_t &id, uint32_t value) {
+    counters[id].value = value;
+  }
+  bool isConfigured(const aie_perf_counter_id_t &id) const {
+    auto it = counters.find(id);
+    return it != counters.end() && it->second.configured;
+  }
+
+private:
+  struct counter_t {
+    uint32_t value = 0;
+    uint32_t startEvent = 0;
+    uint32_t stopEvent = 0;
+    bool configured = false;
+  };
+
+  int numCounters[3];
+  std::map<aie_perf_counter_id_t, counter_t> counters;
+};
+
+/// Summary of the samples of one counter.
+struct aie_perf_stats_t {
+  size_t n = 0;
+  uint64_t min = 0;
+  uint64_t max = 0;
+  double mean = 0;
+  double stddev = 0;
+  double p50 = 0;
+  double p90 = 0;
+  double p99 = 0;
+
+  /// The `p`th percentile (0 <= p <= 100) of the ascending `sorted`,
+  /// interpolating linearly between the closest ranks.
+  static double percentile(const std::vector<uint64_t> &sorted, double p) {
+    if (sorted.empty())
+      return 0;
+    double rank = p / 100.0 * (sorted.size() - 1);
+    size_t lo = static_cast<size_t>(floor(rank));
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (rank - lo) * (double(sorted[hi]) - double(sorted[lo]));
+  }
+
+  static aie_perf_stats_t compute(const std::vector<uint64_t> &samples) {
+    aie_perf_stats_t stats;
+    stats.n = samples.size();
+    if (samples.empty())
+      return stats;
+    std::vector<uint64_t> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    stats.min = sorted.front();
+    stats.max = sorted.back();
+    double total = 0;
+    for (uint64_t s : sorted)
+      total += s;
+    stats.mean = total / stats.n;
+    double variance = 0;
+    for (uint64_t s : sorted)
+      variance += (s - stats.mean) * (s - stats.mean);
+    stats.stddev = sqrt(variance / stats.n);
+    stats.p50 = percentile(sorted, 50);
+    stats.p90 = percentile(sorted, 90);
+    stats.p99 = percentile(sorted, 99);
+    return stats;
+  }
+};
+
+/// Samples a set of performance counters over repeated runs.
+///
+/// Counters are added per tile and module; addTile() configures as many of
+/// the module's counters as there are event pairs. Each run is bracketed by
+/// begin() and end(). Counter deltas are taken modulo 2^32, so a counter that
+/// wraps once during a run is still measured correctly. Runs longer than 2^32
+/// cycles must call poll() at least once every 2^32 cycles; each poll folds
+/// the elapsed count into a 64-bit accumulator.
+class aie_perf_profiler_t {
+public:
+  struct event_pair_t {
+    uint32_t startEvent;
+    uint32_t stopEvent;
+    std::string name;
+  };
+
+  explicit aie_perf_profiler_t(aie_perf_backend_t &backend)
+      : backend(backend) {}
+
+  /// Configure the counters of `module` at (col, row), one per event pair, up
+  /// to the number of counters the module has. Returns the number of
+  /// counters configured.
+  int addTile(int col, int row, aie_perf_module_t module,
+              const std::vector<event_pair_t> &events) {
+    int n = std::min<int>(events.size(),
+                          backend.getNumCounters(col, row, module));
+    int configured = 0;
+    for (int i = 0; i < n; i++) {
+      aie_perf_counter_id_t id{col, row, module, i};
+      if (!backend.configure(id, events[i].startEvent, events[i].stopEvent))
+        continue;
+      counter_t counter;
+      counter.id = id;
+      counter.name = events[i].name;
+      counters.push_back(counter);
+      configured++;
+    }
+    return configured;
+  }
+
+  void begin() {
+    for (counter_t &c : counters) {
+      c.last = backend.read(c.id);
+      c.accumulated = 0;
+    }
+  }
+
+  void poll() {
+    for (counter_t &c : counters) {
+      uint32_t value = backend.read(c.id);
+      c.accumulated += aie_perf_counter_delta(c.last, value);
+      c.last = value;
+    }
+  }
+
+  void end() {
+    poll();
+    for (counter_t &c : counters)
+      c.samples.push_back(c.accumulated);
+  }
+
+  /// Run `body` `n` times, sampling every counter around each run.
+  template <typename F> void profile(int n, F body) {
+    for (int i = 0; i < n; i++) {
+      begin();
+      body();
+      end();
+    }
+  }
+
+  size_t getNumCounters() const { return counters.size(); }
+  const aie_perf_counter_id_t &getCounterId(size_t i) const {
+    return counters[i].id;
+  }
+  const std::vector<uint64_t> &getSamples(size_t i) const {
+    return counters[i].samples;
+  }
+  aie_perf_stats_t getStats(size_t i) const {
+    return aie_perf_stats_t::compute(counters[i].samples);
+  }
+
+  /// Drop all samples, keeping the counter configuration.
+  void clear() {
+    for (counter_t &c : counters)
+      c.samples.clear();
+  }
+
+  /// One row per counter with its statistics.
+  void writeCSV(FILE *f) const {
+    fprintf(f, "col,row,module,counter,name,n,min,max,mean,stddev,p50,p90,"
+               "p99\n");
+    for (size_t i = 0; i < counters.size(); i++) {
+      const counter_t &c = counters[i];
+      aie_perf_stats_t s = getStats(i);
+      fprintf(f, "%d,%d,%s,%d,", c.id.col, c.id.row,
+              getModuleName(c.id.module), c.id.counter);
+      aie_perf_write_csv_field(f, c.name);
+      fprintf(f, ",%zu,%llu,%llu,%.2f,%.2f,%.2f,%.2f,%.2f\n", s.n,
+              (unsigned long long)s.min, (unsigned long long)s.max, s.mean,
+              s.stddev, s.p50, s.p90, s.p99);
+    }
+  }
+
+  /// The statistics and raw samples of every counter.
+  void writeJSON(FILE *f) const {
+    fprintf(f, "{\n  \"counters\": [");
+    for (size_t i = 0; i < counters.size(); i++) {
+      const counter_t &c = counters[i];
+      aie_perf_stats_t s = getStats(i);
+      fprintf(f, "%s\n    {\"col\": %d, \"row\": %d, \"module\": \"%s\", "
+                 "\"counter\": %d, \"name\": ",
+              i ? "," : "", c.id.col, c.id.row, getModuleName(c.id.module),
+              c.id.counter);
+      aie_perf_write_json_string(f, c.name);
+      fprintf(f, ",\n");
+      fprintf(f, "     \"n\": %zu, \"min\": %llu, \"max\": %llu, "
+                 "\"mean\": %.2f, \"stddev\": %.2f, \"p50\": %.2f, "
+                 "\"p90\": %.2f, \"p99\": %.2f,\n",
+              s.n, (unsigned long long)s.min, (unsigned long long)s.max,
+              s.mean, s.stddev, s.p50, s.p90, s.p99);
+      fprintf(f, "     \"samples\": [");
+      for (size_t j = 0; j < c.samples.size(); j++)
+        fprintf(f, "%s%llu", j ? ", " : "",
+                (unsigned long long)c.samples[j]);
+      fprintf(f, "]}");
+    }
+    fprintf(f, "\n  ]\n}\n");
+  }
+
+  static const char *getModuleName(aie_perf_module_t module) {
+    switch (module) {
+    case AIE_PERF_MEM:
+      return "mem";
+    case AIE_PERF_CORE:
+      return "core";
+    case AIE_PERF_PL:
+      return "pl";
+    }
+    return "unknown";
+  }
+
+private:
+  struct counter_t {
+    aie_perf_counter_id_t id;
+    std::string name;
+    uint32_t last = 0;
+    uint64_t accumulated = 0;
+    std::vector<uint64_t> samples;
+  };
+
+  aie_perf_backend_t &backend;
+  std::vector<counter_t> counters;
+};
+
+#endif
@@ -0,0 +1,222 @@
+//===- register_batch.h -----------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef AIE_REGISTER_BATCH_H
+#define AIE_REGISTER_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/// Destination of the register transactions issued by aie_reg_batch_t. The
+/// test library provides a libXAIE implementation; aie_regfile_backend_t below
+/// models the register space in host memory.
+class aie_reg_backend_t {
+public:
+  virtual ~aie_reg_backend_t() = default;
+  virtual void write32(uint64_t addr, uint32_t value) = 0;
+  /// Write `count` words to consecutive addresses starting at `addr`.
+  virtual void blockWrite32(uint64_t addr, const uint32_t *values,
+                            size_t count) = 0;
+  virtual uint32_t read32(uint64_t addr) = 0;
+};
+
+/// In-memory register file. Unwritten registers read as zero. Counts the
+/// transactions it receives so batching can be verified and benchmarked
+/// without a device.
+class aie_regfile_backend_t : public aie_reg_backend_t {
+public:
+  void write32(uint64_t addr, uint32_t value) override {
+    regs[addr] = value;
+    numWrites++;
+    numWords++;
+  }
+
+  void blockWrite32(uint64_t addr, const uint32_t *values,
+                    size_t count) override {
+    for (size_t i = 0; i < count; i++)
+      regs[addr + 4 * i] = values[i];
+    numBlockWrites++;
+    numWords += count;
+  }
+
+  uint32_t read32(uint64_t addr) override {
+    numReads++;
+    return get(addr);
+  }
+
+  /// Inspect a register without counting it as a transaction.
+  uint32_t get(uint64_t addr) const {
+    auto it = regs.find(addr);
+    return it == regs.end() ? 0 : it->second;
+  }
+
+  size_t getNumTransactions() const {
+    return numWrites + numBlockWrites + numReads;
+  }
+
+  size_t numWrites = 0;
+  size_t numBlockWrites = 0;
+  size_t numWords = 0;
+  size_t numReads = 0;
+
+private:
+  std::unordered_map<uint64_t, uint32_t> regs;
+};
+
+/// Records 32-bit register writes per tile and issues them in as few
+/// transactions as possible when flushed.
+///
+/// Writes are buffered per tile (tiles are identified by the address bits
+/// above `tileAddrShift`, i.e. the row shift of the device). On flush, the
+/// tiles are visited in the order they were first written and each tile's
+/// writes are coalesced into block writes over contiguous address ranges. By
+/// default the program order of writes within a tile is preserved, so only
+/// consecutive writes to ascending addresses are merged. When `reorder` is
+/// set, writes within a tile are sorted by address first (the last write to
+/// an address wins), which is only valid for phases whose writes are order
+/// independent, such as data memory or stream switch initialization.
+///
+/// Reads are served from the pending writes where possible so a batch is
+/// always read-after-write consistent.
+class aie_reg_batch_t {
+public:
+  static constexpr size_t defaultMaxBlockWords = 1024;
+
+  aie_reg_batch_t(aie_reg_backend_t &backend, unsigned tileAddrShift,
+                  bool reorder = false,
+                  size_t maxBlockWords = defaultMaxBlockWords)
+      : backend(backend), tileAddrShift(tileAddrShift), reorder(reorder),
+        maxBlockWords(maxBlockWords) {}
+  aie_reg_batch_t(const aie_reg_batch_t &) = delete;
+  aie_reg_batch_t &operator=(const aie_reg_batch_t &) = delete;
+  ~aie_reg_batch_t() { flush(); }
+
+  void write32(uint64_t addr, uint32_t value) {
+    uint64_t tileKey = addr >> tileAddrShift;
+    auto it = tiles.find(tileKey);
+    if (it == tiles.end()) {
+      it = tiles.emplace(tileKey, tile_writes_t()).first;
+      tileOrder.push_back(tileKey);
+    }
+    tile_writes_t &tile = it->second;
+    tile.latest[addr] = tile.writes.size();
+    tile.writes.push_back({addr, value});
+    numPending++;
+  }
+
+  void maskWrite32(uint64_t addr, uint32_t mask, uint32_t value) {
+    write32(addr, (read32(addr) & ~mask) | (value & mask));
+  }
+
+  uint32_t read32(uint64_t addr) {
+    auto tileIt = tiles.find(addr >> tileAddrShift);
+    if (tileIt != tiles.end()) {
+      auto it = tileIt->second.latest.find(addr);
+      if (it != tileIt->second.latest.end())
+        return tileIt->second.writes[it->second].second;
+    }
+    return backend.read32(addr);
+  }
+
+  /// Issue all pending writes. Returns the number of transactions issued.
+  size_t flush() {
+    size_t transactions = 0;
+    for (uint64_t tileKey : tileOrder) {
+      tile_writes_t &tile = tiles[tileKey];
+      if (reorder) {
+        std::map<uint64_t, uint32_t> sorted;
+        for (auto &write : tile.writes)
+          sorted[write.first] = write.second;
+        tile.writes.assign(sorted.begin(), sorted.end());
+      }
+
+      uint64_t runStart = 0;
+      std::vector<uint32_t> run;
+      for (auto &write : tile.writes) {
+        if (!run.empty() && (write.first != runStart + 4 * run.size() ||
+                             run.size() == maxBlockWords)) {
+          transactions += issue(runStart, run);
+          run.clear();
+        }
+        if (run.empty())
+          runStart = write.first;
+        run.push_back(write.second);
+      }
+      if (!run.empty())
+        transactions += issue(runStart, run);
+    }
+    tiles.clear();
+    tileOrder.clear();
+    numPending = 0;
+    return transactions;
+  }
+
+  size_t getNumPending() const { return numPending; }
+
+private:
+  struct tile_writes_t {
+    std::vector<std::pair<uint64_t, uint32_t>> writes;
+    // Index in `writes` of the most recent write to each address.
+    std::unordered_map<uint64_t, size_t> latest;
+  };
+
+  size_t issue(uint64_t addr, const std::vector<uint32_t> &values) {
+    if (values.size() == 1)
+      backend.write32(addr, values[0]);
+    else
+      backend.blockWrite32(addr, values.data(), values.size());
+    return 1;
+  }
+
+  aie_reg_backend_t &backend;
+  unsigned tileAddrShift;
+  bool reorder;
+  size_t maxBlockWords;
+  std::unordered_map<uint64_t, tile_writes_t> tiles;
+  std::vector<uint64_t> tileOrder;
+  size_t numPending = 0;
+};
+
+/// The batch, if any, that a runtime context records register writes into.
+/// mlir_aie_begin_batch and mlir_aie_flush_batch forward to begin() and
+/// flush().
+class aie_reg_batch_slot_t {
+public:
+  /// Start a new batch into `backend`, flushing the current one first.
+  void begin(aie_reg_backend_t &backend, unsigned tileAddrShift,
+             bool reorder) {
+    if (batch)
+      batch->flush();
+    batch.reset(new aie_reg_batch_t(backend, tileAddrShift, reorder));
+  }
+
+  /// Flush and end the current batch. Returns the number of transactions
+  /// issued, or 0 if no batch was active.
+  size_t flush() {
+    if (!batch)
+      return 0;
+    size_t transactions = batch->flush();
+    batch.reset();
+    return transactions;
+  }
+
+  explicit operator bool() const { return batch != nullptr; }
+  aie_reg_batch_t *operator->() const { return batch.get(); }
+
+private:
+  std::unique_ptr<aie_reg_batch_t> batch;
+};
+
+#endif
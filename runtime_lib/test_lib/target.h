@@ -11,7 +11,11 @@
 #ifndef AIE_TARGET_H
 #define AIE_TARGET_H
 
-#include <list>
+#include "memory_pool.h"
+#include "perf_profiler.h"
+#include "register_batch.h"
+
+#include <memory>
 #include <vector>
 #include <xaiengine.h>
 
@@ -31,8 +35,15 @@ struct ext_mem_model_t {
 struct aie_libxaie_ctx_t {
   XAie_Config AieConfigPtr;
   XAie_DevInst DevInst;
-  // Some device memory allocators need this to keep track of VA->PA mappings
-  std::list<ext_mem_model_t> allocations;
+  // Pool backing mlir_aie_mem_alloc, created on first use and released with
+  // the context. Also tracks VA->PA mappings for the allocators that need it.
+  std::unique_ptr<aie_mem_pool_t> memPool;
+  // Register writes are recorded here between mlir_aie_begin_batch and
+  // mlir_aie_flush_batch. The backend must outlive the batch.
+  std::unique_ptr<aie_reg_backend_t> regBackend;
+  aie_reg_batch_slot_t regBatch;
+  // Created by mlir_aie_get_perf_backend.
+  std::unique_ptr<aie_perf_backend_t> perfBackend;
 #ifdef HSA_RUNTIME
   hsa_queue_t *cmd_queue;
   std::vector<hsa_agent_t> agents;
@@ -151,6 +151,11 @@ hsa_status_t mlir_aie_packet_device_init(hsa_agent_dispatch_packet_t *pkt,
 /// @brief  Release access to the libXAIE context.
 /// @param ctx The context
 void mlir_aie_deinit_libxaie(aie_libxaie_ctx_t *ctx) {
+  // Pending register writes and device memory must be dealt with while the
+  // device instance is still live.
+  mlir_aie_flush_batch(ctx);
+  ctx->memPool.reset();
+
   AieRC RC = XAie_Finish(&(ctx->DevInst));
   if (RC != XAIE_OK) {
     printf("Failed to finish tiles.\n");
@@ -162,7 +167,7 @@ void mlir_aie_deinit_libxaie(aie_libxaie_ctx_t *ctx) {
   }
   hsa_shut_down();
 #endif
-  free(ctx);
+  delete ctx;
 }
 
 /// @brief Initialize the device represented by the context.
@@ -321,8 +326,105 @@ int mlir_aie_release_lock(aie_libxaie_ctx_t *ctx, int col, int row, int lockid,
                            XAie_LockInit(lockid, lockval), timeout) == XAIE_OK);
 }
 
+namespace {
+
+/// Issues batched register transactions through libXAIE.
+class aie_libxaie_reg_backend_t : public aie_reg_backend_t {
+public:
+  aie_libxaie_reg_backend_t(XAie_DevInst *devInst) : devInst(devInst) {}
+
+  void write32(uint64_t addr, uint32_t value) override {
+    XAie_Write32(devInst, addr, value);
+  }
+  void blockWrite32(uint64_t addr, const uint32_t *values,
+                    size_t count) override {
+    XAie_BlockWrite32(devInst, addr, values, count);
+  }
+  uint32_t read32(uint64_t addr) override {
+    u32 val;
+    XAie_Read32(devInst, addr, &val);
+    return val;
+  }
+
+private:
+  XAie_DevInst *devInst;
+};
+
+/// Reads and configures performance counters through libXAIE.
+class aie_libxaie_perf_backend_t : public aie_perf_backend_t {
+public:
+  aie_libxaie_perf_backend_t(aie_libxaie_ctx_t *ctx)
+      : devInst(&(ctx->DevInst)),
+        memTileRowStart(ctx->AieConfigPtr.MemTileRowStart),
+        memTileNumRows(ctx->AieConfigPtr.MemTileNumRows) {}
+
+  int getNumCounters(int col, int row, aie_perf_module_t module) override {
+    bool isShim = row == 0;
+    bool isMemTile = row >= memTileRowStart &&
+                     row < memTileRowStart + memTileNumRows;
+    switch (module) {
+    case AIE_PERF_CORE:
+      return isShim || isMemTile ? 0 : 4;
+    case AIE_PERF_MEM:
+      return isShim ? 0 : isMemTile ? 4 : 2;
+    case AIE_PERF_PL:
+      return isShim ? 2 : 0;
+    }
+    return 0;
+  }
+  bool configure(const aie_perf_counter_id_t &id, uint32_t startEvent,
+                 uint32_t stopEvent) override {
+    return XAie_PerfCounterControlSet(
+               devInst, XAie_TileLoc(id.col, id.row), getModule(id.module),
+               id.counter, static_cast<XAie_Events>(startEvent),
+               static_cast<XAie_Events>(stopEvent)) == XAIE_OK;
+  }
+  uint32_t read(const aie_perf_counter_id_t &id) override {
+    u32 val = 0;
+    XAie_PerfCounterGet(devInst, XAie_TileLoc(id.col, id.row),
+                        getModule(id.module), id.counter, &val);
+    return val;
+  }
+
+private:
+  static XAie_ModuleType getModule(aie_perf_module_t module) {
+    switch (module) {
+    case AIE_PERF_CORE:
+      return XAIE_CORE_MOD;
+    case AIE_PERF_PL:
+      return XAIE_PL_MOD;
+    default:
+      return XAIE_MEM_MOD;
+    }
+  }
+
+  XAie_DevInst *devInst;
+  int memTileRowStart;
+  int memTileNumRows;
+};
+
+} // namespace
+
+aie_perf_backend_t *mlir_aie_get_perf_backend(aie_libxaie_ctx_t *ctx) {
+  if (!ctx->perfBackend)
+    ctx->perfBackend.reset(new aie_libxaie_perf_backend_t(ctx));
+  return ctx->perfBackend.get();
+}
+
+void mlir_aie_begin_batch(aie_libxaie_ctx_t *ctx, bool reorder) {
+  if (!ctx->regBackend)
+    ctx->regBackend.reset(new aie_libxaie_reg_backend_t(&(ctx->DevInst)));
+  ctx->regBatch.begin(*ctx->regBackend, ctx->AieConfigPtr.RowShift, reorder);
+}
+
+int mlir_aie_flush_batch(aie_libxaie_ctx_t *ctx) {
+  return ctx->regBatch.flush();
+}
+
 /// @brief Read the AIE configuration memory at the given physical address.
 u32 mlir_aie_read32(aie_libxaie_ctx_t *ctx, u64 addr) {
+  if (ctx->regBatch)
+    return ctx->regBatch->read32(addr);
   u32 val;
   XAie_Read32(&(ctx->DevInst), addr, &val);
   return val;
@@ -332,6 +434,10 @@ u32 mlir_aie_read32(aie_libxaie_ctx_t *ctx, u64 addr) {
 /// It's almost always better to use some more indirect method of accessing
 /// configuration registers, but this is provided as a last resort.
 void mlir_aie_write32(aie_libxaie_ctx_t *ctx, u64 addr, u32 val) {
+  if (ctx->regBatch) {
+    ctx->regBatch->write32(addr, val);
+    return;
+  }
   XAie_Write32(&(ctx->DevInst), addr, val);
 }
 
@@ -340,6 +446,8 @@ void mlir_aie_write32(aie_libxaie_ctx_t *ctx, u64 addr, u32 val) {
 /// @return The data
 u32 mlir_aie_data_mem_rd_word(aie_libxaie_ctx_t *ctx, int col, int row,
                               u64 addr) {
+  if (ctx->regBatch)
+    return ctx->regBatch->read32(mlir_aie_get_tile_addr(ctx, col, row) + addr);
   u32 data;
   XAie_DataMemRdWord(&(ctx->DevInst), XAie_TileLoc(col, row), addr, &data);
   return data;
@@ -350,6 +458,11 @@ u32 mlir_aie_data_mem_rd_word(aie_libxaie_ctx_t *ctx, int col, int row,
 /// @param data The data
 void mlir_aie_data_mem_wr_word(aie_libxaie_ctx_t *ctx, int col, int row,
                                u64 addr, u32 data) {
+  // Data memory starts at offset 0 of the tile address space.
+  if (ctx->regBatch) {
+    ctx->regBatch->write32(mlir_aie_get_tile_addr(ctx, col, row) + addr, data);
+    return;
+  }
   XAie_DataMemWrWord(&(ctx->DevInst), XAie_TileLoc(col, row), addr, data);
 }
 
@@ -375,9 +488,13 @@ void mlir_aie_dump_tile_memory(aie_libxaie_ctx_t *ctx, int col, int row) {
 /// @brief Fill the tile memory of the given tile with zeros.
 /// Values that are zero are not shown
 void mlir_aie_clear_tile_memory(aie_libxaie_ctx_t *ctx, int col, int row) {
-  for (int i = 0; i < 0x2000; i++) {
-    XAie_DataMemWrWord(&(ctx->DevInst), XAie_TileLoc(col, row), (i * 4), 0);
-  }
+  bool ownsBatch = !ctx->regBatch;
+  if (ownsBatch)
+    mlir_aie_begin_batch(ctx);
+  for (int i = 0; i < 0x2000; i++)
+    mlir_aie_data_mem_wr_word(ctx, col, row, (i * 4), 0);
+  if (ownsBatch)
+    mlir_aie_flush_batch(ctx);
 }
 
 static void print_aie1_dmachannel_status(aie_libxaie_ctx_t *ctx, int col,
@@ -1027,10 +1144,10 @@ void mlir_aie_print_tile_status(aie_libxaie_ctx_t *ctx, int col, int row) {
   printf("\n");
 }
 
-static void clear_range(XAie_DevInst *devInst, u64 tileAddr, u64 low,
+static void clear_range(aie_libxaie_ctx_t *ctx, u64 tileAddr, u64 low,
                         u64 high) {
   for (int i = low; i <= high; i += 4) {
-    XAie_Write32(devInst, tileAddr + i, 0);
+    mlir_aie_write32(ctx, tileAddr + i, 0);
     // int x = XAie_Read32(ctx->DevInst,tileAddr+i);
     // if(x != 0) {
     //   printf("@%x = %x\n", i, x);
@@ -1050,20 +1167,31 @@ void mlir_aie_clear_config(aie_libxaie_ctx_t *ctx, int col, int row) {
   // TODO Check if this works
   XAie_CoreDisable(&(ctx->DevInst), XAie_TileLoc(col, row));
 
+  bool ownsBatch = !ctx->regBatch;
+  if (ownsBatch)
+    mlir_aie_begin_batch(ctx);
+
   // Program Memory
-  clear_range(&(ctx->DevInst), tileAddr, 0x20000, 0x200FF);
+  clear_range(ctx, tileAddr, 0x20000, 0x200FF);
   // TileDMA
-  clear_range(&(ctx->DevInst), tileAddr, 0x1D000, 0x1D1F8);
-  XAie_Write32(&(ctx->DevInst), tileAddr + 0x1DE00, 0);
-  XAie_Write32(&(ctx->DevInst), tileAddr + 0x1DE08, 0);
-  XAie_Write32(&(ctx->DevInst), tileAddr + 0x1DE10, 0);
-  XAie_Write32(&(ctx->DevInst), tileAddr + 0x1DE08, 0);
+  clear_range(ctx, tileAddr, 0x1D000, 0x1D1F8);
+  mlir_aie_write32(ctx, tileAddr + 0x1DE00, 0);
+  mlir_aie_write32(ctx, tileAddr + 0x1DE08, 0);
+  mlir_aie_write32(ctx, tileAddr + 0x1DE10, 0);
+  mlir_aie_write32(ctx, tileAddr + 0x1DE08, 0);
   // Stream Switch master config
-  clear_range(&(ctx->DevInst), tileAddr, 0x3F000, 0x3F060);
+  clear_range(ctx, tileAddr, 0x3F000, 0x3F060);
   // Stream Switch slave config
-  clear_range(&(ctx->DevInst), tileAddr, 0x3F100, 0x3F168);
+  clear_range(ctx, tileAddr, 0x3F100, 0x3F168);
   // Stream Switch slave slot config
-  clear_range(&(ctx->DevInst), tileAddr, 0x3F200, 0x3F3AC);
+  clear_range(ctx, tileAddr, 0x3F200, 0x3F3AC);
+
+  // The clears must land before the core is enabled again, also when they
+  // were recorded in a batch of the caller, which stays open.
+  if (ownsBatch)
+    mlir_aie_flush_batch(ctx);
+  else
+    ctx->regBatch->flush();
 
   // TODO Check if this works
   XAie_CoreEnable(&(ctx->DevInst), XAie_TileLoc(col, row));
@@ -1075,19 +1203,26 @@ void mlir_aie_clear_config(aie_libxaie_ctx_t *ctx, int col, int row) {
 void mlir_aie_clear_shim_config(aie_libxaie_ctx_t *ctx, int col, int row) {
   u64 tileAddr = _XAie_GetTileAddr(&(ctx->DevInst), row, col);
 
+  bool ownsBatch = !ctx->regBatch;
+  if (ownsBatch)
+    mlir_aie_begin_batch(ctx);
+
   // ShimDMA
-  clear_range(&(ctx->DevInst), tileAddr, 0x1D000, 0x1D13C);
-  XAie_Write32(&(ctx->DevInst), tileAddr + 0x1D140, 0);
-  XAie_Write32(&(ctx->DevInst), tileAddr + 0x1D148, 0);
-  XAie_Write32(&(ctx->DevInst), tileAddr + 0x1D150, 0);
-  XAie_Write32(&(ctx->DevInst), tileAddr + 0x1D158, 0);
+  clear_range(ctx, tileAddr, 0x1D000, 0x1D13C);
+  mlir_aie_write32(ctx, tileAddr + 0x1D140, 0);
+  mlir_aie_write32(ctx, tileAddr + 0x1D148, 0);
+  mlir_aie_write32(ctx, tileAddr + 0x1D150, 0);
+  mlir_aie_write32(ctx, tileAddr + 0x1D158, 0);
 
   // Stream Switch master config
-  clear_range(&(ctx->DevInst), tileAddr, 0x3F000, 0x3F058);
+  clear_range(ctx, tileAddr, 0x3F000, 0x3F058);
   // Stream Switch slave config
-  clear_range(&(ctx->DevInst), tileAddr, 0x3F100, 0x3F15C);
+  clear_range(ctx, tileAddr, 0x3F100, 0x3F15C);
   // Stream Switch slave slot config
-  clear_range(&(ctx->DevInst), tileAddr, 0x3F200, 0x3F37C);
+  clear_range(ctx, tileAddr, 0x3F200, 0x3F37C);
+
+  if (ownsBatch)
+    mlir_aie_flush_batch(ctx);
 }
 
 /*
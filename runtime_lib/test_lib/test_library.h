@@ -100,12 +100,7 @@ public:
     // } else {
     //   end = XAieTileMem_PerfCounterGet(tilePtr, pfc);
     // }
-    if (end < start) {
-      printf("WARNING: EventMonitor: performance counter wrapped!\n");
-      return 0; // TODO: fix this
-    } else {
-      return end - start;
-    }
+    return aie_perf_counter_delta(start, end);
   }
 
 private:
@@ -152,6 +147,15 @@ int mlir_aie_acquire_lock(aie_libxaie_ctx_t *ctx, int col, int row, int lockid,
                           int lockval, int timeout);
 int mlir_aie_release_lock(aie_libxaie_ctx_t *ctx, int col, int row, int lockid,
                           int lockval, int timeout);
+/// Start recording register writes made through mlir_aie_write32,
+/// mlir_aie_data_mem_wr_word and the tile clearing functions instead of
+/// issuing them one at a time. See aie_reg_batch_t for the meaning of
+/// `reorder`.
+void mlir_aie_begin_batch(aie_libxaie_ctx_t *ctx, bool reorder = false);
+/// Issue the recorded writes, coalescing contiguous addresses into block
+/// writes, and stop recording. Returns the number of transactions issued.
+int mlir_aie_flush_batch(aie_libxaie_ctx_t *ctx);
+
 u32 mlir_aie_read32(aie_libxaie_ctx_t *ctx, u64 addr);
 void mlir_aie_write32(aie_libxaie_ctx_t *ctx, u64 addr, u32 val);
 u32 mlir_aie_data_mem_rd_word(aie_libxaie_ctx_t *ctx, int col, int row,
@@ -187,6 +191,10 @@ void mlir_aie_clear_shim_config(aie_libxaie_ctx_t *ctx, int col, int row);
 
 void computeStats(u32 performance_counter[], int n);
 
+/// Performance counters of the device behind `ctx`, for use with
+/// aie_perf_profiler_t. Owned by the context.
+aie_perf_backend_t *mlir_aie_get_perf_backend(aie_libxaie_ctx_t *ctx);
+
 } // extern "C"
 
 #endif
@@ -0,0 +1,108 @@
+// RUN: aie-opt %s -split-input-file -convert-aievec-to-llvm | FileCheck %s
+
+// -----
+
+func.func @i32_add_elem(%lhs : vector<16xi32>, %rhs : vector<16xi32>) -> vector<16xi32> {
+  %0 = aievec.add_elem %lhs, %rhs : vector<16xi32>
+  return %0 : vector<16xi32>
+}
+
+// CHECK-LABEL: @i32_add_elem
+// CHECK-SAME: %[[LHS:.*]]: vector<16xi32>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xi32>
+// CHECK: %[[RES:.*]] = llvm.add %[[LHS]], %[[RHS]] : vector<16xi32>
+// CHECK-NEXT: return %[[RES]] : vector<16xi32>
+
+// -----
+
+func.func @i64_sub_elem(%lhs : vector<16xi64>, %rhs : vector<16xi64>) -> vector<16xi64> {
+  %0 = aievec.sub_elem %lhs, %rhs : vector<16xi64>
+  return %0 : vector<16xi64>
+}
+
+// CHECK-LABEL: @i64_sub_elem
+// CHECK-SAME: %[[LHS:.*]]: vector<16xi64>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xi64>
+// CHECK: %[[RES:.*]] = llvm.sub %[[LHS]], %[[RHS]] : vector<16xi64>
+// CHECK-NEXT: return %[[RES]] : vector<16xi64>
+
+// -----
+
+func.func @f32_add_elem(%lhs : vector<16xf32>, %rhs : vector<16xf32>) -> vector<16xf32> {
+  %0 = aievec.add_elem %lhs, %rhs : vector<16xf32>
+  return %0 : vector<16xf32>
+}
+
+// CHECK-LABEL: @f32_add_elem
+// CHECK-SAME: %[[LHS:.*]]: vector<16xf32>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xf32>
+// CHECK: %[[CONF:.*]] = llvm.mlir.constant(0 : i32) : i32
+// CHECK-NEXT: %[[BITCAST0:.*]] = llvm.bitcast %[[LHS]] : vector<16xf32> to vector<8xi64>
+// CHECK-NEXT: %[[BITCAST1:.*]] = llvm.bitcast %[[RHS]] : vector<16xf32> to vector<8xi64>
+// CHECK-NEXT: %[[ADD:.*]] = "xllvm.intr.aie2.add.accfloat"(
+// CHECK-SAME: %[[BITCAST0]], %[[BITCAST1]], %[[CONF]]) :
+// CHECK-SAME: (vector<8xi64>, vector<8xi64>, i32) -> vector<8xi64>
+// CHECK-NEXT: %[[RES:.*]] = llvm.bitcast %[[ADD]] : vector<8xi64> to vector<16xf32>
+// CHECK-NEXT: return %[[RES]] : vector<16xf32>
+
+// -----
+
+func.func @f32_sub_elem(%lhs : vector<16xf32>, %rhs : vector<16xf32>) -> vector<16xf32> {
+  %0 = aievec.sub_elem %lhs, %rhs : vector<16xf32>
+  return %0 : vector<16xf32>
+}
+
+// CHECK-LABEL: @f32_sub_elem
+// CHECK: "xllvm.intr.aie2.sub.accfloat"(
+// CHECK-SAME: (vector<8xi64>, vector<8xi64>, i32) -> vector<8xi64>
+
+// -----
+
+func.func @bf16_add_elem(%lhs : vector<16xbf16>, %rhs : vector<16xbf16>) -> vector<16xbf16> {
+  %0 = aievec.add_elem %lhs, %rhs : vector<16xbf16>
+  return %0 : vector<16xbf16>
+}
+
+// CHECK-LABEL: @bf16_add_elem
+// CHECK-SAME: %[[LHS:.*]]: vector<16xbf16>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xbf16>
+// CHECK: %[[ACC0:.*]] = "xllvm.intr.aie2.v16bf16.to.v16accfloat"(%[[LHS]]) :
+// CHECK-SAME: (vector<16xbf16>) -> vector<8xi64>
+// CHECK-NEXT: %[[ACC1:.*]] = "xllvm.intr.aie2.v16bf16.to.v16accfloat"(%[[RHS]]) :
+// CHECK-SAME: (vector<16xbf16>) -> vector<8xi64>
+// CHECK-NEXT: %[[CONF:.*]] = llvm.mlir.constant(0 : i32) : i32
+// CHECK-NEXT: %[[ADD:.*]] = "xllvm.intr.aie2.add.accfloat"(
+// CHECK-SAME: %[[ACC0]], %[[ACC1]], %[[CONF]]) :
+// CHECK-SAME: (vector<8xi64>, vector<8xi64>, i32) -> vector<8xi64>
+// CHECK-NEXT: %[[RES:.*]] = "xllvm.intr.aie2.v16accfloat.to.v16bf16"(%[[ADD]]) :
+// CHECK-SAME: (vector<8xi64>) -> vector<16xbf16>
+// CHECK-NEXT: return %[[RES]] : vector<16xbf16>
+
+// -----
+
+func.func @bf16_sub_elem(%lhs : vector<32xbf16>, %rhs : vector<32xbf16>) -> vector<32xbf16> {
+  %0 = aievec.sub_elem %lhs, %rhs : vector<32xbf16>
+  return %0 : vector<32xbf16>
+}
+
+// CHECK-LABEL: @bf16_sub_elem
+// CHECK-SAME: %[[LHS:.*]]: vector<32xbf16>,
+// CHECK-SAME: %[[RHS:.*]]: vector<32xbf16>
+// CHECK: %[[IDX0:.*]] = llvm.mlir.constant(0 : i32) : i32
+// CHECK-NEXT: %[[LHS0:.*]] = llvm.bitcast %[[LHS]] : vector<32xbf16> to vector<16xi32>
+// CHECK-NEXT: %[[LO0:.*]] = "xllvm.intr.aie2.ext.I256.I512"(%[[LHS0]], %[[IDX0]]) :
+// CHECK-NEXT: %[[LO0BF:.*]] = llvm.bitcast %[[LO0]] : vector<8xi32> to vector<16xbf16>
+// CHECK-NEXT: %[[ACC0:.*]] = "xllvm.intr.aie2.v16bf16.to.v16accfloat"(%[[LO0BF]])
+// CHECK: %[[ACC1:.*]] = "xllvm.intr.aie2.v16bf16.to.v16accfloat"
+// CHECK: %[[SUB0:.*]] = "xllvm.intr.aie2.sub.accfloat"(%[[ACC0]], %[[ACC1]],
+// CHECK-NEXT: %[[RES0:.*]] = "xllvm.intr.aie2.v16accfloat.to.v16bf16"(%[[SUB0]])
+// CHECK: %[[IDX1:.*]] = llvm.mlir.constant(1 : i32) : i32
+// CHECK-NEXT: %[[LHS1:.*]] = llvm.bitcast %[[LHS]] : vector<32xbf16> to vector<16xi32>
+// CHECK-NEXT: "xllvm.intr.aie2.ext.I256.I512"(%[[LHS1]], %[[IDX1]]) :
+// CHECK: %[[SUB1:.*]] = "xllvm.intr.aie2.sub.accfloat"(
+// CHECK-NEXT: %[[RES1:.*]] = "xllvm.intr.aie2.v16accfloat.to.v16bf16"(%[[SUB1]])
+// CHECK-NEXT: %[[CAT0:.*]] = llvm.bitcast %[[RES0]] : vector<16xbf16> to vector<8xi32>
+// CHECK-NEXT: %[[CAT1:.*]] = llvm.bitcast %[[RES1]] : vector<16xbf16> to vector<8xi32>
+// CHECK-NEXT: %[[CAT:.*]] = "xllvm.intr.aie2.concat.I512.I256"(%[[CAT0]], %[[CAT1]]) :
+// CHECK-NEXT: %[[RES:.*]] = llvm.bitcast %[[CAT]] : vector<16xi32> to vector<32xbf16>
+// CHECK-NEXT: return %[[RES]] : vector<32xbf16>
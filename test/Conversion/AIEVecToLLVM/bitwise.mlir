@@ -0,0 +1,106 @@
+// RUN: aie-opt %s -split-input-file -convert-aievec-to-llvm | FileCheck %s
+
+// -----
+
+func.func @i8_band(%lhs : vector<64xi8>, %rhs : vector<64xi8>) -> vector<64xi8> {
+  %0 = aievec.band %lhs, %rhs : vector<64xi8>, vector<64xi8>, vector<64xi8>
+  return %0 : vector<64xi8>
+}
+
+// CHECK-LABEL: @i8_band
+// CHECK-SAME: %[[LHS:.*]]: vector<64xi8>,
+// CHECK-SAME: %[[RHS:.*]]: vector<64xi8>
+// CHECK: %[[BITCAST0:.*]] = llvm.bitcast %[[LHS]] : vector<64xi8> to vector<16xi32>
+// CHECK-NEXT: %[[BITCAST1:.*]] = llvm.bitcast %[[RHS]] : vector<64xi8> to vector<16xi32>
+// CHECK-NEXT: %[[AND:.*]] = llvm.and %[[BITCAST0]], %[[BITCAST1]] : vector<16xi32>
+// CHECK-NEXT: %[[RES:.*]] = llvm.bitcast %[[AND]] : vector<16xi32> to vector<64xi8>
+// CHECK-NEXT: return %[[RES]] : vector<64xi8>
+
+// -----
+
+func.func @i32_bor(%lhs : vector<16xi32>, %rhs : vector<16xi32>) -> vector<16xi32> {
+  %0 = aievec.bor %lhs, %rhs : vector<16xi32>, vector<16xi32>, vector<16xi32>
+  return %0 : vector<16xi32>
+}
+
+// CHECK-LABEL: @i32_bor
+// CHECK-SAME: %[[LHS:.*]]: vector<16xi32>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xi32>
+// CHECK: %[[OR:.*]] = llvm.or %[[LHS]], %[[RHS]] : vector<16xi32>
+// CHECK-NEXT: return %[[OR]] : vector<16xi32>
+
+// -----
+
+func.func @bf16_bxor(%lhs : vector<32xbf16>, %rhs : vector<32xbf16>) -> vector<32xbf16> {
+  %0 = aievec.bxor %lhs, %rhs : vector<32xbf16>, vector<32xbf16>, vector<32xbf16>
+  return %0 : vector<32xbf16>
+}
+
+// CHECK-LABEL: @bf16_bxor
+// CHECK-SAME: %[[LHS:.*]]: vector<32xbf16>,
+// CHECK-SAME: %[[RHS:.*]]: vector<32xbf16>
+// CHECK: %[[BITCAST0:.*]] = llvm.bitcast %[[LHS]] : vector<32xbf16> to vector<16xi32>
+// CHECK-NEXT: %[[BITCAST1:.*]] = llvm.bitcast %[[RHS]] : vector<32xbf16> to vector<16xi32>
+// CHECK-NEXT: %[[XOR:.*]] = llvm.xor %[[BITCAST0]], %[[BITCAST1]] : vector<16xi32>
+// CHECK-NEXT: %[[RES:.*]] = llvm.bitcast %[[XOR]] : vector<16xi32> to vector<32xbf16>
+// CHECK-NEXT: return %[[RES]] : vector<32xbf16>
+
+// -----
+
+func.func @i16_bneg(%arg0 : vector<32xi16>) -> vector<32xi16> {
+  %0 = aievec.bneg %arg0 : vector<32xi16>
+  return %0 : vector<32xi16>
+}
+
+// CHECK-LABEL: @i16_bneg
+// CHECK-SAME: %[[ARG0:.*]]: vector<32xi16>
+// CHECK: %[[ONES:.*]] = llvm.mlir.constant(dense<-1> : vector<16xi32>) : vector<16xi32>
+// CHECK-NEXT: %[[BITCAST:.*]] = llvm.bitcast %[[ARG0]] : vector<32xi16> to vector<16xi32>
+// CHECK-NEXT: %[[XOR:.*]] = llvm.xor %[[BITCAST]], %[[ONES]] : vector<16xi32>
+// CHECK-NEXT: %[[RES:.*]] = llvm.bitcast %[[XOR]] : vector<16xi32> to vector<32xi16>
+// CHECK-NEXT: return %[[RES]] : vector<32xi16>
+
+// -----
+
+func.func @i32_neg(%arg0 : vector<16xi32>) -> vector<16xi32> {
+  %0 = aievec.neg %arg0 : vector<16xi32>
+  return %0 : vector<16xi32>
+}
+
+// CHECK-LABEL: @i32_neg
+// CHECK-SAME: %[[ARG0:.*]]: vector<16xi32>
+// CHECK: %[[ZERO:.*]] = llvm.mlir.constant(dense<0> : vector<16xi32>) : vector<16xi32>
+// CHECK-NEXT: %[[RES:.*]] = llvm.sub %[[ZERO]], %[[ARG0]] : vector<16xi32>
+// CHECK-NEXT: return %[[RES]] : vector<16xi32>
+
+// -----
+
+func.func @f32_neg(%arg0 : vector<16xf32>) -> vector<16xf32> {
+  %0 = aievec.neg %arg0 : vector<16xf32>
+  return %0 : vector<16xf32>
+}
+
+// CHECK-LABEL: @f32_neg
+// CHECK-SAME: %[[ARG0:.*]]: vector<16xf32>
+// CHECK: %[[RES:.*]] = llvm.fneg %[[ARG0]] : vector<16xf32>
+// CHECK-NEXT: return %[[RES]] : vector<16xf32>
+
+// -----
+
+func.func @bf16_neg(%arg0 : vector<16xbf16>) -> vector<16xbf16> {
+  %0 = aievec.neg %arg0 : vector<16xbf16>
+  return %0 : vector<16xbf16>
+}
+
+// CHECK-LABEL: @bf16_neg
+// CHECK-SAME: %[[ARG0:.*]]: vector<16xbf16>
+// CHECK: %[[ACC:.*]] = "xllvm.intr.aie2.v16bf16.to.v16accfloat"(%[[ARG0]]) :
+// CHECK-SAME: (vector<16xbf16>) -> vector<8xi64>
+// CHECK-NEXT: %[[ZERO:.*]] = llvm.mlir.constant(dense<0> : vector<8xi64>) : vector<8xi64>
+// CHECK-NEXT: %[[CONF:.*]] = llvm.mlir.constant(0 : i32) : i32
+// CHECK-NEXT: %[[NEG:.*]] = "xllvm.intr.aie2.sub.accfloat"(
+// CHECK-SAME: %[[ZERO]], %[[ACC]], %[[CONF]]) :
+// CHECK-SAME: (vector<8xi64>, vector<8xi64>, i32) -> vector<8xi64>
+// CHECK-NEXT: %[[RES:.*]] = "xllvm.intr.aie2.v16accfloat.to.v16bf16"(%[[NEG]]) :
+// CHECK-SAME: (vector<8xi64>) -> vector<16xbf16>
+// CHECK-NEXT: return %[[RES]] : vector<16xbf16>
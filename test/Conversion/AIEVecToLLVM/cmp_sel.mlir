@@ -0,0 +1,139 @@
+// RUN: aie-opt %s -split-input-file -convert-aievec-to-llvm | FileCheck %s
+
+// -----
+
+func.func @i32_sgt_sel(%lhs : vector<16xi32>, %rhs : vector<16xi32>) -> vector<16xi32> {
+  %0 = aievec.cmp %lhs, %rhs {pred = "sgt"} : vector<16xi32>, vector<16xi32>, ui32
+  %1 = aievec.sel %lhs, %rhs, %0 : vector<16xi32>, vector<16xi32>, ui32, vector<16xi32>
+  return %1 : vector<16xi32>
+}
+
+// CHECK-LABEL: @i32_sgt_sel
+// CHECK-SAME: %[[LHS:.*]]: vector<16xi32>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xi32>
+// CHECK: %[[SIGN:.*]] = llvm.mlir.constant(1 : i32) : i32
+// CHECK-NEXT: %[[MASK:.*]] = "xllvm.intr.aie2.vlt32"(
+// CHECK-SAME: %[[RHS]], %[[LHS]], %[[SIGN]]) :
+// CHECK-SAME: (vector<16xi32>, vector<16xi32>, i32) -> i32
+// CHECK-NEXT: %[[SEL:.*]] = "xllvm.intr.aie2.vsel32"(
+// CHECK-SAME: %[[LHS]], %[[RHS]], %[[MASK]]) :
+// CHECK-SAME: (vector<16xi32>, vector<16xi32>, i32) -> vector<16xi32>
+// CHECK-NEXT: return %[[SEL]] : vector<16xi32>
+
+// -----
+
+func.func @i16_ult_sel(%lhs : vector<32xi16>, %rhs : vector<32xi16>) -> vector<32xi16> {
+  %0 = aievec.cmp %lhs, %rhs {pred = "ult"} : vector<32xi16>, vector<32xi16>, ui32
+  %1 = aievec.sel %lhs, %rhs, %0 : vector<32xi16>, vector<32xi16>, ui32, vector<32xi16>
+  return %1 : vector<32xi16>
+}
+
+// CHECK-LABEL: @i16_ult_sel
+// CHECK-SAME: %[[LHS:.*]]: vector<32xi16>,
+// CHECK-SAME: %[[RHS:.*]]: vector<32xi16>
+// CHECK: %[[SIGN:.*]] = llvm.mlir.constant(0 : i32) : i32
+// CHECK-NEXT: %[[MASK:.*]] = "xllvm.intr.aie2.vlt16"(
+// CHECK-SAME: %[[LHS]], %[[RHS]], %[[SIGN]]) :
+// CHECK-SAME: (vector<32xi16>, vector<32xi16>, i32) -> i32
+// CHECK-NEXT: %[[SEL:.*]] = "xllvm.intr.aie2.vsel16"(
+// CHECK-SAME: %[[LHS]], %[[RHS]], %[[MASK]]) :
+// CHECK-SAME: (vector<32xi16>, vector<32xi16>, i32) -> vector<32xi16>
+// CHECK-NEXT: return %[[SEL]] : vector<32xi16>
+
+// -----
+
+func.func @i8_sle_sel(%lhs : vector<64xi8>, %rhs : vector<64xi8>) -> vector<64xi8> {
+  %0 = aievec.cmp %lhs, %rhs {pred = "sle"} : vector<64xi8>, vector<64xi8>, ui64
+  %1 = aievec.sel %lhs, %rhs, %0 : vector<64xi8>, vector<64xi8>, ui64, vector<64xi8>
+  return %1 : vector<64xi8>
+}
+
+// CHECK-LABEL: @i8_sle_sel
+// CHECK-SAME: %[[LHS:.*]]: vector<64xi8>,
+// CHECK-SAME: %[[RHS:.*]]: vector<64xi8>
+// CHECK: %[[SIGN:.*]] = llvm.mlir.constant(1 : i32) : i32
+// CHECK-NEXT: %[[VGE:.*]] = "xllvm.intr.aie2.vge8"(
+// CHECK-SAME: %[[RHS]], %[[LHS]], %[[SIGN]]) :
+// CHECK-SAME: (vector<64xi8>, vector<64xi8>, i32) -> vector<2xi32>
+// CHECK-NEXT: %[[MASK:.*]] = llvm.bitcast %[[VGE]] : vector<2xi32> to i64
+// CHECK-NEXT: %[[SELMASK:.*]] = llvm.bitcast %[[MASK]] : i64 to vector<2xi32>
+// CHECK-NEXT: %[[SEL:.*]] = "xllvm.intr.aie2.vsel8"(
+// CHECK-SAME: %[[LHS]], %[[RHS]], %[[SELMASK]]) :
+// CHECK-SAME: (vector<64xi8>, vector<64xi8>, vector<2xi32>) -> vector<64xi8>
+// CHECK-NEXT: return %[[SEL]] : vector<64xi8>
+
+// -----
+
+func.func @i32_eq(%lhs : vector<16xi32>, %rhs : vector<16xi32>) -> vector<16xi32> {
+  %0 = aievec.cmp %lhs, %rhs {pred = "eq"} : vector<16xi32>, vector<16xi32>, ui32
+  %1 = aievec.sel %lhs, %rhs, %0 : vector<16xi32>, vector<16xi32>, ui32, vector<16xi32>
+  return %1 : vector<16xi32>
+}
+
+// CHECK-LABEL: @i32_eq
+// CHECK-SAME: %[[LHS:.*]]: vector<16xi32>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xi32>
+// CHECK: %[[GE0:.*]] = "xllvm.intr.aie2.vge32"(%[[LHS]], %[[RHS]], %{{.*}})
+// CHECK: %[[GE1:.*]] = "xllvm.intr.aie2.vge32"(%[[RHS]], %[[LHS]], %{{.*}})
+// CHECK-NEXT: %[[MASK:.*]] = llvm.and %[[GE0]], %[[GE1]] : i32
+// CHECK-NEXT: "xllvm.intr.aie2.vsel32"(%[[LHS]], %[[RHS]], %[[MASK]])
+
+// -----
+
+func.func @i32_ne(%lhs : vector<16xi32>, %rhs : vector<16xi32>) -> vector<16xi32> {
+  %0 = aievec.cmp %lhs, %rhs {pred = "ne"} : vector<16xi32>, vector<16xi32>, ui32
+  %1 = aievec.sel %lhs, %rhs, %0 : vector<16xi32>, vector<16xi32>, ui32, vector<16xi32>
+  return %1 : vector<16xi32>
+}
+
+// CHECK-LABEL: @i32_ne
+// CHECK-SAME: %[[LHS:.*]]: vector<16xi32>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xi32>
+// CHECK: %[[GE0:.*]] = "xllvm.intr.aie2.vge32"(%[[LHS]], %[[RHS]], %{{.*}})
+// CHECK: %[[GE1:.*]] = "xllvm.intr.aie2.vge32"(%[[RHS]], %[[LHS]], %{{.*}})
+// CHECK-NEXT: %[[EQ:.*]] = llvm.and %[[GE0]], %[[GE1]] : i32
+// CHECK-NEXT: %[[LANES:.*]] = llvm.mlir.constant(65535 : i32) : i32
+// CHECK-NEXT: %[[MASK:.*]] = llvm.xor %[[EQ]], %[[LANES]] : i32
+// CHECK-NEXT: "xllvm.intr.aie2.vsel32"(%[[LHS]], %[[RHS]], %[[MASK]])
+
+// -----
+
+func.func @bf16_sgt_sel(%lhs : vector<32xbf16>, %rhs : vector<32xbf16>) -> vector<32xbf16> {
+  %0 = aievec.cmp %lhs, %rhs {pred = "sgt"} : vector<32xbf16>, vector<32xbf16>, ui32
+  %1 = aievec.sel %lhs, %rhs, %0 : vector<32xbf16>, vector<32xbf16>, ui32, vector<32xbf16>
+  return %1 : vector<32xbf16>
+}
+
+// CHECK-LABEL: @bf16_sgt_sel
+// CHECK-SAME: %[[LHS:.*]]: vector<32xbf16>,
+// CHECK-SAME: %[[RHS:.*]]: vector<32xbf16>
+// CHECK: %[[MASK:.*]] = "xllvm.intr.aie2.vltbf16"(
+// CHECK-SAME: %[[RHS]], %[[LHS]]) :
+// CHECK-SAME: (vector<32xbf16>, vector<32xbf16>) -> i32
+// CHECK-NEXT: %[[LHSI16:.*]] = llvm.bitcast %[[LHS]] : vector<32xbf16> to vector<32xi16>
+// CHECK-NEXT: %[[RHSI16:.*]] = llvm.bitcast %[[RHS]] : vector<32xbf16> to vector<32xi16>
+// CHECK-NEXT: %[[SEL:.*]] = "xllvm.intr.aie2.vsel16"(
+// CHECK-SAME: %[[LHSI16]], %[[RHSI16]], %[[MASK]]) :
+// CHECK-SAME: (vector<32xi16>, vector<32xi16>, i32) -> vector<32xi16>
+// CHECK-NEXT: %[[RES:.*]] = llvm.bitcast %[[SEL]] : vector<32xi16> to vector<32xbf16>
+// CHECK-NEXT: return %[[RES]] : vector<32xbf16>
+
+// -----
+
+// The lane mask of a select with a constant condition, as built for the
+// LLVM IR backend.
+func.func @i32_const_mask_sel(%lhs : vector<16xi32>, %rhs : vector<16xi32>) -> vector<16xi32> {
+  %bits = arith.constant 15 : i32
+  %0 = builtin.unrealized_conversion_cast %bits : i32 to ui32
+  %1 = aievec.sel %lhs, %rhs, %0 : vector<16xi32>, vector<16xi32>, ui32, vector<16xi32>
+  return %1 : vector<16xi32>
+}
+
+// CHECK-LABEL: @i32_const_mask_sel
+// CHECK-SAME: %[[LHS:.*]]: vector<16xi32>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xi32>
+// CHECK: arith.constant 15 : i32
+// CHECK: %[[MASK:.*]] = builtin.unrealized_conversion_cast %{{.*}} : ui32 to i32
+// CHECK: %[[SEL:.*]] = "xllvm.intr.aie2.vsel32"(
+// CHECK-SAME: %[[LHS]], %[[RHS]], %[[MASK]]) :
+// CHECK-SAME: (vector<16xi32>, vector<16xi32>, i32) -> vector<16xi32>
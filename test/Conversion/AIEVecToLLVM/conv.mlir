@@ -0,0 +1,76 @@
+// RUN: aie-opt %s -split-input-file -convert-aievec-to-llvm | FileCheck %s
+
+// -----
+
+func.func @i8_mul_conv(%lhs : vector<64xi8>, %rhs : vector<64xi8>) -> vector<32xi32> {
+  %0 = aievec.mul_conv %lhs, %rhs {M = 32 : i32, N = 8 : i32} : vector<64xi8>, vector<64xi8>, vector<32xi32>
+  return %0 : vector<32xi32>
+}
+
+// CHECK-LABEL: @i8_mul_conv
+// CHECK-SAME: %[[LHS:.*]]: vector<64xi8>,
+// CHECK-SAME: %[[RHS:.*]]: vector<64xi8>
+// CHECK: %[[CONF:.*]] = llvm.mlir.constant(840 : i32) : i32
+// CHECK-NEXT: %[[BITCAST:.*]] = llvm.bitcast %[[RHS]] : vector<64xi8> to vector<16xi32>
+// CHECK-NEXT: %[[MUL:.*]] = "xllvm.intr.aie2.I512.I512.acc32.mul.conf"(
+// CHECK-SAME: %[[LHS]], %[[BITCAST]], %[[CONF]]) :
+// CHECK-SAME: (vector<64xi8>, vector<16xi32>, i32) -> vector<16xi64>
+// CHECK-NEXT: %[[RES:.*]] = llvm.bitcast %[[MUL]] : vector<16xi64> to vector<32xi32>
+// CHECK-NEXT: return %[[RES]] : vector<32xi32>
+
+// -----
+
+func.func @i16_mul_conv(%lhs : vector<32xi16>, %rhs : vector<32xi16>) -> vector<16xi64> {
+  %0 = aievec.mul_conv %lhs, %rhs {M = 16 : i32, N = 4 : i32} : vector<32xi16>, vector<32xi16>, vector<16xi64>
+  return %0 : vector<16xi64>
+}
+
+// CHECK-LABEL: @i16_mul_conv
+// CHECK-SAME: %[[LHS:.*]]: vector<32xi16>,
+// CHECK-SAME: %[[RHS:.*]]: vector<32xi16>
+// CHECK: %[[CONF:.*]] = llvm.mlir.constant(890 : i32) : i32
+// CHECK-NEXT: %[[BITCAST0:.*]] = llvm.bitcast %[[LHS]] : vector<32xi16> to vector<64xi8>
+// CHECK-NEXT: %[[BITCAST1:.*]] = llvm.bitcast %[[RHS]] : vector<32xi16> to vector<16xi32>
+// CHECK-NEXT: %[[MUL:.*]] = "xllvm.intr.aie2.I512.I512.acc64.mul.conf"(
+// CHECK-SAME: %[[BITCAST0]], %[[BITCAST1]], %[[CONF]]) :
+// CHECK-SAME: (vector<64xi8>, vector<16xi32>, i32) -> vector<16xi64>
+// CHECK-NEXT: return %[[MUL]] : vector<16xi64>
+
+// -----
+
+func.func @i8_fma_conv(%lhs : vector<64xi8>, %rhs : vector<64xi8>, %acc : vector<32xi32>) -> vector<32xi32> {
+  %0 = aievec.fma_conv %lhs, %rhs, %acc {M = 32 : i32, N = 8 : i32} : vector<64xi8>, vector<64xi8>, vector<32xi32>
+  return %0 : vector<32xi32>
+}
+
+// CHECK-LABEL: @i8_fma_conv
+// CHECK-SAME: %[[LHS:.*]]: vector<64xi8>,
+// CHECK-SAME: %[[RHS:.*]]: vector<64xi8>,
+// CHECK-SAME: %[[ACC:.*]]: vector<32xi32>
+// CHECK: %[[CONF:.*]] = llvm.mlir.constant(840 : i32) : i32
+// CHECK-NEXT: %[[BITCAST0:.*]] = llvm.bitcast %[[RHS]] : vector<64xi8> to vector<16xi32>
+// CHECK-NEXT: %[[BITCAST1:.*]] = llvm.bitcast %[[ACC]] : vector<32xi32> to vector<16xi64>
+// CHECK-NEXT: %[[MAC:.*]] = "xllvm.intr.aie2.I512.I512.ACC1024.acc32.mac.conf"(
+// CHECK-SAME: %[[LHS]], %[[BITCAST0]], %[[BITCAST1]], %[[CONF]]) :
+// CHECK-SAME: (vector<64xi8>, vector<16xi32>, vector<16xi64>, i32) -> vector<16xi64>
+// CHECK-NEXT: %[[RES:.*]] = llvm.bitcast %[[MAC]] : vector<16xi64> to vector<32xi32>
+// CHECK-NEXT: return %[[RES]] : vector<32xi32>
+
+// -----
+
+func.func @i16_fmsub_conv(%lhs : vector<32xi16>, %rhs : vector<32xi16>, %acc : vector<16xi64>) -> vector<16xi64> {
+  %0 = aievec.fma_conv %lhs, %rhs, %acc {M = 16 : i32, N = 4 : i32, fmsub = true} : vector<32xi16>, vector<32xi16>, vector<16xi64>
+  return %0 : vector<16xi64>
+}
+
+// CHECK-LABEL: @i16_fmsub_conv
+// CHECK-SAME: %[[LHS:.*]]: vector<32xi16>,
+// CHECK-SAME: %[[RHS:.*]]: vector<32xi16>,
+// CHECK-SAME: %[[ACC:.*]]: vector<16xi64>
+// CHECK: %[[CONF:.*]] = llvm.mlir.constant(2938 : i32) : i32
+// CHECK-NEXT: %[[BITCAST0:.*]] = llvm.bitcast %[[LHS]] : vector<32xi16> to vector<64xi8>
+// CHECK-NEXT: %[[BITCAST1:.*]] = llvm.bitcast %[[RHS]] : vector<32xi16> to vector<16xi32>
+// CHECK-NEXT: %[[MAC:.*]] = "xllvm.intr.aie2.I512.I512.ACC1024.acc64.mac.conf"(
+// CHECK-SAME: %[[BITCAST0]], %[[BITCAST1]], %[[ACC]], %[[CONF]]) :
+// CHECK-SAME: (vector<64xi8>, vector<16xi32>, vector<16xi64>, i32) -> vector<16xi64>
+// CHECK-NEXT: return %[[MAC]] : vector<16xi64>
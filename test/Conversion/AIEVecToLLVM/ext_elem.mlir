@@ -0,0 +1,74 @@
+// RUN: aie-opt %s -split-input-file -convert-aievec-to-llvm | FileCheck %s
+
+// -----
+
+func.func @i8_ext_elem(%arg0 : vector<64xi8>, %idx : i32) -> i8 {
+  %0 = aievec.ext_elem %arg0, %idx : vector<64xi8>, i32, i8
+  return %0 : i8
+}
+
+// CHECK-LABEL: @i8_ext_elem
+// CHECK-SAME: %[[ARG0:.*]]: vector<64xi8>,
+// CHECK-SAME: %[[IDX:.*]]: i32
+// CHECK: %[[SIGN:.*]] = llvm.mlir.constant(1 : i32) : i32
+// CHECK-NEXT: %[[EXT:.*]] = "xllvm.intr.aie2.vextract.elem8.I512"(
+// CHECK-SAME: %[[ARG0]], %[[IDX]], %[[SIGN]]) :
+// CHECK-SAME: (vector<64xi8>, i32, i32) -> i32
+// CHECK-NEXT: %[[RES:.*]] = llvm.trunc %[[EXT]] : i32 to i8
+// CHECK-NEXT: return %[[RES]] : i8
+
+// -----
+
+func.func @i32_ext_elem(%arg0 : vector<16xi32>, %idx : i32) -> i32 {
+  %0 = aievec.ext_elem %arg0, %idx : vector<16xi32>, i32, i32
+  return %0 : i32
+}
+
+// CHECK-LABEL: @i32_ext_elem
+// CHECK-SAME: %[[ARG0:.*]]: vector<16xi32>,
+// CHECK-SAME: %[[IDX:.*]]: i32
+// CHECK: %[[SIGN:.*]] = llvm.mlir.constant(1 : i32) : i32
+// CHECK-NEXT: %[[EXT:.*]] = "xllvm.intr.aie2.vextract.elem32.I512"(
+// CHECK-SAME: %[[ARG0]], %[[IDX]], %[[SIGN]]) :
+// CHECK-SAME: (vector<16xi32>, i32, i32) -> i32
+// CHECK-NEXT: return %[[EXT]] : i32
+
+// -----
+
+func.func @i16_256b_ext_elem(%arg0 : vector<16xi16>, %idx : i32) -> i16 {
+  %0 = aievec.ext_elem %arg0, %idx : vector<16xi16>, i32, i16
+  return %0 : i16
+}
+
+// CHECK-LABEL: @i16_256b_ext_elem
+// CHECK-SAME: %[[ARG0:.*]]: vector<16xi16>,
+// CHECK-SAME: %[[IDX:.*]]: i32
+// CHECK: %[[SIGN:.*]] = llvm.mlir.constant(1 : i32) : i32
+// CHECK: %[[BITCAST0:.*]] = llvm.bitcast %[[ARG0]] : vector<16xi16> to vector<8xi32>
+// CHECK-NEXT: %[[SET:.*]] = "xllvm.intr.aie2.set.I512.I256"(%[[BITCAST0]], %{{.*}}) :
+// CHECK-SAME: (vector<8xi32>, i32) -> vector<16xi32>
+// CHECK-NEXT: %[[BITCAST1:.*]] = llvm.bitcast %[[SET]] : vector<16xi32> to vector<32xi16>
+// CHECK-NEXT: %[[EXT:.*]] = "xllvm.intr.aie2.vextract.elem16.I512"(
+// CHECK-SAME: %[[BITCAST1]], %[[IDX]], %[[SIGN]]) :
+// CHECK-SAME: (vector<32xi16>, i32, i32) -> i32
+// CHECK-NEXT: %[[RES:.*]] = llvm.trunc %[[EXT]] : i32 to i16
+// CHECK-NEXT: return %[[RES]] : i16
+
+// -----
+
+func.func @bf16_ext_elem(%arg0 : vector<32xbf16>, %idx : i32) -> bf16 {
+  %0 = aievec.ext_elem %arg0, %idx : vector<32xbf16>, i32, bf16
+  return %0 : bf16
+}
+
+// CHECK-LABEL: @bf16_ext_elem
+// CHECK-SAME: %[[ARG0:.*]]: vector<32xbf16>,
+// CHECK-SAME: %[[IDX:.*]]: i32
+// CHECK: %[[SIGN:.*]] = llvm.mlir.constant(1 : i32) : i32
+// CHECK-NEXT: %[[BITCAST:.*]] = llvm.bitcast %[[ARG0]] : vector<32xbf16> to vector<32xi16>
+// CHECK-NEXT: %[[EXT:.*]] = "xllvm.intr.aie2.vextract.elem16.I512"(
+// CHECK-SAME: %[[BITCAST]], %[[IDX]], %[[SIGN]]) :
+// CHECK-SAME: (vector<32xi16>, i32, i32) -> i32
+// CHECK-NEXT: %[[TRUNC:.*]] = llvm.trunc %[[EXT]] : i32 to i16
+// CHECK-NEXT: %[[RES:.*]] = llvm.bitcast %[[TRUNC]] : i16 to bf16
+// CHECK-NEXT: return %[[RES]] : bf16
@@ -0,0 +1,32 @@
+// RUN: aie-opt %s -split-input-file -convert-aievec-to-llvm | FileCheck %s
+
+// -----
+
+func.func @i4_unpack(%arg0 : vector<64xi4>) -> vector<64xi8> {
+  %0 = aievec.unpack %arg0 : vector<64xi4>, vector<64xi8>
+  return %0 : vector<64xi8>
+}
+
+// CHECK-LABEL: @i4_unpack
+// CHECK-SAME: %[[ARG0:.*]]: vector<64xi4>
+// CHECK: %[[SIGN:.*]] = llvm.mlir.constant(1 : i32) : i32
+// CHECK-NEXT: %[[BITCAST:.*]] = llvm.bitcast %[[ARG0]] : vector<64xi4> to vector<32xi8>
+// CHECK-NEXT: %[[UNPACK:.*]] = "xllvm.intr.aie2.unpack.I8.I4"(
+// CHECK-SAME: %[[BITCAST]], %[[SIGN]]) :
+// CHECK-SAME: (vector<32xi8>, i32) -> vector<64xi8>
+// CHECK-NEXT: return %[[UNPACK]] : vector<64xi8>
+
+// -----
+
+func.func @i8_unpack(%arg0 : vector<32xi8>) -> vector<32xi16> {
+  %0 = aievec.unpack %arg0 : vector<32xi8>, vector<32xi16>
+  return %0 : vector<32xi16>
+}
+
+// CHECK-LABEL: @i8_unpack
+// CHECK-SAME: %[[ARG0:.*]]: vector<32xi8>
+// CHECK: %[[SIGN:.*]] = llvm.mlir.constant(1 : i32) : i32
+// CHECK-NEXT: %[[UNPACK:.*]] = "xllvm.intr.aie2.unpack.I16.I8"(
+// CHECK-SAME: %[[ARG0]], %[[SIGN]]) :
+// CHECK-SAME: (vector<32xi8>, i32) -> vector<32xi16>
+// CHECK-NEXT: return %[[UNPACK]] : vector<32xi16>
@@ -175,3 +175,57 @@ func.func @contracti64i64i64(%A : vector<4x2xi32>,
   return %2 : vector<4x4xi64>
 }
 
+
+// CHECK-LABEL: func.func @contracti4i8i32(
+// CHECK-SAME: %[[A:[a-zA-Z0-9]+]]: vector<4x8xi4>,
+// CHECK-SAME: %[[B:[a-zA-Z0-9]+]]: vector<8x8xi8>,
+// CHECK-SAME: %[[C:[a-zA-Z0-9]+]]: vector<4x8xi32>) -> vector<4x8xi32> {
+// CHECK:        %[[FA:.*]] = vector.shape_cast %[[A]] : vector<4x8xi4> to vector<32xi4>
+// CHECK:        %[[CA:.*]] = aievec.concat %[[FA]], %[[FA]] : vector<32xi4>, vector<64xi4>
+// CHECK:        %[[UA:.*]] = aievec.unpack %[[CA]] : vector<64xi4>, vector<64xi8>
+// CHECK:        %[[EA:.*]] = aievec.ext %[[UA]] {index = 0 : i8} : vector<64xi8>, vector<32xi8>
+// CHECK:        %[[WA:.*]] = vector.shape_cast %[[EA]] : vector<32xi8> to vector<4x8xi8>
+// CHECK:        %[[MM:.*]] = aievec.matmul %[[WA]], %[[B]], %{{.*}} :
+// CHECK-SAME:   vector<4x8xi8>, vector<8x8xi8> into vector<4x8xi32>
+
+// CHECK-LLVM-LABEL: func.func @contracti4i8i32(
+// CHECK-LLVM:        aievec.unpack {{.*}} : vector<64xi4>, vector<64xi8>
+// CHECK-LLVM:        aievec.matmul {{.*}} : vector<4x8xi8>, vector<8x8xi8> into vector<4x8xi32>
+func.func @contracti4i8i32(%A : vector<4x8xi4>,
+                           %B : vector<8x8xi8>,
+                           %C : vector<4x8xi32>) -> vector<4x8xi32> {
+  %0 = arith.extsi %A : vector<4x8xi4> to vector<4x8xi32>
+  %1 = arith.extsi %B : vector<8x8xi8> to vector<8x8xi32>
+  %2 = vector.contract {indexing_maps = [#map1, #map2, #map3],
+                        iterator_types = ["parallel", "parallel", "reduction"],
+                        kind = #vector.kind<add>} %0, %1, %C :
+                        vector<4x8xi32>, vector<8x8xi32> into vector<4x8xi32>
+  return %2 : vector<4x8xi32>
+}
+
+// CHECK-LABEL: func.func @contracti8i16i32(
+// CHECK-SAME: %[[A:[a-zA-Z0-9]+]]: vector<4x2xi8>,
+// CHECK-SAME: %[[B:[a-zA-Z0-9]+]]: vector<2x8xi16>,
+// CHECK-SAME: %[[C:[a-zA-Z0-9]+]]: vector<4x8xi32>) -> vector<4x8xi32> {
+// CHECK:        %[[FA:.*]] = vector.shape_cast %[[A]] : vector<4x2xi8> to vector<8xi8>
+// CHECK:        %[[CA:.*]] = aievec.concat %[[FA]], %[[FA]], %[[FA]], %[[FA]] : vector<8xi8>, vector<32xi8>
+// CHECK:        %[[UA:.*]] = aievec.unpack %[[CA]] : vector<32xi8>, vector<32xi16>
+// CHECK:        %[[EA:.*]] = aievec.ext %[[UA]] {index = 0 : i8} : vector<32xi16>, vector<8xi16>
+// CHECK:        %[[WA:.*]] = vector.shape_cast %[[EA]] : vector<8xi16> to vector<4x2xi16>
+// CHECK:        %[[MM:.*]] = aievec.matmul %[[WA]], %[[B]], %{{.*}} :
+// CHECK-SAME:   vector<4x2xi16>, vector<2x8xi16> into vector<4x8xi32>
+
+// CHECK-LLVM-LABEL: func.func @contracti8i16i32(
+// CHECK-LLVM:        aievec.unpack {{.*}} : vector<32xi8>, vector<32xi16>
+// CHECK-LLVM:        aievec.matmul {{.*}} : vector<4x2xi16>, vector<2x8xi16> into vector<4x8xi32>
+func.func @contracti8i16i32(%A : vector<4x2xi8>,
+                            %B : vector<2x8xi16>,
+                            %C : vector<4x8xi32>) -> vector<4x8xi32> {
+  %0 = arith.extsi %A : vector<4x2xi8> to vector<4x2xi32>
+  %1 = arith.extsi %B : vector<2x8xi16> to vector<2x8xi32>
+  %2 = vector.contract {indexing_maps = [#map1, #map2, #map3],
+                        iterator_types = ["parallel", "parallel", "reduction"],
+                        kind = #vector.kind<add>} %0, %1, %C :
+                        vector<4x2xi32>, vector<2x8xi32> into vector<4x8xi32>
+  return %2 : vector<4x8xi32>
+}
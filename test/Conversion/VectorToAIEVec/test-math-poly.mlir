@@ -0,0 +1,76 @@
+// RUN: aie-opt %s --convert-vector-to-aievec="aie-target=aieml math-approx=poly" | FileCheck %s
+// RUN: aie-opt %s --convert-vector-to-aievec="aie-target=aieml math-approx=poly math-approx-order=3" | FileCheck %s --check-prefix=ORDER
+
+// CHECK: emitc.include "poly_approx_ops.h"
+
+// CHECK-LABEL: func @exp_v16bf16
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: vector<16xbf16>
+// CHECK: %[[R:.*]] = emitc.call_opaque "getExpBf16Poly"(%[[A]]) : (vector<16xbf16>) -> vector<16xbf16>
+// CHECK: return %[[R]]
+// ORDER-LABEL: func @exp_v16bf16
+// ORDER: emitc.call_opaque "getExpBf16Poly"(%{{.*}}) {template_args = [3 : i32]}
+func.func @exp_v16bf16(%a: vector<16xbf16>) -> vector<16xbf16> {
+  %0 = math.exp %a : vector<16xbf16>
+  return %0 : vector<16xbf16>
+}
+
+// CHECK-LABEL: func @exp_v32bf16
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: vector<32xbf16>
+// CHECK: emitc.call_opaque "getExpBf16Poly"(%[[A]]) : (vector<32xbf16>) -> vector<32xbf16>
+func.func @exp_v32bf16(%a: vector<32xbf16>) -> vector<32xbf16> {
+  %0 = math.exp %a : vector<32xbf16>
+  return %0 : vector<32xbf16>
+}
+
+// CHECK-LABEL: func @tanh_v16bf16
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: vector<16xbf16>
+// CHECK: emitc.call_opaque "getTanhBf16Poly"(%[[A]]) : (vector<16xbf16>) -> vector<16xbf16>
+// ORDER-LABEL: func @tanh_v16bf16
+// ORDER: emitc.call_opaque "getTanhBf16Poly"(%{{.*}}) {template_args = [3 : i32]}
+func.func @tanh_v16bf16(%a: vector<16xbf16>) -> vector<16xbf16> {
+  %0 = math.tanh %a : vector<16xbf16>
+  return %0 : vector<16xbf16>
+}
+
+// CHECK-LABEL: func @erf_v32bf16
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: vector<32xbf16>
+// CHECK: emitc.call_opaque "getErfBf16Poly"(%[[A]]) : (vector<32xbf16>) -> vector<32xbf16>
+func.func @erf_v32bf16(%a: vector<32xbf16>) -> vector<32xbf16> {
+  %0 = math.erf %a : vector<32xbf16>
+  return %0 : vector<32xbf16>
+}
+
+// CHECK-LABEL: func @rsqrt_v16bf16
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: vector<16xbf16>
+// CHECK: emitc.call_opaque "getRsqrtBf16Poly"(%[[A]]) : (vector<16xbf16>) -> vector<16xbf16>
+func.func @rsqrt_v16bf16(%a: vector<16xbf16>) -> vector<16xbf16> {
+  %0 = math.rsqrt %a : vector<16xbf16>
+  return %0 : vector<16xbf16>
+}
+
+// CHECK-LABEL: func @sigmoid_v16bf16
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: vector<16xbf16>
+// CHECK: %[[R:.*]] = emitc.call_opaque "getSigmoidBf16Poly"(%[[A]]) : (vector<16xbf16>) -> vector<16xbf16>
+// CHECK: return %[[R]]
+// ORDER-LABEL: func @sigmoid_v16bf16
+// ORDER: emitc.call_opaque "getSigmoidBf16Poly"(%{{.*}}) {template_args = [3 : i32]}
+func.func @sigmoid_v16bf16(%a: vector<16xbf16>) -> vector<16xbf16> {
+  %cst = arith.constant dense<1.000000e+00> : vector<16xbf16>
+  %0 = arith.negf %a : vector<16xbf16>
+  %1 = math.exp %0 : vector<16xbf16>
+  %2 = arith.addf %1, %cst : vector<16xbf16>
+  %3 = arith.divf %cst, %2 : vector<16xbf16>
+  return %3 : vector<16xbf16>
+}
+
+// CHECK-LABEL: func @inv_f32
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: f32
+// CHECK-NOT: arith.divf
+// CHECK: %[[R:.*]] = emitc.call_opaque "getInvBf16Poly"(%[[A]]) : (f32) -> bf16
+// CHECK: return %[[R]]
+func.func @inv_f32(%a: f32) -> bf16 {
+  %cst = arith.constant 1.000000e+00 : f32
+  %0 = arith.divf %cst, %a : f32
+  %1 = arith.truncf %0 : f32 to bf16
+  return %1 : bf16
+}
@@ -347,3 +347,15 @@ func.func @reduce_max_bf16(%arg0: vector<32xbf16>) -> bf16 {
   // CHECK: return %[[EXTELEM]] : bf16
   return %0 : bf16
 }
+
+// CHECK-LABEL:func @reduce_add_i32_acc
+// CHECK-SAME: %[[SRC:.*]]: vector<16xi32>, %[[ACC:.*]]: i32
+func.func @reduce_add_i32_acc(%arg0: vector<16xi32>, %arg1: i32) -> i32 {
+  // CHECK: %[[ADD4:.*]] = aievec.add_elem
+  // CHECK: %[[EXTELEM:.*]] = aievec.ext_elem %[[ADD4]], %{{.*}} : vector<16xi32>, i32, i32
+  // CHECK: %[[SUM:.*]] = arith.addi
+  // CHECK-SAME: %[[ACC]]
+  %0 = vector.reduction <add>, %arg0, %arg1 : vector<16xi32> into i32
+  // CHECK: return %[[SUM]] : i32
+  return %0 : i32
+}
@@ -1,4 +1,5 @@
 // RUN: aie-opt %s --convert-vector-to-aievec="aie-target=aieml" | FileCheck %s
+// RUN: aie-opt %s --convert-vector-to-aievec="aie-target=aieml target-backend=llvmir" | FileCheck %s --check-prefix=LLVM
 
 // CHECK-LABEL:func @vecsel_i32
 // CHECK-SAME: %[[LHS:.*]]: vector<16xi32>,
@@ -119,3 +120,18 @@ func.func @vecsel_f32_unsigned_cmp(%arg0: vector<16xf32>, %arg1: vector<16xf32>)
   // CHECK: return %[[SEL]] : vector<16xf32>
   return %1 : vector<16xf32>
 }
+
+// CHECK-LABEL:func @vecsel_i32_const_mask
+// CHECK-SAME: %[[LHS:.*]]: vector<16xi32>,
+// CHECK-SAME: %[[RHS:.*]]: vector<16xi32>)
+func.func @vecsel_i32_const_mask(%arg0: vector<16xi32>, %arg1: vector<16xi32>) -> vector<16xi32> {
+  // CHECK: %[[MASK:.*]] = {{.*}}emitc.constant{{.*}}15 : ui32
+  // CHECK: %[[SEL:.*]] = aievec.sel %[[LHS]], %[[RHS]], %[[MASK]] : vector<16xi32>, vector<16xi32>, ui32, vector<16xi32>
+  // LLVM: %[[BITS:.*]] = arith.constant 15 : i32
+  // LLVM: %[[MASK:.*]] = builtin.unrealized_conversion_cast %[[BITS]] : i32 to ui32
+  // LLVM: aievec.sel %{{.*}}, %{{.*}}, %[[MASK]] : vector<16xi32>, vector<16xi32>, ui32, vector<16xi32>
+  %mask = arith.constant dense<[true, true, true, true, false, false, false, false, false, false, false, false, false, false, false, false]> : vector<16xi1>
+  %0 = arith.select %mask, %arg0, %arg1 : vector<16xi1>, vector<16xi32>
+  // CHECK: return %[[SEL]] : vector<16xi32>
+  return %0 : vector<16xi32>
+}
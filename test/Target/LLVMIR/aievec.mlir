@@ -105,6 +105,16 @@ llvm.func @vector_set_256b_into_512b(%v : vector<8xi32>) -> vector<16xi32> {
     llvm.return %1 : vector<16xi32>
 }
 
+// ----- UPS ----- 
+
+// CHECK-LABEL: define <8 x i64> @ups_v16bf16_to_v16accfloat
+llvm.func @ups_v16bf16_to_v16accfloat(%v : vector<16xbf16>) -> vector<8xi64> {
+    // CHECK: call <8 x i64> @llvm.aie2.v16bf16.to.v16accfloat(
+    // CHECK-SAME: <16 x bfloat> %{{[0-9]+}})
+    %0 = "xllvm.intr.aie2.v16bf16.to.v16accfloat"(%v) : (vector<16xbf16>) -> vector<8xi64>
+    llvm.return %0 : vector<8xi64>
+}
+
 // ----- SRS ----- 
 
 // CHECK-LABEL: define <32 x i16> @srs_512b_v32_acc32
@@ -265,3 +275,61 @@ llvm.func @vextract_elem32_i512(%a : vector<16xi32>, %idx : i32, %sign : i32) ->
     %0 = "xllvm.intr.aie2.vextract.elem32.I512"(%a, %idx, %sign) : (vector<16xi32>, i32, i32) -> i32
     llvm.return %0 : i32
 }
+
+// ----- MAX/MIN ----- 
+
+// CHECK-LABEL: define <64 x i8> @vmax_lt8
+llvm.func @vmax_lt8(%a : vector<64xi8>, %b : vector<64xi8>, %sign : i32) -> vector<64xi8> {
+    // CHECK: call { <64 x i8>, <2 x i32> } @llvm.aie2.vmax.lt8(
+    // CHECK-SAME: <64 x i8> %{{[0-9]+}}, <64 x i8> %{{[0-9]+}}, i32 %{{[0-9]+}})
+    %0 = "xllvm.intr.aie2.vmax.lt8"(%a, %b, %sign) : (vector<64xi8>, vector<64xi8>, i32) -> !llvm.struct<(vector<64xi8>, vector<2xi32>)>
+    %1 = llvm.extractvalue %0[0] : !llvm.struct<(vector<64xi8>, vector<2xi32>)>
+    llvm.return %1 : vector<64xi8>
+}
+
+// CHECK-LABEL: define <32 x bfloat> @vmin_gebf16
+llvm.func @vmin_gebf16(%a : vector<32xbf16>, %b : vector<32xbf16>) -> vector<32xbf16> {
+    // CHECK: call { <32 x bfloat>, i32 } @llvm.aie2.vmin.gebf16(
+    // CHECK-SAME: <32 x bfloat> %{{[0-9]+}}, <32 x bfloat> %{{[0-9]+}})
+    %0 = "xllvm.intr.aie2.vmin.gebf16"(%a, %b) : (vector<32xbf16>, vector<32xbf16>) -> !llvm.struct<(vector<32xbf16>, i32)>
+    %1 = llvm.extractvalue %0[0] : !llvm.struct<(vector<32xbf16>, i32)>
+    llvm.return %1 : vector<32xbf16>
+}
+
+// ----- COMPARE ----- 
+
+// CHECK-LABEL: define <2 x i32> @vlt8
+llvm.func @vlt8(%a : vector<64xi8>, %b : vector<64xi8>, %sign : i32) -> vector<2xi32> {
+    // CHECK: call <2 x i32> @llvm.aie2.vlt8(
+    // CHECK-SAME: <64 x i8> %{{[0-9]+}}, <64 x i8> %{{[0-9]+}}, i32 %{{[0-9]+}})
+    %0 = "xllvm.intr.aie2.vlt8"(%a, %b, %sign) : (vector<64xi8>, vector<64xi8>, i32) -> vector<2xi32>
+    llvm.return %0 : vector<2xi32>
+}
+
+// CHECK-LABEL: define i32 @vge32
+llvm.func @vge32(%a : vector<16xi32>, %b : vector<16xi32>, %sign : i32) -> i32 {
+    // CHECK: call i32 @llvm.aie2.vge32(
+    // CHECK-SAME: <16 x i32> %{{[0-9]+}}, <16 x i32> %{{[0-9]+}}, i32 %{{[0-9]+}})
+    %0 = "xllvm.intr.aie2.vge32"(%a, %b, %sign) : (vector<16xi32>, vector<16xi32>, i32) -> i32
+    llvm.return %0 : i32
+}
+
+// ----- SELECT ----- 
+
+// CHECK-LABEL: define <32 x i16> @vsel16
+llvm.func @vsel16(%a : vector<32xi16>, %b : vector<32xi16>, %sel : i32) -> vector<32xi16> {
+    // CHECK: call <32 x i16> @llvm.aie2.vsel16(
+    // CHECK-SAME: <32 x i16> %{{[0-9]+}}, <32 x i16> %{{[0-9]+}}, i32 %{{[0-9]+}})
+    %0 = "xllvm.intr.aie2.vsel16"(%a, %b, %sel) : (vector<32xi16>, vector<32xi16>, i32) -> vector<32xi16>
+    llvm.return %0 : vector<32xi16>
+}
+
+// ----- ACCUMULATOR ADD/SUB ----- 
+
+// CHECK-LABEL: define <8 x i64> @add_accfloat
+llvm.func @add_accfloat(%a : vector<8xi64>, %b : vector<8xi64>, %conf : i32) -> vector<8xi64> {
+    // CHECK: call <8 x i64> @llvm.aie2.add.accfloat(
+    // CHECK-SAME: <8 x i64> %{{[0-9]+}}, <8 x i64> %{{[0-9]+}}, i32 %{{[0-9]+}})
+    %0 = "xllvm.intr.aie2.add.accfloat"(%a, %b, %conf) : (vector<8xi64>, vector<8xi64>, i32) -> vector<8xi64>
+    llvm.return %0 : vector<8xi64>
+}
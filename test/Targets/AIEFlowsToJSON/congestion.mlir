@@ -0,0 +1,45 @@
+//===- congestion.mlir -----------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-create-pathfinder-flows=annotate-congestion=true %s | FileCheck %s --check-prefix=IR
+// RUN: aie-opt --aie-create-pathfinder-flows=annotate-congestion=true --aie-find-flows %s | aie-translate --aie-flows-to-json | FileCheck %s
+
+// IR: aie.congestion = [{{.*}}{bundle = "North", demand = {{.*}}, max_capacity = 6 : i32, over_capacity_count = 0 : i32, used_capacity = 1 : i32}
+
+// The flow leaves the switchbox of (1, 2) to the north, with the 64 bytes of
+// the BD of MM2S channel 0 every iteration.
+// CHECK: "switchbox12": {
+// CHECK: "northbound": 1,
+// CHECK: "channels": {
+// CHECK: "North": {"used": 1, "capacity": 6, "utilization": 0.167, "bytes_per_iteration": 64, "used_capacity": 1, "max_capacity": 6, "over_capacity_count": 0, "demand": {{[0-9.]+}}}
+// CHECK: "switchbox13": {
+// CHECK: "North": {"used": 1, "capacity": 6, "utilization": 0.167, "bytes_per_iteration": 64,
+// CHECK: "South": {"used": 0, "capacity": 4, "utilization": 0.000, "bytes_per_iteration": 0,
+// CHECK: "route0": [
+// CHECK: "flows": [
+// CHECK-NEXT: {"route": "route0", "source": [1, 2], "bytes_per_iteration": 64}
+
+module {
+  aie.device(npu) {
+    %tile_1_2 = aie.tile(1, 2)
+    %tile_1_3 = aie.tile(1, 3)
+    %tile_1_4 = aie.tile(1, 4)
+    %buf = aie.buffer(%tile_1_2) {sym_name = "buf"} : memref<16xi32>
+    aie.flow(%tile_1_2, DMA : 0, %tile_1_4, DMA : 0)
+    %mem_1_2 = aie.mem(%tile_1_2) {
+      %0 = aie.dma_start(MM2S, 0, ^bb1, ^bb2)
+    ^bb1:
+      aie.dma_bd(%buf : memref<16xi32>, 0, 16)
+      aie.next_bd ^bb1
+    ^bb2:
+      aie.end
+    }
+  }
+}
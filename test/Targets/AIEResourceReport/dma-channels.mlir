@@ -0,0 +1,30 @@
+//===- dma-channels.mlir ---------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-translate --aie-generate-resource-report %s | FileCheck %s
+
+// A shim PL tile has no DMA, so it has neither MM2S nor S2MM channels.
+
+// CHECK: "tiles": [
+// CHECK: "dma_mm2s": {
+// CHECK-NEXT: "available": 0,
+// CHECK-NEXT: "used": 0
+// CHECK-NEXT: },
+// CHECK-NEXT: "dma_s2mm": {
+// CHECK-NEXT: "available": 0,
+// CHECK-NEXT: "used": 0
+// CHECK-NEXT: },
+// CHECK-NEXT: "kind": "shim_pl",
+
+module {
+  aie.device(npu) {
+    %tile_4_0 = aie.tile(4, 0)
+  }
+}
@@ -0,0 +1,24 @@
+//===- html-escape.mlir ----------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-translate --aie-generate-resource-report --resource-report-html %s | FileCheck %s
+
+// Symbol names are escaped in the HTML report.
+
+// CHECK: <h2>ObjectFifos</h2>
+// CHECK: <tr><td>in&lt;&quot;a&amp;b&quot;&gt;</td><td>(1, 2)</td><td>(1, 3)</td><td>2</td><td>2</td></tr>
+
+module {
+  aie.device(npu) {
+    %tile_1_2 = aie.tile(1, 2)
+    %tile_1_3 = aie.tile(1, 3)
+    aie.objectfifo @"in<\"a&b\">"(%tile_1_2, {%tile_1_3}, 2 : i32) : !aie.objectfifo<memref<16xi32>>
+  }
+}
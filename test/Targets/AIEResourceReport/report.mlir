@@ -0,0 +1,122 @@
+//===- report.mlir ---------------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-translate --aie-generate-resource-report %s | FileCheck %s
+// RUN: aie-translate --aie-generate-resource-report --resource-report-html %s | FileCheck %s --check-prefix=HTML
+
+// CHECK: "devices": [
+// CHECK: "bottlenecks": [
+// CHECK-NEXT: {
+// CHECK-NEXT: "available": 2,
+// CHECK-NEXT: "resource": "dma_s2mm",
+// CHECK-NEXT: "tile": [
+// CHECK-NEXT: 1,
+// CHECK-NEXT: 2
+// CHECK-NEXT: ],
+// CHECK-NEXT: "used": 2,
+// CHECK-NEXT: "utilization": 1
+// CHECK: "device": "npu"
+
+// The flow from the shim DMA goes through the switchboxes of the shim, the
+// memory tile and the core tile. The unrouted one needs at least two.
+// CHECK: "flows": [
+// CHECK: "dest": {
+// CHECK-NEXT: "bundle": "DMA",
+// CHECK-NEXT: "channel": 0,
+// CHECK: "hops": 3,
+// CHECK-NEXT: "routed": true,
+// CHECK-NEXT: "source": {
+// CHECK-NEXT: "bundle": "South",
+// CHECK-NEXT: "channel": 3,
+// CHECK: "hops": 2,
+// CHECK-NEXT: "routed": false,
+
+// CHECK: "objectfifos": [
+// CHECK: "consumer_depth": 3,
+// CHECK: "name": "of",
+// CHECK: "producer_depth": 2
+
+// CHECK: "tiles": [
+// CHECK: "kind": "shim_noc",
+// CHECK: "streams": {
+// CHECK: "North": {
+// CHECK: "out": {
+// CHECK-NEXT: "available": 6,
+// CHECK-NEXT: "used": 1
+// CHECK: "kind": "mem",
+// CHECK: "bds": {
+// CHECK-NEXT: "available": 16,
+// CHECK-NEXT: "used": 2
+// CHECK: "kind": "core",
+// CHECK: "locks": {
+// CHECK-NEXT: "available": 16,
+// CHECK-NEXT: "used": 2
+// The stack and @a share the first bank, @b is in the second one.
+// CHECK: "memory_banks": [
+// CHECK-NEXT: {
+// CHECK-NEXT: "available": 16384,
+// CHECK-NEXT: "used": 2048
+// CHECK-NEXT: },
+// CHECK-NEXT: {
+// CHECK-NEXT: "available": 16384,
+// CHECK-NEXT: "used": 1024
+// CHECK: "stack_size": 1024,
+// CHECK: "unassigned_bytes": 0
+
+// HTML: <title>AIE resource report</title>
+// HTML: <h1>npu</h1>
+// HTML: <tr><td>dma_s2mm</td><td>(1, 2)</td><td class="full">2 / 2</td><td>100.00%</td></tr>
+// HTML: <h2>Flows</h2>
+// HTML: <tr><td>(1, 0) South:3</td><td>(1, 2) DMA:0</td><td>3</td></tr>
+// HTML: <td>2 (unrouted)</td>
+// HTML: <tr><td>of</td><td>(1, 2)</td><td>(1, 3)</td><td>2</td><td>3</td></tr>
+
+module {
+  aie.device(npu) {
+    %tile_1_0 = aie.tile(1, 0)
+    %tile_1_1 = aie.tile(1, 1)
+    %tile_1_2 = aie.tile(1, 2)
+    %tile_1_3 = aie.tile(1, 3)
+    %a = aie.buffer(%tile_1_2) {address = 1024 : i32, sym_name = "a"} : memref<256xi32>
+    %b = aie.buffer(%tile_1_2) {address = 16384 : i32, sym_name = "b"} : memref<256xi32>
+    %prod = aie.lock(%tile_1_2, 0) {init = 1 : i32}
+    %cons = aie.lock(%tile_1_2, 1) {init = 0 : i32}
+    aie.objectfifo @of(%tile_1_2, {%tile_1_3}, [2, 3]) : !aie.objectfifo<memref<16xi32>>
+    %switchbox_1_0 = aie.switchbox(%tile_1_0) {
+      aie.connect<South : 3, North : 0>
+    }
+    %switchbox_1_1 = aie.switchbox(%tile_1_1) {
+      aie.connect<South : 0, North : 0>
+    }
+    %switchbox_1_2 = aie.switchbox(%tile_1_2) {
+      aie.connect<South : 0, DMA : 0>
+    }
+    aie.flow(%tile_1_2, DMA : 0, %tile_1_3, DMA : 0)
+    %core_1_2 = aie.core(%tile_1_2) {
+      aie.end
+    }
+    %mem_1_2 = aie.mem(%tile_1_2) {
+      %0 = aie.dma_start(S2MM, 0, ^bb1, ^bb2)
+    ^bb1:
+      aie.use_lock(%prod, AcquireGreaterEqual, 1)
+      aie.dma_bd(%a : memref<256xi32>, 0, 256)
+      aie.use_lock(%cons, Release, 1)
+      aie.next_bd ^bb1
+    ^bb2:
+      %1 = aie.dma_start(S2MM, 1, ^bb3, ^bb4)
+    ^bb3:
+      aie.dma_bd(%b : memref<256xi32>, 0, 256)
+      aie.next_bd ^bb3
+    ^bb4:
+      aie.end
+    }
+    aie.shim_dma_allocation @in(MM2S, 0, 1)
+  }
+}
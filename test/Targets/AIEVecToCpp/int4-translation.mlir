@@ -0,0 +1,19 @@
+// RUN: not aie-translate %s -aieml -aievec-to-cpp -split-input-file 2>&1 | FileCheck %s
+
+// Vectors of 4-bit elements are printed as AIE API vector types.
+
+// CHECK-LABEL: v64int8 unpack_i4(
+// CHECK-SAME:      v64int4 [[V:[a-zA-Z0-9]+]])
+// CHECK:         v64int8 [[R:[a-zA-Z0-9]+]] = unpack([[V]]);
+// CHECK:         return [[R]];
+func.func @unpack_i4(%v : vector<64xi4>) -> vector<64xi8> {
+  %0 = aievec.unpack %v : vector<64xi4>, vector<64xi8>
+  return %0 : vector<64xi8>
+}
+
+// -----
+
+// There is no C++ pointer type for 4-bit elements.
+
+// CHECK: error: cannot emit type memref<128xi4>: 4-bit elements are not addressable
+func.func private @external_i4(%m : memref<128xi4>)
@@ -0,0 +1,22 @@
+// RUN: aie-opt %s -aie-loop-hints="pipeline=false" | aie-translate --aievec-to-cpp | FileCheck %s
+
+// The bounds of the inner loop of a triangular nest come from the outer loop.
+
+// CHECK-LABEL: void triangular(
+// CHECK:       for (size_t [[I:.*]] = {{.*}}; [[I]] < {{.*}}; [[I]] += {{.*}})
+// CHECK-NEXT:  chess_prepare_for_pipelining
+// CHECK-NEXT:  chess_loop_range(64, 64)
+// CHECK:         for (size_t [[J:.*]] = {{.*}}; [[J]] < [[I]]; [[J]] += {{.*}})
+// CHECK-NEXT:    chess_prepare_for_pipelining
+// CHECK-NEXT:    chess_loop_range(0, 63)
+func.func @triangular(%A: memref<64x64xi32>, %v: i32) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c64 = arith.constant 64 : index
+  scf.for %i = %c0 to %c64 step %c1 {
+    scf.for %j = %c0 to %i step %c1 {
+      memref.store %v, %A[%i, %j] : memref<64x64xi32>
+    }
+  }
+  return
+}
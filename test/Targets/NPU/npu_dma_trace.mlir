@@ -0,0 +1,157 @@
+//===- npu_dma_trace.mlir --------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-translate --aie-npu-dma-trace %s | FileCheck %s
+
+module {
+  aie.device(npu) {
+    func.func @test0(%arg0: memref<64xi32>, %arg1: memref<64xi32>) {
+
+      // A 4x8 tile of a 4x16 matrix, sent twice.
+      // CHECK: task 0: col 0 mm2s 0 bd 1 repeat 1
+      // CHECK-NEXT: words 64 runs 8 min_run 8 max_run 8 avg_run 8.00
+      // CHECK-NEXT: aligned_128b 8 aligned_32b 0 beats_128b 16 efficiency 1.00
+      // CHECK-NEXT: ddr 0 offset 0 words 8
+      // CHECK-NEXT: ddr 0 offset 64 words 8
+      // CHECK-NEXT: ddr 0 offset 128 words 8
+      // CHECK-NEXT: ddr 0 offset 192 words 8
+      // CHECK-NEXT: ddr 0 offset 0 words 8
+      // CHECK-NEXT: ddr 0 offset 64 words 8
+      // CHECK-NEXT: ddr 0 offset 128 words 8
+      // CHECK-NEXT: ddr 0 offset 192 words 8
+      aiex.npu.writebd_shimtile { bd_id = 1 : i32,
+                                  buffer_length = 32 : i32,
+                                  buffer_offset = 0 : i32,
+                                  enable_packet = 0 : i32,
+                                  out_of_order_id = 0 : i32,
+                                  packet_id = 0 : i32,
+                                  packet_type = 0 : i32,
+                                  column = 0 : i32,
+                                  column_num = 1 : i32,
+                                  d0_stride = 0 : i32,
+                                  d0_size = 8 : i32,
+                                  d1_stride = 15 : i32,
+                                  d1_size = 4 : i32,
+                                  d2_stride = 0 : i32,
+                                  ddr_id = 0 : i32,
+                                  iteration_current = 0 : i32,
+                                  iteration_stride = 0 : i32,
+                                  iteration_size = 0 : i32,
+                                  lock_acq_enable = 0 : i32,
+                                  lock_acq_id = 0 : i32,
+                                  lock_acq_val = 0 : i32,
+                                  lock_rel_id = 0 : i32,
+                                  lock_rel_val = 0 : i32,
+                                  next_bd = 0 : i32,
+                                  use_next_bd = 0 : i32,
+                                  valid_bd = 1 : i32}
+      aiex.npu.write32 { column = 0 : i32, row = 0 : i32, address = 0x1D214 : ui32, value = 0x00010001 : ui32 }
+
+      // A linear transfer that does not start on a 128-bit boundary.
+      // CHECK: task 1: col 0 s2mm 1 bd 2 repeat 0
+      // CHECK-NEXT: words 6 runs 1 min_run 6 max_run 6 avg_run 6.00
+      // CHECK-NEXT: aligned_128b 0 aligned_32b 1 beats_128b 2 efficiency 0.75
+      // CHECK-NEXT: ddr 1 offset 4 words 6
+      aiex.npu.writebd_shimtile { bd_id = 2 : i32,
+                                  buffer_length = 6 : i32,
+                                  buffer_offset = 4 : i32,
+                                  enable_packet = 0 : i32,
+                                  out_of_order_id = 0 : i32,
+                                  packet_id = 0 : i32,
+                                  packet_type = 0 : i32,
+                                  column = 0 : i32,
+                                  column_num = 1 : i32,
+                                  d0_stride = 0 : i32,
+                                  d0_size = 0 : i32,
+                                  d1_stride = 0 : i32,
+                                  d1_size = 0 : i32,
+                                  d2_stride = 0 : i32,
+                                  ddr_id = 1 : i32,
+                                  iteration_current = 0 : i32,
+                                  iteration_stride = 0 : i32,
+                                  iteration_size = 0 : i32,
+                                  lock_acq_enable = 0 : i32,
+                                  lock_acq_id = 0 : i32,
+                                  lock_acq_val = 0 : i32,
+                                  lock_rel_id = 0 : i32,
+                                  lock_rel_val = 0 : i32,
+                                  next_bd = 0 : i32,
+                                  use_next_bd = 0 : i32,
+                                  valid_bd = 1 : i32}
+      aiex.npu.write32 { column = 0 : i32, row = 0 : i32, address = 0x1D20C : ui32, value = 0x80000002 : ui32 }
+
+      // The iteration dimension advances the base address on every execution
+      // and wraps after two iterations; the chained BD 4 follows each one.
+      // CHECK: task 2: col 0 mm2s 1 bd 3 repeat 2
+      // CHECK-NEXT: words 18 runs 6 min_run 2 max_run 4 avg_run 3.00
+      // CHECK-NEXT: aligned_128b 6 aligned_32b 0 beats_128b 6 efficiency 0.75
+      // CHECK-NEXT: ddr 0 offset 0 words 4
+      // CHECK-NEXT: ddr 1 offset 0 words 2
+      // CHECK-NEXT: ddr 0 offset 16 words 4
+      // CHECK-NEXT: ddr 1 offset 0 words 2
+      // CHECK-NEXT: ddr 0 offset 0 words 4
+      // CHECK-NEXT: ddr 1 offset 0 words 2
+      aiex.npu.writebd_shimtile { bd_id = 3 : i32,
+                                  buffer_length = 4 : i32,
+                                  buffer_offset = 0 : i32,
+                                  enable_packet = 0 : i32,
+                                  out_of_order_id = 0 : i32,
+                                  packet_id = 0 : i32,
+                                  packet_type = 0 : i32,
+                                  column = 0 : i32,
+                                  column_num = 1 : i32,
+                                  d0_stride = 0 : i32,
+                                  d0_size = 0 : i32,
+                                  d1_stride = 0 : i32,
+                                  d1_size = 0 : i32,
+                                  d2_stride = 0 : i32,
+                                  ddr_id = 0 : i32,
+                                  iteration_current = 0 : i32,
+                                  iteration_stride = 3 : i32,
+                                  iteration_size = 1 : i32,
+                                  lock_acq_enable = 0 : i32,
+                                  lock_acq_id = 0 : i32,
+                                  lock_acq_val = 0 : i32,
+                                  lock_rel_id = 0 : i32,
+                                  lock_rel_val = 0 : i32,
+                                  next_bd = 4 : i32,
+                                  use_next_bd = 1 : i32,
+                                  valid_bd = 1 : i32}
+      aiex.npu.writebd_shimtile { bd_id = 4 : i32,
+                                  buffer_length = 2 : i32,
+                                  buffer_offset = 0 : i32,
+                                  enable_packet = 0 : i32,
+                                  out_of_order_id = 0 : i32,
+                                  packet_id = 0 : i32,
+                                  packet_type = 0 : i32,
+                                  column = 0 : i32,
+                                  column_num = 1 : i32,
+                                  d0_stride = 0 : i32,
+                                  d0_size = 0 : i32,
+                                  d1_stride = 0 : i32,
+                                  d1_size = 0 : i32,
+                                  d2_stride = 0 : i32,
+                                  ddr_id = 1 : i32,
+                                  iteration_current = 0 : i32,
+                                  iteration_stride = 0 : i32,
+                                  iteration_size = 0 : i32,
+                                  lock_acq_enable = 0 : i32,
+                                  lock_acq_id = 0 : i32,
+                                  lock_acq_val = 0 : i32,
+                                  lock_rel_id = 0 : i32,
+                                  lock_rel_val = 0 : i32,
+                                  next_bd = 0 : i32,
+                                  use_next_bd = 0 : i32,
+                                  valid_bd = 1 : i32}
+      aiex.npu.write32 { column = 0 : i32, row = 0 : i32, address = 0x1D21C : ui32, value = 0x00020003 : ui32 }
+      return
+    }
+  }
+}
@@ -0,0 +1,61 @@
+//===- npu_instgen_relocate.mlir -------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-translate --aie-npu-instgen --npu-column-offset=2 %s | FileCheck %s
+// RUN: not aie-translate --aie-npu-instgen --npu-column-offset=-4 %s 2>&1 | FileCheck %s --check-prefix=ERROR
+
+// Only the column field of each instruction moves; the prolog is untouched.
+// CHECK:      00000011
+// CHECK:      000055FF
+// CHECK:      060504A6
+// CHECK-NEXT: 00000000
+// CHECK-NEXT: 00000001
+// CHECK:      02050400
+// CHECK-NEXT: ABC00DEF
+// CHECK-NEXT: 00000042
+// CHECK-NEXT: 03050401
+// CHECK-NEXT: 05010200
+
+// ERROR: cannot relocate NPU instructions: relocated column -1 is out of range
+module {
+  aie.device(npu) {
+    func.func @test0(%arg0: memref<16xf32>, %arg1: memref<16xf32>) {
+      aiex.npu.writebd_shimtile { bd_id = 6 : i32,
+                                  buffer_length = 1 : i32,
+                                  buffer_offset = 2 : i32,
+                                  enable_packet = 0 : i32,
+                                  out_of_order_id = 0 : i32,
+                                  packet_id = 0 : i32,
+                                  packet_type = 0 : i32,
+                                  column = 3 : i32,
+                                  column_num = 4 : i32,
+                                  d0_stride = 5 : i32,
+                                  d0_size = 6 : i32,
+                                  d1_stride = 7 : i32,
+                                  d1_size = 8 : i32,
+                                  d2_stride = 9 : i32,
+                                  ddr_id = 10 : i32,
+                                  iteration_current = 11 : i32,
+                                  iteration_stride = 12 : i32,
+                                  iteration_size = 13 : i32,
+                                  lock_acq_enable = 1 : i32,
+                                  lock_acq_id = 1 : i32,
+                                  lock_acq_val = 2 : i32,
+                                  lock_rel_id = 3 : i32,
+                                  lock_rel_val = 4 : i32,
+                                  next_bd = 5 : i32,
+                                  use_next_bd = 1 : i32,
+                                  valid_bd = 1 : i32}
+      aiex.npu.write32 { column = 3 : i32, row = 4 : i32, address = 0xabc00def : ui32, value = 0x42 : ui32 }
+      aiex.npu.sync { column = 3 : i32, row = 4 : i32, direction = 1 : i32, channel = 5 : i32, column_num = 1 : i32, row_num = 2 : i32 }
+      return
+    }
+  }
+}
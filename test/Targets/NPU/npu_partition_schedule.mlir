@@ -0,0 +1,48 @@
+//===- npu_partition_schedule.mlir -----------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-translate --aie-npu-partition-schedule --npu-schedule-runs=3 %s | FileCheck %s
+
+// Both designs were compiled for column 0. The wider one is placed first and
+// keeps its columns; the single column design is moved next to it. The
+// instruction stream of each design follows the last word of the prolog.
+
+// CHECK-LABEL: design0: columns 0-1 offset 0 executed 6
+// CHECK:         07BD9630
+// CHECK-NEXT:    000055FF
+// CHECK-NEXT:    02010000
+// CHECK-NEXT:    0001D214
+// CHECK-NEXT:    00000001
+// CHECK-NEXT:    03000000
+// CHECK-NEXT:    00010100
+// CHECK-LABEL: design1: columns 2-2 offset 2 executed 3
+// CHECK:         07BD9630
+// CHECK-NEXT:    000055FF
+// CHECK-NEXT:    02020000
+// CHECK-NEXT:    0001D204
+// CHECK-NEXT:    00000002
+module {
+  aie.device(npu) {
+    %tile_0_0 = aie.tile(0, 0)
+    %tile_1_0 = aie.tile(1, 0)
+    func.func @sequence() {
+      aiex.npu.write32 { column = 1 : i32, row = 0 : i32, address = 0x1d214 : ui32, value = 1 : ui32 }
+      aiex.npu.sync { column = 0 : i32, row = 0 : i32, direction = 0 : i32, channel = 0 : i32, column_num = 1 : i32, row_num = 1 : i32 }
+      return
+    }
+  }
+  aie.device(npu) {
+    %tile_0_0 = aie.tile(0, 0)
+    func.func @sequence() {
+      aiex.npu.write32 { column = 0 : i32, row = 0 : i32, address = 0x1d204 : ui32, value = 2 : ui32 }
+      return
+    }
+  }
+}
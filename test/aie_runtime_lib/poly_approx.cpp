@@ -0,0 +1,296 @@
+//===- poly_approx.cpp ------------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: %host_cxx -std=c++17 -O2 -I%AIE_SRC_ROOT/aie_runtime_lib/AIE2 %s -o %t
+// RUN: %t | FileCheck %s
+
+// Scalar model of poly_approx_ops.h, checked against libm for every
+// math-approx-order. Every value the vector code converts to bfloat16 is
+// rounded to bfloat16 here; accumulators stay in fp32. The model uses the
+// coefficients and constants of poly_approx_coeffs.h, so a change there is
+// caught without an AIE toolchain.
+
+#include "poly_approx_coeffs.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+
+using namespace poly_approx;
+
+namespace {
+
+float fromBits(uint32_t bits) {
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+uint32_t toBits(float f) {
+  uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  return bits;
+}
+
+// Round to the nearest bfloat16, ties to even.
+float bf16(float f) {
+  uint32_t bits = toBits(f);
+  bits += 0x7fff + ((bits >> 16) & 1);
+  return fromBits(bits & 0xffff0000);
+}
+
+float fromBf16Bits(uint16_t bits) { return fromBits(uint32_t(bits) << 16); }
+uint16_t toBf16Bits(float f) { return toBits(bf16(f)) >> 16; }
+
+// horner() accumulates in fp32 and feeds the accumulator back as bfloat16.
+template <unsigned N> float horner(const float (&c)[N], float x) {
+  float acc = c[N - 1];
+  for (int i = N - 2; i >= 0; i--)
+    acc = c[i] + bf16(acc) * x;
+  return acc;
+}
+
+template <unsigned Steps> float inv(float d) {
+  float y = fromBf16Bits(uint16_t(invSeedBf16 - toBf16Bits(d)));
+  for (unsigned i = 0; i < Steps; i++)
+    y = bf16(bf16(2.0f - d * y) * y);
+  return y;
+}
+
+template <unsigned Steps> float rsqrt(float x) {
+  float y = fromBf16Bits(uint16_t(rsqrtSeedBf16 - (toBf16Bits(x) >> 1)));
+  float halfX = bf16(x * 0.5f);
+  for (unsigned i = 0; i < Steps; i++) {
+    float y2 = bf16(y * y);
+    y = bf16(bf16(1.5f - halfX * y2) * y);
+  }
+  return y;
+}
+
+template <unsigned Order> float exp(float x) {
+  x = std::max(std::min(x, bf16(expMax)), bf16(expMin));
+  float t = x * bf16(log2e);
+  int32_t n = int32_t(std::nearbyint(bf16(t)));
+  float nBf16 = bf16(float(n));
+  float r = x - nBf16 * bf16(ln2Hi);
+  r = r - nBf16 * bf16(ln2Lo);
+  float p = horner(ExpCoeffs<Order>::c, bf16(r));
+  return bf16(fromBits(toBits(p) + (uint32_t(n) << 23)));
+}
+
+template <unsigned Order> float tanh(float x) {
+  float ax = std::min(std::fabs(x), 9.0f);
+  float e = exp<Order>(bf16(ax * 2.0f));
+  float q = inv<getNewtonSteps(Order)>(bf16(e + 1.0f));
+  float large = bf16(1.0f - q * 2.0f);
+  if (x < 0)
+    large = -large;
+  float x2 = bf16(x * x);
+  float small = bf16(bf16(horner(TanhCoeffs<Order>::c, x2)) * x);
+  return ax < 0.5f ? small : large;
+}
+
+template <unsigned Order> float sigmoid(float x) {
+  x = std::max(std::min(x, 20.0f), -20.0f);
+  float e = exp<Order>(-x);
+  return inv<getNewtonSteps(Order)>(bf16(e + 1.0f));
+}
+
+template <unsigned Order> float erf(float x) {
+  using Coeffs = ErfCoeffs<Order>;
+  float ax = std::min(std::fabs(x), 4.0f);
+  float d = bf16(1.0f + ax * bf16(Coeffs::p));
+  float t = inv<getNewtonSteps(Order)>(d);
+  float tp = bf16(bf16(horner(Coeffs::c, t)) * t);
+  float e = exp<Order>(-bf16(ax * ax));
+  float y = bf16(1.0f - tp * e);
+  if (x < 0)
+    y = -y;
+  float x2 = bf16(x * x);
+  float small = bf16(bf16(horner(ErfSmallCoeffs<Order>::c, x2)) * x);
+  return ax < 0.5f ? small : y;
+}
+
+// getInvBf16Poly, with the fp32 seed of getInvBf16.
+template <unsigned Order> float invScalar(float x) {
+  float y = fromBits(invSeedF32 - toBits(x));
+  for (unsigned i = 0; i < getNewtonSteps(Order); i++)
+    y = y * (2.0f - x * y);
+  return bf16(y);
+}
+
+// Largest error of `f` relative to `ref` over every bfloat16 in [lo, hi].
+// AIE2 flushes subnormals, so only normal inputs are checked.
+double maxError(const std::function<float(float)> &f, double (*ref)(double),
+                float lo, float hi) {
+  double worst = 0;
+  for (uint32_t bits = 0; bits < 0x10000; bits++) {
+    float x = fromBf16Bits(bits);
+    if (!std::isnormal(x) || x < lo || x > hi)
+      continue;
+    double expected = ref(x);
+    worst = std::max(worst, std::fabs(f(x) - expected) / std::fabs(expected));
+  }
+  return worst;
+}
+
+double refExp(double x) { return std::exp(x); }
+double refTanh(double x) { return std::tanh(x); }
+double refSigmoid(double x) { return 1 / (1 + std::exp(-x)); }
+double refErf(double x) { return std::erf(x); }
+double refInv(double x) { return 1 / x; }
+double refRsqrt(double x) { return 1 / std::sqrt(x); }
+
+bool failed = false;
+
+void report(const char *name, unsigned order, double err, double bound) {
+  bool ok = err <= bound;
+  failed |= !ok;
+  std::printf("%s order %u: %s (error %.3g, bound %.3g)\n", name, order,
+              ok ? "ok" : "FAILED", err, bound);
+}
+
+// Error of the polynomials alone against the functions they approximate,
+// evaluated in double on their fitting intervals.
+template <unsigned N> double poly(const float (&c)[N], double x) {
+  double acc = 0;
+  for (int i = N - 1; i >= 0; i--)
+    acc = acc * x + c[i];
+  return acc;
+}
+
+double factorial(unsigned n) { return n < 2 ? 1 : n * factorial(n - 1); }
+
+// Taylor coefficients of tanh(x) / x in powers of x^2.
+const double tanhTaylor[] = {1,          -1.0 / 3,      2.0 / 15,
+                             -17.0 / 315, 62.0 / 2835, -1382.0 / 155925};
+
+template <unsigned Order> void checkCoefficients() {
+  // The exp polynomial of degree n interpolates at Chebyshev nodes on
+  // [-h, h], h = ln2, so its error is at most max|exp^(n+1)| h^(n+1) /
+  // (2^n (n+1)!); max|exp^(n+1)| = 2 and exp >= 1/2 on the interval.
+  double h = M_LN2;
+  double expBound =
+      4 * std::pow(h, Order + 1) / (std::pow(2, Order) * factorial(Order + 1));
+  // The tanh and erf series on [-0.5, 0.5] are at least as accurate as their
+  // truncated alternating Taylor series, whose error is below the first
+  // omitted term, up to one float ulp for rounding the coefficients. The
+  // relative error of the term is largest at x = 0.5, where tanh(x) / x and
+  // erf(x) / (2/sqrt(pi) x) are at least tanh(0.5) / 0.5 and 1 - 0.5^2 / 3.
+  double x0 = 0.5;
+  double tanhBound = std::fabs(tanhTaylor[Order]) * std::pow(x0, 2 * Order) *
+                         (x0 / std::tanh(x0)) +
+                     0x1p-23;
+  double erfSmallBound = std::pow(x0, 2 * Order) /
+                             (factorial(Order) * (2 * Order + 1)) /
+                             (1 - x0 * x0 / 3) +
+                         0x1p-23;
+  double expErr = 0, tanhErr = 0, erfSmallErr = 0, erfErr = 0;
+  for (int i = -1000; i <= 1000; i++) {
+    double r = h * i / 1000;
+    expErr = std::max(
+        expErr, std::fabs(poly(ExpCoeffs<Order>::c, r) / std::exp(r) - 1));
+    double x = x0 * i / 1000;
+    if (x != 0) {
+      double y = x * poly(TanhCoeffs<Order>::c, x * x);
+      tanhErr = std::max(tanhErr, std::fabs(y / std::tanh(x) - 1));
+      y = x * poly(ErfSmallCoeffs<Order>::c, x * x);
+      erfSmallErr = std::max(erfSmallErr, std::fabs(y / std::erf(x) - 1));
+    }
+    double ax = 4.0 * (i + 1000) / 2000;
+    double t = 1 / (1 + ErfCoeffs<Order>::p * ax);
+    double y = 1 - t * poly(ErfCoeffs<Order>::c, t) * std::exp(-ax * ax);
+    erfErr = std::max(erfErr, std::fabs(y - std::erf(ax)));
+  }
+  report("exp polynomial", Order, expErr, expBound);
+  report("tanh polynomial", Order, tanhErr, tanhBound);
+  report("erf series", Order, erfSmallErr, erfSmallBound);
+  report("erf rational", Order, erfErr, ErfCoeffs<Order>::maxError);
+}
+
+// Relative errors of the complete functions, including the bfloat16
+// roundings, against the bounds documented in poly_approx_ops.h: eight
+// bfloat16 ulps at order 2 and two from order 3 on.
+template <unsigned Order> void checkFunctions() {
+  const double bound = Order == 2 ? 0x1p-4 : 0x1p-6;
+  report("exp", Order, maxError(exp<Order>, refExp, expMin, expMax), bound);
+  report("tanh", Order, maxError(tanh<Order>, refTanh, -100, 100), bound);
+  report("sigmoid", Order, maxError(sigmoid<Order>, refSigmoid, -20, 20),
+         bound);
+  report("erf", Order, maxError(erf<Order>, refErf, -100, 100), bound);
+  double invErr =
+      std::max(maxError(invScalar<Order>, refInv, 0x1p-125f, 0x1p125f),
+               maxError(invScalar<Order>, refInv, -0x1p125f, -0x1p-125f));
+  report("inv", Order, invErr, bound);
+  report("rsqrt", Order,
+         maxError(rsqrt<getNewtonSteps(Order)>, refRsqrt, 0x1p-120f, 0x1p120f),
+         bound);
+}
+
+template <unsigned Order> void check() {
+  checkCoefficients<Order>();
+  checkFunctions<Order>();
+}
+
+} // namespace
+
+int main() {
+  check<2>();
+  check<3>();
+  check<4>();
+  check<5>();
+  std::printf(failed ? "TEST FAILED\n" : "TEST PASSED\n");
+  return failed;
+}
+
+// CHECK: exp polynomial order 2: ok
+// CHECK-NEXT: tanh polynomial order 2: ok
+// CHECK-NEXT: erf series order 2: ok
+// CHECK-NEXT: erf rational order 2: ok
+// CHECK-NEXT: exp order 2: ok
+// CHECK-NEXT: tanh order 2: ok
+// CHECK-NEXT: sigmoid order 2: ok
+// CHECK-NEXT: erf order 2: ok
+// CHECK-NEXT: inv order 2: ok
+// CHECK-NEXT: rsqrt order 2: ok
+// CHECK-NEXT: exp polynomial order 3: ok
+// CHECK-NEXT: tanh polynomial order 3: ok
+// CHECK-NEXT: erf series order 3: ok
+// CHECK-NEXT: erf rational order 3: ok
+// CHECK-NEXT: exp order 3: ok
+// CHECK-NEXT: tanh order 3: ok
+// CHECK-NEXT: sigmoid order 3: ok
+// CHECK-NEXT: erf order 3: ok
+// CHECK-NEXT: inv order 3: ok
+// CHECK-NEXT: rsqrt order 3: ok
+// CHECK-NEXT: exp polynomial order 4: ok
+// CHECK-NEXT: tanh polynomial order 4: ok
+// CHECK-NEXT: erf series order 4: ok
+// CHECK-NEXT: erf rational order 4: ok
+// CHECK-NEXT: exp order 4: ok
+// CHECK-NEXT: tanh order 4: ok
+// CHECK-NEXT: sigmoid order 4: ok
+// CHECK-NEXT: erf order 4: ok
+// CHECK-NEXT: inv order 4: ok
+// CHECK-NEXT: rsqrt order 4: ok
+// CHECK-NEXT: exp polynomial order 5: ok
+// CHECK-NEXT: tanh polynomial order 5: ok
+// CHECK-NEXT: erf series order 5: ok
+// CHECK-NEXT: erf rational order 5: ok
+// CHECK-NEXT: exp order 5: ok
+// CHECK-NEXT: tanh order 5: ok
+// CHECK-NEXT: sigmoid order 5: ok
+// CHECK-NEXT: erf order 5: ok
+// CHECK-NEXT: inv order 5: ok
+// CHECK-NEXT: rsqrt order 5: ok
+// CHECK-NEXT: TEST PASSED
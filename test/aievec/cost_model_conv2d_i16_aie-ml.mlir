@@ -0,0 +1,262 @@
+// RUN: aie-opt %s -affine-super-vectorize="virtual-vector-size=16" --aie-vectorize="shift=10 zero-offset=4 cost-model=true" -aieml=true -canonicalize -split-input-file | FileCheck %s
+// RUN: aie-opt %s -affine-super-vectorize="virtual-vector-size=16" --aie-vectorize="shift=10 zero-offset=4 cost-model=true" -aieml=true -split-input-file -debug-only=aie-vect 2>&1 >/dev/null | FileCheck %s --check-prefix=REPORT
+// REQUIRES: asserts
+
+// The cost model keeps the default conv scheme: three mul_conv/fma_conv ops
+// in place of six multiply-accumulates.
+
+// REPORT-LABEL: aie-vectorize: conv2d nest 0
+//       REPORT:   * fuse-columns=1 fuse-conv=1: cycles=
+//       REPORT:     fuse-columns=1 fuse-conv=0: cycles=
+
+func.func @conv2d (%A: memref<18x288xi16>, %B: memref<12xi16>, %C: memref<16x256xi16>) {
+    affine.for %arg3 = 0 to 16 {
+        affine.for %arg4 = 0 to 256 {
+            //First row
+            //first point 
+            %a11 = affine.load %A[%arg3, %arg4+0] : memref<18x288xi16>
+            %b11 = affine.load %B[0] : memref<12xi16>
+            %p11 = arith.muli %a11, %b11 : i16
+
+            //second point 
+            %a12 = affine.load %A[%arg3, %arg4+1] : memref<18x288xi16>
+            %b12 = affine.load %B[1] : memref<12xi16>
+            %p12 = arith.muli %a12, %b12 : i16
+            %c12 = arith.addi %p11, %p12 : i16
+
+            //third point 
+            %a13 = affine.load %A[%arg3, %arg4+2] : memref<18x288xi16>
+            %b13 = affine.load %B[2] : memref<12xi16>
+            %p13 = arith.muli %a13, %b13 : i16
+            %c13 = arith.addi %c12, %p13 : i16
+
+            //Second row
+            //first point 
+            %a21 = affine.load %A[%arg3+1, %arg4+0] : memref<18x288xi16>
+            %b21 = affine.load %B[4] : memref<12xi16>
+            %p21 = arith.muli %a21, %b21 : i16
+            %c21 = arith.addi %c13, %p21 : i16
+
+            //second point 
+            %a22 = affine.load %A[%arg3+1, %arg4+1] : memref<18x288xi16>
+            %b22 = affine.load %B[5] : memref<12xi16>
+            %p22 = arith.muli %a22, %b22 : i16
+            %c22 = arith.addi %c21, %p22 : i16
+
+            //third point 
+            %a23 = affine.load %A[%arg3+1, %arg4+2] : memref<18x288xi16>
+            %b23 = affine.load %B[6] : memref<12xi16>
+            %p23 = arith.muli %a23, %b23 : i16
+            %c23 = arith.addi %c22, %p23 : i16
+
+            //Third row
+            //first point 
+            %a31 = affine.load %A[%arg3+2, %arg4+0] : memref<18x288xi16>
+            %b31 = affine.load %B[8] : memref<12xi16>
+            %p31 = arith.muli %a31, %b31 : i16
+            %c31 = arith.addi %c23, %p31 : i16
+
+            //second point 
+            %a32 = affine.load %A[%arg3+2, %arg4+1] : memref<18x288xi16>
+            %b32 = affine.load %B[9] : memref<12xi16>
+            %p32 = arith.muli %a32, %b32 : i16
+            %c32 = arith.addi %c31, %p32 : i16
+
+            //third point 
+            %a33 = affine.load %A[%arg3+2, %arg4+2] : memref<18x288xi16>
+            %b33 = affine.load %B[10] : memref<12xi16>
+            %p33 = arith.muli %a33, %b33 : i16
+            %c33 = arith.addi %c32, %p33 : i16
+
+            //Store accumulated sum
+            affine.store %c33, %C[%arg3, %arg4] : memref<16x256xi16>
+        }
+    }
+    return
+}
+
+// CHECK-LABEL: @conv2d
+//       CHECK:   scf.for
+//       CHECK:     scf.for
+//       CHECK:       aievec.mul_conv {{.*}} {M = 16 : i32, N = 4 : i32}
+//       CHECK:       aievec.fma_conv {{.*}} {M = 16 : i32, N = 4 : i32}
+//       CHECK:       aievec.fma_conv {{.*}} {M = 16 : i32, N = 4 : i32}
+//   CHECK-NOT:       aievec.mac_elem
+//       CHECK:       aievec.srs
+
+// -----
+
+// Sixteen rows with the same three coefficients. The conv scheme keeps a
+// 512-bit copy of the coefficients live for each row, which overflows the
+// vector registers, so plain 16x2 multiply-accumulates are cheaper.
+
+// REPORT-LABEL: aie-vectorize: conv2d_rows nest 0
+//       REPORT:     fuse-columns=1 fuse-conv=1: cycles={{[0-9]+}} {{.*}} spills={{[1-9][0-9]*}}
+//       REPORT:   * fuse-columns=1 fuse-conv=0: cycles={{[0-9]+}} {{.*}} spills=0
+//       REPORT:     fuse-columns=0 fuse-conv=1:
+//       REPORT:     fuse-columns=0 fuse-conv=0:
+
+func.func @conv2d_rows (%A: memref<32x288xi16>, %B: memref<16xi16>, %C: memref<16x256xi16>) {
+    affine.for %arg3 = 0 to 16 {
+        affine.for %arg4 = 0 to 256 {
+            %b0 = affine.load %B[0] : memref<16xi16>
+            %b1 = affine.load %B[1] : memref<16xi16>
+            %b2 = affine.load %B[2] : memref<16xi16>
+            %a0_0 = affine.load %A[%arg3, %arg4+0] : memref<32x288xi16>
+            %p0_0 = arith.muli %a0_0, %b0 : i16
+            %a0_1 = affine.load %A[%arg3, %arg4+1] : memref<32x288xi16>
+            %p0_1 = arith.muli %a0_1, %b1 : i16
+            %c0_1 = arith.addi %p0_0, %p0_1 : i16
+            %a0_2 = affine.load %A[%arg3, %arg4+2] : memref<32x288xi16>
+            %p0_2 = arith.muli %a0_2, %b2 : i16
+            %c0_2 = arith.addi %c0_1, %p0_2 : i16
+            %a1_0 = affine.load %A[%arg3+1, %arg4+0] : memref<32x288xi16>
+            %p1_0 = arith.muli %a1_0, %b0 : i16
+            %c1_0 = arith.addi %c0_2, %p1_0 : i16
+            %a1_1 = affine.load %A[%arg3+1, %arg4+1] : memref<32x288xi16>
+            %p1_1 = arith.muli %a1_1, %b1 : i16
+            %c1_1 = arith.addi %c1_0, %p1_1 : i16
+            %a1_2 = affine.load %A[%arg3+1, %arg4+2] : memref<32x288xi16>
+            %p1_2 = arith.muli %a1_2, %b2 : i16
+            %c1_2 = arith.addi %c1_1, %p1_2 : i16
+            %a2_0 = affine.load %A[%arg3+2, %arg4+0] : memref<32x288xi16>
+            %p2_0 = arith.muli %a2_0, %b0 : i16
+            %c2_0 = arith.addi %c1_2, %p2_0 : i16
+            %a2_1 = affine.load %A[%arg3+2, %arg4+1] : memref<32x288xi16>
+            %p2_1 = arith.muli %a2_1, %b1 : i16
+            %c2_1 = arith.addi %c2_0, %p2_1 : i16
+            %a2_2 = affine.load %A[%arg3+2, %arg4+2] : memref<32x288xi16>
+            %p2_2 = arith.muli %a2_2, %b2 : i16
+            %c2_2 = arith.addi %c2_1, %p2_2 : i16
+            %a3_0 = affine.load %A[%arg3+3, %arg4+0] : memref<32x288xi16>
+            %p3_0 = arith.muli %a3_0, %b0 : i16
+            %c3_0 = arith.addi %c2_2, %p3_0 : i16
+            %a3_1 = affine.load %A[%arg3+3, %arg4+1] : memref<32x288xi16>
+            %p3_1 = arith.muli %a3_1, %b1 : i16
+            %c3_1 = arith.addi %c3_0, %p3_1 : i16
+            %a3_2 = affine.load %A[%arg3+3, %arg4+2] : memref<32x288xi16>
+            %p3_2 = arith.muli %a3_2, %b2 : i16
+            %c3_2 = arith.addi %c3_1, %p3_2 : i16
+            %a4_0 = affine.load %A[%arg3+4, %arg4+0] : memref<32x288xi16>
+            %p4_0 = arith.muli %a4_0, %b0 : i16
+            %c4_0 = arith.addi %c3_2, %p4_0 : i16
+            %a4_1 = affine.load %A[%arg3+4, %arg4+1] : memref<32x288xi16>
+            %p4_1 = arith.muli %a4_1, %b1 : i16
+            %c4_1 = arith.addi %c4_0, %p4_1 : i16
+            %a4_2 = affine.load %A[%arg3+4, %arg4+2] : memref<32x288xi16>
+            %p4_2 = arith.muli %a4_2, %b2 : i16
+            %c4_2 = arith.addi %c4_1, %p4_2 : i16
+            %a5_0 = affine.load %A[%arg3+5, %arg4+0] : memref<32x288xi16>
+            %p5_0 = arith.muli %a5_0, %b0 : i16
+            %c5_0 = arith.addi %c4_2, %p5_0 : i16
+            %a5_1 = affine.load %A[%arg3+5, %arg4+1] : memref<32x288xi16>
+            %p5_1 = arith.muli %a5_1, %b1 : i16
+            %c5_1 = arith.addi %c5_0, %p5_1 : i16
+            %a5_2 = affine.load %A[%arg3+5, %arg4+2] : memref<32x288xi16>
+            %p5_2 = arith.muli %a5_2, %b2 : i16
+            %c5_2 = arith.addi %c5_1, %p5_2 : i16
+            %a6_0 = affine.load %A[%arg3+6, %arg4+0] : memref<32x288xi16>
+            %p6_0 = arith.muli %a6_0, %b0 : i16
+            %c6_0 = arith.addi %c5_2, %p6_0 : i16
+            %a6_1 = affine.load %A[%arg3+6, %arg4+1] : memref<32x288xi16>
+            %p6_1 = arith.muli %a6_1, %b1 : i16
+            %c6_1 = arith.addi %c6_0, %p6_1 : i16
+            %a6_2 = affine.load %A[%arg3+6, %arg4+2] : memref<32x288xi16>
+            %p6_2 = arith.muli %a6_2, %b2 : i16
+            %c6_2 = arith.addi %c6_1, %p6_2 : i16
+            %a7_0 = affine.load %A[%arg3+7, %arg4+0] : memref<32x288xi16>
+            %p7_0 = arith.muli %a7_0, %b0 : i16
+            %c7_0 = arith.addi %c6_2, %p7_0 : i16
+            %a7_1 = affine.load %A[%arg3+7, %arg4+1] : memref<32x288xi16>
+            %p7_1 = arith.muli %a7_1, %b1 : i16
+            %c7_1 = arith.addi %c7_0, %p7_1 : i16
+            %a7_2 = affine.load %A[%arg3+7, %arg4+2] : memref<32x288xi16>
+            %p7_2 = arith.muli %a7_2, %b2 : i16
+            %c7_2 = arith.addi %c7_1, %p7_2 : i16
+            %a8_0 = affine.load %A[%arg3+8, %arg4+0] : memref<32x288xi16>
+            %p8_0 = arith.muli %a8_0, %b0 : i16
+            %c8_0 = arith.addi %c7_2, %p8_0 : i16
+            %a8_1 = affine.load %A[%arg3+8, %arg4+1] : memref<32x288xi16>
+            %p8_1 = arith.muli %a8_1, %b1 : i16
+            %c8_1 = arith.addi %c8_0, %p8_1 : i16
+            %a8_2 = affine.load %A[%arg3+8, %arg4+2] : memref<32x288xi16>
+            %p8_2 = arith.muli %a8_2, %b2 : i16
+            %c8_2 = arith.addi %c8_1, %p8_2 : i16
+            %a9_0 = affine.load %A[%arg3+9, %arg4+0] : memref<32x288xi16>
+            %p9_0 = arith.muli %a9_0, %b0 : i16
+            %c9_0 = arith.addi %c8_2, %p9_0 : i16
+            %a9_1 = affine.load %A[%arg3+9, %arg4+1] : memref<32x288xi16>
+            %p9_1 = arith.muli %a9_1, %b1 : i16
+            %c9_1 = arith.addi %c9_0, %p9_1 : i16
+            %a9_2 = affine.load %A[%arg3+9, %arg4+2] : memref<32x288xi16>
+            %p9_2 = arith.muli %a9_2, %b2 : i16
+            %c9_2 = arith.addi %c9_1, %p9_2 : i16
+            %a10_0 = affine.load %A[%arg3+10, %arg4+0] : memref<32x288xi16>
+            %p10_0 = arith.muli %a10_0, %b0 : i16
+            %c10_0 = arith.addi %c9_2, %p10_0 : i16
+            %a10_1 = affine.load %A[%arg3+10, %arg4+1] : memref<32x288xi16>
+            %p10_1 = arith.muli %a10_1, %b1 : i16
+            %c10_1 = arith.addi %c10_0, %p10_1 : i16
+            %a10_2 = affine.load %A[%arg3+10, %arg4+2] : memref<32x288xi16>
+            %p10_2 = arith.muli %a10_2, %b2 : i16
+            %c10_2 = arith.addi %c10_1, %p10_2 : i16
+            %a11_0 = affine.load %A[%arg3+11, %arg4+0] : memref<32x288xi16>
+            %p11_0 = arith.muli %a11_0, %b0 : i16
+            %c11_0 = arith.addi %c10_2, %p11_0 : i16
+            %a11_1 = affine.load %A[%arg3+11, %arg4+1] : memref<32x288xi16>
+            %p11_1 = arith.muli %a11_1, %b1 : i16
+            %c11_1 = arith.addi %c11_0, %p11_1 : i16
+            %a11_2 = affine.load %A[%arg3+11, %arg4+2] : memref<32x288xi16>
+            %p11_2 = arith.muli %a11_2, %b2 : i16
+            %c11_2 = arith.addi %c11_1, %p11_2 : i16
+            %a12_0 = affine.load %A[%arg3+12, %arg4+0] : memref<32x288xi16>
+            %p12_0 = arith.muli %a12_0, %b0 : i16
+            %c12_0 = arith.addi %c11_2, %p12_0 : i16
+            %a12_1 = affine.load %A[%arg3+12, %arg4+1] : memref<32x288xi16>
+            %p12_1 = arith.muli %a12_1, %b1 : i16
+            %c12_1 = arith.addi %c12_0, %p12_1 : i16
+            %a12_2 = affine.load %A[%arg3+12, %arg4+2] : memref<32x288xi16>
+            %p12_2 = arith.muli %a12_2, %b2 : i16
+            %c12_2 = arith.addi %c12_1, %p12_2 : i16
+            %a13_0 = affine.load %A[%arg3+13, %arg4+0] : memref<32x288xi16>
+            %p13_0 = arith.muli %a13_0, %b0 : i16
+            %c13_0 = arith.addi %c12_2, %p13_0 : i16
+            %a13_1 = affine.load %A[%arg3+13, %arg4+1] : memref<32x288xi16>
+            %p13_1 = arith.muli %a13_1, %b1 : i16
+            %c13_1 = arith.addi %c13_0, %p13_1 : i16
+            %a13_2 = affine.load %A[%arg3+13, %arg4+2] : memref<32x288xi16>
+            %p13_2 = arith.muli %a13_2, %b2 : i16
+            %c13_2 = arith.addi %c13_1, %p13_2 : i16
+            %a14_0 = affine.load %A[%arg3+14, %arg4+0] : memref<32x288xi16>
+            %p14_0 = arith.muli %a14_0, %b0 : i16
+            %c14_0 = arith.addi %c13_2, %p14_0 : i16
+            %a14_1 = affine.load %A[%arg3+14, %arg4+1] : memref<32x288xi16>
+            %p14_1 = arith.muli %a14_1, %b1 : i16
+            %c14_1 = arith.addi %c14_0, %p14_1 : i16
+            %a14_2 = affine.load %A[%arg3+14, %arg4+2] : memref<32x288xi16>
+            %p14_2 = arith.muli %a14_2, %b2 : i16
+            %c14_2 = arith.addi %c14_1, %p14_2 : i16
+            %a15_0 = affine.load %A[%arg3+15, %arg4+0] : memref<32x288xi16>
+            %p15_0 = arith.muli %a15_0, %b0 : i16
+            %c15_0 = arith.addi %c14_2, %p15_0 : i16
+            %a15_1 = affine.load %A[%arg3+15, %arg4+1] : memref<32x288xi16>
+            %p15_1 = arith.muli %a15_1, %b1 : i16
+            %c15_1 = arith.addi %c15_0, %p15_1 : i16
+            %a15_2 = affine.load %A[%arg3+15, %arg4+2] : memref<32x288xi16>
+            %p15_2 = arith.muli %a15_2, %b2 : i16
+            %c15_2 = arith.addi %c15_1, %p15_2 : i16
+            affine.store %c15_2, %C[%arg3, %arg4] : memref<16x256xi16>
+        }
+    }
+    return
+}
+
+// CHECK-LABEL: @conv2d_rows
+//       CHECK:   scf.for
+//       CHECK:     scf.for
+//   CHECK-NOT:       aievec.mul_conv
+//   CHECK-NOT:       aievec.fma_conv
+//       CHECK:       aievec.mul %
+//   CHECK-NOT:       aievec.mul_conv
+//   CHECK-NOT:       aievec.fma_conv
+//       CHECK:       aievec.srs
@@ -0,0 +1,49 @@
+// RUN: aie-opt %s -affine-super-vectorize="virtual-vector-size=32" --aie-vectorize="aieml=true report-reuse=true" 2>&1 | FileCheck %s
+// RUN: aie-opt %s -affine-super-vectorize="virtual-vector-size=16" --aie-vectorize="aieml=true report-reuse=true" 2>&1 | FileCheck %s --check-prefix=V16
+
+// A 1x3 max filter. The three windows of each row are derived from a single
+// interval vector with shifts instead of being loaded one by one.
+func.func @max3(%A: memref<16x288xi16>, %C: memref<16x256xi16>) {
+  affine.for %i = 0 to 16 {
+    affine.for %j = 0 to 256 {
+      %a0 = affine.load %A[%i, %j] : memref<16x288xi16>
+      %a1 = affine.load %A[%i, %j + 1] : memref<16x288xi16>
+      %a2 = affine.load %A[%i, %j + 2] : memref<16x288xi16>
+      %m0 = arith.maxsi %a0, %a1 : i16
+      %m1 = arith.maxsi %m0, %a2 : i16
+      affine.store %m1, %C[%i, %j] : memref<16x256xi16>
+    }
+  }
+  return
+}
+
+// CHECK: remark: vector loads per iteration: 4 with reuse, 10 without (6 saved)
+// CHECK-LABEL: func.func @max3
+//   CHECK-DAG: %[[C2:.*]] = arith.constant 2 : i32
+//   CHECK-DAG: %[[C4:.*]] = arith.constant 4 : i32
+//       CHECK: scf.for
+//       CHECK:   scf.for
+//       CHECK:     %[[U0:.*]] = aievec.upd {{.*}} {index = 0 : i8, offset = 0 : i32} : memref<16x288xi16>, vector<64xi16>
+//       CHECK:     %[[W0:.*]] = aievec.ext %[[U0]] {index = 0 : i8} : vector<64xi16>, vector<32xi16>
+//       CHECK:     %[[U1:.*]] = aievec.upd {{.*}}, %[[U0]] {index = 1 : i8, {{.*}}} : memref<16x288xi16>, vector<64xi16>
+//   CHECK-DAG:     %[[LO:.*]] = aievec.ext %[[U1]] {index = 0 : i8} : vector<64xi16>, vector<32xi16>
+//   CHECK-DAG:     %[[HI:.*]] = aievec.ext %[[U1]] {index = 1 : i8} : vector<64xi16>, vector<32xi16>
+//   CHECK-DAG:     %[[W1:.*]] = aievec.shift %[[LO]], %[[HI]], %[[C2]] {isAcc = false} : vector<32xi16>, vector<32xi16>, i32, vector<32xi16>
+//   CHECK-DAG:     %[[W2:.*]] = aievec.shift %[[LO]], %[[HI]], %[[C4]] {isAcc = false} : vector<32xi16>, vector<32xi16>, i32, vector<32xi16>
+//       CHECK:     %[[M0:.*]] = arith.maxsi %[[W0]], %[[W1]] : vector<32xi16>
+//       CHECK:     %[[M1:.*]] = arith.maxsi %[[M0]], %[[W2]] : vector<32xi16>
+//       CHECK:     vector.transfer_write %[[M1]]
+
+// V16: remark: vector loads per iteration: 2 with reuse, 5 without (3 saved)
+// V16-LABEL: func.func @max3
+//   V16-DAG: %[[C2:.*]] = arith.constant 2 : i32
+//   V16-DAG: %[[C4:.*]] = arith.constant 4 : i32
+//       V16: %[[U0:.*]] = aievec.upd {{.*}} {index = 0 : i8, offset = 0 : i32} : memref<16x288xi16>, vector<32xi16>
+//       V16: %[[W0:.*]] = aievec.ext %[[U0]] {index = 0 : i8} : vector<32xi16>, vector<16xi16>
+//       V16: %[[U1:.*]] = aievec.upd {{.*}}, %[[U0]] {index = 1 : i8, {{.*}}} : memref<16x288xi16>, vector<32xi16>
+//   V16-DAG: %[[S1:.*]] = aievec.shift %[[U1]], %[[U1]], %[[C2]] {isAcc = false} : vector<32xi16>, vector<32xi16>, i32, vector<32xi16>
+//   V16-DAG: %[[W1:.*]] = aievec.ext %[[S1]] {index = 0 : i8} : vector<32xi16>, vector<16xi16>
+//   V16-DAG: %[[S2:.*]] = aievec.shift %[[U1]], %[[U1]], %[[C4]] {isAcc = false} : vector<32xi16>, vector<32xi16>, i32, vector<32xi16>
+//   V16-DAG: %[[W2:.*]] = aievec.ext %[[S2]] {index = 0 : i8} : vector<32xi16>, vector<16xi16>
+//       V16: %[[M0:.*]] = arith.maxsi %[[W0]], %[[W1]] : vector<16xi16>
+//       V16: %[[M1:.*]] = arith.maxsi %[[M0]], %[[W2]] : vector<16xi16>
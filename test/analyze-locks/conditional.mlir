@@ -0,0 +1,110 @@
+//===- conditional.mlir ----------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-analyze-locks --split-input-file --verify-diagnostics %s
+
+// The branch of a condition computed at run time is not known, inside a loop
+// whose trip count is not constant either.
+
+aie.device(npu) {
+  %t12 = aie.tile(1, 2)
+  %buf = aie.buffer(%t12) : memref<2xi32>
+  %lock = aie.lock(%t12, 0) {init = 1 : i32, sym_name = "lock"}
+  %core12 = aie.core(%t12) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %v = memref.load %buf[%c0] : memref<2xi32>
+    %n = arith.index_cast %v : i32 to index
+    scf.for %i = %c0 to %n step %c1 {
+      %odd = arith.cmpi eq, %i, %c1 : index
+      // expected-warning@+1 {{lock operations under a condition that is not constant: the lock protocol is not analyzed}}
+      scf.if %odd {
+      } else {
+        aie.use_lock(%lock, AcquireGreaterEqual, 1)
+        aie.use_lock(%lock, Release, 1)
+      }
+    }
+    aie.end
+  }
+}
+
+// -----
+
+// The same outside of a loop.
+
+aie.device(npu) {
+  %t12 = aie.tile(1, 2)
+  %buf = aie.buffer(%t12) : memref<2xi32>
+  %lock = aie.lock(%t12, 0) {init = 1 : i32, sym_name = "lock"}
+  %core12 = aie.core(%t12) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %flag = memref.load %buf[%c0] : memref<2xi32>
+    %one = arith.constant 1 : i32
+    %set = arith.cmpi eq, %flag, %one : i32
+    // expected-warning@+1 {{lock operations under a condition that is not constant: the lock protocol is not analyzed}}
+    scf.if %set {
+      aie.use_lock(%lock, AcquireGreaterEqual, 1)
+    } else {
+      aie.use_lock(%lock, AcquireGreaterEqual, 2)
+    }
+    aie.end
+  }
+}
+
+// -----
+
+// A constant condition selects the else branch.
+
+// expected-warning@+1 {{potential deadlock after 0 cycles}}
+aie.device(npu) {
+  %t12 = aie.tile(1, 2)
+  %lock = aie.lock(%t12, 0) {init = 2 : i32, sym_name = "lock"}
+  %core12 = aie.core(%t12) {
+    %false = arith.constant false
+    scf.if %false {
+      aie.use_lock(%lock, AcquireGreaterEqual, 1)
+    } else {
+      // expected-note@+1 {{core (1, 2) waits to acquire lock lock (value 2, needs >= 3)}}
+      aie.use_lock(%lock, AcquireGreaterEqual, 3)
+    }
+    aie.end
+  }
+}
+
+// -----
+
+// The lock operations of a loop that runs forever are in a branch that is
+// never taken: the loop takes no time and is dropped instead of spinning.
+// Only the load and the index cast before the loop remain.
+
+// expected-remark@+1 {{throughput bottleneck after 2 simulated cycles: core (1, 2), busy 100%}}
+aie.device(npu) {
+  %t12 = aie.tile(1, 2)
+  %buf = aie.buffer(%t12) : memref<2xi32>
+  %lock = aie.lock(%t12, 0) {init = 1 : i32, sym_name = "lock"}
+  // expected-remark@+1 {{core (1, 2): busy 100%}}
+  %core12 = aie.core(%t12) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %false = arith.constant false
+    %v = memref.load %buf[%c0] : memref<2xi32>
+    %n = arith.index_cast %v : i32 to index
+    scf.for %i = %c0 to %n step %c1 {
+      scf.if %false {
+      } else {
+        scf.if %false {
+          aie.use_lock(%lock, AcquireGreaterEqual, 1)
+        }
+      }
+    }
+    aie.end
+  }
+}
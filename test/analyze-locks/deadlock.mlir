@@ -0,0 +1,89 @@
+//===- deadlock.mlir -------------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-analyze-locks --split-input-file --verify-diagnostics %s
+
+// The core acquires three elements of a double buffer.
+
+// expected-warning@+1 {{potential deadlock after 0 cycles}}
+aie.device(npu) {
+  %t12 = aie.tile(1, 2)
+  %prod = aie.lock(%t12, 0) {init = 2 : i32, sym_name = "prod_lock"}
+  %core12 = aie.core(%t12) {
+    // expected-note@+1 {{core (1, 2) waits to acquire lock prod_lock (value 2, needs >= 3)}}
+    aie.use_lock(%prod, AcquireGreaterEqual, 3)
+    aie.end
+  }
+}
+
+// -----
+
+// Core (1, 2) produces two buffers, which the DMAs move to tile (1, 3), but
+// core (1, 3) consumes three.
+
+// expected-warning@+1 {{potential deadlock after 518 cycles}}
+aie.device(npu) {
+  %t12 = aie.tile(1, 2)
+  %t13 = aie.tile(1, 3)
+  %buf12 = aie.buffer(%t12) : memref<256xi32>
+  %buf13 = aie.buffer(%t13) : memref<256xi32>
+  %prod = aie.lock(%t12, 0) {init = 2 : i32, sym_name = "prod_lock"}
+  %cons = aie.lock(%t12, 1) {init = 0 : i32, sym_name = "cons_lock"}
+  %in_prod = aie.lock(%t13, 0) {init = 2 : i32, sym_name = "in_prod_lock"}
+  %in_cons = aie.lock(%t13, 1) {init = 0 : i32, sym_name = "in_cons_lock"}
+  aie.flow(%t12, DMA : 0, %t13, DMA : 0)
+
+  %core12 = aie.core(%t12) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c2 = arith.constant 2 : index
+    scf.for %i = %c0 to %c2 step %c1 {
+      aie.use_lock(%prod, AcquireGreaterEqual, 1)
+      aie.use_lock(%cons, Release, 1)
+    }
+    aie.end
+  }
+
+  %core13 = aie.core(%t13) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c3 = arith.constant 3 : index
+    scf.for %i = %c0 to %c3 step %c1 {
+      // expected-note@+1 {{core (1, 3) waits to acquire lock in_cons_lock (value 0, needs >= 1)}}
+      aie.use_lock(%in_cons, AcquireGreaterEqual, 1)
+      aie.use_lock(%in_prod, Release, 1)
+    }
+    aie.end
+  }
+
+  %mem12 = aie.mem(%t12) {
+    %0 = aie.dma_start(MM2S, 0, ^bd0, ^end)
+  ^bd0:
+    // expected-note@+1 {{DMA (1, 2) MM2S 0 waits to acquire lock cons_lock (value 0, needs >= 1)}}
+    aie.use_lock(%cons, AcquireGreaterEqual, 1)
+    aie.dma_bd(%buf12 : memref<256xi32>, 0, 256)
+    aie.use_lock(%prod, Release, 1)
+    aie.next_bd ^bd0
+  ^end:
+    aie.end
+  }
+
+  %mem13 = aie.mem(%t13) {
+    %0 = aie.dma_start(S2MM, 0, ^bd0, ^end)
+  ^bd0:
+    aie.use_lock(%in_prod, AcquireGreaterEqual, 1)
+    // expected-note@+1 {{DMA (1, 3) S2MM 0 waits to receive 1024 bytes from DMA (1, 2) MM2S 0}}
+    aie.dma_bd(%buf13 : memref<256xi32>, 0, 256)
+    aie.use_lock(%in_cons, Release, 1)
+    aie.next_bd ^bd0
+  ^end:
+    aie.end
+  }
+}
@@ -0,0 +1,67 @@
+//===- horizon.mlir --------------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-analyze-locks="max-cycles=10000" %s 2>&1 | FileCheck %s
+
+// Cores (1, 2) and (1, 3) run a producer/consumer pipeline forever, so the
+// simulation stops at the horizon. Core (1, 4) waits from the start on a lock
+// that is never released: it is reported although the pipeline still runs,
+// and the pipeline is still analyzed.
+
+// CHECK: warning: potential deadlock at the horizon of 10000 cycles
+// CHECK: note: core (1, 4) waits to acquire lock never_lock (value 0, needs >= 1) since cycle 0
+// CHECK-NOT: note: core (1, {{[23]}})
+// CHECK-DAG: remark: core (1, 2): busy 100%{{$}}
+// CHECK-DAG: remark: core (1, 4): busy 0%, waiting 100% on lock never_lock
+// CHECK-DAG: remark: throughput bottleneck after 10000 simulated cycles: core (1, 2), busy 100%
+
+aie.device(npu) {
+  %t12 = aie.tile(1, 2)
+  %t13 = aie.tile(1, 3)
+  %t14 = aie.tile(1, 4)
+  %prod = aie.lock(%t13, 0) {init = 2 : i32, sym_name = "of_prod_lock"}
+  %cons = aie.lock(%t13, 1) {init = 0 : i32, sym_name = "of_cons_lock"}
+  %never = aie.lock(%t14, 0) {init = 0 : i32, sym_name = "never_lock"}
+
+  func.func private @produce() attributes {aie.estimated_cycles = 100 : i64}
+  func.func private @consume() attributes {aie.estimated_cycles = 40 : i64}
+
+  // The loops have no constant trip count and run forever.
+  %core12 = aie.core(%t12) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %n = arith.index_cast %c1 : index to i32
+    %ub = arith.index_cast %n : i32 to index
+    scf.for %i = %c0 to %ub step %c1 {
+      aie.use_lock(%prod, AcquireGreaterEqual, 1)
+      func.call @produce() : () -> ()
+      aie.use_lock(%cons, Release, 1)
+    }
+    aie.end
+  }
+
+  %core13 = aie.core(%t13) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %n = arith.index_cast %c1 : index to i32
+    %ub = arith.index_cast %n : i32 to index
+    scf.for %i = %c0 to %ub step %c1 {
+      aie.use_lock(%cons, AcquireGreaterEqual, 1)
+      func.call @consume() : () -> ()
+      aie.use_lock(%prod, Release, 1)
+    }
+    aie.end
+  }
+
+  %core14 = aie.core(%t14) {
+    aie.use_lock(%never, AcquireGreaterEqual, 1)
+    aie.end
+  }
+}
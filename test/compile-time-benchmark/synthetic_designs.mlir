@@ -0,0 +1,32 @@
+//===- synthetic_designs.mlir ----------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: %PYTHON %AIE_SRC_ROOT/utils/compile-time-benchmark.py --emit --device npu --cores 4 --fanout 2 --packet-flows 2 | aie-opt | FileCheck %s --check-prefix=DESIGN
+// RUN: %PYTHON %AIE_SRC_ROOT/utils/compile-time-benchmark.py --device npu --cores 4 --fanout 2 --packet-flows 2 -o %t.json
+// RUN: FileCheck %s --check-prefix=TIMING < %t.json
+// RUN: %PYTHON %AIE_SRC_ROOT/utils/compile-time-benchmark.py --device npu --cores 4 --fanout 2 --packet-flows 2 -o %t2.json --baseline %t.json --threshold 1000
+
+// DESIGN: aie.device(npu)
+// DESIGN: aie.objectfifo @in(%{{.*}}, {%{{.*}}}, 2 : i32)
+// DESIGN: aie.objectfifo @fifo0(%{{.*}}, {%{{.*}}, %{{.*}}}, 2 : i32)
+// DESIGN: aie.objectfifo @fifo2(
+// DESIGN: aie.objectfifo @out(
+// DESIGN: aie.packet_flow(1)
+// DESIGN-COUNT-4: aie.core
+// DESIGN: func.func @sequence
+
+// TIMING: "name": "npu_c4_f3_b2_p2"
+// TIMING: "passes": {
+// TIMING-DAG: "AIEObjectFifoStatefulTransform
+// TIMING-DAG: "AIEAssignBufferAddresses
+// TIMING-DAG: "AIERoutePathfinderFlows
+// TIMING-DAG: "AIEDmaToNpu
+// TIMING-DAG: "aie-generate-cdo"
+// TIMING-DAG: "verifier"
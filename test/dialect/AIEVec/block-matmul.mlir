@@ -0,0 +1,128 @@
+// RUN: aie-opt %s -aie-block-matmul -split-input-file -verify-diagnostics | FileCheck %s
+// RUN: aie-opt %s -aie-block-matmul="tiled-layout=true block-m=1 block-n=1" -split-input-file -verify-diagnostics | FileCheck %s --check-prefix=TILED
+// RUN: aie-opt %s -aie-block-matmul="tiled-layout=true block-m=1 block-n=1" -convert-vector-to-aievec="aie-target=aieml target-backend=llvmir" -split-input-file | FileCheck %s --check-prefix=AIEVEC
+
+// CHECK-LABEL: func.func @matmul_i16
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: memref<16x32xi16>
+// CHECK-SAME: %[[B:[A-Za-z0-9]+]]: memref<32x32xi16>
+// CHECK-SAME: %[[C:[A-Za-z0-9]+]]: memref<16x32xi32>
+// CHECK-NOT:  linalg.matmul
+// CHECK:      scf.for %[[TM:.*]] = %{{.*}} to %{{.*}} step %c2
+// CHECK:        scf.for %[[TN:.*]] = %{{.*}} to %{{.*}} step %c2
+// CHECK-COUNT-4:  vector.transfer_read %[[C]]{{.*}} : memref<16x32xi32>, vector<4x8xi32>
+// CHECK:          %[[R:.*]]:4 = scf.for %[[TK:.*]] = %{{.*}} to %{{.*}} step %c1 iter_args(
+// CHECK-COUNT-2:    vector.transfer_read %[[A]]{{.*}} : memref<16x32xi16>, vector<4x2xi16>
+// CHECK-COUNT-2:    vector.transfer_read %[[B]]{{.*}} : memref<32x32xi16>, vector<2x8xi16>
+// CHECK-COUNT-4:    vector.contract {{.*}} : vector<4x2xi32>, vector<2x8xi32> into vector<4x8xi32>
+// CHECK:            scf.yield
+// CHECK-COUNT-4:  vector.transfer_write {{.*}}, %[[C]]{{.*}} : vector<4x8xi32>, memref<16x32xi32>
+// TILED-LABEL: func.func @matmul_i16
+// TILED-COUNT-3: memref.collapse_shape
+// TILED:         vector.transfer_read {{.*}} : memref<512xi32>, vector<32xi32>
+// TILED:         vector.shape_cast {{.*}} : vector<32xi32> to vector<4x8xi32>
+// TILED:         scf.for
+// TILED:           vector.transfer_read {{.*}} : memref<512xi16>, vector<8xi16>
+// TILED:           vector.transfer_read {{.*}} : memref<1024xi16>, vector<16xi16>
+// TILED:           vector.contract
+// TILED-NOT:       vector.contract
+// TILED:           scf.yield
+// AIEVEC-LABEL: func.func @matmul_i16
+// AIEVEC:         scf.for
+// AIEVEC:           aievec.matmul {{.*}} : vector<4x2xi16>, vector<2x8xi16> into vector<4x8xi32>
+// AIEVEC-NOT:       vector.contract
+func.func @matmul_i16(%A: memref<16x32xi16>, %B: memref<32x32xi16>,
+                      %C: memref<16x32xi32>) {
+  linalg.matmul ins(%A, %B : memref<16x32xi16>, memref<32x32xi16>)
+                outs(%C : memref<16x32xi32>)
+  return
+}
+
+// -----
+
+// CHECK-LABEL: func.func @matmul_bf16
+// CHECK:      scf.for
+// CHECK:        scf.for
+// CHECK:          arith.extf {{.*}} : vector<4x4xbf16> to vector<4x4xf32>
+// CHECK:          scf.for
+// CHECK-COUNT-2:    arith.extf {{.*}} : vector<4x8xbf16> to vector<4x8xf32>
+// CHECK-COUNT-2:    arith.extf {{.*}} : vector<8x4xbf16> to vector<8x4xf32>
+// CHECK-COUNT-4:    vector.contract {{.*}} : vector<4x8xf32>, vector<8x4xf32> into vector<4x4xf32>
+// CHECK:          arith.truncf {{.*}} : vector<4x4xf32> to vector<4x4xbf16>
+// TILED-LABEL: func.func @matmul_bf16
+// AIEVEC-LABEL: func.func @matmul_bf16
+// AIEVEC:           aievec.matmul {{.*}} : vector<4x8xbf16>, vector<8x4xbf16> into vector<4x4xf32>
+// AIEVEC-NOT:       vector.contract
+func.func @matmul_bf16(%A: memref<8x16xbf16>, %B: memref<16x8xbf16>,
+                       %C: memref<8x8xbf16>) {
+  linalg.matmul ins(%A, %B : memref<8x16xbf16>, memref<16x8xbf16>)
+                outs(%C : memref<8x8xbf16>)
+  return
+}
+
+// -----
+
+// CHECK-LABEL: func.func @matmul_i8_i4
+// CHECK:          scf.for
+// CHECK-COUNT-2:    arith.extsi {{.*}} : vector<4x16xi8> to vector<4x16xi32>
+// CHECK-COUNT-2:    arith.extsi {{.*}} : vector<16x8xi4> to vector<16x8xi32>
+// CHECK-COUNT-4:    vector.contract {{.*}} : vector<4x16xi32>, vector<16x8xi32> into vector<4x8xi32>
+// TILED-LABEL: func.func @matmul_i8_i4
+// AIEVEC-LABEL: func.func @matmul_i8_i4
+// AIEVEC:           aievec.matmul {{.*}} : vector<4x16xi8>, vector<16x8xi4> into vector<4x8xi32>
+// AIEVEC-NOT:       vector.contract
+func.func @matmul_i8_i4(%A: memref<8x32xi8>, %B: memref<32x16xi4>,
+                        %C: memref<8x16xi32>) {
+  linalg.matmul ins(%A, %B : memref<8x32xi8>, memref<32x16xi4>)
+                outs(%C : memref<8x16xi32>)
+  return
+}
+
+// -----
+
+// An int4 lhs is loaded as int4 and multiplied in the int8 x int8 shape.
+
+// CHECK-LABEL: func.func @matmul_i4_i8
+// CHECK:          scf.for
+// CHECK-COUNT-2:    vector.transfer_read {{.*}} : memref<8x32xi4>, vector<4x8xi4>
+// CHECK-COUNT-2:    vector.transfer_read {{.*}} : memref<32x16xi8>, vector<8x8xi8>
+// CHECK-COUNT-4:    vector.contract {{.*}} : vector<4x8xi32>, vector<8x8xi32> into vector<4x8xi32>
+// TILED-LABEL: func.func @matmul_i4_i8
+// AIEVEC-LABEL: func.func @matmul_i4_i8
+// AIEVEC:           aievec.matmul {{.*}} : vector<4x8xi8>, vector<8x8xi8> into vector<4x8xi32>
+// AIEVEC-NOT:       vector.contract
+func.func @matmul_i4_i8(%A: memref<8x32xi4>, %B: memref<32x16xi8>,
+                        %C: memref<8x16xi32>) {
+  linalg.matmul ins(%A, %B : memref<8x32xi4>, memref<32x16xi8>)
+                outs(%C : memref<8x16xi32>)
+  return
+}
+
+// -----
+
+// CHECK-LABEL: func.func @matmul_i8_i16
+// CHECK:          scf.for
+// CHECK-COUNT-2:    vector.transfer_read {{.*}} : memref<16x32xi8>, vector<4x2xi8>
+// CHECK-COUNT-2:    vector.transfer_read {{.*}} : memref<32x32xi16>, vector<2x8xi16>
+// CHECK-COUNT-4:    vector.contract {{.*}} : vector<4x2xi32>, vector<2x8xi32> into vector<4x8xi32>
+// TILED-LABEL: func.func @matmul_i8_i16
+// AIEVEC-LABEL: func.func @matmul_i8_i16
+// AIEVEC:           aievec.matmul {{.*}} : vector<4x2xi16>, vector<2x8xi16> into vector<4x8xi32>
+// AIEVEC-NOT:       vector.contract
+func.func @matmul_i8_i16(%A: memref<16x32xi8>, %B: memref<32x32xi16>,
+                         %C: memref<16x32xi32>) {
+  linalg.matmul ins(%A, %B : memref<16x32xi8>, memref<32x32xi16>)
+                outs(%C : memref<16x32xi32>)
+  return
+}
+
+// -----
+
+// CHECK-LABEL: func.func @matmul_unaligned
+// CHECK:       linalg.matmul
+func.func @matmul_unaligned(%A: memref<6x16xi8>, %B: memref<16x16xi8>,
+                            %C: memref<6x16xi32>) {
+  // expected-warning @+1 {{matmul of size 6x16x16 is not a multiple of the}}
+  linalg.matmul ins(%A, %B : memref<6x16xi8>, memref<16x16xi8>)
+                outs(%C : memref<6x16xi32>)
+  return
+}
@@ -0,0 +1,129 @@
+// RUN: aie-opt %s -canonicalize-vector-for-aievec=aie-target=aieml -canonicalize -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @reduce_add_i32(
+// CHECK-SAME: %[[MEM:[a-zA-Z0-9]+]]: memref<1024xi32>) -> i32 {
+// CHECK:   %[[ZERO:.*]] = arith.constant dense<0> : vector<16xi32>
+// CHECK:   %[[PART:.*]] = scf.for %{{.*}} = %{{.*}} to %{{.*}} step %{{.*}}
+// CHECK-SAME:      iter_args(%[[ACC:.*]] = %[[ZERO]]) -> (vector<16xi32>) {
+// CHECK:     %[[V:.*]] = vector.transfer_read %[[MEM]]
+// CHECK:     %[[ADD:.*]] = arith.addi
+// CHECK-SAME:      : vector<16xi32>
+// CHECK:     scf.yield %[[ADD]] : vector<16xi32>
+// CHECK:   }
+// CHECK:   %[[RED:.*]] = vector.reduction <add>, %[[PART]] : vector<16xi32> into i32
+// CHECK:   return %[[RED]] : i32
+func.func @reduce_add_i32(%m : memref<1024xi32>) -> i32 {
+  %c0 = arith.constant 0 : index
+  %c16 = arith.constant 16 : index
+  %c1024 = arith.constant 1024 : index
+  %c0_i32 = arith.constant 0 : i32
+  %0 = scf.for %i = %c0 to %c1024 step %c16 iter_args(%acc = %c0_i32) -> (i32) {
+    %v = vector.transfer_read %m[%i], %c0_i32 : memref<1024xi32>, vector<16xi32>
+    %s = vector.reduction <add>, %v, %acc : vector<16xi32> into i32
+    scf.yield %s : i32
+  }
+  return %0 : i32
+}
+
+// -----
+
+// CHECK-LABEL: func.func @reduce_add_bf16(
+// CHECK-SAME: %[[MEM:[a-zA-Z0-9]+]]: memref<1024xbf16>,
+// CHECK-SAME: %[[INIT:[a-zA-Z0-9]+]]: bf16) -> bf16 {
+// CHECK:   %[[ZERO:.*]] = arith.constant dense<0.000000e+00> : vector<16xf32>
+// CHECK:   %[[PART:.*]] = scf.for
+// CHECK-SAME:      iter_args(%[[ACC:.*]] = %[[ZERO]]) -> (vector<16xf32>) {
+// CHECK:     %[[V:.*]] = vector.transfer_read %[[MEM]]
+// CHECK:     %[[VF:.*]] = arith.extf %[[V]] : vector<16xbf16> to vector<16xf32>
+// CHECK:     %[[ADD:.*]] = arith.addf
+// CHECK-SAME:      : vector<16xf32>
+// CHECK:     scf.yield %[[ADD]] : vector<16xf32>
+// CHECK:   }
+// CHECK:   %[[RED:.*]] = vector.reduction <add>, %[[PART]] : vector<16xf32> into f32
+// CHECK:   %[[INITF:.*]] = arith.extf %[[INIT]] : bf16 to f32
+// CHECK:   %[[SUM:.*]] = arith.addf
+// CHECK-SAME:      : f32
+// CHECK:   %[[RES:.*]] = arith.truncf %[[SUM]] : f32 to bf16
+// CHECK:   return %[[RES]] : bf16
+func.func @reduce_add_bf16(%m : memref<1024xbf16>, %init : bf16) -> bf16 {
+  %c0 = arith.constant 0 : index
+  %c16 = arith.constant 16 : index
+  %c1024 = arith.constant 1024 : index
+  %pad = arith.constant 0.0 : bf16
+  %0 = scf.for %i = %c0 to %c1024 step %c16 iter_args(%acc = %init) -> (bf16) {
+    %v = vector.transfer_read %m[%i], %pad : memref<1024xbf16>, vector<16xbf16>
+    %s = vector.reduction <add>, %v fastmath<reassoc> : vector<16xbf16> into bf16
+    %n = arith.addf %acc, %s fastmath<fast> : bf16
+    scf.yield %n : bf16
+  }
+  return %0 : bf16
+}
+
+// -----
+
+// Without the reassoc flag on both ops the sum must keep its order.
+// CHECK-LABEL: func.func @reduce_add_f32_strict(
+// CHECK:   scf.for {{.*}} -> (f32) {
+// CHECK:     vector.reduction <add>
+// CHECK:     scf.yield %{{.*}} : f32
+// CHECK-NOT: vector.reduction
+func.func @reduce_add_f32_strict(%m : memref<1024xf32>, %init : f32) -> f32 {
+  %c0 = arith.constant 0 : index
+  %c16 = arith.constant 16 : index
+  %c1024 = arith.constant 1024 : index
+  %pad = arith.constant 0.0 : f32
+  %0 = scf.for %i = %c0 to %c1024 step %c16 iter_args(%acc = %init) -> (f32) {
+    %v = vector.transfer_read %m[%i], %pad : memref<1024xf32>, vector<16xf32>
+    %s = vector.reduction <add>, %v fastmath<reassoc> : vector<16xf32> into f32
+    %n = arith.addf %acc, %s : f32
+    scf.yield %n : f32
+  }
+  return %0 : f32
+}
+
+// -----
+
+// CHECK-LABEL: func.func @reduce_max_i16(
+// CHECK:   %[[MIN:.*]] = arith.constant dense<-32768> : vector<32xi16>
+// CHECK:   affine.for %{{.*}} = 0 to 1024 step 32
+// CHECK-SAME:      iter_args({{.*}}%[[ACC:[a-zA-Z0-9_]+]] = %[[MIN]])
+// CHECK:     %[[MAX:.*]] = arith.maxsi
+// CHECK-SAME:      : vector<32xi16>
+// CHECK:     affine.yield {{.*}}%[[MAX]] : {{.*}}vector<32xi16>
+// CHECK:   }
+// CHECK:   vector.reduction <maxsi>, %{{.*}} : vector<32xi16> into i16
+func.func @reduce_max_i16(%m : memref<1024xi16>, %out : memref<i16>) {
+  %pad = arith.constant 0 : i16
+  %init = arith.constant -32768 : i16
+  %0 = affine.for %i = 0 to 1024 step 32 iter_args(%acc = %init) -> (i16) {
+    %v = vector.transfer_read %m[%i], %pad : memref<1024xi16>, vector<32xi16>
+    %s = vector.reduction <maxsi>, %v : vector<32xi16> into i16
+    %n = arith.maxsi %s, %acc : i16
+    affine.yield %n : i16
+  }
+  affine.store %0, %out[] : memref<i16>
+  return
+}
+
+// -----
+
+// The partial sum is used in the loop, so the reduction can't be deferred.
+// CHECK-LABEL: func.func @reduce_add_used_in_loop(
+// CHECK:   scf.for {{.*}} -> (i32) {
+// CHECK:     vector.reduction <add>
+// CHECK:     memref.store
+// CHECK:     scf.yield %{{.*}} : i32
+func.func @reduce_add_used_in_loop(%m : memref<1024xi32>,
+                                   %out : memref<i32>) -> i32 {
+  %c0 = arith.constant 0 : index
+  %c16 = arith.constant 16 : index
+  %c1024 = arith.constant 1024 : index
+  %c0_i32 = arith.constant 0 : i32
+  %0 = scf.for %i = %c0 to %c1024 step %c16 iter_args(%acc = %c0_i32) -> (i32) {
+    %v = vector.transfer_read %m[%i], %c0_i32 : memref<1024xi32>, vector<16xi32>
+    %s = vector.reduction <add>, %v, %acc : vector<16xi32> into i32
+    memref.store %s, %out[] : memref<i32>
+    scf.yield %s : i32
+  }
+  return %0 : i32
+}
@@ -0,0 +1,93 @@
+// RUN: aie-opt %s -aie-loop-hints -split-input-file | FileCheck %s
+// RUN: aie-opt %s -aie-loop-hints="pipeline=false" -split-input-file | FileCheck %s --check-prefix=NOPIPE
+
+// CHECK: #[[PIPE:.*]] = #llvm.loop_pipeline<disable = false>
+// CHECK: #[[ANN:.*]] = #llvm.loop_annotation<pipeline = #[[PIPE]], mustProgress = true>
+
+// CHECK-LABEL: func.func @trip_counts
+// CHECK-SAME: %[[N:[A-Za-z0-9]+]]: index
+// NOPIPE-LABEL: func.func @trip_counts
+// NOPIPE-NOT: llvm.loop_annotation
+func.func @trip_counts(%n: index) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c16 = arith.constant 16 : index
+  %c64 = arith.constant 64 : index
+  // Constant bounds.
+  // CHECK: scf.for
+  // CHECK: } {aie.loop_range = array<i64: 16, 16>, llvm.loop_annotation = #[[ANN]]}
+  scf.for %i = %c0 to %c64 step %c4 {
+  }
+  // An upper bound clamped to at least 16 and at most 64.
+  // CHECK: scf.for
+  // CHECK: } {aie.loop_range = array<i64: 4, 16>, llvm.loop_annotation = #[[ANN]]}
+  %lo = arith.maxsi %n, %c16 : index
+  %ub = arith.minsi %lo, %c64 : index
+  scf.for %i = %c0 to %ub step %c4 {
+  }
+  // An upper bound only known from above.
+  // CHECK: scf.for
+  // CHECK: } {aie.loop_range = array<i64: 0, 32>, llvm.loop_annotation = #[[ANN]]}
+  %min = affine.min affine_map<(d0) -> (d0, 32)>(%n)
+  scf.for %i = %c0 to %min step %c1 {
+  }
+  // A triangular nest: the inner loop runs at most 63 times.
+  // CHECK: scf.for %[[I:.*]] =
+  // CHECK:   scf.for
+  // CHECK:   } {aie.loop_range = array<i64: 0, 63>, llvm.loop_annotation = #[[ANN]]}
+  // CHECK: } {aie.loop_range = array<i64: 64, 64>, llvm.loop_annotation = #[[ANN]]}
+  scf.for %i = %c0 to %c64 step %c1 {
+    scf.for %j = %c0 to %i step %c1 {
+    }
+  }
+  // Nothing is known about a loop to %n.
+  // CHECK: scf.for
+  // CHECK: } {llvm.loop_annotation = #[[ANN]]}
+  scf.for %i = %c0 to %n step %c1 {
+  }
+  return
+}
+
+// -----
+
+// The kernel is called with distinct ObjectFifo buffers for its first two
+// arguments, and with a buffer and a view of it for the last two.
+
+// CHECK-LABEL: func.func @kernel
+// CHECK-SAME: %{{.*}}: memref<64xi32> {llvm.noalias},
+// CHECK-SAME: %{{.*}}: memref<64xi32> {llvm.noalias},
+// CHECK-SAME: %{{.*}}: memref<64xi32>,
+// CHECK-SAME: %{{.*}}: memref<32xi32, strided<[1]>>)
+aie.device(xcve2302) {
+  %tile = aie.tile(0, 2)
+  %in = aie.buffer(%tile) {sym_name = "in"} : memref<64xi32>
+  %out = aie.buffer(%tile) {sym_name = "out"} : memref<64xi32>
+  %tmp = aie.buffer(%tile) {sym_name = "tmp"} : memref<64xi32>
+  func.func @kernel(%a: memref<64xi32>, %b: memref<64xi32>,
+                    %c: memref<64xi32>, %d: memref<32xi32, strided<[1]>>) {
+    return
+  }
+  %core = aie.core(%tile) {
+    %half = memref.subview %tmp[0] [32] [1] : memref<64xi32> to memref<32xi32, strided<[1]>>
+    func.call @kernel(%in, %out, %tmp, %half) : (memref<64xi32>, memref<64xi32>, memref<64xi32>, memref<32xi32, strided<[1]>>) -> ()
+    func.call @kernel(%out, %in, %tmp, %half) : (memref<64xi32>, memref<64xi32>, memref<64xi32>, memref<32xi32, strided<[1]>>) -> ()
+    aie.end
+  }
+}
+
+// -----
+
+// Public functions outside of a device may have unknown callers.
+
+// CHECK-LABEL: func.func @public_kernel
+// CHECK-NOT: llvm.noalias
+func.func @public_kernel(%a: memref<64xi32>, %b: memref<64xi32>) {
+  return
+}
+func.func @caller() {
+  %a = memref.alloc() : memref<64xi32>
+  %b = memref.alloc() : memref<64xi32>
+  func.call @public_kernel(%a, %b) : (memref<64xi32>, memref<64xi32>) -> ()
+  return
+}
@@ -0,0 +1,131 @@
+// RUN: aie-opt %s -aie-vector-tail -split-input-file | FileCheck %s
+// RUN: aie-opt %s -aie-vector-tail="mode=mask" -split-input-file | FileCheck %s --check-prefix=MASK
+
+// The 100 iterations of a 16-lane loop: 96 in the main loop, and 4 left over
+// that are too few for a 256-bit vector.
+
+// CHECK-LABEL: func.func @add_i32_tail
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: memref<100xi32>
+// CHECK-SAME: %[[B:[A-Za-z0-9]+]]: memref<100xi32>
+// CHECK:      affine.for %{{.*}} = 0 to 96 step 16 {
+// CHECK:        arith.addi %{{.*}}, %{{.*}} : vector<16xi32>
+// CHECK:      }
+// CHECK:      affine.for %[[I:.*]] = 96 to 100 {
+// CHECK:        %[[X:.*]] = memref.load %[[A]][%[[I]]] : memref<100xi32>
+// CHECK:        %[[S:.*]] = arith.addi %[[X]], %{{.*}} : i32
+// CHECK:        memref.store %[[S]], %[[B]][%[[I]]] : memref<100xi32>
+// CHECK:      }
+// A full vector at 96 would access elements past the end of the memrefs, so
+// the tail is peeled in mask mode too.
+// MASK-LABEL: func.func @add_i32_tail
+// MASK:       affine.for %{{.*}} = 0 to 96 step 16 {
+// MASK:       affine.for %[[I:.*]] = 96 to 100 {
+// MASK:         memref.load %{{.*}}[%[[I]]] : memref<100xi32>
+// MASK-NOT:     arith.select
+func.func @add_i32_tail(%a: memref<100xi32>, %b: memref<100xi32>) {
+  %c0_i32 = arith.constant 0 : i32
+  %cst = arith.constant dense<7> : vector<16xi32>
+  affine.for %i = 0 to 100 step 16 {
+    %0 = vector.transfer_read %a[%i], %c0_i32 : memref<100xi32>, vector<16xi32>
+    %1 = arith.addi %0, %cst : vector<16xi32>
+    vector.transfer_write %1, %b[%i] : vector<16xi32>, memref<100xi32>
+  }
+  return
+}
+
+// -----
+
+// With memrefs large enough for a full vector at 96, including the offset
+// read, the tail is masked.
+
+// MASK-LABEL: func.func @add_i32_tail_padded
+// MASK:       affine.for %{{.*}} = 0 to 96 step 16 {
+// MASK:       affine.for %[[I:.*]] = 96 to 112 step 16 {
+// MASK:         %[[M:.*]] = arith.constant dense<[true, true, true, true, false, false, false, false, false, false, false, false, false, false, false, false]> : vector<16xi1>
+// MASK:         %[[J:.*]] = affine.apply #{{.*}}(%[[I]])
+// MASK:         vector.transfer_read %{{.*}}[%[[J]]], %{{.*}} : memref<120xi32>, vector<16xi32>
+// MASK:         %[[NEW:.*]] = arith.addi %{{.*}}, %{{.*}} : vector<16xi32>
+// MASK:         %[[OLD:.*]] = vector.transfer_read %{{.*}}[%[[I]]], %{{.*}} : memref<112xi32>, vector<16xi32>
+// MASK:         %[[SEL:.*]] = arith.select %[[M]], %[[NEW]], %[[OLD]] : vector<16xi1>, vector<16xi32>
+// MASK:         vector.transfer_write %[[SEL]], %{{.*}}[%[[I]]] : vector<16xi32>, memref<112xi32>
+func.func @add_i32_tail_padded(%a: memref<120xi32>, %b: memref<112xi32>) {
+  %c0_i32 = arith.constant 0 : i32
+  %cst = arith.constant dense<7> : vector<16xi32>
+  affine.for %i = 0 to 100 step 16 {
+    %j = affine.apply affine_map<(d0) -> (d0 + 8)>(%i)
+    %0 = vector.transfer_read %a[%j], %c0_i32 : memref<120xi32>, vector<16xi32>
+    %1 = arith.addi %0, %cst : vector<16xi32>
+    vector.transfer_write %1, %b[%i] : vector<16xi32>, memref<112xi32>
+  }
+  return
+}
+
+// -----
+
+// An unaligned lower bound gets a prologue up to the first 16-lane boundary.
+// Leftovers use 8-lane vectors where they are aligned, and scalar code
+// elsewhere.
+
+// CHECK-LABEL: func.func @mul_i32_prologue
+// CHECK-SAME: %[[A:[A-Za-z0-9]+]]: memref<112xi32>
+// CHECK-SAME: %[[S:[A-Za-z0-9]+]]: i32
+// CHECK:      affine.for %[[I:.*]] = 4 to 8 {
+// CHECK:        %[[X:.*]] = memref.load %[[A]][%[[I]]] : memref<112xi32>
+// CHECK:        arith.muli %[[X]], %[[S]] : i32
+// CHECK:      }
+// CHECK:      affine.for %{{.*}} = 8 to 16 step 8 {
+// CHECK:        vector.broadcast %[[S]] : i32 to vector<8xi32>
+// CHECK:        arith.muli %{{.*}}, %{{.*}} : vector<8xi32>
+// CHECK:      }
+// CHECK:      affine.for %{{.*}} = 16 to 96 step 16 {
+// CHECK:        arith.muli %{{.*}}, %{{.*}} : vector<16xi32>
+// CHECK:      }
+// CHECK:      affine.for %{{.*}} = 96 to 104 step 8 {
+// CHECK:        arith.muli %{{.*}}, %{{.*}} : vector<8xi32>
+// CHECK:      }
+// CHECK:      affine.for %{{.*}} = 104 to 108 {
+// CHECK:        arith.muli %{{.*}}, %{{.*}} : i32
+// CHECK:      }
+// MASK-LABEL: func.func @mul_i32_prologue
+// MASK:       affine.for %{{.*}} = 0 to 16 step 16 {
+// MASK:         arith.constant dense<[false, false, false, false, true, true, true, true, true, true, true, true, true, true, true, true]> : vector<16xi1>
+// MASK:         arith.select
+// MASK:       affine.for %{{.*}} = 16 to 96 step 16 {
+// MASK:       affine.for %{{.*}} = 96 to 112 step 16 {
+// MASK:         arith.constant dense<[true, true, true, true, true, true, true, true, true, true, true, true, false, false, false, false]> : vector<16xi1>
+// MASK:         arith.select
+func.func @mul_i32_prologue(%a: memref<112xi32>, %s: i32) {
+  %c0_i32 = arith.constant 0 : i32
+  affine.for %i = 4 to 108 step 16 {
+    %0 = vector.transfer_read %a[%i], %c0_i32 : memref<112xi32>, vector<16xi32>
+    %1 = vector.broadcast %s : i32 to vector<16xi32>
+    %2 = arith.muli %0, %1 : vector<16xi32>
+    vector.transfer_write %2, %a[%i] : vector<16xi32>, memref<112xi32>
+  }
+  return
+}
+
+// -----
+
+// Loops whose trip count is a multiple of the lanes, and loops carrying a
+// reduction, are left alone.
+
+// CHECK-LABEL: func.func @untouched
+// CHECK:      affine.for %{{.*}} = 0 to 64 step 16 {
+// CHECK:      affine.for %{{.*}} = 0 to 100 step 16 iter_args(
+// CHECK-NOT:  affine.for
+func.func @untouched(%a: memref<100xi32>) -> vector<16xi32> {
+  %c0_i32 = arith.constant 0 : i32
+  %zero = arith.constant dense<0> : vector<16xi32>
+  affine.for %i = 0 to 64 step 16 {
+    %0 = vector.transfer_read %a[%i], %c0_i32 : memref<100xi32>, vector<16xi32>
+    %1 = arith.addi %0, %0 : vector<16xi32>
+    vector.transfer_write %1, %a[%i] : vector<16xi32>, memref<100xi32>
+  }
+  %r = affine.for %i = 0 to 100 step 16 iter_args(%acc = %zero) -> vector<16xi32> {
+    %0 = vector.transfer_read %a[%i], %c0_i32 : memref<100xi32>, vector<16xi32>
+    %1 = arith.addi %acc, %0 : vector<16xi32>
+    affine.yield %1 : vector<16xi32>
+  }
+  return %r : vector<16xi32>
+}
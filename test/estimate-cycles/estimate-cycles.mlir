@@ -0,0 +1,136 @@
+//===- estimate-cycles.mlir ------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-estimate-cycles %s | FileCheck %s
+// RUN: aie-opt --aie-estimate-cycles="report=true default-trip-count=10" %s 2>&1 | FileCheck %s --check-prefix=REPORT
+
+// A load, a vector add and a store issue in one bundle, so each iteration of
+// the first loop takes one cycle. The loop runs 32 times and pays a 7-cycle
+// load pipeline fill: 39 cycles. Each lock operation adds 3 cycles.
+
+// CHECK-LABEL: aie.device(xcve2802)
+// CHECK:       func.func @kernel({{.*}}) attributes {aie.estimated_cycles = 23 : i64}
+// CHECK:         affine.for
+// CHECK:         } {aie.estimated_cycles = 23 : i64, aie.estimated_cycles_per_iteration = 1 : i64}
+// CHECK:       func.func @locked({{.*}}) attributes {aie.estimated_cycles = 9 : i64}
+// CHECK:       scf.for
+// CHECK:       } {aie.estimated_cycles = 39 : i64, aie.estimated_cycles_per_iteration = 1 : i64}
+// CHECK:       } {aie.estimated_cycles = 45 : i64}
+// CHECK:       } {aie.estimated_cycles = 35 : i64}
+// CHECK:       scf.for
+// CHECK:       } {aie.estimated_cycles = 4 : i64, aie.estimated_cycles_per_iteration = 1 : i64}
+// CHECK:       } {aie.estimated_cycles = 4 : i64}
+// CHECK:       scf.for
+// CHECK:       } {aie.estimated_cycles = 11 : i64, aie.estimated_cycles_per_iteration = 1 : i64, aie.loop_range = array<i64: 4, 12>}
+// CHECK:       scf.for
+// CHECK:       } {aie.estimated_cycles = 9 : i64, aie.estimated_cycles_per_iteration = 1 : i64, aie.loop_range = array<i64: 6>}
+// CHECK:       } {aie.estimated_cycles = 20 : i64}
+// CHECK:       } {aie.estimated_cycles = 15 : i64}
+// CHECK:       } {aie.estimated_cycles = 15 : i64}
+
+// REPORT-DAG: remark: loop: 16 iterations x 1 cycles (load bound) = 23 cycles
+// REPORT-DAG: remark: loop: 32 iterations x 1 cycles (load bound) = 39 cycles
+// REPORT-DAG: remark: core (1, 3): 45 cycles, 2 lock operations
+// REPORT-DAG: remark: core (2, 3): 35 cycles, 0 lock operations, external call to @ext not estimated
+// REPORT-DAG: remark: loop: unknown (assumed 10) iterations x 1 cycles (scalar bound) = 13 cycles
+// REPORT-DAG: remark: loop: range 4-12 (assumed 8) iterations x 1 cycles (scalar bound) = 11 cycles
+// REPORT-DAG: remark: loop: at least 6 (assumed 6) iterations x 1 cycles (scalar bound) = 9 cycles
+// REPORT-DAG: remark: core (5, 3): 15 cycles, 1 lock operations, external call to @ext not estimated
+// REPORT-DAG: remark: core (6, 3): 15 cycles, 1 lock operations, external call to @ext not estimated
+
+aie.device(xcve2802) {
+  %t13 = aie.tile(1, 3)
+  %t23 = aie.tile(2, 3)
+  %t33 = aie.tile(3, 3)
+  %t43 = aie.tile(4, 3)
+  %t53 = aie.tile(5, 3)
+  %t63 = aie.tile(6, 3)
+  %lock = aie.lock(%t13, 0)
+  %buf = aie.buffer(%t13) : memref<256xi32>
+  %buf2 = aie.buffer(%t23) : memref<16xi32>
+
+  func.func private @ext(memref<16xi32>)
+  func.func @kernel(%a: memref<16xi32>) {
+    affine.for %i = 0 to 16 {
+      %x = affine.load %a[%i] : memref<16xi32>
+      %y = arith.addi %x, %x : i32
+      affine.store %y, %a[%i] : memref<16xi32>
+    }
+    return
+  }
+
+  // 3 cycles for the lock and 6 for the call.
+  func.func @locked(%a: memref<16xi32>) {
+    aie.use_lock(%lock, AcquireGreaterEqual, 1)
+    func.call @ext(%a) : (memref<16xi32>) -> ()
+    return
+  }
+
+  %core13 = aie.core(%t13) {
+    %c0 = arith.constant 0 : index
+    %c8 = arith.constant 8 : index
+    %c256 = arith.constant 256 : index
+    aie.use_lock(%lock, AcquireGreaterEqual, 1)
+    scf.for %i = %c0 to %c256 step %c8 {
+      %v = vector.load %buf[%i] : memref<256xi32>, vector<8xi32>
+      %w = arith.addi %v, %v : vector<8xi32>
+      vector.store %w, %buf[%i] : memref<256xi32>, vector<8xi32>
+    }
+    aie.use_lock(%lock, Release, 1)
+    aie.end
+  }
+
+  // 6 cycles per call, plus the 23 cycles of @kernel.
+  %core23 = aie.core(%t23) {
+    func.call @kernel(%buf2) : (memref<16xi32>) -> ()
+    func.call @ext(%buf2) : (memref<16xi32>) -> ()
+    aie.end
+  }
+
+  // The trip count of a loop with dynamic bounds is taken from
+  // default-trip-count.
+  %core33 = aie.core(%t33) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %n = arith.index_cast %c1 : index to i32
+    %ub = arith.index_cast %n : i32 to index
+    scf.for %i = %c0 to %ub step %c1 {
+      %m = arith.muli %n, %n : i32
+    }
+    aie.end
+  }
+
+  // Without constant bounds, the aie.loop_range hint gives the trip count:
+  // the middle of the range, or its minimum if it has no maximum.
+  %core43 = aie.core(%t43) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %n = arith.index_cast %c1 : index to i32
+    %ub = arith.index_cast %n : i32 to index
+    scf.for %i = %c0 to %ub step %c1 {
+      %m = arith.muli %n, %n : i32
+    } {aie.loop_range = array<i64: 4, 12>}
+    scf.for %i = %c0 to %ub step %c1 {
+      %m = arith.muli %n, %n : i32
+    } {aie.loop_range = array<i64: 6>}
+    aie.end
+  }
+
+  // The lock operations and external calls of @locked count for every core
+  // that calls it, not only for the first one.
+  %core53 = aie.core(%t53) {
+    func.call @locked(%buf2) : (memref<16xi32>) -> ()
+    aie.end
+  }
+  %core63 = aie.core(%t63) {
+    func.call @locked(%buf2) : (memref<16xi32>) -> ()
+    aie.end
+  }
+}
@@ -167,6 +167,16 @@ elif config.aieHostTarget == "aarch64":
 config.substitutions.append(("%VitisSysrootFlag%", VitisSysrootFlag))
 config.substitutions.append(("%aieHostTargetArch%", config.aieHostTarget))
 
+# The host compiler builds host-side checks of the runtime headers and
+# libraries.
+if config.aie_host_cxx.strip():
+    config.available_features.add("host-cxx")
+    config.substitutions.append(("%host_cxx", config.aie_host_cxx))
+
+# Tests of -debug-only output need a build with assertions.
+if config.enable_assertions:
+    config.available_features.add("asserts")
+
 llvm_config.with_system_environment(["HOME", "INCLUDE", "LIB", "TMP", "TEMP"])
 
 llvm_config.use_default_substitutions()
@@ -0,0 +1,72 @@
+//===- split_cores.mlir ----------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-localize-locks --aie-standard-lowering="split-cores=true" %s | FileCheck %s
+
+// Each core is lowered into a module of its own, which only holds the buffers
+// and functions that core uses.  Only the owner of an initialized buffer
+// defines it.
+
+// CHECK: module @test_split attributes {llvm.target_triple = "aie2"} {
+// CHECK-NOT: aie.device
+// CHECK:   module @core_1_2 attributes {llvm.target_triple = "aie2"} {
+// CHECK-DAG:  func.func private @llvm.aie2.acquire(i32, i32)
+// CHECK-DAG:  memref.global "public" @a : memref<16xi32> = dense<1>
+// CHECK-DAG:  func.func private @kernel(memref<16xi32>)
+// CHECK-NOT:  @b :
+// CHECK:      func.func @core_1_2() {
+// CHECK:        %[[A:.*]] = memref.get_global @a : memref<16xi32>
+// CHECK:        call @kernel(%[[A]]) : (memref<16xi32>) -> ()
+// CHECK:        return
+// CHECK:      }
+// CHECK:    }
+// CHECK:   module @core_1_3 attributes {llvm.target_triple = "aie2"} {
+// CHECK-DAG:  memref.global "public" @a : memref<16xi32>{{$}}
+// CHECK-DAG:  memref.global "public" @b : memref<16xi32>{{$}}
+// CHECK-NOT:  @kernel
+// CHECK:      func.func @core_1_3() {
+// CHECK:        call @llvm.aie2.acquire
+// CHECK:        memref.load
+// CHECK:        memref.store
+// CHECK:        call @llvm.aie2.release
+// CHECK:        return
+// CHECK:      }
+// CHECK:    }
+// CHECK: }
+module @test_split {
+ aie.device(xcve2302) {
+  %tile12 = aie.tile(1, 2)
+  %tile13 = aie.tile(1, 3)
+  %tile22 = aie.tile(2, 2)
+
+  %lock12 = aie.lock(%tile12, 0)
+  %buf_a = aie.buffer(%tile12) { sym_name = "a" } : memref<16xi32> = dense<1>
+  %buf_b = aie.buffer(%tile13) { sym_name = "b" } : memref<16xi32>
+  %buf_c = aie.buffer(%tile22) { sym_name = "c" } : memref<16xi32> = dense<2>
+
+  aie.flow(%tile12, DMA : 0, %tile22, DMA : 0)
+
+  func.func private @kernel(%buf : memref<16xi32>)
+
+  %core12 = aie.core(%tile12) {
+    func.call @kernel(%buf_a) : (memref<16xi32>) -> ()
+    aie.end
+  }
+
+  %core13 = aie.core(%tile13) {
+    %c0 = arith.constant 0 : index
+    aie.use_lock(%lock12, AcquireGreaterEqual, 1)
+    %0 = memref.load %buf_a[%c0] : memref<16xi32>
+    memref.store %0, %buf_b[%c0] : memref<16xi32>
+    aie.use_lock(%lock12, Release, 1)
+    aie.end
+  }
+ }
+}
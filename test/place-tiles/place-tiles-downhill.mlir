@@ -0,0 +1,28 @@
+//===- place-tiles-downhill.mlir -------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-place-tiles %s | FileCheck %s
+
+// The core starts on the core tile farthest from the shim tile, so that every
+// move is downhill; the search must still move it next to the shim tile.
+
+// CHECK-LABEL: aie.device(npu)
+// CHECK:       aie.tile(0, 0)
+// CHECK:       %[[CORE:.*]] = aie.tile(0, 2)
+// CHECK-NOT:   aie.unplaced
+// CHECK:       aie.objectfifo @in(%{{.*}}, {%[[CORE]]}, 2 : i32)
+aie.device(npu) {
+  %shim = aie.tile(0, 0)
+  %core = aie.tile(4, 5) {aie.unplaced}
+  aie.objectfifo @in(%shim, {%core}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.core(%core) {
+    aie.end
+  }
+}
@@ -0,0 +1,42 @@
+//===- place-tiles-errors.mlir ---------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-place-tiles --split-input-file --verify-diagnostics %s
+
+// The shim NOC tiles of the npu are all taken.
+
+// expected-error@+1 {{'aie.device' op cannot place 1 unplaced shim NOC tiles: only 0 are free}}
+aie.device(npu) {
+  %t00 = aie.tile(0, 0)
+  %t10 = aie.tile(1, 0)
+  %t20 = aie.tile(2, 0)
+  %t30 = aie.tile(3, 0)
+  %t40 = aie.tile(4, 0) {aie.unplaced}
+}
+
+// -----
+
+// The core (0, 2) can only access the memory of (0, 3), so it cannot use the
+// buffers of both unplaced tiles.
+
+// expected-error@+1 {{'aie.device' op could not find a legal placement of the unplaced tiles}}
+aie.device(npu) {
+  %t02 = aie.tile(0, 2)
+  %m0 = aie.tile(2, 2) {aie.unplaced}
+  %m1 = aie.tile(3, 3) {aie.unplaced}
+  %buf0 = aie.buffer(%m0) : memref<16xi32>
+  %buf1 = aie.buffer(%m1) : memref<16xi32>
+  aie.core(%t02) {
+    %c0 = arith.constant 0 : index
+    %v = memref.load %buf0[%c0] : memref<16xi32>
+    memref.store %v, %buf1[%c0] : memref<16xi32>
+    aie.end
+  }
+}
@@ -0,0 +1,155 @@
+//===- place-tiles-large.mlir ----------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-place-tiles %s | FileCheck %s
+// RUN: aie-opt --aie-place-tiles="seed=3" %s | FileCheck %s
+
+// Four pipelines of four cores each fill 16 of the 20 core tiles. Pipeline
+// c is fed from the shim tile (c, 0) through the mem tile (c, 1). The
+// objectFifos between its cores cost nothing when they share a memory
+// module, so every shortest placement puts the first core of pipeline c at
+// (c, 2) and the rest of the pipeline on tiles next to each other.
+
+// CHECK-LABEL: aie.device(npu)
+// CHECK:       aie.tile(0, 2){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK:       aie.tile(1, 2){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK:       aie.tile(2, 2){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK:       aie.tile(3, 2){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK-NEXT:  aie.tile({{[0-4]}}, {{[2-5]}}){{$}}
+// CHECK-NOT:   aie.unplaced
+aie.device(npu) {
+  %shim0 = aie.tile(0, 0)
+  %shim1 = aie.tile(1, 0)
+  %shim2 = aie.tile(2, 0)
+  %shim3 = aie.tile(3, 0)
+  %mem0 = aie.tile(0, 1)
+  %mem1 = aie.tile(1, 1)
+  %mem2 = aie.tile(2, 1)
+  %mem3 = aie.tile(3, 1)
+  %core00 = aie.tile(4, 5) {aie.unplaced}
+  %core01 = aie.tile(4, 4) {aie.unplaced}
+  %core02 = aie.tile(4, 3) {aie.unplaced}
+  %core03 = aie.tile(4, 2) {aie.unplaced}
+  %core10 = aie.tile(3, 5) {aie.unplaced}
+  %core11 = aie.tile(3, 4) {aie.unplaced}
+  %core12 = aie.tile(3, 3) {aie.unplaced}
+  %core13 = aie.tile(3, 2) {aie.unplaced}
+  %core20 = aie.tile(2, 5) {aie.unplaced}
+  %core21 = aie.tile(2, 4) {aie.unplaced}
+  %core22 = aie.tile(2, 3) {aie.unplaced}
+  %core23 = aie.tile(2, 2) {aie.unplaced}
+  %core30 = aie.tile(1, 5) {aie.unplaced}
+  %core31 = aie.tile(1, 4) {aie.unplaced}
+  %core32 = aie.tile(1, 3) {aie.unplaced}
+  %core33 = aie.tile(1, 2) {aie.unplaced}
+
+  aie.objectfifo @in0(%shim0, {%mem0}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @in00(%mem0, {%core00}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo.link [@in0] -> [@in00] ()
+  aie.objectfifo @c00(%core00, {%core01}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @c01(%core01, {%core02}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @c02(%core02, {%core03}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+
+  aie.objectfifo @in1(%shim1, {%mem1}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @in10(%mem1, {%core10}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo.link [@in1] -> [@in10] ()
+  aie.objectfifo @c10(%core10, {%core11}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @c11(%core11, {%core12}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @c12(%core12, {%core13}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+
+  aie.objectfifo @in2(%shim2, {%mem2}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @in20(%mem2, {%core20}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo.link [@in2] -> [@in20] ()
+  aie.objectfifo @c20(%core20, {%core21}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @c21(%core21, {%core22}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @c22(%core22, {%core23}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+
+  aie.objectfifo @in3(%shim3, {%mem3}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @in30(%mem3, {%core30}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo.link [@in3] -> [@in30] ()
+  aie.objectfifo @c30(%core30, {%core31}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @c31(%core31, {%core32}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+  aie.objectfifo @c32(%core32, {%core33}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+
+  aie.core(%core00) {
+    aie.end
+  }
+
+  aie.core(%core01) {
+    aie.end
+  }
+
+  aie.core(%core02) {
+    aie.end
+  }
+
+  aie.core(%core03) {
+    aie.end
+  }
+
+  aie.core(%core10) {
+    aie.end
+  }
+
+  aie.core(%core11) {
+    aie.end
+  }
+
+  aie.core(%core12) {
+    aie.end
+  }
+
+  aie.core(%core13) {
+    aie.end
+  }
+
+  aie.core(%core20) {
+    aie.end
+  }
+
+  aie.core(%core21) {
+    aie.end
+  }
+
+  aie.core(%core22) {
+    aie.end
+  }
+
+  aie.core(%core23) {
+    aie.end
+  }
+
+  aie.core(%core30) {
+    aie.end
+  }
+
+  aie.core(%core31) {
+    aie.end
+  }
+
+  aie.core(%core32) {
+    aie.end
+  }
+
+  aie.core(%core33) {
+    aie.end
+  }
+}
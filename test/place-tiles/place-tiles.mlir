@@ -0,0 +1,51 @@
+//===- place-tiles.mlir ----------------------------------------*- MLIR -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: aie-opt --aie-place-tiles %s | FileCheck %s
+// RUN: aie-opt --aie-place-tiles="seed=7 moves-per-tile=20" %s | FileCheck %s
+
+// Data flows from the shim tile (0, 0) through the mem tile (0, 1) to the
+// cores %a and %b and back to the shim tile (1, 0). The shortest placement
+// puts %a right above the mem tile and %b right above the shim tile; as they
+// are neighbours, @ab then shares a memory module and needs no DMA.
+
+// CHECK-LABEL: aie.device(npu)
+// CHECK:       aie.tile(0, 0)
+// CHECK:       aie.tile(1, 0)
+// CHECK:       aie.tile(0, 1)
+// CHECK:       %[[A:.*]] = aie.tile(0, 2)
+// CHECK-NOT:   aie.unplaced
+// CHECK:       %[[B:.*]] = aie.tile(1, 2)
+// CHECK-NOT:   aie.unplaced
+// CHECK:       aie.objectfifo @ab(%[[A]], {%[[B]]}, 2 : i32)
+// CHECK:       aie.core(%[[A]])
+// CHECK:       aie.core(%[[B]])
+module {
+  aie.device(npu) {
+    %shim_in = aie.tile(0, 0)
+    %shim_out = aie.tile(1, 0)
+    %mem = aie.tile(0, 1)
+    %a = aie.tile(3, 5) {aie.unplaced}
+    %b = aie.tile(1, 3) {aie.unplaced}
+
+    aie.objectfifo @in(%shim_in, {%mem}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+    aie.objectfifo @in2(%mem, {%a}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+    aie.objectfifo.link [@in] -> [@in2] ()
+    aie.objectfifo @ab(%a, {%b}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+    aie.objectfifo @out(%b, {%shim_out}, 2 : i32) : !aie.objectfifo<memref<256xi32>>
+
+    aie.core(%a) {
+      aie.end
+    }
+    aie.core(%b) {
+      aie.end
+    }
+  }
+}
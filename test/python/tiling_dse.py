@@ -0,0 +1,78 @@
+# This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+# (c) Copyright 2024 Advanced Micro Devices, Inc.
+
+# RUN: %python %s | FileCheck %s
+
+from aie.utils.tiling import Tensor, explore_tilings
+
+gemm = [
+    Tensor("A", ["i", "k"], element_bytes=2),
+    Tensor("B", ["k", "j"], element_bytes=2),
+    Tensor("C", ["i", "j"], element_bytes=4, output=True),
+]
+
+
+def print_tilings(tilings):
+    for t in tilings:
+        print("l1_tile", t["l1_tile"])
+        print("spatial", t["spatial"])
+        print("l2_tile", t["l2_tile"])
+        print("order", t["order"], "cores", t["cores"], "columns", t["columns"])
+        print("bytes", t["l1_bytes"], t["l2_bytes"])
+        print("traffic", t["l3_traffic"], t["l2_traffic"])
+        print("cycles", t["compute_cycles"], t["communication_cycles"])
+
+
+# The four columns of the npu each bring 8 bytes per cycle from L3, so reading
+# A and B and writing C once takes 32768 / 32 cycles. The reduction loop k is
+# not spread over cores.
+# CHECK-LABEL: npu
+# CHECK-NEXT: l1_tile {'i': 4, 'j': 64, 'k': 64}
+# CHECK-NEXT: spatial {'i': 16, 'j': 1, 'k': 1}
+# CHECK-NEXT: l2_tile {'i': 64, 'j': 64, 'k': 64}
+# CHECK-NEXT: order ['i', 'j', 'k'] cores 16 columns 4
+# CHECK-NEXT: bytes 19456 16384
+# CHECK-NEXT: traffic 32768 32768
+# CHECK-NEXT: cycles 256 1024
+# CHECK-NOT: l1_tile
+print("npu")
+print_tilings(explore_tilings({"i": 64, "j": 64, "k": 64}, gemm, device="npu"))
+
+# Limits given explicitly, without a device.
+# CHECK-LABEL: small
+# CHECK-NEXT: l1_tile {'i': 2, 'j': 4, 'k': 16}
+# CHECK-NEXT: spatial {'i': 1, 'j': 4, 'k': 1}
+# CHECK-NEXT: l2_tile {'i': 64, 'j': 64, 'k': 64}
+# CHECK-NEXT: order ['j', 'k', 'i'] cores 4 columns 1
+print("small")
+print_tilings(
+    explore_tilings(
+        {"i": 64, "j": 64, "k": 64},
+        gemm,
+        l1_bytes=512,
+        l2_bytes=2**19,
+        num_columns=1,
+        cores_per_column=4,
+        dma_dims=3,
+        l3_bytes_per_cycle=8,
+        l2_bytes_per_cycle=24,
+        macs_per_cycle=4,
+    )
+)
+
+# A loop nest that does not fit has no tilings.
+# CHECK-LABEL: too_large
+# CHECK-NEXT: []
+print("too_large")
+print(explore_tilings({"i": 64}, [Tensor("A", ["i"])], device="npu", l1_bytes=4))
+
+# CHECK-LABEL: invalid
+# CHECK: unknown loop
+print("invalid")
+try:
+    explore_tilings({"i": 64}, [Tensor("A", ["x"])], device="npu")
+except ValueError as e:
+    print(e)
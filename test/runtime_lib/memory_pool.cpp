@@ -0,0 +1,196 @@
+//===- memory_pool.cpp ------------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: %host_cxx -std=c++17 -I%AIE_SRC_ROOT/runtime_lib/test_lib %s -o %t
+// RUN: %t | FileCheck %s
+
+// Drives aie_mem_pool_t, the allocator behind mlir_aie_mem_alloc, on top of
+// the host memory backend.
+
+#include "memory_pool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+
+#define EXPECT(cond)                                                           \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::printf("%s:%d: expected %s\n", __FILE__, __LINE__, #cond);          \
+      std::exit(1);                                                            \
+    }                                                                          \
+  } while (0)
+
+// Small chunks keep the tests cheap: the largest size class is 1 KiB.
+static const size_t chunkSize = 4096;
+static const uint64_t deviceBase = 0x80000000;
+
+static aie_host_mem_pool_backend_t *
+makePool(std::unique_ptr<aie_mem_pool_t> &pool, size_t capacity = 0) {
+  auto *backend = new aie_host_mem_pool_backend_t(deviceBase, capacity);
+  pool.reset(new aie_mem_pool_t(
+      std::unique_ptr<aie_mem_pool_backend_t>(backend), chunkSize));
+  return backend;
+}
+
+// CHECK: alloc and free: ok
+static void testAllocFree() {
+  std::unique_ptr<aie_mem_pool_t> pool;
+  aie_host_mem_pool_backend_t *backend = makePool(pool);
+
+  aie_mem_block_t a, b, c;
+  EXPECT(pool->allocate(100, a));
+  EXPECT(a.size == 128);
+  EXPECT(pool->allocate(1, b));
+  EXPECT(b.size == aie_mem_pool_t::minBlockSize);
+  EXPECT(pool->allocate(0, c));
+  EXPECT(c.size == aie_mem_pool_t::minBlockSize);
+  for (const aie_mem_block_t *block : {&a, &b, &c}) {
+    EXPECT(reinterpret_cast<uintptr_t>(block->virtualAddr) % 16 == 0);
+    EXPECT(block->chunk == pool->findChunk(block->virtualAddr));
+  }
+  EXPECT(a.virtualAddr != b.virtualAddr && b.virtualAddr != c.virtualAddr);
+  EXPECT(pool->getNumChunks() == 1);
+  EXPECT(pool->getBytesInUse() == 256);
+
+  // Blocks are usable memory.
+  static_cast<char *>(a.virtualAddr)[a.size - 1] = 1;
+
+  EXPECT(pool->deallocate(b.virtualAddr));
+  EXPECT(!pool->deallocate(b.virtualAddr));
+  EXPECT(!pool->deallocate(static_cast<char *>(a.virtualAddr) + 1));
+  EXPECT(pool->getBytesInUse() == 192);
+
+  // Requests above a quarter of the chunk size get a chunk of their own,
+  // which goes back to the backend when freed.
+  aie_mem_block_t big;
+  EXPECT(pool->allocate(3000, big));
+  EXPECT(big.size == 4096);
+  EXPECT(pool->getNumChunks() == 2);
+  EXPECT(pool->deallocate(big.virtualAddr));
+  EXPECT(pool->getNumChunks() == 1);
+  EXPECT(backend->getBytesAllocated() == chunkSize);
+
+  pool->release();
+  EXPECT(pool->getNumChunks() == 0 && pool->getBytesInUse() == 0);
+  EXPECT(backend->getBytesAllocated() == 0);
+  std::printf("alloc and free: ok\n");
+}
+
+// CHECK: coalescing: ok
+static void testCoalescing() {
+  std::unique_ptr<aie_mem_pool_t> pool;
+  makePool(pool);
+
+  // Two neighbouring minimum size blocks merge back into the 128 byte block
+  // they were split from.
+  aie_mem_block_t lo, hi, pair;
+  EXPECT(pool->allocate(64, lo));
+  EXPECT(pool->allocate(64, hi));
+  EXPECT(static_cast<char *>(hi.virtualAddr) ==
+         static_cast<char *>(lo.virtualAddr) + 64);
+  EXPECT(pool->deallocate(lo.virtualAddr));
+  EXPECT(pool->deallocate(hi.virtualAddr));
+  EXPECT(pool->allocate(128, pair));
+  EXPECT(pair.virtualAddr == lo.virtualAddr);
+  EXPECT(pool->deallocate(pair.virtualAddr));
+
+  // Fill the chunk with minimum size blocks, then free every other one: no
+  // two free blocks are buddies, so a larger request needs a new chunk.
+  std::vector<aie_mem_block_t> blocks(chunkSize / 64);
+  for (aie_mem_block_t &block : blocks)
+    EXPECT(pool->allocate(64, block));
+  EXPECT(pool->getNumChunks() == 1);
+  for (size_t i = 0; i < blocks.size(); i += 2)
+    EXPECT(pool->deallocate(blocks[i].virtualAddr));
+  aie_mem_block_t large;
+  EXPECT(pool->allocate(1024, large));
+  EXPECT(pool->getNumChunks() == 2);
+  EXPECT(pool->deallocate(large.virtualAddr));
+
+  // Once the rest is freed the first chunk merges back into its largest
+  // blocks and serves large requests again.
+  for (size_t i = 1; i < blocks.size(); i += 2)
+    EXPECT(pool->deallocate(blocks[i].virtualAddr));
+  EXPECT(pool->getBytesInUse() == 0);
+  std::set<const aie_mem_chunk_t *> used;
+  for (int i = 0; i < 8; i++) {
+    EXPECT(pool->allocate(1024, large));
+    used.insert(large.chunk);
+  }
+  EXPECT(pool->getNumChunks() == 2 && used.size() == 2);
+  std::printf("coalescing: ok\n");
+}
+
+// CHECK: exhaustion: ok
+static void testExhaustion() {
+  std::unique_ptr<aie_mem_pool_t> pool;
+  makePool(pool, /*capacity=*/2 * chunkSize);
+
+  std::vector<aie_mem_block_t> blocks;
+  aie_mem_block_t block;
+  while (pool->allocate(512, block))
+    blocks.push_back(block);
+  EXPECT(blocks.size() == 2 * chunkSize / 512);
+  EXPECT(pool->getNumChunks() == 2);
+  EXPECT(!pool->allocate(64, block));
+  EXPECT(!pool->allocate(2 * chunkSize, block));
+
+  // Freeing makes room again, for the same and for smaller sizes.
+  EXPECT(pool->deallocate(blocks.back().virtualAddr));
+  EXPECT(pool->allocate(64, block));
+  EXPECT(pool->allocate(256, block));
+  EXPECT(!pool->allocate(256, block));
+  std::printf("exhaustion: ok\n");
+}
+
+// CHECK: device address lookup: ok
+static void testDeviceAddress() {
+  std::unique_ptr<aie_mem_pool_t> pool;
+  makePool(pool);
+
+  aie_mem_block_t a, big, b;
+  EXPECT(pool->allocate(256, a));
+  EXPECT(pool->allocate(2 * chunkSize, big));
+  EXPECT(a.physicalAddr == deviceBase);
+  EXPECT(big.physicalAddr == deviceBase + chunkSize);
+
+  // Every block of the first chunk maps to its offset from the base, also
+  // for pointers into the middle of a block.
+  for (int i = 0; i < 8; i++) {
+    EXPECT(pool->allocate(64, b));
+    uint64_t offset = static_cast<char *>(b.virtualAddr) -
+                      static_cast<char *>(a.chunk->virtualAddr);
+    EXPECT(b.physicalAddr == deviceBase + offset);
+    uint64_t pa = 0;
+    EXPECT(pool->getDeviceAddress(static_cast<char *>(b.virtualAddr) + 60, pa));
+    EXPECT(pa == b.physicalAddr + 60);
+  }
+  uint64_t pa = 0;
+  EXPECT(pool->getDeviceAddress(static_cast<char *>(big.virtualAddr) + 5000,
+                                pa));
+  EXPECT(pa == big.physicalAddr + 5000);
+
+  // Pointers outside the pool are not found.
+  int local = 0;
+  EXPECT(!pool->getDeviceAddress(&local, pa));
+  EXPECT(!pool->findChunk(static_cast<char *>(big.virtualAddr) + big.size));
+  EXPECT(pool->deallocate(big.virtualAddr));
+  EXPECT(!pool->getDeviceAddress(big.virtualAddr, pa));
+  std::printf("device address lookup: ok\n");
+}
+
+int main() {
+  testAllocFree();
+  testCoalescing();
+  testExhaustion();
+  testDeviceAddress();
+  return 0;
+}
@@ -0,0 +1,164 @@
+//===- perf_profiler.cpp ----------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: %host_cxx -std=c++17 -I%AIE_SRC_ROOT/runtime_lib/test_lib %s -o %t
+// RUN: %t | FileCheck %s
+
+// Drives aie_perf_profiler_t against the emulated counters, including
+// counters that wrap at 32 bits during a run, and checks its CSV and JSON
+// output.
+
+#include "perf_profiler.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#define EXPECT(cond)                                                           \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::printf("%s:%d: expected %s\n", __FILE__, __LINE__, #cond);          \
+      std::exit(1);                                                            \
+    }                                                                          \
+  } while (0)
+
+static const aie_perf_counter_id_t core0{1, 3, AIE_PERF_CORE, 0};
+static const aie_perf_counter_id_t core1{1, 3, AIE_PERF_CORE, 1};
+
+// CHECK: counter delta: ok
+static void testCounterDelta() {
+  // The arithmetic behind EventMonitor::diff and the profiler.
+  EXPECT(aie_perf_counter_delta(10, 25) == 15);
+  EXPECT(aie_perf_counter_delta(0xfffffff0u, 0x10) == 0x20);
+  EXPECT(aie_perf_counter_delta(0x80000000u, 0x7fffffffu) == 0xffffffffu);
+  std::printf("counter delta: ok\n");
+}
+
+// CHECK: emulated counters: ok
+static void testEmulatedBackend() {
+  aie_emulated_perf_backend_t backend(/*numCoreCounters=*/2);
+  EXPECT(backend.getNumCounters(1, 3, AIE_PERF_CORE) == 2);
+  EXPECT(!backend.configure({1, 3, AIE_PERF_CORE, 2}, 28, 29));
+  EXPECT(!backend.isConfigured(core0));
+
+  // Unconfigured counters do not count.
+  backend.advance(core0, 5);
+  EXPECT(backend.read(core0) == 0);
+
+  EXPECT(backend.configure(core0, 28, 29));
+  backend.set(core0, 0xffffff00u);
+  backend.advance(core0, 0x180);
+  EXPECT(backend.read(core0) == 0x80);
+  std::printf("emulated counters: ok\n");
+}
+
+// CHECK: wrapping counters: ok
+static void testWrap() {
+  aie_emulated_perf_backend_t backend;
+  aie_perf_profiler_t profiler(backend);
+  EXPECT(profiler.addTile(1, 3, AIE_PERF_CORE,
+                          {{28, 29, "active"}, {28, 29, "stalled"}}) == 2);
+
+  // A counter that wraps past 2^32 within a run.
+  backend.set(core0, 0xffffffffu - 99);
+  backend.set(core1, 0);
+  profiler.profile(3, [&] {
+    backend.advance(core0, 1000);
+    backend.advance(core1, 7);
+  });
+  for (uint64_t s : profiler.getSamples(0))
+    EXPECT(s == 1000);
+  EXPECT(profiler.getSamples(1) == std::vector<uint64_t>({7, 7, 7}));
+
+  // A run longer than 2^32 cycles is measured when polled often enough.
+  profiler.clear();
+  profiler.begin();
+  for (int i = 0; i < 3; i++) {
+    backend.advance(core0, 3000000000ull);
+    profiler.poll();
+  }
+  profiler.end();
+  EXPECT(profiler.getSamples(0).size() == 1);
+  EXPECT(profiler.getSamples(0)[0] == 9000000000ull);
+  std::printf("wrapping counters: ok\n");
+}
+
+// CHECK: counter limit: ok
+static void testCounterLimit() {
+  aie_emulated_perf_backend_t backend;
+  aie_perf_profiler_t profiler(backend);
+  // The memory module has two counters; the third pair is dropped.
+  EXPECT(profiler.addTile(2, 4, AIE_PERF_MEM,
+                          {{1, 2, "a"}, {3, 4, "b"}, {5, 6, "c"}}) == 2);
+  EXPECT(profiler.getNumCounters() == 2);
+  EXPECT(profiler.getCounterId(1).module == AIE_PERF_MEM);
+  EXPECT(profiler.getCounterId(1).counter == 1);
+  std::printf("counter limit: ok\n");
+}
+
+// CHECK: statistics: ok
+static void testStats() {
+  std::vector<uint64_t> samples;
+  for (uint64_t i = 100; i >= 1; i--)
+    samples.push_back(i);
+  aie_perf_stats_t s = aie_perf_stats_t::compute(samples);
+  EXPECT(s.n == 100 && s.min == 1 && s.max == 100);
+  EXPECT(s.mean == 50.5);
+  EXPECT(s.p50 == 50.5);
+  EXPECT(s.p99 > 99 && s.p99 < 100);
+  EXPECT(aie_perf_stats_t::compute({}).n == 0);
+  std::printf("statistics: ok\n");
+}
+
+// Names with characters that need escaping in both formats.
+// CHECK-LABEL: export:
+// CHECK-NEXT: col,row,module,counter,name,n,min,max,mean,stddev,p50,p90,p99
+// CHECK-NEXT: 1,3,core,0,"say ""hi"", \n",2,5,7,6.00,1.00,6.00,6.80,6.98
+// CHECK-NEXT: 1,3,core,1,back\slash,2,0,0,0.00,0.00,0.00,0.00,0.00
+// CHECK-NEXT: {
+// CHECK-NEXT:   "counters": [
+// CHECK-NEXT:     {"col": 1, "row": 3, "module": "core", "counter": 0, "name": "say \"hi\", \\n",
+// CHECK-NEXT:      "n": 2, "min": 5, "max": 7, "mean": 6.00, "stddev": 1.00, "p50": 6.00, "p90": 6.80, "p99": 6.98,
+// CHECK-NEXT:      "samples": [5, 7]},
+// CHECK-NEXT:     {"col": 1, "row": 3, "module": "core", "counter": 1, "name": "back\\slash",
+// CHECK:           "samples": [0, 0]}
+// CHECK-NEXT:   ]
+// CHECK-NEXT: }
+static void testExport() {
+  aie_emulated_perf_backend_t backend;
+  aie_perf_profiler_t profiler(backend);
+  profiler.addTile(1, 3, AIE_PERF_CORE,
+                   {{28, 29, "say \"hi\", \\n"}, {28, 29, "back\\slash"}});
+  profiler.profile(1, [&] { backend.advance(core0, 5); });
+  profiler.profile(1, [&] { backend.advance(core0, 7); });
+  std::printf("export:\n");
+  profiler.writeCSV(stdout);
+  profiler.writeJSON(stdout);
+}
+
+// CHECK: json control characters: ok
+static void testJSONControlCharacters() {
+  char buf[64] = {};
+  FILE *f = fmemopen(buf, sizeof(buf), "w");
+  aie_perf_write_json_string(f, "a\nb\tc\x01");
+  fclose(f);
+  EXPECT(std::string(buf) == "\"a\\nb\\tc\\u0001\"");
+  std::printf("json control characters: ok\n");
+}
+
+int main() {
+  testCounterDelta();
+  testEmulatedBackend();
+  testWrap();
+  testCounterLimit();
+  testStats();
+  testExport();
+  testJSONControlCharacters();
+  return 0;
+}
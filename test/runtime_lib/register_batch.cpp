@@ -0,0 +1,213 @@
+//===- register_batch.cpp ---------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// (c) Copyright 2024 Advanced Micro Devices, Inc.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: %host_cxx -std=c++17 -I%AIE_SRC_ROOT/runtime_lib/test_lib %s -o %t
+// RUN: %t | FileCheck %s
+
+// Drives aie_reg_batch_t, and the batch slot behind mlir_aie_begin_batch and
+// mlir_aie_flush_batch, against the in-memory register file.
+
+#include "register_batch.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#define EXPECT(cond)                                                           \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::printf("%s:%d: expected %s\n", __FILE__, __LINE__, #cond);          \
+      std::exit(1);                                                            \
+    }                                                                          \
+  } while (0)
+
+// Tiles are 1 MiB apart, as with a row shift of 20.
+static const unsigned tileShift = 20;
+static const uint64_t tileA = 1ull << tileShift;
+static const uint64_t tileB = 2ull << tileShift;
+
+// CHECK: contiguous writes: ok
+static void testContiguous() {
+  aie_regfile_backend_t regs;
+  aie_reg_batch_t batch(regs, tileShift);
+  for (unsigned i = 0; i < 8; i++)
+    batch.write32(tileA + 4 * i, i);
+  EXPECT(batch.getNumPending() == 8);
+  EXPECT(regs.getNumTransactions() == 0);
+  EXPECT(batch.flush() == 1);
+  EXPECT(batch.getNumPending() == 0);
+  EXPECT(regs.numBlockWrites == 1 && regs.numWrites == 0);
+  EXPECT(regs.numWords == 8);
+  for (unsigned i = 0; i < 8; i++)
+    EXPECT(regs.get(tileA + 4 * i) == i);
+  std::printf("contiguous writes: ok\n");
+}
+
+// CHECK: gaps and tiles: ok
+static void testGapsAndTiles() {
+  aie_regfile_backend_t regs;
+  aie_reg_batch_t batch(regs, tileShift);
+  // One run of two words and a single word in tile A, interleaved with a
+  // run of three words in tile B.
+  batch.write32(tileA, 1);
+  batch.write32(tileB + 0x100, 2);
+  batch.write32(tileA + 4, 3);
+  batch.write32(tileB + 0x104, 4);
+  batch.write32(tileA + 12, 5);
+  batch.write32(tileB + 0x108, 6);
+  EXPECT(batch.flush() == 3);
+  EXPECT(regs.numBlockWrites == 2 && regs.numWrites == 1);
+  EXPECT(regs.get(tileA + 4) == 3 && regs.get(tileB + 0x108) == 6);
+  std::printf("gaps and tiles: ok\n");
+}
+
+// CHECK: block size limit: ok
+static void testMaxBlockWords() {
+  aie_regfile_backend_t regs;
+  aie_reg_batch_t batch(regs, tileShift, /*reorder=*/false,
+                        /*maxBlockWords=*/4);
+  for (unsigned i = 0; i < 10; i++)
+    batch.write32(tileA + 4 * i, i);
+  EXPECT(batch.flush() == 3);
+  EXPECT(regs.numBlockWrites == 3 && regs.numWords == 10);
+  std::printf("block size limit: ok\n");
+}
+
+// CHECK: reorder: ok
+static void testReorder() {
+  // Descending addresses are not contiguous in program order...
+  aie_regfile_backend_t ordered;
+  {
+    aie_reg_batch_t batch(ordered, tileShift);
+    for (int i = 7; i >= 0; i--)
+      batch.write32(tileA + 4 * i, i);
+    EXPECT(batch.flush() == 8);
+  }
+  EXPECT(ordered.numWrites == 8);
+
+  // ...but are once sorted, and the last write to an address wins.
+  aie_regfile_backend_t sorted;
+  {
+    aie_reg_batch_t batch(sorted, tileShift, /*reorder=*/true);
+    for (int i = 7; i >= 0; i--)
+      batch.write32(tileA + 4 * i, i);
+    batch.write32(tileA + 8, 42);
+    EXPECT(batch.flush() == 1);
+  }
+  EXPECT(sorted.numBlockWrites == 1 && sorted.numWords == 8);
+  EXPECT(sorted.get(tileA + 8) == 42);
+  std::printf("reorder: ok\n");
+}
+
+// CHECK: read after write: ok
+static void testReadAfterWrite() {
+  aie_regfile_backend_t regs;
+  regs.write32(tileA + 0x20, 0xff00ff00);
+  regs.numWrites = regs.numWords = 0;
+
+  aie_reg_batch_t batch(regs, tileShift);
+  batch.write32(tileA, 7);
+  batch.write32(tileA, 8);
+  EXPECT(batch.read32(tileA) == 8);
+  EXPECT(regs.numReads == 0);
+  // Masked writes start from the device value, then from the pending one.
+  batch.maskWrite32(tileA + 0x20, 0x0000ffff, 0x12345678);
+  EXPECT(regs.numReads == 1);
+  batch.maskWrite32(tileA + 0x20, 0xffff0000, 0xabcd0000);
+  EXPECT(regs.numReads == 1);
+  EXPECT(batch.read32(tileA + 0x20) == 0xabcd5678);
+  batch.flush();
+  EXPECT(regs.get(tileA) == 8 && regs.get(tileA + 0x20) == 0xabcd5678);
+  std::printf("read after write: ok\n");
+}
+
+// CHECK: matches unbatched writes: ok
+static void testMatchesUnbatched() {
+  for (bool reorder : {false, true}) {
+    aie_regfile_backend_t direct, batched;
+    size_t numWrites = 0;
+    {
+      aie_reg_batch_t batch(batched, tileShift, reorder);
+      uint32_t seed = 1;
+      for (unsigned i = 0; i < 4096; i++) {
+        seed = seed * 1664525 + 1013904223;
+        // Mostly short ascending runs, with repeated addresses and jumps
+        // between two tiles.
+        uint64_t tile = (seed >> 31) ? tileB : tileA;
+        uint64_t addr = tile + 4 * ((i / 4 + (seed >> 8) % 3) % 256);
+        direct.write32(addr, seed);
+        batch.write32(addr, seed);
+        numWrites++;
+      }
+      EXPECT(batch.flush() < numWrites);
+    }
+    EXPECT(batched.getNumTransactions() < direct.getNumTransactions());
+    for (uint64_t tile : {tileA, tileB})
+      for (uint64_t addr = tile; addr < tile + 4 * 256; addr += 4)
+        EXPECT(batched.get(addr) == direct.get(addr));
+  }
+  std::printf("matches unbatched writes: ok\n");
+}
+
+// CHECK: batch slot: ok
+static void testSlot() {
+  aie_regfile_backend_t regs;
+  aie_reg_batch_slot_t slot;
+  EXPECT(!slot);
+  EXPECT(slot.flush() == 0);
+
+  slot.begin(regs, tileShift, /*reorder=*/false);
+  EXPECT(slot);
+  slot->write32(tileA, 1);
+  slot->write32(tileA + 4, 2);
+  // Beginning a batch flushes the current one.
+  slot.begin(regs, tileShift, /*reorder=*/true);
+  EXPECT(regs.numBlockWrites == 1);
+  slot->write32(tileB + 4, 4);
+  slot->write32(tileB, 3);
+  EXPECT(regs.get(tileB) == 0);
+  EXPECT(slot.flush() == 1);
+  EXPECT(!slot);
+  EXPECT(regs.numBlockWrites == 2 && regs.get(tileB + 4) == 4);
+  EXPECT(slot.flush() == 0);
+
+  // Flushing the batch itself issues its writes and keeps it open, as
+  // mlir_aie_clear_config does with a batch of the caller.
+  slot.begin(regs, tileShift, /*reorder=*/false);
+  slot->write32(tileA, 7);
+  EXPECT(slot->flush() == 1);
+  EXPECT(slot && regs.get(tileA) == 7);
+  slot->write32(tileA, 8);
+  EXPECT(regs.get(tileA) == 7);
+  EXPECT(slot.flush() == 1 && regs.get(tileA) == 8);
+  std::printf("batch slot: ok\n");
+}
+
+// CHECK: flush on destruction: ok
+static void testDestructorFlushes() {
+  aie_regfile_backend_t regs;
+  {
+    aie_reg_batch_t batch(regs, tileShift);
+    batch.write32(tileA, 5);
+  }
+  EXPECT(regs.numWrites == 1 && regs.get(tileA) == 5);
+  std::printf("flush on destruction: ok\n");
+}
+
+int main() {
+  testContiguous();
+  testGapsAndTiles();
+  testMaxBlockWords();
+  testReorder();
+  testReadAfterWrite();
+  testMatchesUnbatched();
+  testSlot();
+  testDestructorFlushes();
+  return 0;
+}
@@ -0,0 +1,533 @@
+#!/usr/bin/env python
+#
+# This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+# (c) Copyright 2024 Advanced Micro Devices, Inc.
+
+"""Measure how the compile time of the AIE passes scales with design size.
+
+Synthetic designs are generated from a handful of parameters: the number of
+cores, the number of core-to-core ObjectFifos and their broadcast fan-out, and
+the number of packet flows. Each design is compiled with aie-opt through the
+pipelines of aiecc, imported from aie.compiler.aiecc, using MLIR's pass timing,
+and then handed to aie-translate --aie-generate-cdo with stub ELF files, so no
+AIE toolchain is needed. The cost of verifying the resulting physical design
+once is reported as "verifier" (null if aie-opt cannot skip the verifier). The
+timings are written as JSON and can be compared against those of an earlier
+run to catch regressions.
+
+Examples:
+
+  # Run the default suite and store the results.
+  compile-time-benchmark.py -o results.json
+
+  # Compare against a baseline; exits with 1 if any pass regressed.
+  compile-time-benchmark.py -o results.json --baseline baseline.json
+
+  # Only print a single design.
+  compile-time-benchmark.py --emit --device npu --cores 8 --fanout 2
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+from aie.compiler.aiecc.main import (
+    ASSIGN_BUFFER_ADDRESSES,
+    DMA_TO_NPU,
+    INPUT_WITH_SWITCHBOXES_PIPELINE,
+    ROUTE_FLOWS,
+)
+
+# Column and row layout of the devices the designs can target. Shim tiles are
+# on row 0 and cores on `core_rows`; the shim DMAs are in `noc_columns`.
+DEVICES = {
+    "npu": {
+        "columns": 5,
+        "core_rows": range(2, 6),
+        "noc_columns": [0, 1, 2, 3],
+    },
+    "xcve2802": {
+        "columns": 38,
+        "core_rows": range(3, 11),
+        "noc_columns": [2, 3, 6, 7, 14, 15, 22, 23, 30, 31, 34, 35],
+    },
+}
+
+# Number of DMA channels in each direction of a core tile.
+CORE_DMA_CHANNELS = 2
+
+# The passes aiecc runs up to the physical design, in the same order.
+PIPELINE = str(
+    INPUT_WITH_SWITCHBOXES_PIPELINE
+    + ASSIGN_BUFFER_ADDRESSES()
+    + ROUTE_FLOWS
+    + DMA_TO_NPU
+)
+
+# (device, cores, fifos, fanout, packet flows) of the default suite.
+DEFAULT_SUITE = [
+    ("npu", 4, 4, 1, 2),
+    ("npu", 8, 7, 2, 4),
+    ("npu", 20, 19, 2, 8),
+    ("xcve2802", 32, 31, 2, 8),
+    ("xcve2802", 128, 127, 2, 16),
+    ("xcve2802", 304, 303, 2, 32),
+]
+
+
+class Design:
+    def __init__(self, device, cores, fifos, fanout, packet_flows, size):
+        self.device = device
+        self.cores = cores
+        self.fifos = fifos
+        self.fanout = fanout
+        self.packet_flows = packet_flows
+        self.size = size
+
+    @property
+    def name(self):
+        return (
+            f"{self.device}_c{self.cores}_f{self.fifos}"
+            f"_b{self.fanout}_p{self.packet_flows}"
+        )
+
+    def parameters(self):
+        return {
+            "device": self.device,
+            "cores": self.cores,
+            "fifos": self.fifos,
+            "fanout": self.fanout,
+            "packet_flows": self.packet_flows,
+            "size": self.size,
+        }
+
+    def core_tiles(self):
+        model = DEVICES[self.device]
+        tiles = [
+            (col, row)
+            for col in range(model["columns"])
+            for row in model["core_rows"]
+        ]
+        if self.cores > len(tiles):
+            raise ValueError(
+                f"{self.device} has only {len(tiles)} cores, "
+                f"{self.cores} requested"
+            )
+        return tiles[: self.cores]
+
+    def fifo_endpoints(self):
+        """Return the producer and consumers of each core-to-core fifo.
+
+        Fifo i is produced by core i (modulo the number of cores) and
+        broadcast to `fanout` cores spread evenly over the design, so that
+        most of the data has to be routed rather than shared through
+        neighbouring memories. Cores whose DMA channels are all taken are
+        skipped. The shim fifos feed the first core and drain the last one.
+        """
+        n = self.cores
+        if self.fanout >= n:
+            raise ValueError(f"fan-out {self.fanout} needs more than {n} cores")
+        inputs = [0] * n
+        outputs = [0] * n
+        inputs[0] += 1
+        outputs[-1] += 1
+
+        def next_free(start, used, exclude):
+            for offset in range(n):
+                core = (start + offset) % n
+                if used[core] < CORE_DMA_CHANNELS and core not in exclude:
+                    return core
+            raise ValueError(
+                f"not enough DMA channels for {self.fifos} fifos with a "
+                f"fan-out of {self.fanout} on {n} cores"
+            )
+
+        stride = max(1, n // (self.fanout + 1))
+        endpoints = []
+        for i in range(self.fifos):
+            producer = next_free(i, outputs, [])
+            outputs[producer] += 1
+            consumers = []
+            for k in range(self.fanout):
+                consumer = next_free(
+                    producer + 1 + k * stride, inputs, [producer] + consumers
+                )
+                inputs[consumer] += 1
+                consumers.append(consumer)
+            endpoints.append((producer, consumers))
+        return endpoints
+
+    def emit(self):
+        model = DEVICES[self.device]
+        tiles = self.core_tiles()
+        endpoints = self.fifo_endpoints()
+        if self.packet_flows > 32:
+            raise ValueError("packet ids are limited to 5 bits")
+
+        memref = f"memref<{self.size}xi32>"
+        fifo_type = f"!aie.objectfifo<{memref}>"
+        subview_type = f"!aie.objectfifosubview<{memref}>"
+        shim = (model["noc_columns"][0], 0)
+
+        def tile(t):
+            return f"%tile_{t[0]}_{t[1]}"
+
+        lines = ["module {", f"  aie.device({self.device}) {{"]
+        lines.append(f"    {tile(shim)} = aie.tile({shim[0]}, {shim[1]})")
+        for t in tiles:
+            lines.append(f"    {tile(t)} = aie.tile({t[0]}, {t[1]})")
+
+        # Fifos acquired by each core, as (name, port) pairs.
+        uses = [[] for _ in tiles]
+        lines.append(
+            f"    aie.objectfifo @in({tile(shim)}, {{{tile(tiles[0])}}}, "
+            f"2 : i32) : {fifo_type}"
+        )
+        uses[0].append(("in", "Consume"))
+        for i, (producer, consumers) in enumerate(endpoints):
+            dests = ", ".join(tile(tiles[c]) for c in consumers)
+            lines.append(
+                f"    aie.objectfifo @fifo{i}({tile(tiles[producer])}, "
+                f"{{{dests}}}, 2 : i32) : {fifo_type}"
+            )
+            uses[producer].append((f"fifo{i}", "Produce"))
+            for consumer in consumers:
+                uses[consumer].append((f"fifo{i}", "Consume"))
+        lines.append(
+            f"    aie.objectfifo @out({tile(tiles[-1])}, {{{tile(shim)}}}, "
+            f"2 : i32) : {fifo_type}"
+        )
+        uses[-1].append(("out", "Produce"))
+
+        # Packet flows between the core ports, which the fifos do not use.
+        for i in range(self.packet_flows):
+            src = tiles[i % self.cores]
+            dst = tiles[(i + self.cores // 2 + 1) % self.cores]
+            if src == dst:
+                dst = tiles[(i + 1) % self.cores]
+            lines += [
+                f"    aie.packet_flow({i}) {{",
+                f"      aie.packet_source<{tile(src)}, Core : 0>",
+                f"      aie.packet_dest<{tile(dst)}, Core : 0>",
+                "    }",
+            ]
+
+        for t, fifos in zip(tiles, uses):
+            lines += [
+                f"    aie.core({tile(t)}) {{",
+                "      %c0 = arith.constant 0 : index",
+                "      %c1 = arith.constant 1 : index",
+                "      %c4 = arith.constant 4 : index",
+                "      scf.for %i = %c0 to %c4 step %c1 {",
+            ]
+            for j, (name, port) in enumerate(fifos):
+                lines += [
+                    f"        %sub{j} = aie.objectfifo.acquire @{name}"
+                    f"({port}, 1) : {subview_type}",
+                    f"        %elem{j} = aie.objectfifo.subview.access "
+                    f"%sub{j}[0] : {subview_type} -> {memref}",
+                ]
+            for name, port in fifos:
+                lines.append(f"        aie.objectfifo.release @{name}({port}, 1)")
+            lines += ["      }", "      aie.end", "    }"]
+
+        if self.device == "npu":
+            lines += [
+                f"    func.func @sequence(%in : {memref}, %out : {memref}) {{",
+                "      %c0 = arith.constant 0 : i64",
+                "      %c1 = arith.constant 1 : i64",
+                f"      %cN = arith.constant {self.size} : i64",
+                f"      aiex.npu.dma_memcpy_nd ({shim[0]}, 0, "
+                "%out[%c0,%c0,%c0,%c0][%c1,%c1,%c1,%cN][%c0,%c0,%c0]) "
+                f"{{ metadata = @out, id = 1 : i64 }} : {memref}",
+                f"      aiex.npu.dma_memcpy_nd ({shim[0]}, 0, "
+                "%in[%c0,%c0,%c0,%c0][%c1,%c1,%c1,%cN][%c0,%c0,%c0]) "
+                f"{{ metadata = @in, id = 0 : i64 }} : {memref}",
+                f"      aiex.npu.sync {{ column = {shim[0]} : i32, "
+                "row = 0 : i32, direction = 0 : i32, channel = 0 : i32, "
+                "column_num = 1 : i32, row_num = 1 : i32 }",
+                "      return",
+                "    }",
+            ]
+        lines += ["  }", "}"]
+        return "\n".join(lines) + "\n"
+
+
+# A 32-bit little-endian ELF header without any segments. It is all
+# aie-generate-cdo needs to emit the loading of a core.
+STUB_ELF = struct.pack(
+    "<4sBBBB8sHHIIIIIHHHHHH",
+    b"\x7fELF",
+    1,  # ELFCLASS32
+    1,  # ELFDATA2LSB
+    1,  # EV_CURRENT
+    0,
+    bytes(8),
+    2,  # ET_EXEC
+    0,
+    1,
+    0,
+    0,
+    0,
+    0,
+    52,  # e_ehsize
+    32,  # e_phentsize
+    0,
+    40,  # e_shentsize
+    0,
+    0,
+)
+
+TIMING_LINE = re.compile(r"^\s*([0-9.]+)\s+\(\s*[0-9.]+%\)\s+(.*\S)\s*$")
+
+
+def parse_pass_timing(report):
+    """Parse the list display of --mlir-timing into {name: seconds}."""
+    timings = {}
+    for line in report.splitlines():
+        m = TIMING_LINE.match(line)
+        if m and m.group(2) != "Total":
+            timings[m.group(2)] = timings.get(m.group(2), 0.0) + float(m.group(1))
+    return timings
+
+
+def time_verifier(physical_path, args):
+    """Return the time spent verifying the physical design once.
+
+    It is the difference in parse time of the design with and without the
+    verification that follows parsing, or None if aie-opt cannot skip it.
+    """
+    parse_time = []
+    for flags in ([], ["--mlir-very-unsafe-disable-verifier-on-parsing"]):
+        result = subprocess.run(
+            [
+                args.aie_opt,
+                *flags,
+                "--mlir-timing",
+                "--mlir-timing-display=list",
+                physical_path,
+                "-o",
+                os.devnull,
+            ],
+            stderr=subprocess.PIPE,
+            text=True,
+        )
+        timings = parse_pass_timing(result.stderr)
+        if result.returncode or "Parser" not in timings:
+            return None
+        parse_time.append(timings["Parser"])
+    return max(parse_time[0] - parse_time[1], 0.0)
+
+
+def run_design(design, args, work_dir):
+    input_path = os.path.join(work_dir, "input.mlir")
+    physical_path = os.path.join(work_dir, "input_physical.mlir")
+    with open(input_path, "w") as f:
+        f.write(design.emit())
+
+    start = time.perf_counter()
+    result = subprocess.run(
+        [
+            args.aie_opt,
+            f"--pass-pipeline={PIPELINE}",
+            "--mlir-timing",
+            "--mlir-timing-display=list",
+            input_path,
+            "-o",
+            physical_path,
+        ],
+        stderr=subprocess.PIPE,
+        text=True,
+    )
+    opt_time = time.perf_counter() - start
+    if result.returncode:
+        raise RuntimeError(f"aie-opt failed on {design.name}:\n{result.stderr}")
+    passes = parse_pass_timing(result.stderr)
+    passes["verifier"] = time_verifier(physical_path, args)
+
+    for col, row in design.core_tiles():
+        with open(os.path.join(work_dir, f"core_{col}_{row}.elf"), "wb") as f:
+            f.write(STUB_ELF)
+    start = time.perf_counter()
+    result = subprocess.run(
+        [
+            args.aie_translate,
+            "--aie-generate-cdo",
+            f"--work-dir-path={work_dir}",
+            physical_path,
+        ],
+        stderr=subprocess.PIPE,
+        text=True,
+    )
+    cdo_time = time.perf_counter() - start
+    if result.returncode:
+        raise RuntimeError(
+            f"aie-translate failed on {design.name}:\n{result.stderr}"
+        )
+    passes["aie-generate-cdo"] = cdo_time
+
+    return {"aie-opt": opt_time, "passes": passes}
+
+
+def run_suite(designs, args):
+    results = []
+    for design in designs:
+        best = None
+        for _ in range(args.repeat):
+            with tempfile.TemporaryDirectory(prefix="aie-compile-time-") as d:
+                run = run_design(design, args, d)
+            if best is None:
+                best = run
+                continue
+            # Keep the fastest time of every pass over the repetitions.
+            best["aie-opt"] = min(best["aie-opt"], run["aie-opt"])
+            for name, seconds in run["passes"].items():
+                # The verifier time is None when it cannot be measured.
+                previous = best["passes"].get(name)
+                if previous is None or (seconds is not None and seconds < previous):
+                    best["passes"][name] = seconds
+        summary = (
+            f"{design.name}: aie-opt {best['aie-opt']:.3f}s, "
+            f"aie-generate-cdo {best['passes']['aie-generate-cdo']:.3f}s"
+        )
+        if best["passes"]["verifier"] is not None:
+            summary += f", verifier {best['passes']['verifier']:.3f}s"
+        print(summary, file=sys.stderr)
+        results.append(
+            {"name": design.name, "parameters": design.parameters(), **best}
+        )
+    return results
+
+
+def compare(results, baseline, threshold, min_seconds):
+    """Print the passes slower than in `baseline` by more than `threshold`.
+
+    Returns whether any pass regressed. Passes faster than `min_seconds` in
+    both runs are ignored, as their timings are mostly noise.
+    """
+    previous = {r["name"]: r["passes"] for r in baseline["designs"]}
+    regressed = False
+    for result in results:
+        old = previous.get(result["name"])
+        if old is None:
+            continue
+        for name, seconds in sorted(result["passes"].items()):
+            if seconds is None or old.get(name) is None:
+                continue
+            if max(seconds, old[name]) < min_seconds:
+                continue
+            ratio = seconds / max(old[name], 1e-9)
+            if ratio > threshold:
+                regressed = True
+                print(
+                    f"{result['name']}: {name} took {seconds:.3f}s, "
+                    f"{ratio:.2f}x the baseline {old[name]:.3f}s"
+                )
+    return regressed
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("--device", choices=sorted(DEVICES), default="npu")
+    parser.add_argument(
+        "--cores",
+        type=int,
+        help="number of cores; runs the default suite if not given",
+    )
+    parser.add_argument(
+        "--fifos",
+        type=int,
+        help="number of core-to-core ObjectFifos (default: as many as fit)",
+    )
+    parser.add_argument(
+        "--fanout", type=int, default=1, help="consumers of each ObjectFifo"
+    )
+    parser.add_argument(
+        "--packet-flows", type=int, default=0, help="number of packet flows"
+    )
+    parser.add_argument(
+        "--size", type=int, default=256, help="i32 elements of each fifo object"
+    )
+    parser.add_argument(
+        "--emit", action="store_true", help="print the design and exit"
+    )
+    parser.add_argument("--aie-opt", default="aie-opt")
+    parser.add_argument("--aie-translate", default="aie-translate")
+    parser.add_argument(
+        "--repeat", type=int, default=1, help="keep the fastest of N runs"
+    )
+    parser.add_argument("-o", "--output", help="write the results as JSON")
+    parser.add_argument("--baseline", help="JSON results to compare against")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=1.25,
+        help="slowdown over the baseline reported as a regression",
+    )
+    parser.add_argument(
+        "--min-seconds",
+        type=float,
+        default=0.05,
+        help="ignore passes faster than this in the comparison",
+    )
+    args = parser.parse_args()
+
+    if args.cores is None:
+        if args.emit:
+            parser.error("--emit needs --cores")
+        designs = [
+            Design(d, c, f, b, p, args.size) for d, c, f, b, p in DEFAULT_SUITE
+        ]
+    else:
+        fifos = args.fifos
+        if fifos is None:
+            fifos = (args.cores * CORE_DMA_CHANNELS - 1) // max(1, args.fanout)
+            fifos = min(fifos, args.cores * CORE_DMA_CHANNELS - 1)
+        designs = [
+            Design(
+                args.device,
+                args.cores,
+                fifos,
+                args.fanout,
+                args.packet_flows,
+                args.size,
+            )
+        ]
+
+    try:
+        if args.emit:
+            sys.stdout.write(designs[0].emit())
+            return 0
+        results = run_suite(designs, args)
+    except (ValueError, RuntimeError) as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 2
+
+    output = {"pipeline": PIPELINE, "designs": results}
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(output, f, indent=2)
+    else:
+        json.dump(output, sys.stdout, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if compare(results, baseline, args.threshold, args.min_seconds):
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())